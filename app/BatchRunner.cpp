@@ -0,0 +1,214 @@
+/**
+ * @file BatchRunner.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Runs many independent simulation scenarios across cores.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "BatchRunner.hpp"
+#include <algorithm>
+#include <cmath>
+#include "SimulationContext.hpp"
+
+namespace {
+
+/**
+ * @brief Tracks how far a signal moved past its target.
+ *
+ * The overshoot direction is the direction from the initial value to the
+ * target; a signal starting on the target counts excursions either way.
+ */
+class OvershootTracker {
+public:
+    OvershootTracker(double initial, double target)
+        : target_(target), direction_(target - initial), overshoot_(0.0) {
+    }
+
+    void update(double value) {
+        double past = value - target_;
+        if (direction_ < 0) past = -past;
+        else if (direction_ == 0) past = std::abs(past);
+        overshoot_ = std::max(overshoot_, past);
+    }
+
+    double overshoot() const { return overshoot_; }
+
+private:
+    double target_;
+    double direction_;
+    double overshoot_;
+};
+
+/**
+ * @brief Steps a scenario's simulation until it converges, diverges or
+ *        runs out of iterations.
+ */
+ScenarioSummary simulate(RobotSimulation& simulation, const Scenario& scenario,
+                         RealTimeExecutor* executor,
+                         SimulationContext* context,
+                         SharedStatePublisher* publisher) {
+    TrajectoryRecorder recorder;
+    if (!scenario.recordPath.empty()) {
+        recorder.open(scenario.recordPath);
+        simulation.setRecorder(&recorder);
+    }
+    simulation.setPublisher(publisher);
+
+    ScenarioSummary summary;
+    OvershootTracker velocity(scenario.initialVelocity,
+                              scenario.targetVelocity);
+    OvershootTracker heading(scenario.initialTheta, scenario.targetHeading);
+    ConvergenceMonitor monitor(scenario.getConvergenceCriteria());
+
+    auto step = [&](std::uint64_t) {
+        simulation.step(scenario.targetHeading, scenario.targetVelocity);
+        if (context != nullptr) context->recordStep();
+
+        double currentVelocity = simulation.getCurrentVelocity();
+        double currentHeading = simulation.getCurrentHeading();
+        velocity.update(currentVelocity);
+        heading.update(currentHeading);
+
+        return !monitor.update(scenario.targetVelocity - currentVelocity,
+                               scenario.targetHeading - currentHeading);
+    };
+
+    std::uint64_t steps = scenario.maxIterations > 0
+                              ? static_cast<std::uint64_t>(
+                                    scenario.maxIterations)
+                              : 0;
+    if (executor != nullptr) {
+        executor->run(step, steps);
+    } else {
+        for (std::uint64_t i = 0; i < steps; i++) {
+            if (!step(i)) break;
+        }
+    }
+    // The recorder goes out of scope with this call
+    simulation.setRecorder(nullptr);
+    simulation.setPublisher(nullptr);
+
+    summary.steps = monitor.getSteps();
+    summary.reason = monitor.getReason();
+    summary.converged = monitor.isSettled();
+    if (summary.converged) {
+        summary.settlingTime = (monitor.getSettledSince() + 1) *
+                               scenario.deltaT;
+    }
+    summary.velocityOvershoot = velocity.overshoot();
+    summary.headingOvershoot = heading.overshoot();
+    summary.finalHeading = simulation.getCurrentHeading();
+    summary.finalVelocity = simulation.getCurrentVelocity();
+    double poseVelocity;
+    simulation.getState(summary.finalX, summary.finalY, summary.finalTheta,
+                        poseVelocity);
+    return summary;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the BatchRunner class.
+ *
+ * @param threads The number of worker threads (0 = one per core).
+ */
+BatchRunner::BatchRunner(std::size_t threads) : pool_(threads) {
+}
+
+/**
+ * @brief Runs all scenarios in parallel.
+ *
+ * @param scenarios The scenarios to run.
+ * @return One summary per scenario, in the same order.
+ */
+std::vector<ScenarioSummary> BatchRunner::run(
+                                const std::vector<Scenario>& scenarios) {
+    std::vector<ScenarioSummary> summaries(scenarios.size());
+    pool_.parallelFor(scenarios.size(), [&](std::size_t i) {
+        summaries[i] = runScenario(scenarios[i], nullptr,
+                                   &SimulationContext::forThread());
+    });
+    return summaries;
+}
+
+/**
+ * @brief Builds the simulation a scenario describes, in its initial state.
+ *
+ * @param scenario The scenario.
+ * @param context Supplies cached steering tables and the arena the error
+ *        histories are taken from, when given.
+ * @return The simulation, ready to step.
+ */
+RobotSimulation BatchRunner::makeSimulation(const Scenario& scenario,
+                                            SimulationContext* context) {
+    RobotSimulation simulation(scenario.wheelbase, scenario.trackWidth,
+                               scenario.maxSteeringAngle,
+                               scenario.velP, scenario.velI, scenario.velD,
+                               scenario.deltaT,
+                               scenario.headP, scenario.headI, scenario.headD);
+    simulation.setInitialState(scenario.initialX, scenario.initialY,
+                               scenario.initialTheta,
+                               scenario.initialVelocity);
+    simulation.setIntegrator(makeIntegrator(scenario.integrator));
+    if (scenario.controlMode != ControlMode::PID) {
+        simulation.setControlMode(
+            scenario.controlMode, ControlTuning(),
+            static_cast<std::size_t>(scenario.mpcHorizon));
+    }
+    if (scenario.steeringTableIntervals > 0) {
+        std::shared_ptr<const SteeringTable> table;
+        if (context != nullptr) table = context->findSteeringTable(scenario);
+        if (table != nullptr) {
+            simulation.setSteeringTable(std::move(table));
+        } else {
+            simulation.enableSteeringTable(
+                scenario.steeringTableRange,
+                static_cast<std::size_t>(scenario.steeringTableIntervals),
+                scenario.steeringTableCubic ? SteeringInterpolation::Cubic
+                                            : SteeringInterpolation::Linear);
+            if (context != nullptr) {
+                context->storeSteeringTable(scenario,
+                                            simulation.shareSteeringTable());
+            }
+        }
+    }
+    if (scenario.errorHistory > 0) {
+        simulation.setErrorHistoryCapacity(
+            static_cast<std::size_t>(scenario.errorHistory),
+            context != nullptr ? &context->getArena() : nullptr);
+    }
+    return simulation;
+}
+
+/**
+ * @brief Runs a single scenario on the calling thread.
+ *
+ * @param scenario The scenario to run.
+ * @param executor Paces the steps against the wall clock when given.
+ * @param context Holds the simulation and its buffers when given.
+ * @param publisher Receives the state after every step when given.
+ * @return The summary of the run.
+ */
+ScenarioSummary BatchRunner::runScenario(const Scenario& scenario,
+                                         RealTimeExecutor* executor,
+                                         SimulationContext* context,
+                                         SharedStatePublisher* publisher) {
+    if (context != nullptr) {
+        return simulate(context->begin(scenario), scenario, executor, context,
+                        publisher);
+    }
+    RobotSimulation simulation = makeSimulation(scenario);
+    return simulate(simulation, scenario, executor, nullptr, publisher);
+}
+
+/**
+ * @brief Retrieves the number of worker threads.
+ *
+ * @return The number of worker threads.
+ */
+std::size_t BatchRunner::getThreadCount() const {
+    return pool_.size();
+}
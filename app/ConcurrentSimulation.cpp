@@ -0,0 +1,226 @@
+/**
+ * @file ConcurrentSimulation.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the two-thread controller and plant loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "ConcurrentSimulation.hpp"
+#include <stdexcept>
+#include "Clock.hpp"
+
+/**
+ * @brief Constructor for the ConcurrentSimulation class.
+ *
+ * @param controller The controller, copied; its time step is the plant's
+ *        time step.
+ * @param robot The plant in its initial state, copied.
+ * @param queueCapacity The slots of every queue.
+ */
+ConcurrentSimulation::ConcurrentSimulation(const PIDController& controller,
+                                           const RobotModel& robot,
+                                           std::size_t queueCapacity)
+    : controller_(controller), robot_(robot), setpoints_(queueCapacity),
+      commands_(queueCapacity), telemetry_(queueCapacity),
+      stopRequested_(false), running_(false), setpointCount_(0) {
+    StateSample sample;
+    double velocity;
+    robot_.getState(sample.x, sample.y, sample.theta, velocity);
+    sample.heading = robot_.getHeading();
+    sample.speed = robot_.getSpeed();
+    publish(sample);
+}
+
+/**
+ * @brief Stops and joins the threads.
+ */
+ConcurrentSimulation::~ConcurrentSimulation() {
+    stop();
+}
+
+/**
+ * @brief Queues a new setpoint for the controller. Call from one thread
+ *        only.
+ *
+ * @param heading The target heading (radians).
+ * @param velocity The target velocity.
+ * @return False if the setpoint queue is full.
+ */
+bool ConcurrentSimulation::setSetpoint(double heading, double velocity) {
+    Setpoint setpoint;
+    setpoint.heading = heading;
+    setpoint.velocity = velocity;
+    return setpoints_.tryPush(setpoint);
+}
+
+/**
+ * @brief Starts the controller and plant threads.
+ *
+ * @param maxSteps The number of steps after which both threads end.
+ */
+void ConcurrentSimulation::start(std::uint64_t maxSteps) {
+    if (controllerThread_.joinable() || plantThread_.joinable()) {
+        throw std::logic_error("ConcurrentSimulation is already running");
+    }
+    stats_ = ChannelStats();
+    controlLatency_.clear();
+    setpointCount_ = 0;
+    stopRequested_.store(false);
+    running_.store(true);
+    // Republish so the first reaction time does not include the idle time
+    publish(state_.load().sample);
+    controllerThread_ = std::thread(&ConcurrentSimulation::runController,
+                                    this, maxSteps);
+    plantThread_ = std::thread(&ConcurrentSimulation::runPlant, this,
+                               maxSteps);
+}
+
+/**
+ * @brief Asks both threads to end after the current step, and joins them.
+ */
+void ConcurrentSimulation::stop() {
+    stopRequested_.store(true);
+    join();
+}
+
+/**
+ * @brief Waits for both threads to end.
+ *
+ * @return The channel statistics of the run.
+ */
+const ChannelStats& ConcurrentSimulation::join() {
+    if (controllerThread_.joinable()) controllerThread_.join();
+    if (plantThread_.joinable()) plantThread_.join();
+    stats_.controlLatency.clear();
+    stats_.controlLatency.merge(controlLatency_);
+    stats_.setpoints = setpointCount_;
+    return stats_;
+}
+
+/**
+ * @brief Checks whether the plant is still stepping.
+ *
+ * @return True until maxSteps steps have run or stop() was called.
+ */
+bool ConcurrentSimulation::isRunning() const {
+    return running_.load();
+}
+
+/**
+ * @brief Takes the oldest telemetry sample. Call from one consumer thread
+ *        only.
+ *
+ * @param sample The sample (output).
+ * @return False if no sample is queued.
+ */
+bool ConcurrentSimulation::pollTelemetry(StateSample& sample) {
+    return telemetry_.tryPop(sample);
+}
+
+/**
+ * @brief Reads the latest plant state. Safe from any thread.
+ *
+ * @return The state after the latest step.
+ */
+StateSample ConcurrentSimulation::getLatestState() const {
+    return state_.load().sample;
+}
+
+/**
+ * @brief Retrieves the channel statistics. Complete after join().
+ *
+ * @return The statistics.
+ */
+const ChannelStats& ConcurrentSimulation::getStats() const {
+    return stats_;
+}
+
+/**
+ * @brief The controller thread: waits for state k, computes command k from
+ *        the latest setpoint and sends it to the plant.
+ *
+ * @param maxSteps The number of commands to send.
+ */
+void ConcurrentSimulation::runController(std::uint64_t maxSteps) {
+    Setpoint setpoint;
+    const std::uint64_t first = state_.load().sample.step;
+    for (std::uint64_t k = first; k < first + maxSteps; k++) {
+        PublishedState state = state_.load();
+        while (state.sample.step != k) {
+            if (stopRequested_.load(std::memory_order_relaxed)) return;
+            std::this_thread::yield();
+            state = state_.load();
+        }
+
+        Setpoint latest;
+        while (setpoints_.tryPop(latest)) {
+            setpoint = latest;
+            setpointCount_++;
+        }
+        controller_.computeErrors(setpoint.velocity, state.sample.speed,
+                                  setpoint.heading, state.sample.heading);
+        PIDOutput output = controller_.computeControl();
+
+        CommandMessage command;
+        command.step = k;
+        command.heading = output.heading;
+        command.velocity = output.velocity;
+        command.sentNs = monotonicNow();
+        controlLatency_.record(command.sentNs - state.publishedNs);
+        while (!commands_.tryPush(command)) {
+            if (stopRequested_.load(std::memory_order_relaxed)) return;
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief The plant thread: applies each command as RobotSimulation::step()
+ *        does, then publishes the new state and offers it as telemetry.
+ *
+ * @param maxSteps The number of commands to apply.
+ */
+void ConcurrentSimulation::runPlant(std::uint64_t maxSteps) {
+    const double dt = controller_.getDeltaTime();
+    for (std::uint64_t k = 0; k < maxSteps; k++) {
+        CommandMessage command;
+        bool received = false;
+        while (!(received = commands_.tryPop(command))) {
+            if (stopRequested_.load(std::memory_order_relaxed)) break;
+            std::this_thread::yield();
+        }
+        if (!received) break;
+        stats_.commandLatency.record(monotonicNow() - command.sentNs);
+
+        robot_.Simulate_robot_model(command.heading, command.velocity, dt);
+        robot_.updateState(command.heading, dt);
+
+        StateSample sample;
+        double velocity;
+        sample.step = command.step + 1;
+        robot_.getState(sample.x, sample.y, sample.theta, velocity);
+        sample.heading = robot_.getHeading();
+        sample.speed = robot_.getSpeed();
+        sample.headingCommand = command.heading;
+        sample.velocityCommand = command.velocity;
+        publish(sample);
+        if (!telemetry_.tryPush(sample)) stats_.telemetryDropped++;
+        stats_.steps++;
+    }
+    running_.store(false);
+}
+
+/**
+ * @brief Publishes a state, stamped with the current time.
+ *
+ * @param sample The state.
+ */
+void ConcurrentSimulation::publish(const StateSample& sample) {
+    PublishedState state;
+    state.sample = sample;
+    state.publishedNs = monotonicNow();
+    state_.store(state);
+}
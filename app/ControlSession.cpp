@@ -0,0 +1,139 @@
+/**
+ * @file ControlSession.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Implementation of the long-running closed loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "ControlSession.hpp"
+
+/**
+ * @brief Constructor for the ControlSession class.
+ *
+ * @param simulation The simulation to drive, copied.
+ */
+ControlSession::ControlSession(const RobotSimulation& simulation)
+    : simulation_(simulation),
+      heading_(simulation.getCurrentHeading()),
+      velocity_(simulation.getCurrentVelocity()),
+      bumpless_(true), steps_(0) {
+}
+
+/**
+ * @brief Starts moving both setpoints to new targets.
+ *
+ * @param heading The target heading (radians).
+ * @param velocity The target velocity.
+ * @param shape How the setpoints move.
+ * @param duration The time the move takes; ignored for a step.
+ */
+void ControlSession::command(double heading, double velocity,
+                             ProfileShape shape, double duration) {
+    double headingBefore = heading_.getValue();
+    double velocityBefore = velocity_.getValue();
+    heading_.setTarget(heading, shape, duration);
+    velocity_.setTarget(velocity, shape, duration);
+    // Only a step moves the setpoints before the next step() does
+    if (bumpless_) {
+        simulation_.shiftSetpoints(velocity_.getValue() - velocityBefore,
+                                   heading_.getValue() - headingBefore);
+    }
+}
+
+/**
+ * @brief Turns bumpless transfer of step commands on or off.
+ *
+ * @param enabled True to keep the PID output continuous across steps.
+ */
+void ControlSession::setBumpless(bool enabled) {
+    bumpless_ = enabled;
+}
+
+/**
+ * @brief Advances the setpoints by one time step and steps the simulation
+ *        towards them.
+ *
+ * @return The controller outputs applied in this step.
+ */
+PIDOutput ControlSession::step() {
+    double dt = simulation_.getController().getDeltaTime();
+    double heading = heading_.advance(dt);
+    double velocity = velocity_.advance(dt);
+    steps_++;
+    return simulation_.step(heading, velocity);
+}
+
+/**
+ * @brief Runs a number of steps.
+ *
+ * @param steps The number of steps.
+ */
+void ControlSession::run(std::uint64_t steps) {
+    for (std::uint64_t i = 0; i < steps; i++) step();
+}
+
+/**
+ * @brief Get the heading setpoint the last step used.
+ *
+ * @return The heading setpoint (radians).
+ */
+double ControlSession::getHeadingSetpoint() const {
+    return heading_.getValue();
+}
+
+/**
+ * @brief Get the velocity setpoint the last step used.
+ *
+ * @return The velocity setpoint.
+ */
+double ControlSession::getVelocitySetpoint() const {
+    return velocity_.getValue();
+}
+
+/**
+ * @brief Get the heading setpoint's profile.
+ *
+ * @return The profile, with its target.
+ */
+const SetpointProfile& ControlSession::getHeadingProfile() const {
+    return heading_;
+}
+
+/**
+ * @brief Get the velocity setpoint's profile.
+ *
+ * @return The profile, with its target.
+ */
+const SetpointProfile& ControlSession::getVelocityProfile() const {
+    return velocity_;
+}
+
+/**
+ * @brief Get the number of steps run.
+ *
+ * @return The step count.
+ */
+std::uint64_t ControlSession::getSteps() const {
+    return steps_;
+}
+
+/**
+ * @brief Get the simulation, e.g. to attach a recorder or publisher.
+ *
+ * @return The simulation.
+ */
+RobotSimulation& ControlSession::getSimulation() {
+    return simulation_;
+}
+
+/**
+ * @brief Get the simulation.
+ *
+ * @return The simulation.
+ */
+const RobotSimulation& ControlSession::getSimulation() const {
+    return simulation_;
+}
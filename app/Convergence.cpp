@@ -0,0 +1,113 @@
+/**
+ * @file Convergence.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief When a simulation run counts as converged or diverged, and when it
+ *        should stop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Convergence.hpp"
+#include <cmath>
+
+/**
+ * @brief Get the name of a termination reason, e.g. "converged".
+ *
+ * @param reason The termination reason.
+ * @return Its lower-case name.
+ */
+const char* terminationReasonName(TerminationReason reason) {
+    switch (reason) {
+    case TerminationReason::Converged:
+        return "converged";
+    case TerminationReason::Diverged:
+        return "diverged";
+    case TerminationReason::MaxIterations:
+        return "max_iterations";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Constructor for the ConvergenceMonitor class.
+ *
+ * @param criteria The tolerances, settle window and limits.
+ */
+ConvergenceMonitor::ConvergenceMonitor(const ConvergenceCriteria& criteria)
+    : criteria_(criteria), steps_(0), settledSince_(-1), diverged_(false) {
+    if (criteria_.settleWindow < 1) criteria_.settleWindow = 1;
+}
+
+/**
+ * @brief Checks the errors after one step.
+ *
+ * @param velocityError The velocity error after the step.
+ * @param headingError The heading error after the step.
+ * @return True if the run should stop.
+ */
+bool ConvergenceMonitor::update(double velocityError, double headingError) {
+    double velocity = std::abs(velocityError);
+    double heading = std::abs(headingError);
+
+    // NaN fails every comparison, so it lands here too
+    if (!(velocity <= criteria_.velocityDivergence) ||
+        !(heading <= criteria_.headingDivergence)) {
+        diverged_ = true;
+        settledSince_ = -1;
+        steps_++;
+        return true;
+    }
+
+    if (velocity < criteria_.velocityTolerance &&
+        heading < criteria_.headingTolerance) {
+        if (settledSince_ < 0) settledSince_ = steps_;
+    } else {
+        settledSince_ = -1;
+    }
+    steps_++;
+
+    return (isSettled() && criteria_.stopOnConvergence) ||
+           steps_ >= criteria_.maxIterations;
+}
+
+/**
+ * @brief Get the reason the run ended, or would end now.
+ *
+ * @return The termination reason.
+ */
+TerminationReason ConvergenceMonitor::getReason() const {
+    if (diverged_) return TerminationReason::Diverged;
+    if (isSettled()) return TerminationReason::Converged;
+    return TerminationReason::MaxIterations;
+}
+
+/**
+ * @brief Checks whether both channels have been within tolerance for the
+ *        settle window, up to the latest step.
+ *
+ * @return True if settled.
+ */
+bool ConvergenceMonitor::isSettled() const {
+    return settledSince_ >= 0 &&
+           steps_ - settledSince_ >= criteria_.settleWindow;
+}
+
+/**
+ * @brief Get the first step of the current stretch within tolerance.
+ *
+ * @return The zero-based step index, or -1.
+ */
+int ConvergenceMonitor::getSettledSince() const {
+    return settledSince_;
+}
+
+/**
+ * @brief Get the number of steps checked.
+ *
+ * @return The number of steps.
+ */
+int ConvergenceMonitor::getSteps() const {
+    return steps_;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file ErrorHistory.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Bounded ring buffer used to record recent controller errors.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "ErrorHistory.hpp"
+#include <utility>
+
+/**
+ * @brief Constructor for the ErrorHistory class.
+ *
+ * @param capacity The maximum number of samples kept.
+ */
+ErrorHistory::ErrorHistory(std::size_t capacity)
+    : buffer_(nullptr), capacity_(0), next_(0), size_(0), dirty_(false) {
+    setCapacity(capacity);
+}
+
+/**
+ * @brief Copies a history; a ring taken from an arena is shared with the
+ *        copy.
+ *
+ * @param other The history to copy.
+ */
+ErrorHistory::ErrorHistory(const ErrorHistory& other)
+    : owned_(other.owned_), buffer_(other.buffer_),
+      capacity_(other.capacity_), next_(other.next_), size_(other.size_),
+      ordered_(other.ordered_), dirty_(other.dirty_) {
+    if (!owned_.empty()) buffer_ = owned_.data();
+}
+
+/**
+ * @brief Copies a history; a ring taken from an arena is shared with the
+ *        copy.
+ *
+ * @param other The history to copy.
+ * @return This history.
+ */
+ErrorHistory& ErrorHistory::operator=(const ErrorHistory& other) {
+    if (this == &other) return *this;
+    owned_ = other.owned_;
+    buffer_ = owned_.empty() ? other.buffer_ : owned_.data();
+    capacity_ = other.capacity_;
+    next_ = other.next_;
+    size_ = other.size_;
+    ordered_ = other.ordered_;
+    dirty_ = other.dirty_;
+    return *this;
+}
+
+/**
+ * @brief Moves a history, taking over its ring without copying; the
+ *        moved-from history is left empty with capacity zero.
+ *
+ * @param other The history to move.
+ */
+ErrorHistory::ErrorHistory(ErrorHistory&& other) noexcept
+    : owned_(std::move(other.owned_)), buffer_(other.buffer_),
+      capacity_(other.capacity_), next_(other.next_), size_(other.size_),
+      ordered_(std::move(other.ordered_)), dirty_(other.dirty_) {
+    if (!owned_.empty()) buffer_ = owned_.data();
+    other.releaseAfterMove();
+}
+
+/**
+ * @brief Moves a history, taking over its ring without copying; the
+ *        moved-from history is left empty with capacity zero.
+ *
+ * @param other The history to move.
+ * @return This history.
+ */
+ErrorHistory& ErrorHistory::operator=(ErrorHistory&& other) noexcept {
+    if (this == &other) return *this;
+    owned_ = std::move(other.owned_);
+    buffer_ = owned_.empty() ? other.buffer_ : owned_.data();
+    capacity_ = other.capacity_;
+    next_ = other.next_;
+    size_ = other.size_;
+    ordered_ = std::move(other.ordered_);
+    dirty_ = other.dirty_;
+    other.releaseAfterMove();
+    return *this;
+}
+
+/**
+ * @brief Changes the capacity of the buffer and discards stored samples.
+ *
+ * @param capacity The maximum number of samples kept.
+ */
+void ErrorHistory::setCapacity(std::size_t capacity) {
+    owned_.assign(capacity, 0.0);
+    buffer_ = owned_.empty() ? nullptr : owned_.data();
+    capacity_ = capacity;
+    ordered_.clear();
+    ordered_.reserve(capacity);
+    clear();
+}
+
+/**
+ * @brief Changes the capacity and takes the ring from an arena.
+ *
+ * @param capacity The maximum number of samples kept.
+ * @param arena The arena providing the ring.
+ */
+void ErrorHistory::setCapacity(std::size_t capacity, MonotonicArena& arena) {
+    std::vector<double>().swap(owned_);
+    buffer_ = capacity == 0 ? nullptr : arena.allocateArray<double>(capacity);
+    capacity_ = capacity;
+    ordered_.clear();
+    clear();
+}
+
+/**
+ * @brief Retrieves the maximum number of samples kept.
+ *
+ * @return The capacity of the buffer.
+ */
+std::size_t ErrorHistory::capacity() const {
+    return capacity_;
+}
+
+/**
+ * @brief Retrieves the number of samples currently stored.
+ *
+ * @return The number of stored samples.
+ */
+std::size_t ErrorHistory::size() const {
+    return size_;
+}
+
+/**
+ * @brief Records a sample, overwriting the oldest one when full.
+ *
+ * @param value The sample to record.
+ */
+void ErrorHistory::push(double value) {
+    if (capacity_ == 0) return;
+
+    buffer_[next_] = value;
+    next_ = (next_ + 1) % capacity_;
+    if (size_ < capacity_) size_++;
+    dirty_ = true;
+}
+
+/**
+ * @brief Discards all stored samples while keeping the capacity.
+ */
+void ErrorHistory::clear() {
+    next_ = 0;
+    size_ = 0;
+    dirty_ = true;
+}
+
+/**
+ * @brief Retrieves the stored samples in chronological order.
+ *
+ * The ordered copy is rebuilt lazily, so reading the history costs nothing
+ * on the control path.
+ *
+ * @return The stored samples, oldest first.
+ */
+const std::vector<double>& ErrorHistory::values() const {
+    if (dirty_) {
+        ordered_.clear();
+        std::size_t oldest = (next_ + capacity_ - size_) %
+                             (capacity_ == 0 ? 1 : capacity_);
+        for (std::size_t i = 0; i < size_; i++) {
+            ordered_.push_back(buffer_[(oldest + i) % capacity_]);
+        }
+        dirty_ = false;
+    }
+    return ordered_;
+}
+
+/**
+ * @brief Leaves a moved-from history empty with capacity zero.
+ */
+void ErrorHistory::releaseAfterMove() {
+    owned_.clear();
+    ordered_.clear();
+    buffer_ = nullptr;
+    capacity_ = 0;
+    next_ = 0;
+    size_ = 0;
+    dirty_ = false;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file Fixed16.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Implementation of the Q16.16 elementary functions.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Fixed16.hpp"
+
+namespace {
+
+const std::int64_t kPi = 205887;          // pi * 2^16, rounded
+const std::int64_t kTwoPi = 411775;       // 2 pi * 2^16, rounded
+const std::int64_t kHalfPi = 102944;      // pi / 2 * 2^16, rounded
+const Fixed16 kPiOverSix = Fixed16::fromRaw(34315);
+const Fixed16 kSqrtThree = Fixed16::fromRaw(113512);
+/// tan(pi / 12), the end of the range of the atan series.
+const Fixed16 kTanPiOverTwelve = Fixed16::fromRaw(17560);
+
+/**
+ * @brief Evaluates the sine series on [-pi / 2, pi / 2].
+ */
+Fixed16 sineSeries(Fixed16 x) {
+    const Fixed16 one = Fixed16::fromRaw(Fixed16::kOne);
+    Fixed16 x2 = x * x;
+    // Nested as x (1 - x^2 / 6 (1 - x^2 / 20 (...))) so that no coefficient
+    // is too small for 16 fractional bits; the x^9 term keeps the
+    // truncation error under 1e-5 at pi / 2
+    Fixed16 sum = one - x2 / Fixed16::fromDouble(72.0);
+    sum = one - x2 / Fixed16::fromDouble(42.0) * sum;
+    sum = one - x2 / Fixed16::fromDouble(20.0) * sum;
+    sum = one - x2 / Fixed16::fromDouble(6.0) * sum;
+    return x * sum;
+}
+
+/**
+ * @brief Evaluates the arc tangent series on [0, tan(pi / 12)].
+ */
+Fixed16 arcTangentSeries(Fixed16 x) {
+    const Fixed16 one = Fixed16::fromRaw(Fixed16::kOne);
+    Fixed16 x2 = x * x;
+    Fixed16 sum = Fixed16::fromDouble(1.0 / 5.0) -
+                  x2 / Fixed16::fromDouble(7.0);
+    sum = Fixed16::fromDouble(1.0 / 3.0) - x2 * sum;
+    return x * (one - x2 * sum);
+}
+
+}  // namespace
+
+/**
+ * @brief Get the sine.
+ *
+ * @param angle The angle (radians), any value.
+ * @return sin(angle).
+ */
+Fixed16 sin(Fixed16 angle) {
+    // Reduce to [-pi, pi], then reflect into [-pi / 2, pi / 2]
+    std::int64_t raw = angle.raw() % kTwoPi;
+    if (raw > kPi) raw -= kTwoPi;
+    if (raw < -kPi) raw += kTwoPi;
+    if (raw > kHalfPi) raw = kPi - raw;
+    if (raw < -kHalfPi) raw = -kPi - raw;
+    return sineSeries(Fixed16::fromRaw(static_cast<std::int32_t>(raw)));
+}
+
+/**
+ * @brief Get the cosine.
+ *
+ * @param angle The angle (radians), any value.
+ * @return cos(angle).
+ */
+Fixed16 cos(Fixed16 angle) {
+    std::int64_t raw = angle.raw() % kTwoPi + kHalfPi;
+    return sin(Fixed16::fromRaw(static_cast<std::int32_t>(raw)));
+}
+
+/**
+ * @brief Get the tangent, saturating near odd multiples of pi / 2.
+ *
+ * @param angle The angle (radians), any value.
+ * @return tan(angle).
+ */
+Fixed16 tan(Fixed16 angle) {
+    return sin(angle) / cos(angle);
+}
+
+/**
+ * @brief Get the arc tangent.
+ *
+ * @param value The value.
+ * @return atan(value), in [-pi / 2, pi / 2].
+ */
+Fixed16 atan(Fixed16 value) {
+    const Fixed16 one = Fixed16::fromRaw(Fixed16::kOne);
+    bool negative = value < Fixed16();
+    Fixed16 x = abs(value);
+    // atan(x) = pi / 2 - atan(1 / x) brings x into [0, 1]
+    bool reciprocal = x > one;
+    if (reciprocal) x = one / x;
+    // atan(x) = pi / 6 + atan((sqrt(3) x - 1) / (sqrt(3) + x)) brings it
+    // into [-tan(pi / 12), tan(pi / 12)]
+    bool shifted = x > kTanPiOverTwelve;
+    if (shifted) x = (kSqrtThree * x - one) / (kSqrtThree + x);
+    Fixed16 result = x < Fixed16() ? -arcTangentSeries(-x)
+                                   : arcTangentSeries(x);
+    if (shifted) result += kPiOverSix;
+    if (reciprocal) result = Fixed16::fromRaw(kHalfPi) - result;
+    return negative ? -result : result;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file FleetSimulation.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the closed-loop fleet simulation.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "FleetSimulation.hpp"
+#include <algorithm>
+
+namespace {
+
+/// Vehicles per parallel task; large enough to amortize the scheduling.
+const std::size_t kChunk = 2048;
+
+std::size_t chunkCount(std::size_t count) {
+    return (count + kChunk - 1) / kChunk;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the FleetSimulation class.
+ *
+ * @param count The number of vehicles.
+ * @param dt The time step of a tick.
+ * @param threads The number of worker threads; zero uses one per core.
+ */
+FleetSimulation::FleetSimulation(std::size_t count, double dt,
+                                 std::size_t threads)
+    : dt_(dt), fleet_(count), pool_(threads),
+      velP_(count, 1.0), velI_(count, 0.1), velD_(count, 0.01),
+      headP_(count, 1.0), headI_(count, 0.1), headD_(count, 0.01),
+      targetHeading_(count, 0.0), targetVelocity_(count, 0.0),
+      velLast_(count, 0.0), velPrev_(count, 0.0), velIntegral_(count, 0.0),
+      headLast_(count, 0.0), headPrev_(count, 0.0), headIntegral_(count, 0.0),
+      samples_(count, 0),
+      headingCommand_(count, 0.0), velocityCommand_(count, 0.0) {
+    rebuildIndex();
+}
+
+/**
+ * @brief Sets the PID gains of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param velP The proportional gain for velocity control.
+ * @param velI The integral gain for velocity control.
+ * @param velD The derivative gain for velocity control.
+ * @param headP The proportional gain for heading control.
+ * @param headI The integral gain for heading control.
+ * @param headD The derivative gain for heading control.
+ */
+void FleetSimulation::setGains(std::size_t i, double velP, double velI,
+                               double velD, double headP, double headI,
+                               double headD) {
+    velP_[i] = velP;
+    velI_[i] = velI;
+    velD_[i] = velD;
+    headP_[i] = headP;
+    headI_[i] = headI;
+    headD_[i] = headD;
+}
+
+/**
+ * @brief Sets the targets of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param heading The target heading (radians).
+ * @param velocity The target velocity.
+ */
+void FleetSimulation::setTarget(std::size_t i, double heading,
+                                double velocity) {
+    targetHeading_[i] = heading;
+    targetVelocity_[i] = velocity;
+}
+
+/**
+ * @brief Advances every vehicle by one tick and rebuilds the index.
+ */
+void FleetSimulation::step() {
+    const std::size_t count = size();
+    pool_.parallelFor(chunkCount(count), [this, count](std::size_t c) {
+        stepChunk(c * kChunk, std::min(count, (c + 1) * kChunk));
+    }, 1);
+    rebuildIndex();
+}
+
+/**
+ * @brief Runs the controllers of the vehicles in [begin, end), then steps
+ *        those vehicles.
+ *
+ * The controller math is that of PIDController::computeErrors() and
+ * computeControl() without integral limits, in the same operation order.
+ *
+ * @param begin The index of the first vehicle.
+ * @param end One past the index of the last vehicle.
+ */
+void FleetSimulation::stepChunk(std::size_t begin, std::size_t end) {
+    const std::vector<double>& speed = fleet_.speed();
+    const std::vector<double>& heading = fleet_.heading();
+    for (std::size_t i = begin; i < end; i++) {
+        double velocityError = targetVelocity_[i] - speed[i];
+        double headingError = targetHeading_[i] - heading[i];
+        velPrev_[i] = velLast_[i];
+        velLast_[i] = velocityError;
+        headPrev_[i] = headLast_[i];
+        headLast_[i] = headingError;
+        velIntegral_[i] += velocityError;
+        headIntegral_[i] += headingError;
+        if (samples_[i] < 2) samples_[i]++;
+
+        double velocityD = 0.0;
+        double headingD = 0.0;
+        if (samples_[i] >= 2) {
+            velocityD = velD_[i] * ((velLast_[i] - velPrev_[i]) / dt_);
+            headingD = headD_[i] * ((headLast_[i] - headPrev_[i]) / dt_);
+        }
+        velocityCommand_[i] = velP_[i] * velLast_[i] +
+                              velI_[i] * velIntegral_[i] + velocityD;
+        headingCommand_[i] = headP_[i] * headLast_[i] +
+                             headI_[i] * headIntegral_[i] + headingD;
+    }
+    fleet_.stepRange(begin, end, headingCommand_.data(),
+                     velocityCommand_.data(), dt_);
+}
+
+/**
+ * @brief Rebuilds the index, e.g. after moving vehicles through getFleet().
+ */
+void FleetSimulation::rebuildIndex() {
+    index_.build(fleet_.x().data(), fleet_.y().data(), size());
+}
+
+/**
+ * @brief Changes the cell size of the index and rebuilds it.
+ *
+ * @param cellSize The side of a cell; about the usual query radius works
+ *        best.
+ */
+void FleetSimulation::setCellSize(double cellSize) {
+    index_ = SpatialGrid(cellSize);
+    rebuildIndex();
+}
+
+/**
+ * @brief Finds the vehicle closest to another one.
+ *
+ * @param i The index of the vehicle.
+ * @param distance The distance between the two (output).
+ * @return The index of the closest other vehicle, or SpatialGrid::npos.
+ */
+std::size_t FleetSimulation::nearest(std::size_t i, double& distance) const {
+    return index_.nearest(fleet_.x()[i], fleet_.y()[i], i, distance);
+}
+
+/**
+ * @brief Lists every pair of vehicles at most a radius apart, searching in
+ *        parallel.
+ *
+ * @param radius The largest distance of a pair.
+ * @return The pairs (i, j) with i < j, sorted.
+ */
+std::vector<std::pair<std::size_t, std::size_t>>
+FleetSimulation::findPairs(double radius) {
+    typedef std::vector<std::pair<std::size_t, std::size_t>> Pairs;
+    const std::size_t indexed = index_.size();
+    std::vector<Pairs> found(chunkCount(indexed));
+    pool_.parallelFor(found.size(), [&](std::size_t c) {
+        index_.findPairs(radius, c * kChunk,
+                         std::min(indexed, (c + 1) * kChunk), found[c]);
+    }, 1);
+
+    Pairs pairs;
+    for (const Pairs& chunk : found) {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+/**
+ * @brief Retrieves the number of vehicles.
+ *
+ * @return The number of vehicles.
+ */
+std::size_t FleetSimulation::size() const {
+    return fleet_.size();
+}
+
+/**
+ * @brief Retrieves the vehicles, e.g. to set their geometry and initial
+ *        state.
+ *
+ * @return The fleet.
+ */
+RobotFleet& FleetSimulation::getFleet() {
+    return fleet_;
+}
+
+/**
+ * @brief Retrieves the vehicles.
+ *
+ * @return The fleet.
+ */
+const RobotFleet& FleetSimulation::getFleet() const {
+    return fleet_;
+}
+
+/**
+ * @brief Retrieves the index over the positions of the last tick.
+ *
+ * @return The index.
+ */
+const SpatialGrid& FleetSimulation::getIndex() const {
+    return index_;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file GainTuner.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Searches the six PID gains of a RobotSimulation automatically.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "GainTuner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "BatchRunner.hpp"
+#include "RobotSimulation.hpp"
+
+const std::size_t PIDGains::kCount;
+
+namespace {
+
+/**
+ * @brief Accumulates how far a signal moved past its target.
+ *
+ * Returns only the growth of the overshoot, so summing the results gives
+ * the largest overshoot.
+ */
+class OvershootGrowth {
+public:
+    OvershootGrowth(double initial, double target)
+        : target_(target), direction_(target - initial), overshoot_(0.0) {
+    }
+
+    double update(double value) {
+        double past = value - target_;
+        if (direction_ < 0) past = -past;
+        else if (direction_ == 0) past = std::abs(past);
+        if (past <= overshoot_) return 0.0;
+        double growth = past - overshoot_;
+        overshoot_ = past;
+        return growth;
+    }
+
+private:
+    double target_;
+    double direction_;
+    double overshoot_;
+};
+
+/**
+ * @brief Lists the runs of a problem, one per setpoint.
+ */
+std::vector<Scenario> expandSetpoints(const TuningProblem& problem,
+                                      const PIDGains& gains) {
+    std::vector<Scenario> scenarios;
+    if (problem.setpoints.empty()) {
+        scenarios.push_back(problem.base);
+    }
+    for (std::size_t i = 0; i < problem.setpoints.size(); i++) {
+        Scenario scenario = problem.base;
+        scenario.targetHeading = problem.setpoints[i].first;
+        scenario.targetVelocity = problem.setpoints[i].second;
+        scenario.name += "#" + std::to_string(i + 1);
+        scenarios.push_back(scenario);
+    }
+    for (Scenario& scenario : scenarios) {
+        gains.applyTo(scenario);
+        scenario.stopOnConvergence = false;
+        scenario.recordPath.clear();
+    }
+    return scenarios;
+}
+
+/**
+ * @brief Maps a point of the unit box to gains.
+ */
+PIDGains fromUnit(const TuningProblem& problem, const double* unit) {
+    PIDGains gains;
+    for (std::size_t i = 0; i < PIDGains::kCount; i++) {
+        gains[i] = problem.lower[i] +
+                   unit[i] * (problem.upper[i] - problem.lower[i]);
+    }
+    return gains;
+}
+
+/**
+ * @brief A candidate of the search, in unit-box coordinates.
+ */
+struct Candidate {
+    double unit[PIDGains::kCount];
+    double cost;
+};
+
+}  // namespace
+
+/**
+ * @brief Access a gain by index, in declaration order.
+ *
+ * @param index The gain index, below kCount.
+ * @return The gain.
+ */
+double& PIDGains::operator[](std::size_t index) {
+    double* gains[kCount] = {&velP, &velI, &velD, &headP, &headI, &headD};
+    return *gains[index];
+}
+
+/**
+ * @brief Read a gain by index, in declaration order.
+ *
+ * @param index The gain index, below kCount.
+ * @return The gain.
+ */
+double PIDGains::operator[](std::size_t index) const {
+    return const_cast<PIDGains&>(*this)[index];
+}
+
+/**
+ * @brief Reads the gains of a scenario.
+ *
+ * @param scenario The scenario.
+ * @return Its gains.
+ */
+PIDGains PIDGains::fromScenario(const Scenario& scenario) {
+    PIDGains gains;
+    gains.velP = scenario.velP;
+    gains.velI = scenario.velI;
+    gains.velD = scenario.velD;
+    gains.headP = scenario.headP;
+    gains.headI = scenario.headI;
+    gains.headD = scenario.headD;
+    return gains;
+}
+
+/**
+ * @brief Writes the gains into a scenario.
+ *
+ * @param scenario The scenario to modify.
+ */
+void PIDGains::applyTo(Scenario& scenario) const {
+    scenario.velP = velP;
+    scenario.velI = velI;
+    scenario.velD = velD;
+    scenario.headP = headP;
+    scenario.headI = headI;
+    scenario.headD = headD;
+}
+
+/**
+ * @brief Constructor, with bounds that suit the default scenario.
+ */
+TuningProblem::TuningProblem() {
+    upper.velP = 5.0;
+    upper.velI = 2.0;
+    upper.velD = 1.0;
+    upper.headP = 5.0;
+    upper.headI = 2.0;
+    upper.headD = 1.0;
+}
+
+/**
+ * @brief Constructor for the GainTuner class.
+ *
+ * @param threads The number of worker threads (0 = one per core).
+ */
+GainTuner::GainTuner(std::size_t threads) : pool_(threads) {
+}
+
+/**
+ * @brief Computes the cost of a set of gains.
+ *
+ * @param problem The plant, setpoints and weights.
+ * @param gains The gains to score.
+ * @param bound The run stops as soon as the cost exceeds this value.
+ * @return The cost, a value above the bound when stopped early, or
+ *         infinity if the simulation diverged.
+ */
+double GainTuner::evaluate(const TuningProblem& problem,
+                           const PIDGains& gains, double bound) {
+    const TuningWeights& weights = problem.weights;
+    double cost = 0.0;
+
+    for (const Scenario& scenario : expandSetpoints(problem, gains)) {
+        RobotSimulation simulation = BatchRunner::makeSimulation(scenario);
+        OvershootGrowth velocity(scenario.initialVelocity,
+                                 scenario.targetVelocity);
+        OvershootGrowth heading(scenario.initialTheta,
+                                scenario.targetHeading);
+        const double dt = scenario.deltaT;
+
+        for (int i = 0; i < scenario.maxIterations; i++) {
+            PIDOutput output = simulation.step(scenario.targetHeading,
+                                               scenario.targetVelocity);
+            double currentVelocity = simulation.getCurrentVelocity();
+            double currentHeading = simulation.getCurrentHeading();
+            if (!std::isfinite(currentVelocity) ||
+                !std::isfinite(currentHeading)) {
+                return std::numeric_limits<double>::infinity();
+            }
+
+            double time = (i + 1) * dt;
+            double error =
+                std::abs(scenario.targetVelocity - currentVelocity) +
+                std::abs(scenario.targetHeading - currentHeading);
+            cost += weights.error * time * error * dt;
+            cost += weights.overshoot * (velocity.update(currentVelocity) +
+                                         heading.update(currentHeading));
+            cost += weights.effort * (output.velocity * output.velocity +
+                                      output.heading * output.heading) * dt;
+
+            // Every term is non-negative: a loser cannot catch up
+            if (!(cost <= bound)) {
+                return std::isfinite(cost)
+                           ? cost
+                           : std::numeric_limits<double>::infinity();
+            }
+        }
+    }
+    return cost;
+}
+
+/**
+ * @brief Searches for the gains with the lowest cost.
+ *
+ * @param problem The plant, setpoints and bounds.
+ * @param options The search settings.
+ * @return The best gains and a convergence report.
+ */
+TuningReport GainTuner::tune(const TuningProblem& problem,
+                             const TuningOptions& options) {
+    for (std::size_t i = 0; i < PIDGains::kCount; i++) {
+        if (!(problem.lower[i] <= problem.upper[i])) {
+            throw std::invalid_argument("a gain's lower bound exceeds its "
+                                        "upper bound");
+        }
+    }
+    if (problem.base.maxIterations <= 0) {
+        throw std::invalid_argument("the base scenario has no steps");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TuningReport report;
+    std::vector<Candidate> candidates;
+
+    // Evaluates every candidate in parallel against the given bound
+    auto evaluateAll = [&](double bound, TuningIteration& iteration) {
+        pool_.parallelFor(candidates.size(), [&](std::size_t i) {
+            candidates[i].cost =
+                evaluate(problem, fromUnit(problem, candidates[i].unit),
+                         bound);
+        }, 1);
+        iteration.evaluations = candidates.size();
+        for (const Candidate& candidate : candidates) {
+            if (candidate.cost > bound) iteration.pruned++;
+        }
+        report.evaluations += iteration.evaluations;
+        report.pruned += iteration.pruned;
+    };
+
+    // Iteration 0: the starting gains plus a Latin hypercube sample
+    Candidate incumbent;
+    PIDGains initial = PIDGains::fromScenario(problem.base);
+    for (std::size_t i = 0; i < PIDGains::kCount; i++) {
+        double range = problem.upper[i] - problem.lower[i];
+        double unit = range > 0 ? (initial[i] - problem.lower[i]) / range
+                                : 0.0;
+        incumbent.unit[i] = std::min(1.0, std::max(0.0, unit));
+    }
+    candidates.push_back(incumbent);
+
+    std::mt19937 generator(options.seed);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+    const std::size_t samples = options.initialSamples;
+    std::vector<std::size_t> strata(samples);
+    candidates.resize(1 + samples);
+    for (std::size_t gain = 0; gain < PIDGains::kCount; gain++) {
+        for (std::size_t s = 0; s < samples; s++) strata[s] = s;
+        std::shuffle(strata.begin(), strata.end(), generator);
+        for (std::size_t s = 0; s < samples; s++) {
+            candidates[1 + s].unit[gain] =
+                (strata[s] + jitter(generator)) / samples;
+        }
+    }
+
+    TuningIteration seed;
+    evaluateAll(std::numeric_limits<double>::infinity(), seed);
+    report.initialCost = candidates[0].cost;
+    incumbent = *std::min_element(
+        candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+    seed.bestCost = incumbent.cost;
+    seed.step = options.initialStep;
+    report.history.push_back(seed);
+
+    // Pattern search around the incumbent
+    double step = options.initialStep;
+    while (step >= options.minStep &&
+           report.evaluations < options.maxEvaluations &&
+           std::isfinite(incumbent.cost)) {
+        candidates.clear();
+        for (std::size_t gain = 0; gain < PIDGains::kCount; gain++) {
+            for (double sign : {1.0, -1.0}) {
+                Candidate candidate = incumbent;
+                double moved = std::min(1.0, std::max(0.0,
+                    incumbent.unit[gain] + sign * step));
+                if (moved == incumbent.unit[gain]) continue;
+                candidate.unit[gain] = moved;
+                candidates.push_back(candidate);
+            }
+        }
+
+        TuningIteration iteration;
+        evaluateAll(incumbent.cost, iteration);
+        const Candidate* best = &incumbent;
+        for (const Candidate& candidate : candidates) {
+            if (candidate.cost < best->cost) best = &candidate;
+        }
+        if (best != &incumbent) {
+            incumbent = *best;
+        } else {
+            step *= 0.5;
+        }
+        iteration.bestCost = incumbent.cost;
+        iteration.step = step;
+        report.history.push_back(iteration);
+    }
+
+    report.best = fromUnit(problem, incumbent.unit);
+    report.bestCost = incumbent.cost;
+    report.scenarios = expandSetpoints(problem, report.best);
+    for (const Scenario& scenario : report.scenarios) {
+        report.summaries.push_back(BatchRunner::runScenario(scenario));
+    }
+    report.elapsedSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+/**
+ * @brief Retrieves the number of worker threads.
+ *
+ * @return The number of worker threads.
+ */
+std::size_t GainTuner::getThreadCount() const {
+    return pool_.size();
+}
@@ -0,0 +1,300 @@
+/**
+ * @file Integrator.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Integration schemes for the planar pose of the Ackermann model.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Integrator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Time derivative of the pose.
+ */
+struct PoseRate {
+    double x;
+    double y;
+    double theta;
+};
+
+/**
+ * @brief Input at a fraction of the step, interpolated linearly.
+ */
+MotionInput inputAt(const MotionInput& start, const MotionInput& end,
+                    double fraction) {
+    MotionInput input;
+    input.velocity = start.velocity +
+                     (end.velocity - start.velocity) * fraction;
+    input.yawRate = start.yawRate + (end.yawRate - start.yawRate) * fraction;
+    return input;
+}
+
+PoseRate derivative(const Pose2D& pose, const MotionInput& input) {
+    PoseRate rate;
+    rate.x = input.velocity * std::cos(pose.theta);
+    rate.y = input.velocity * std::sin(pose.theta);
+    rate.theta = input.yawRate;
+    return rate;
+}
+
+/**
+ * @brief Returns pose + h * sum(weights[i] * rates[i]).
+ */
+Pose2D advance(const Pose2D& pose, double h, const PoseRate* rates,
+               const double* weights, int count) {
+    double dx = 0.0;
+    double dy = 0.0;
+    double dtheta = 0.0;
+    for (int i = 0; i < count; i++) {
+        dx += weights[i] * rates[i].x;
+        dy += weights[i] * rates[i].y;
+        dtheta += weights[i] * rates[i].theta;
+    }
+    Pose2D next;
+    next.x = pose.x + h * dx;
+    next.y = pose.y + h * dy;
+    next.theta = pose.theta + h * dtheta;
+    return next;
+}
+
+// Dormand-Prince 5(4) tableau
+const double kNodes[7] = {0.0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0, 1.0};
+const double kStages[6][6] = {
+    {1.0 / 5},
+    {3.0 / 40, 9.0 / 40},
+    {44.0 / 45, -56.0 / 15, 32.0 / 9},
+    {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729},
+    {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176,
+     -5103.0 / 18656},
+    {35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784,
+     11.0 / 84},
+};
+/// Fifth-order minus fourth-order weights.
+const double kErrorWeights[7] = {71.0 / 57600, 0.0, -71.0 / 16695,
+                                 71.0 / 1920, -17253.0 / 339200,
+                                 22.0 / 525, -1.0 / 40};
+
+}  // namespace
+
+/**
+ * @brief Explicit Euler with the start input.
+ *
+ * @param pose The pose to advance (input and output).
+ * @param start The input at the beginning of the step.
+ * @param end The input at the end of the step (unused).
+ * @param dt The time step.
+ * @return The number of derivative evaluations used.
+ */
+int EulerIntegrator::integrate(Pose2D& pose, const MotionInput& start,
+                               const MotionInput&, double dt) const {
+    double deltaX = start.velocity * std::cos(pose.theta) * dt;
+    double deltaY = start.velocity * std::sin(pose.theta) * dt;
+    pose.x += deltaX;
+    pose.y += deltaY;
+    pose.theta += start.yawRate * dt;
+    return 1;
+}
+
+/**
+ * @brief Moves along the circular arc of the mean input.
+ *
+ * @param pose The pose to advance (input and output).
+ * @param start The input at the beginning of the step.
+ * @param end The input at the end of the step.
+ * @param dt The time step.
+ * @return The number of derivative evaluations used.
+ */
+int ArcIntegrator::integrate(Pose2D& pose, const MotionInput& start,
+                             const MotionInput& end, double dt) const {
+    MotionInput mean = inputAt(start, end, 0.5);
+    double half = 0.5 * mean.yawRate * dt;
+    // The chord of the arc is v dt sin(half) / half long; the series avoids
+    // the cancellation of sin(half) / half on straight lines
+    double sinc = std::abs(half) < 1e-4 ? 1.0 - half * half / 6.0
+                                        : std::sin(half) / half;
+    double chord = mean.velocity * dt * sinc;
+    pose.x += chord * std::cos(pose.theta + half);
+    pose.y += chord * std::sin(pose.theta + half);
+    pose.theta += 2.0 * half;
+    return 1;
+}
+
+/**
+ * @brief Classic fourth-order Runge-Kutta.
+ *
+ * @param pose The pose to advance (input and output).
+ * @param start The input at the beginning of the step.
+ * @param end The input at the end of the step.
+ * @param dt The time step.
+ * @return The number of derivative evaluations used.
+ */
+int RK4Integrator::integrate(Pose2D& pose, const MotionInput& start,
+                             const MotionInput& end, double dt) const {
+    static const double kHalf[1] = {0.5};
+    static const double kFull[1] = {1.0};
+    static const double kWeights[4] = {1.0 / 6, 1.0 / 3, 1.0 / 3, 1.0 / 6};
+
+    MotionInput middle = inputAt(start, end, 0.5);
+    PoseRate rates[4];
+    rates[0] = derivative(pose, start);
+    rates[1] = derivative(advance(pose, dt, &rates[0], kHalf, 1), middle);
+    rates[2] = derivative(advance(pose, dt, &rates[1], kHalf, 1), middle);
+    rates[3] = derivative(advance(pose, dt, &rates[2], kFull, 1), end);
+    pose = advance(pose, dt, rates, kWeights, 4);
+    return 4;
+}
+
+/**
+ * @brief Constructor for the RK45Integrator class.
+ *
+ * @param tolerance The largest accepted local error of any pose component,
+ *        relative to max(1, |component|).
+ * @param maxSubsteps The largest number of trial substeps per step.
+ */
+RK45Integrator::RK45Integrator(double tolerance, int maxSubsteps)
+    : tolerance_(tolerance), maxSubsteps_(maxSubsteps) {
+    if (!(tolerance > 0.0)) {
+        throw std::invalid_argument("the tolerance must be positive");
+    }
+}
+
+/**
+ * @brief Advances the pose by dt in as many substeps as the tolerance
+ *        requires.
+ *
+ * @param pose The pose to advance (input and output).
+ * @param start The input at the beginning of the step.
+ * @param end The input at the end of the step.
+ * @param dt The time step.
+ * @return The number of derivative evaluations used.
+ */
+int RK45Integrator::integrate(Pose2D& pose, const MotionInput& start,
+                              const MotionInput& end, double dt) const {
+    if (!(dt > 0.0)) return 0;
+
+    PoseRate rates[7];
+    rates[0] = derivative(pose, start);
+    int evaluations = 1;
+    double t = 0.0;
+    double h = dt;
+
+    for (int trial = 0; t < dt; trial++) {
+        if (trial == maxSubsteps_) {
+            throw std::runtime_error("RK45 tolerance not met within the "
+                                     "substep limit");
+        }
+        bool last = t + h >= dt;
+        if (last) h = dt - t;
+
+        Pose2D next;
+        for (int stage = 1; stage < 7; stage++) {
+            next = advance(pose, h, rates, kStages[stage - 1], stage);
+            rates[stage] = derivative(
+                next, inputAt(start, end, (t + kNodes[stage] * h) / dt));
+        }
+        evaluations += 6;
+
+        // The last stage is the fifth-order solution (first same as last)
+        Pose2D error = advance(Pose2D(), h, rates, kErrorWeights, 7);
+        double ratio = std::max(
+            std::abs(error.x) / std::max(1.0, std::abs(next.x)),
+            std::max(std::abs(error.y) / std::max(1.0, std::abs(next.y)),
+                     std::abs(error.theta) /
+                         std::max(1.0, std::abs(next.theta)))) /
+            tolerance_;
+
+        if (!std::isfinite(ratio) ||
+            !std::isfinite(next.x + next.y + next.theta)) {
+            // A diverged plant: hand the non-finite state back
+            pose = next;
+            return evaluations;
+        }
+        if (ratio <= 1.0) {
+            pose = next;
+            rates[0] = rates[6];
+            t = last ? dt : t + h;
+        }
+        double scale = ratio == 0.0 ? 5.0 : 0.9 * std::pow(ratio, -0.2);
+        h *= std::min(5.0, std::max(0.2, scale));
+    }
+    return evaluations;
+}
+
+/**
+ * @brief Retrieves the local error tolerance.
+ *
+ * @return The tolerance.
+ */
+double RK45Integrator::getTolerance() const {
+    return tolerance_;
+}
+
+/**
+ * @brief Get the name of an integration method: euler, arc, rk4 or rk45.
+ *
+ * @param method The integration method.
+ * @return Its lower-case name.
+ */
+const char* integrationMethodName(IntegrationMethod method) {
+    switch (method) {
+    case IntegrationMethod::Euler:
+        return "euler";
+    case IntegrationMethod::Arc:
+        return "arc";
+    case IntegrationMethod::RK4:
+        return "rk4";
+    case IntegrationMethod::RK45:
+        return "rk45";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of an integration method.
+ *
+ * @param name One of euler, arc, rk4 or rk45.
+ * @return The integration method.
+ */
+IntegrationMethod parseIntegrationMethod(const std::string& name) {
+    const IntegrationMethod methods[] = {
+        IntegrationMethod::Euler, IntegrationMethod::Arc,
+        IntegrationMethod::RK4, IntegrationMethod::RK45};
+    for (IntegrationMethod method : methods) {
+        if (name == integrationMethodName(method)) return method;
+    }
+    throw std::invalid_argument("unknown integrator '" + name + "'");
+}
+
+/**
+ * @brief Get a shared integrator with default settings.
+ *
+ * @param method The integration method.
+ * @return The integrator.
+ */
+std::shared_ptr<const Integrator> makeIntegrator(IntegrationMethod method) {
+    static const std::shared_ptr<const Integrator> euler =
+        std::make_shared<EulerIntegrator>();
+    static const std::shared_ptr<const Integrator> arc =
+        std::make_shared<ArcIntegrator>();
+    static const std::shared_ptr<const Integrator> rk4 =
+        std::make_shared<RK4Integrator>();
+    static const std::shared_ptr<const Integrator> rk45 =
+        std::make_shared<RK45Integrator>();
+    switch (method) {
+    case IntegrationMethod::Arc:
+        return arc;
+    case IntegrationMethod::RK4:
+        return rk4;
+    case IntegrationMethod::RK45:
+        return rk45;
+    default:
+        return euler;
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file LQRController.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the discrete linear-quadratic regulator.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "LQRController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+/// Fixed point iterations allowed for the Riccati equation.
+const int kMaxRiccatiIterations = 10000;
+/// Relative change of P at which the iteration has converged.
+const double kRiccatiTolerance = 1e-12;
+
+/**
+ * @brief Limits a value to [-limit, limit].
+ */
+double clampSymmetric(double value, double limit) {
+    return std::max(-limit, std::min(limit, value));
+}
+
+/**
+ * @brief Computes the gain (R + B'PB)^-1 B'PA.
+ */
+Matrix<kModelInputs, kModelStates> riccatiGain(
+                    const LinearizedModel& model,
+                    const Matrix<kModelStates, kModelStates>& costToGo,
+                    const Matrix<kModelInputs, kModelInputs>& inputWeights) {
+    Matrix<kModelInputs, kModelStates> bTp = model.B.transpose() * costToGo;
+    return solve(inputWeights + bTp * model.B, bTp * model.A);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the LQRController class.
+ *
+ * @param tuning The weights and limits.
+ */
+LQRController::LQRController(const ControlTuning& tuning)
+    : tuning_(tuning), hasModel_(false) {
+    tuning_.validate();
+}
+
+/**
+ * @brief Solves the discrete algebraic Riccati equation by fixed point
+ *        iteration, starting from P = Q.
+ *
+ * @param model The model supplying A and B.
+ * @param stateWeights The state weights Q.
+ * @param inputWeights The input weights R.
+ * @return The cost-to-go matrix P.
+ */
+Matrix<kModelStates, kModelStates> LQRController::solveRiccati(
+                    const LinearizedModel& model,
+                    const Matrix<kModelStates, kModelStates>& stateWeights,
+                    const Matrix<kModelInputs, kModelInputs>& inputWeights) {
+    Matrix<kModelStates, kModelStates> p = stateWeights;
+    Matrix<kModelStates, kModelStates> aT = model.A.transpose();
+    for (int i = 0; i < kMaxRiccatiIterations; i++) {
+        Matrix<kModelInputs, kModelStates> gain =
+            riccatiGain(model, p, inputWeights);
+        Matrix<kModelStates, kModelStates> pA = p * model.A;
+        Matrix<kModelStates, kModelStates> next =
+            stateWeights + aT * pA - aT * (p * model.B) * gain;
+        double change = (next - p).maxAbs();
+        p = next;
+        if (change <= kRiccatiTolerance * (1.0 + p.maxAbs())) return p;
+    }
+    throw std::runtime_error("Riccati iteration did not converge");
+}
+
+/**
+ * @brief Uses a model and computes its gain.
+ *
+ * @param model The model.
+ */
+void LQRController::setModel(const LinearizedModel& model) {
+    costToGo_ = solveRiccati(model, tuning_.stateWeights(),
+                             tuning_.inputWeights());
+    gain_ = riccatiGain(model, costToGo_, tuning_.inputWeights());
+    model_ = model;
+    hasModel_ = true;
+}
+
+/**
+ * @brief Computes the input that drives an error to zero.
+ *
+ * @param error The heading and speed errors from the targets.
+ * @return The input, within the limits of the model.
+ */
+ModelInput LQRController::control(const ModelState& error) const {
+    ModelInput input = -1.0 * (gain_ * error);
+    input(0, 0) = clampSymmetric(input(0, 0), model_.maxSteeringAngle);
+    input(1, 0) = clampSymmetric(input(1, 0), model_.maxWheelSpeedChange);
+    return input;
+}
+
+/**
+ * @brief Runs one control step towards the targets.
+ *
+ * @param robot The robot in its current state.
+ * @param targetHeading The desired heading (radians).
+ * @param targetVelocity The desired speed.
+ * @param dt The time step.
+ * @return The steering angle as heading and the wheel speed change as
+ *         velocity.
+ */
+PIDOutput LQRController::compute(const RobotModel& robot,
+                                 double targetHeading, double targetVelocity,
+                                 double dt) {
+    LinearizedModel model = linearizeRobotModel(robot, robot.getSpeed(), dt,
+                                                tuning_);
+    if (!hasModel_ || !sameModel(model, model_)) setModel(model);
+
+    ModelState error;
+    error(0, 0) = robot.getHeading() - targetHeading;
+    error(1, 0) = robot.getSpeed() - targetVelocity;
+    ModelInput input = control(error);
+
+    PIDOutput output;
+    output.heading = input(0, 0);
+    output.velocity = input(1, 0);
+    return output;
+}
+
+/**
+ * @brief Get the gain K of the current model.
+ *
+ * @return The gain.
+ */
+const Matrix<kModelInputs, kModelStates>& LQRController::getGain() const {
+    return gain_;
+}
+
+/**
+ * @brief Get the cost-to-go matrix P of the current model.
+ *
+ * @return The solution of the Riccati equation.
+ */
+const Matrix<kModelStates, kModelStates>& LQRController::getCostToGo()
+                                                                    const {
+    return costToGo_;
+}
+
+/**
+ * @brief Get the model the gain was computed for.
+ *
+ * @return The model.
+ */
+const LinearizedModel& LQRController::getModel() const {
+    return model_;
+}
+
+/**
+ * @brief Get the weights and limits.
+ *
+ * @return The tuning.
+ */
+const ControlTuning& LQRController::getTuning() const {
+    return tuning_;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Fixed-size log-linear histogram of durations in nanoseconds.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "LatencyHistogram.hpp"
+#include <cmath>
+
+const std::size_t LatencyHistogram::kBucketCount;
+
+/**
+ * @brief Constructor for the LatencyHistogram class.
+ */
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+/**
+ * @brief Adds every value of another histogram.
+ *
+ * @param other The histogram to merge into this one.
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count_ == 0) return;
+    for (std::size_t i = 0; i < kBucketCount; i++) {
+        buckets_[i] += other.buckets_[i];
+    }
+    if (count_ == 0 || other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+    count_ += other.count_;
+    sum_ += other.sum_;
+}
+
+/**
+ * @brief Removes every value.
+ */
+void LatencyHistogram::clear() {
+    for (std::size_t i = 0; i < kBucketCount; i++) buckets_[i] = 0;
+    count_ = min_ = max_ = sum_ = 0;
+}
+
+/**
+ * @brief Get the number of recorded values.
+ *
+ * @return The number of values.
+ */
+std::uint64_t LatencyHistogram::getCount() const {
+    return count_;
+}
+
+/**
+ * @brief Get the smallest recorded value.
+ *
+ * @return The minimum in nanoseconds, or 0 if empty.
+ */
+std::uint64_t LatencyHistogram::getMin() const {
+    return min_;
+}
+
+/**
+ * @brief Get the largest recorded value.
+ *
+ * @return The maximum in nanoseconds, or 0 if empty.
+ */
+std::uint64_t LatencyHistogram::getMax() const {
+    return max_;
+}
+
+/**
+ * @brief Get the sum of the recorded values.
+ *
+ * @return The sum in nanoseconds.
+ */
+std::uint64_t LatencyHistogram::getSum() const {
+    return sum_;
+}
+
+/**
+ * @brief Get the mean of the recorded values.
+ *
+ * @return The mean in nanoseconds, or 0 if empty.
+ */
+double LatencyHistogram::getMean() const {
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_;
+}
+
+/**
+ * @brief Get the value below which a fraction of the values fall.
+ *
+ * @param fraction The fraction, from 0 to 1 (e.g. 0.99).
+ * @return The upper edge of the bucket holding that value.
+ */
+std::uint64_t LatencyHistogram::getPercentile(double fraction) const {
+    if (count_ == 0) return 0;
+    if (fraction <= 0.0) return min_;
+    if (fraction >= 1.0) return max_;
+
+    std::uint64_t rank = static_cast<std::uint64_t>(
+        std::ceil(fraction * static_cast<double>(count_)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; i++) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            std::uint64_t bound = bucketUpperBound(i);
+            if (bound < min_) return min_;
+            return bound < max_ ? bound : max_;
+        }
+    }
+    return max_;
+}
+
+/**
+ * @brief Get the largest value counted in a bucket.
+ *
+ * @param bucket The bucket index.
+ * @return The upper edge of the bucket, inclusive.
+ */
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t bucket) {
+    if (bucket < 32) return bucket;
+    unsigned exponent = static_cast<unsigned>(bucket / 16 - 1);
+    std::uint64_t mantissa = bucket % 16 + 16;
+    return ((mantissa + 1) << exponent) - 1;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file LinearizedModel.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Linearization of the robot model for the LQR and MPC controllers.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "LinearizedModel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Get the name of a control mode.
+ *
+ * @param mode The control mode.
+ * @return One of pid, lqr or mpc.
+ */
+const char* controlModeName(ControlMode mode) {
+    switch (mode) {
+    case ControlMode::PID:
+        return "pid";
+    case ControlMode::LQR:
+        return "lqr";
+    case ControlMode::MPC:
+        return "mpc";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of a control mode.
+ *
+ * @param name One of pid, lqr or mpc.
+ * @return The control mode.
+ */
+ControlMode parseControlMode(const std::string& name) {
+    const ControlMode modes[] = {ControlMode::PID, ControlMode::LQR,
+                                 ControlMode::MPC};
+    for (ControlMode mode : modes) {
+        if (name == controlModeName(mode)) return mode;
+    }
+    throw std::invalid_argument("unknown control mode '" + name + "'");
+}
+
+/**
+ * @brief Checks the weights before a controller is built from them.
+ */
+void ControlTuning::validate() const {
+    if (!(headingWeight >= 0.0) || !(speedWeight >= 0.0)) {
+        throw std::invalid_argument("state weights must not be negative");
+    }
+    // Positive input weights keep the problems strictly convex
+    if (!(steeringWeight > 0.0) || !(wheelSpeedWeight > 0.0)) {
+        throw std::invalid_argument("input weights must be positive");
+    }
+    if (!(minimumSpeed > 0.0) || !(maxWheelSpeedChange > 0.0)) {
+        throw std::invalid_argument(
+            "the minimum speed and wheel speed limit must be positive");
+    }
+}
+
+/**
+ * @brief Linearizes a robot about driving straight at a speed.
+ *
+ * @param robot Supplies the wheelbase, wheel radius and steering limit.
+ * @param speed The operating speed.
+ * @param dt The time step.
+ * @param tuning Supplies the minimum speed and the wheel speed limit.
+ * @return The model of one step.
+ */
+LinearizedModel linearizeRobotModel(const RobotModel& robot, double speed,
+                                    double dt, const ControlTuning& tuning) {
+    LinearizedModel model;
+    model.A = Matrix<kModelStates, kModelStates>::identity();
+    // Simulate_robot_model() reports the speed as a magnitude, so the
+    // heading responds to the steering the same way in either direction
+    double operatingSpeed = std::max(std::abs(speed), tuning.minimumSpeed);
+    model.B(0, 0) = dt * operatingSpeed / robot.getWheelbase();
+    // For a RobotSimulation this is its trackWidth argument; see the
+    // RobotSimulation constructor
+    model.B(1, 1) = robot.getWheelRadius();
+    model.maxSteeringAngle = robot.getMaxSteeringAngle();
+    model.maxWheelSpeedChange = tuning.maxWheelSpeedChange;
+    return model;
+}
+
+/**
+ * @brief Checks whether two models have the same matrices and limits.
+ *
+ * @param a The first model.
+ * @param b The second model.
+ * @return True if they are identical.
+ */
+bool sameModel(const LinearizedModel& a, const LinearizedModel& b) {
+    for (std::size_t i = 0; i < kModelStates; i++) {
+        for (std::size_t j = 0; j < kModelStates; j++) {
+            if (a.A(i, j) != b.A(i, j)) return false;
+        }
+        for (std::size_t j = 0; j < kModelInputs; j++) {
+            if (a.B(i, j) != b.B(i, j)) return false;
+        }
+    }
+    return a.maxSteeringAngle == b.maxSteeringAngle &&
+           a.maxWheelSpeedChange == b.maxWheelSpeedChange;
+}
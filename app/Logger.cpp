@@ -0,0 +1,236 @@
+/**
+ * @file Logger.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Levelled logging with pluggable sinks for the control loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Logger.hpp"
+#include <chrono>
+#include <cstring>
+
+std::atomic<LogSink*> Logger::sink_(nullptr);
+std::atomic<int> Logger::level_(static_cast<int>(LogLevel::Info));
+std::atomic<int> Logger::threshold_(static_cast<int>(LogLevel::Off) + 1);
+
+const std::size_t RingBufferSink::kMaxMessageLength;
+
+/**
+ * @brief Discards the message.
+ */
+void NullSink::write(LogLevel, const char*, std::size_t) {
+}
+
+/**
+ * @brief Constructor for the StreamSink class.
+ *
+ * @param stream The stream receiving the messages.
+ */
+StreamSink::StreamSink(std::ostream& stream) : stream_(stream) {
+}
+
+/**
+ * @brief Writes the message followed by a newline, without flushing.
+ *
+ * @param level The severity of the message.
+ * @param message The message text.
+ * @param length The number of characters in the message.
+ */
+void StreamSink::write(LogLevel, const char* message, std::size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_.write(message, static_cast<std::streamsize>(length));
+    stream_.put('\n');
+}
+
+/**
+ * @brief Constructor for the RingBufferSink class.
+ *
+ * @param capacity The number of slots, rounded up to a power of two.
+ */
+RingBufferSink::RingBufferSink(std::size_t capacity)
+    : enqueuePos_(0), dequeuePos_(0), dropped_(0), running_(false) {
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    slots_.reset(new Slot[size]);
+    mask_ = size - 1;
+    for (std::size_t i = 0; i < size; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Stops the background thread and drains pending messages.
+ */
+RingBufferSink::~RingBufferSink() {
+    stop();
+}
+
+/**
+ * @brief Copies the message into a free slot, dropping it if none is free.
+ *
+ * @param level The severity of the message.
+ * @param message The message text.
+ * @param length The number of characters in the message.
+ */
+void RingBufferSink::write(LogLevel level, const char* message,
+                           std::size_t length) {
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) -
+                              static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->length = length < kMaxMessageLength ? length : kMaxMessageLength;
+    std::memcpy(slot->text, message, slot->length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Forwards the oldest pending message, if any.
+ *
+ * @param downstream The sink receiving the message.
+ * @return True if a message was forwarded.
+ */
+bool RingBufferSink::pop(LogSink& downstream) {
+    std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (seq != pos + 1) return false;
+
+    downstream.write(slot.level, slot.text, slot.length);
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Starts a background thread forwarding messages to a sink.
+ *
+ * @param downstream The sink receiving the drained messages.
+ */
+void RingBufferSink::start(LogSink& downstream) {
+    stop();
+    running_.store(true, std::memory_order_release);
+    worker_ = std::thread([this, &downstream]() {
+        while (running_.load(std::memory_order_acquire)) {
+            if (!pop(downstream)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+        while (pop(downstream)) {
+        }
+    });
+}
+
+/**
+ * @brief Stops the background thread after draining pending messages.
+ */
+void RingBufferSink::stop() {
+    running_.store(false, std::memory_order_release);
+    if (worker_.joinable()) worker_.join();
+}
+
+/**
+ * @brief Forwards all pending messages to a sink on the calling thread.
+ *
+ * @param downstream The sink receiving the drained messages.
+ * @return The number of messages forwarded.
+ */
+std::size_t RingBufferSink::drain(LogSink& downstream) {
+    std::size_t count = 0;
+    while (pop(downstream)) count++;
+    return count;
+}
+
+/**
+ * @brief Retrieves the number of messages dropped because of overflow.
+ *
+ * @return The number of dropped messages.
+ */
+std::uint64_t RingBufferSink::getDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Installs the sink receiving all messages.
+ *
+ * @param sink The sink to install, or nullptr to silence logging.
+ */
+void Logger::setSink(LogSink* sink) {
+    sink_.store(sink, std::memory_order_release);
+    updateThreshold();
+}
+
+/**
+ * @brief Retrieves the installed sink.
+ *
+ * @return The installed sink, or nullptr when logging is silent.
+ */
+LogSink* Logger::getSink() {
+    return sink_.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Sets the lowest level forwarded to the sink.
+ *
+ * @param level The lowest enabled level.
+ */
+void Logger::setLevel(LogLevel level) {
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+    updateThreshold();
+}
+
+/**
+ * @brief Retrieves the lowest level forwarded to the sink.
+ *
+ * @return The lowest enabled level.
+ */
+LogLevel Logger::getLevel() {
+    return static_cast<LogLevel>(level_.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Folds the sink and level into the threshold checked by enabled().
+ */
+void Logger::updateThreshold() {
+    int threshold = static_cast<int>(LogLevel::Off) + 1;
+    if (sink_.load(std::memory_order_acquire) != nullptr) {
+        threshold = level_.load(std::memory_order_relaxed);
+    }
+    threshold_.store(threshold, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Constructor for the LogLine class.
+ *
+ * @param level The severity of the message being formatted.
+ */
+LogLine::LogLine(LogLevel level)
+    : level_(level), buffer_(text_, sizeof(text_)), stream_(&buffer_) {
+}
+
+/**
+ * @brief Writes the formatted message to the installed sink.
+ */
+LogLine::~LogLine() {
+    LogSink* sink = Logger::getSink();
+    if (sink != nullptr) sink->write(level_, text_, buffer_.length());
+}
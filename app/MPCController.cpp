@@ -0,0 +1,346 @@
+/**
+ * @file MPCController.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of model predictive control with input limits.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "MPCController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "LQRController.hpp"
+
+namespace {
+
+/// Which bound, if any, an input of the active-set method is fixed at.
+enum class Bound : unsigned char {
+    Free,
+    Lower,
+    Upper,
+};
+
+/// Multipliers above -kMultiplierTolerance count as non-negative.
+const double kMultiplierTolerance = 1e-12;
+
+/**
+ * @brief Solves S x = b in place for the symmetric positive definite
+ *        leading n x n block of a row-major array with the given stride.
+ *        Only the lower triangle of S is read; it is overwritten by the
+ *        Cholesky factor.
+ */
+void choleskySolve(double* s, std::size_t stride, std::size_t n, double* b) {
+    for (std::size_t j = 0; j < n; j++) {
+        double diagonal = s[j * stride + j];
+        for (std::size_t k = 0; k < j; k++) {
+            diagonal -= s[j * stride + k] * s[j * stride + k];
+        }
+        if (!(diagonal > 0.0)) {
+            throw std::runtime_error("MPC Hessian is not positive definite");
+        }
+        diagonal = std::sqrt(diagonal);
+        s[j * stride + j] = diagonal;
+        for (std::size_t i = j + 1; i < n; i++) {
+            double sum = s[i * stride + j];
+            for (std::size_t k = 0; k < j; k++) {
+                sum -= s[i * stride + k] * s[j * stride + k];
+            }
+            s[i * stride + j] = sum / diagonal;
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        double sum = b[i];
+        for (std::size_t k = 0; k < i; k++) sum -= s[i * stride + k] * b[k];
+        b[i] = sum / s[i * stride + i];
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        double sum = b[i];
+        for (std::size_t k = i + 1; k < n; k++) sum -= s[k * stride + i] * b[k];
+        b[i] = sum / s[i * stride + i];
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the MPCController class.
+ *
+ * @param horizon The number of steps planned, in [1, kMaxHorizon].
+ * @param tuning The weights and limits.
+ */
+MPCController::MPCController(std::size_t horizon,
+                             const ControlTuning& tuning)
+    : horizon_(horizon), tuning_(tuning), hasModel_(false), lower_(),
+      upper_(), plan_(), iterations_(0) {
+    if (horizon == 0 || horizon > kMaxHorizon) {
+        throw std::invalid_argument("MPC horizon must be between 1 and " +
+                                    std::to_string(kMaxHorizon));
+    }
+    tuning_.validate();
+}
+
+/**
+ * @brief Uses a model and builds the quadratic programme for it.
+ *
+ * With M_m = A^m B and W_k the weight of the state after step k, the
+ * Hessian block of steps i and j is
+ * R [i == j] + sum_{k >= max(i, j)} M_{k-i}' W_k M_{k-j}, and the gradient
+ * of step i at zero inputs is sum_{k >= i} M_{k-i}' W_k A^{k+1} e.
+ *
+ * @param model The model.
+ */
+void MPCController::setModel(const LinearizedModel& model) {
+    typedef Matrix<kModelStates, kModelStates> StateMatrix;
+    typedef Matrix<kModelStates, kModelInputs> InputMatrix;
+
+    StateMatrix stateWeights = tuning_.stateWeights();
+    Matrix<kModelInputs, kModelInputs> inputWeights = tuning_.inputWeights();
+    StateMatrix terminalWeights =
+        LQRController::solveRiccati(model, stateWeights, inputWeights);
+
+    StateMatrix powers[kMaxHorizon + 1];
+    InputMatrix responses[kMaxHorizon];
+    powers[0] = StateMatrix::identity();
+    for (std::size_t m = 0; m < horizon_; m++) {
+        responses[m] = powers[m] * model.B;
+        powers[m + 1] = model.A * powers[m];
+    }
+    // W_k M_m, reused by every block that row k contributes to
+    InputMatrix weighted[kMaxHorizon];
+
+    for (std::size_t i = 0; i < horizon_; i++) {
+        gradientGain_[i] = Matrix<kModelInputs, kModelStates>();
+    }
+    for (std::size_t j = 0; j < horizon_; j++) {
+        for (std::size_t k = j; k < horizon_; k++) {
+            const StateMatrix& weight =
+                k + 1 == horizon_ ? terminalWeights : stateWeights;
+            weighted[k] = weight * responses[k - j];
+        }
+        for (std::size_t i = j; i < horizon_; i++) {
+            Matrix<kModelInputs, kModelInputs> block;
+            if (i == j) block = inputWeights;
+            for (std::size_t k = i; k < horizon_; k++) {
+                block += responses[k - i].transpose() * weighted[k];
+            }
+            for (std::size_t r = 0; r < kModelInputs; r++) {
+                for (std::size_t c = 0; c < kModelInputs; c++) {
+                    hessian_(i * kModelInputs + r, j * kModelInputs + c) =
+                        block(r, c);
+                    hessian_(j * kModelInputs + c, i * kModelInputs + r) =
+                        block(r, c);
+                }
+            }
+        }
+        // The gradient of step j: weighted[k] holds W_k M_{k-j}
+        for (std::size_t k = j; k < horizon_; k++) {
+            gradientGain_[j] += weighted[k].transpose() * powers[k + 1];
+        }
+    }
+
+    for (std::size_t k = 0; k < horizon_; k++) {
+        lower_[k * kModelInputs] = -model.maxSteeringAngle;
+        upper_[k * kModelInputs] = model.maxSteeringAngle;
+        lower_[k * kModelInputs + 1] = -model.maxWheelSpeedChange;
+        upper_[k * kModelInputs + 1] = model.maxWheelSpeedChange;
+    }
+    model_ = model;
+    hasModel_ = true;
+}
+
+/**
+ * @brief Plans the inputs that drive an error to zero within the limits.
+ *
+ * @param error The heading and speed errors from the targets.
+ * @return The first input of the plan.
+ */
+ModelInput MPCController::control(const ModelState& error) {
+    const std::size_t n = horizon_ * kModelInputs;
+    double gradient[kMaxVariables];
+    for (std::size_t k = 0; k < horizon_; k++) {
+        ModelInput g = gradientGain_[k] * error;
+        for (std::size_t r = 0; r < kModelInputs; r++) {
+            gradient[k * kModelInputs + r] = g(r, 0);
+        }
+    }
+
+    // Start from the previous plan shifted by one step, inside the bounds
+    for (std::size_t i = 0; i < n; i++) {
+        double warm = i + kModelInputs < n ? plan_[i + kModelInputs]
+                                           : plan_[i];
+        plan_[i] = std::max(lower_[i], std::min(upper_[i], warm));
+    }
+
+    Bound bounds[kMaxVariables];
+    std::fill(bounds, bounds + n, Bound::Free);
+    std::size_t free[kMaxVariables];
+    double factor[kMaxVariables * kMaxVariables];
+    double target[kMaxVariables];
+
+    // Every iteration fixes or releases one input; a bound released is not
+    // fixed again on the same face, so this is a generous cap
+    const int maxIterations = static_cast<int>(4 * n + 4);
+    iterations_ = 0;
+    while (iterations_ < maxIterations) {
+        iterations_++;
+
+        // Minimise over the free inputs with the fixed ones held
+        std::size_t freeCount = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            if (bounds[i] == Bound::Free) free[freeCount++] = i;
+        }
+        for (std::size_t a = 0; a < freeCount; a++) {
+            std::size_t i = free[a];
+            double rhs = -gradient[i];
+            for (std::size_t j = 0; j < n; j++) {
+                if (bounds[j] != Bound::Free) rhs -= hessian_(i, j) * plan_[j];
+            }
+            target[a] = rhs;
+            for (std::size_t b = 0; b <= a; b++) {
+                factor[a * freeCount + b] = hessian_(i, free[b]);
+            }
+        }
+        choleskySolve(factor, freeCount, freeCount, target);
+
+        // Move towards the minimiser, stopping at the first bound in the way
+        double step = 1.0;
+        std::size_t blocking = n;
+        bool blockingUpper = false;
+        for (std::size_t a = 0; a < freeCount; a++) {
+            std::size_t i = free[a];
+            bool above = target[a] > upper_[i];
+            if (!above && !(target[a] < lower_[i])) continue;
+            double limit = above ? upper_[i] : lower_[i];
+            double fraction = (limit - plan_[i]) / (target[a] - plan_[i]);
+            if (fraction < step) {
+                step = fraction;
+                blocking = i;
+                blockingUpper = above;
+            }
+        }
+        for (std::size_t a = 0; a < freeCount; a++) {
+            std::size_t i = free[a];
+            plan_[i] += step * (target[a] - plan_[i]);
+        }
+        if (blocking < n) {
+            bounds[blocking] = blockingUpper ? Bound::Upper : Bound::Lower;
+            plan_[blocking] = blockingUpper ? upper_[blocking]
+                                            : lower_[blocking];
+            continue;
+        }
+
+        // Optimal on this face; release the bound that most wants to leave
+        double worst = -kMultiplierTolerance;
+        std::size_t release = n;
+        for (std::size_t i = 0; i < n; i++) {
+            if (bounds[i] == Bound::Free) continue;
+            double slope = gradient[i];
+            for (std::size_t j = 0; j < n; j++) {
+                slope += hessian_(i, j) * plan_[j];
+            }
+            double multiplier = bounds[i] == Bound::Lower ? slope : -slope;
+            if (multiplier < worst) {
+                worst = multiplier;
+                release = i;
+            }
+        }
+        if (release == n) break;
+        bounds[release] = Bound::Free;
+    }
+
+    ModelInput input;
+    for (std::size_t r = 0; r < kModelInputs; r++) input(r, 0) = plan_[r];
+    return input;
+}
+
+/**
+ * @brief Runs one control step towards the targets.
+ *
+ * @param robot The robot in its current state.
+ * @param targetHeading The desired heading (radians).
+ * @param targetVelocity The desired speed.
+ * @param dt The time step.
+ * @return The steering angle as heading and the wheel speed change as
+ *         velocity.
+ */
+PIDOutput MPCController::compute(const RobotModel& robot,
+                                 double targetHeading, double targetVelocity,
+                                 double dt) {
+    LinearizedModel model = linearizeRobotModel(robot, robot.getSpeed(), dt,
+                                                tuning_);
+    if (!hasModel_ || !sameModel(model, model_)) setModel(model);
+
+    ModelState error;
+    error(0, 0) = robot.getHeading() - targetHeading;
+    error(1, 0) = robot.getSpeed() - targetVelocity;
+    ModelInput input = control(error);
+
+    PIDOutput output;
+    output.heading = input(0, 0);
+    output.velocity = input(1, 0);
+    return output;
+}
+
+/**
+ * @brief Forgets the previous plan.
+ */
+void MPCController::reset() {
+    std::fill(plan_, plan_ + kMaxVariables, 0.0);
+}
+
+/**
+ * @brief Get an input of the latest plan.
+ *
+ * @param step The step, less than getHorizon().
+ * @return The planned input.
+ */
+ModelInput MPCController::getPlannedInput(std::size_t step) const {
+    if (step >= horizon_) {
+        throw std::out_of_range("MPC plan step out of range");
+    }
+    ModelInput input;
+    for (std::size_t r = 0; r < kModelInputs; r++) {
+        input(r, 0) = plan_[step * kModelInputs + r];
+    }
+    return input;
+}
+
+/**
+ * @brief Get the number of steps planned.
+ *
+ * @return The horizon.
+ */
+std::size_t MPCController::getHorizon() const {
+    return horizon_;
+}
+
+/**
+ * @brief Get the active-set iterations of the latest solve.
+ *
+ * @return The iteration count.
+ */
+int MPCController::getLastIterations() const {
+    return iterations_;
+}
+
+/**
+ * @brief Get the model the programme was built for.
+ *
+ * @return The model.
+ */
+const LinearizedModel& MPCController::getModel() const {
+    return model_;
+}
+
+/**
+ * @brief Get the weights and limits.
+ *
+ * @return The tuning.
+ */
+const ControlTuning& MPCController::getTuning() const {
+    return tuning_;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file MonotonicArena.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Implementation of the bump allocator.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "MonotonicArena.hpp"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+/// Offset of the first usable byte of a block, keeping it max-aligned.
+const std::size_t kHeaderSize =
+    (sizeof(void*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1) /
+    alignof(std::max_align_t) * alignof(std::max_align_t);
+
+}  // namespace
+
+/**
+ * @brief Constructor for the MonotonicArena class. No memory is taken until
+ *        the first allocation.
+ *
+ * @param blockSize The size of the first block (bytes).
+ */
+MonotonicArena::MonotonicArena(std::size_t blockSize)
+    : blockSize_(std::max<std::size_t>(blockSize, 2 * kHeaderSize)),
+      head_(nullptr), offset_(0), usedBefore_(0), peak_(0), reserved_(0),
+      blockAllocations_(0) {
+}
+
+/**
+ * @brief Returns every block to the heap.
+ */
+MonotonicArena::~MonotonicArena() {
+    releaseBlocks();
+}
+
+/**
+ * @brief Hands out uninitialised memory, valid until reset().
+ *
+ * @param bytes The number of bytes.
+ * @param alignment The alignment, a power of two.
+ * @return The memory.
+ */
+void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        throw std::invalid_argument("arena alignment must be a power of two");
+    }
+    if (head_ != nullptr) {
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(head_);
+        std::uintptr_t start = (base + offset_ + alignment - 1) &
+                               ~static_cast<std::uintptr_t>(alignment - 1);
+        std::size_t end = static_cast<std::size_t>(start - base) + bytes;
+        if (end <= head_->size) {
+            peak_ = std::max(peak_, usedBefore_ + end - kHeaderSize);
+            offset_ = end;
+            return reinterpret_cast<void*>(start);
+        }
+    }
+    addBlock(bytes + alignment);
+    return allocate(bytes, alignment);
+}
+
+/**
+ * @brief Makes all memory reusable, merging the blocks of the last cycle
+ *        into one.
+ */
+void MonotonicArena::reset() {
+    if (head_ != nullptr && head_->next != nullptr) {
+        std::size_t total = reserved_;
+        releaseBlocks();
+        addBlock(total - kHeaderSize);
+    }
+    offset_ = kHeaderSize;
+    usedBefore_ = 0;
+}
+
+/**
+ * @brief Get the bytes handed out since the last reset().
+ *
+ * @return The bytes in use, including alignment padding.
+ */
+std::size_t MonotonicArena::getBytesUsed() const {
+    return head_ == nullptr ? 0 : usedBefore_ + offset_ - kHeaderSize;
+}
+
+/**
+ * @brief Get the most bytes in use in any cycle.
+ *
+ * @return The peak of getBytesUsed().
+ */
+std::size_t MonotonicArena::getPeakBytesUsed() const {
+    return peak_;
+}
+
+/**
+ * @brief Get the memory the arena holds.
+ *
+ * @return The total size of the blocks (bytes).
+ */
+std::size_t MonotonicArena::getBytesReserved() const {
+    return reserved_;
+}
+
+/**
+ * @brief Get the number of blocks taken from the heap.
+ *
+ * @return The number of heap allocations made by the arena.
+ */
+std::uint64_t MonotonicArena::getBlockAllocations() const {
+    return blockAllocations_;
+}
+
+/**
+ * @brief Takes a new block from the heap and makes it current. The new
+ *        block is at least twice the previous one, so a cycle needs few
+ *        blocks.
+ *
+ * @param minimumSize The usable bytes the block must have.
+ */
+void MonotonicArena::addBlock(std::size_t minimumSize) {
+    std::size_t size = head_ == nullptr ? blockSize_ : 2 * head_->size;
+    size = std::max(size, minimumSize + kHeaderSize);
+    if (head_ != nullptr) usedBefore_ += offset_ - kHeaderSize;
+    Block* block = static_cast<Block*>(::operator new(size));
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    offset_ = kHeaderSize;
+    reserved_ += size;
+    blockAllocations_++;
+}
+
+/**
+ * @brief Returns every block to the heap.
+ */
+void MonotonicArena::releaseBlocks() {
+    while (head_ != nullptr) {
+        Block* next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+    reserved_ = 0;
+    offset_ = 0;
+    usedBefore_ = 0;
+}
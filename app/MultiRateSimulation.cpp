@@ -0,0 +1,176 @@
+/**
+ * @file MultiRateSimulation.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Implementation of the multi-rate closed loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "MultiRateSimulation.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Checks a divisor before it is used to build a loop.
+ */
+std::uint32_t checkedDivisor(std::uint32_t divisor, const char* group) {
+    if (divisor == 0) {
+        throw std::invalid_argument(std::string("the ") + group +
+                                    " divisor must be at least 1");
+    }
+    return divisor;
+}
+
+/**
+ * @brief Builds the heading loop: the heading channel of a controller,
+ *        updated every divisor base periods.
+ *
+ * The integral sums one error per update, so Ki is scaled by the divisor
+ * to cover the same time as at the base rate and the integral limit is
+ * divided by it to clamp the same integral term.
+ */
+PIDController headingLoop(const PIDController& controller,
+                          std::uint32_t divisor) {
+    double scale = checkedDivisor(divisor, "heading");
+    PIDController loop(0.0, 0.0, 0.0, scale * controller.getDeltaTime(),
+                       controller.getHeadingProportionalConstant(),
+                       controller.getHeadingIntegralConstant() * scale,
+                       controller.getHeadingDerivativeConstant());
+    loop.setIntegralLimits(0.0, controller.getHeadingIntegralLimit() / scale);
+    return loop;
+}
+
+/**
+ * @brief Builds the velocity loop, scaled as in headingLoop().
+ */
+PIDController velocityLoop(const PIDController& controller,
+                           std::uint32_t divisor) {
+    double scale = checkedDivisor(divisor, "velocity");
+    PIDController loop(controller.getVelocityProportionalConstant(),
+                       controller.getVelocityIntegralConstant() * scale,
+                       controller.getVelocityDerivativeConstant(),
+                       scale * controller.getDeltaTime(), 0.0, 0.0, 0.0);
+    loop.setIntegralLimits(controller.getVelocityIntegralLimit() / scale, 0.0);
+    return loop;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the MultiRateSimulation class.
+ *
+ * @param controller Supplies the gains, integral limits and the base
+ *        period; its state is not used.
+ * @param robot The plant in its initial state, copied.
+ * @param rates The divisor of every rate group.
+ */
+MultiRateSimulation::MultiRateSimulation(const PIDController& controller,
+                                         const RobotModel& robot,
+                                         const RateConfig& rates)
+    : robot_(robot),
+      heading_(headingLoop(controller, rates.headingDivisor)),
+      velocity_(velocityLoop(controller, rates.velocityDivisor)),
+      command_{0.0, 0.0},
+      plantPeriod_(checkedDivisor(rates.plantDivisor, "plant") *
+                   controller.getDeltaTime()),
+      velocityShare_(plantPeriod_ / velocity_.getDeltaTime()),
+      targetHeading_(0.0), targetVelocity_(0.0),
+      scheduler_(controller.getDeltaTime()) {
+    // Added in the order RobotSimulation::step() runs them
+    scheduler_.addGroup("heading", rates.headingDivisor,
+                        [this](std::uint64_t) {
+        heading_.computeErrors(0.0, 0.0, targetHeading_, robot_.getHeading());
+        command_.heading = heading_.computeControl().heading;
+    });
+    scheduler_.addGroup("velocity", rates.velocityDivisor,
+                        [this](std::uint64_t) {
+        velocity_.computeErrors(targetVelocity_, robot_.getSpeed(), 0.0, 0.0);
+        command_.velocity = velocity_.computeControl().velocity;
+    });
+    scheduler_.addGroup("plant", rates.plantDivisor, [this](std::uint64_t) {
+        double steering = command_.heading;
+        // The velocity output is an increment that Simulate_robot_model()
+        // applies whole on every call, so each plant step takes its share
+        robot_.Simulate_robot_model(steering,
+                                    command_.velocity * velocityShare_,
+                                    plantPeriod_);
+        robot_.updateState(steering, plantPeriod_);
+    });
+}
+
+/**
+ * @brief Sets the targets the loops steer towards.
+ *
+ * @param heading The target heading (radians).
+ * @param velocity The target velocity.
+ */
+void MultiRateSimulation::setTargets(double heading, double velocity) {
+    targetHeading_ = heading;
+    targetVelocity_ = velocity;
+}
+
+/**
+ * @brief Runs the rate groups due on the next base tick.
+ */
+void MultiRateSimulation::tick() {
+    scheduler_.tick();
+}
+
+/**
+ * @brief Runs a number of base ticks.
+ *
+ * @param ticks The number of ticks.
+ */
+void MultiRateSimulation::run(std::uint64_t ticks) {
+    scheduler_.run(ticks);
+}
+
+/**
+ * @brief Get the command the plant applies.
+ *
+ * @return The latest outputs of the two loops.
+ */
+PIDOutput MultiRateSimulation::getCommand() const {
+    return command_;
+}
+
+/**
+ * @brief Get the plant.
+ *
+ * @return The robot model.
+ */
+const RobotModel& MultiRateSimulation::getRobot() const {
+    return robot_;
+}
+
+/**
+ * @brief Get the heading loop.
+ *
+ * @return The controller of the heading loop, with its scaled gains.
+ */
+const PIDController& MultiRateSimulation::getHeadingLoop() const {
+    return heading_;
+}
+
+/**
+ * @brief Get the velocity loop.
+ *
+ * @return The controller of the velocity loop, with its scaled gains.
+ */
+const PIDController& MultiRateSimulation::getVelocityLoop() const {
+    return velocity_;
+}
+
+/**
+ * @brief Get the schedule, with the run count of every group.
+ *
+ * @return The scheduler; group 0 is the heading loop, 1 the velocity loop
+ *         and 2 the plant.
+ */
+const RateGroupScheduler& MultiRateSimulation::getScheduler() const {
+    return scheduler_;
+}
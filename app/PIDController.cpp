@@ -9,9 +9,11 @@
  */
 
 #include "PIDController.hpp"
-#include <iostream>
-#include <numeric>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include "Logger.hpp"
+#include "Profiler.hpp"
 
 /**
  * @brief Constructor for the PIDController class.
@@ -26,7 +28,9 @@
  * @param headD The derivative constant for heading control.
  */
 PIDController::PIDController(double velP, double velI, double velD, double dt,
-                             double headP, double headI, double headD) {
+                             double headP, double headI, double headD)
+    : velIntegralLimit(std::numeric_limits<double>::infinity()),
+      headIntegralLimit(std::numeric_limits<double>::infinity()) {
     velKp = velP;
     velKi = velI;
     velKd = velD;
@@ -34,6 +38,7 @@ PIDController::PIDController(double velP, double velI, double velD, double dt,
     headKp = headP;
     headKi = headI;
     headKd = headD;
+    reset();
 }
 
 /**
@@ -43,48 +48,67 @@ PIDController::PIDController(double velP, double velI, double velD, double dt,
  * @return A vector containing the computed PID values for velocity and heading.
  */
 std::vector<double> PIDController::computePID() {
-    double Pvel, Ivel, Dvel;
-    double Phead, Ihead, Dhead;
     std::vector<double> pidOut;
 
-    if (velocityErrors.empty() || headingErrors.empty()) return pidOut;
+    if (sampleCount == 0) return pidOut;
 
-    // Calculate the proportional term for velocity control.
-    Pvel = velKp * velocityErrors.back();
-    double IvelSum = std::accumulate(velocityErrors.begin(),
-                                 velocityErrors.end(), 0.0);
-    // Calculate the integral term for velocity control.
-    Ivel = velKi * IvelSum;
+    // Store the computed PID values in the output vector.
+    PIDOutput output = computeControl();
+    pidOut.push_back(output.velocity);
+    pidOut.push_back(output.heading);
 
-    if (velocityErrors.size() < 2)
-        Dvel = 0;
-    else
-        // Calculate the derivative term for velocity control.
-        Dvel = velKd * ((velocityErrors.back() -
-                     velocityErrors[velocityErrors.size() - 2]) / deltaT);
+    return pidOut;
+}
 
-    // Calculate the overall PID output for velocity control.
-    double velPIDOut = Pvel + Ivel + Dvel;
+/**
+ * @brief Computes the PID control outputs without allocating.
+ *
+ * 
+ * @return The computed PID values for velocity and heading.
+ */
+PIDOutput PIDController::computeControl() const {
+    ACK_PROFILE_SCOPE(ComputePID);
+    PIDTerms terms = computeTerms();
+    PIDOutput output;
 
+    // Calculate the overall PID output for velocity control.
+    output.velocity = terms.velocityP + terms.velocityI + terms.velocityD;
     // Repeat the same process for heading control.
-    Phead = headKp * headingErrors.back();
-    double IheadSum = std::accumulate(headingErrors.begin(),
-                             headingErrors.end(), 0.0);
-    Ihead = headKi * IheadSum;
+    output.heading = terms.headingP + terms.headingI + terms.headingD;
 
-    if (headingErrors.size() < 2)
-        Dhead = 0;
-    else
-        Dhead = headKd * ((headingErrors.back() -
-                         headingErrors[headingErrors.size() - 2]) / deltaT);
+    return output;
+}
 
-    double headPIDOut = Phead + Ihead + Dhead;
+/**
+ * @brief Computes the individual terms behind computeControl().
+ *
+ * @return The latest errors and the P, I and D terms of both channels.
+ */
+PIDTerms PIDController::computeTerms() const {
+    PIDTerms terms = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
-    // Store the computed PID values in the output vector.
-    pidOut.push_back(velPIDOut);
-    pidOut.push_back(headPIDOut);
+    if (sampleCount == 0) return terms;
 
-    return pidOut;
+    terms.velocityError = velLastError;
+    terms.headingError = headLastError;
+
+    // Calculate the proportional term for velocity control.
+    terms.velocityP = velKp * velLastError;
+    // Calculate the integral term for velocity control.
+    terms.velocityI = velKi * velIntegral;
+
+    if (sampleCount >= 2)
+        // Calculate the derivative term for velocity control.
+        terms.velocityD = velKd * ((velLastError - velPrevError) / deltaT);
+
+    // Repeat the same process for heading control.
+    terms.headingP = headKp * headLastError;
+    terms.headingI = headKi * headIntegral;
+
+    if (sampleCount >= 2)
+        terms.headingD = headKd * ((headLastError - headPrevError) / deltaT);
+
+    return terms;
 }
 
 /**
@@ -93,7 +117,7 @@ std::vector<double> PIDController::computePID() {
  * 
  * @return The velocity proportional constant.
  */
-double PIDController::getVelocityProportionalConstant() {
+double PIDController::getVelocityProportionalConstant() const {
     return velKp;
 }
 
@@ -103,7 +127,7 @@ double PIDController::getVelocityProportionalConstant() {
  * 
  * @return The velocity integral constant.
  */
-double PIDController::getVelocityIntegralConstant() {
+double PIDController::getVelocityIntegralConstant() const {
     return velKi;
 }
 
@@ -113,7 +137,7 @@ double PIDController::getVelocityIntegralConstant() {
  * 
  * @return The velocity derivative constant.
  */
-double PIDController::getVelocityDerivativeConstant() {
+double PIDController::getVelocityDerivativeConstant() const {
     return velKd;
 }
 
@@ -123,7 +147,7 @@ double PIDController::getVelocityDerivativeConstant() {
  * 
  * @return The time step.
  */
-double PIDController::getDeltaTime() {
+double PIDController::getDeltaTime() const {
     return deltaT;
 }
 
@@ -133,7 +157,7 @@ double PIDController::getDeltaTime() {
  * 
  * @return The heading proportional constant.
  */
-double PIDController::getHeadingProportionalConstant() {
+double PIDController::getHeadingProportionalConstant() const {
     return headKp;
 }
 
@@ -143,7 +167,7 @@ double PIDController::getHeadingProportionalConstant() {
  * 
  * @return The heading integral constant.
  */
-double PIDController::getHeadingIntegralConstant() {
+double PIDController::getHeadingIntegralConstant() const {
     return headKi;
 }
 
@@ -153,27 +177,146 @@ double PIDController::getHeadingIntegralConstant() {
  * 
  * @return The heading derivative constant.
  */
-double PIDController::getHeadingDerivativeConstant() {
+double PIDController::getHeadingDerivativeConstant() const {
     return headKd;
 }
 
 /**
- * @brief Retrieves the vector of velocity errors.
+ * @brief Retrieves the recorded velocity errors, oldest first.
  *
  * 
  * @return The vector containing velocity errors.
  */
 const std::vector<double>& PIDController::getVelocityErrors() const {
-    return velocityErrors;
+    return velocityErrors.values();
 }
 
 /**
- * @brief Retrieves the vector of heading errors.
+ * @brief Retrieves the recorded heading errors, oldest first.
  * 
  * @return The vector containing heading errors.
  */
 const std::vector<double>& PIDController::getHeadingErrors() const {
-    return headingErrors;
+    return headingErrors.values();
+}
+
+/**
+ * @brief Enables recording of the most recent errors.
+ *
+ * @param capacity The number of errors kept per channel (0 disables).
+ */
+void PIDController::setErrorHistoryCapacity(std::size_t capacity) {
+    velocityErrors.setCapacity(capacity);
+    headingErrors.setCapacity(capacity);
+}
+
+/**
+ * @brief Enables recording of the most recent errors into rings taken from
+ *        an arena.
+ *
+ * @param capacity The number of errors kept per channel (0 disables).
+ * @param arena The arena providing the rings.
+ */
+void PIDController::setErrorHistoryCapacity(std::size_t capacity,
+                                            MonotonicArena& arena) {
+    velocityErrors.setCapacity(capacity, arena);
+    headingErrors.setCapacity(capacity, arena);
+}
+
+/**
+ * @brief Sets the anti-windup limits of the accumulated errors.
+ *
+ * @param velocityLimit The limit of the accumulated velocity error.
+ * @param headingLimit The limit of the accumulated heading error.
+ */
+void PIDController::setIntegralLimits(double velocityLimit,
+                                      double headingLimit) {
+    velIntegralLimit = std::abs(velocityLimit);
+    headIntegralLimit = std::abs(headingLimit);
+    velIntegral = std::max(-velIntegralLimit,
+                           std::min(velIntegral, velIntegralLimit));
+    headIntegral = std::max(-headIntegralLimit,
+                            std::min(headIntegral, headIntegralLimit));
+}
+
+/**
+ * @brief Retrieves the anti-windup limit of the velocity channel.
+ *
+ * @return The limit, infinite unless set.
+ */
+double PIDController::getVelocityIntegralLimit() const {
+    return velIntegralLimit;
+}
+
+/**
+ * @brief Retrieves the anti-windup limit of the heading channel.
+ *
+ * @return The limit, infinite unless set.
+ */
+double PIDController::getHeadingIntegralLimit() const {
+    return headIntegralLimit;
+}
+
+/**
+ * @brief Retrieves the accumulated velocity error.
+ *
+ * @return The running sum of velocity errors.
+ */
+double PIDController::getVelocityIntegral() const {
+    return velIntegral;
+}
+
+/**
+ * @brief Retrieves the accumulated heading error.
+ *
+ * @return The running sum of heading errors.
+ */
+double PIDController::getHeadingIntegral() const {
+    return headIntegral;
+}
+
+/**
+ * @brief Clears the integral, derivative and history state.
+ */
+void PIDController::reset() {
+    velIntegral = 0.0;
+    headIntegral = 0.0;
+    velLastError = 0.0;
+    velPrevError = 0.0;
+    headLastError = 0.0;
+    headPrevError = 0.0;
+    sampleCount = 0;
+    velocityErrors.clear();
+    headingErrors.clear();
+}
+
+/**
+ * @brief Prepares for a jump of the setpoints so that the output does not
+ *        jump with them (bumpless transfer).
+ *
+ * @param velocityShift The new velocity target minus the old one.
+ * @param headingShift The new heading target minus the old one.
+ */
+void PIDController::shiftSetpoints(double velocityShift,
+                                   double headingShift) {
+    if (sampleCount == 0) return;
+
+    // Both stored errors move, so the next difference excludes the jump
+    velLastError += velocityShift;
+    velPrevError += velocityShift;
+    headLastError += headingShift;
+    headPrevError += headingShift;
+    // Ki * integral absorbs the change of Kp * error
+    if (velKi != 0.0) {
+        velIntegral = std::max(-velIntegralLimit,
+            std::min(velIntegral - velKp * velocityShift / velKi,
+                     velIntegralLimit));
+    }
+    if (headKi != 0.0) {
+        headIntegral = std::max(-headIntegralLimit,
+            std::min(headIntegral - headKp * headingShift / headKi,
+                     headIntegralLimit));
+    }
 }
 
 /**
@@ -186,14 +329,26 @@ const std::vector<double>& PIDController::getHeadingErrors() const {
  */
 void PIDController::computeErrors(double targetVelocity,
          double currentVelocity, double targetHeading, double currentHeading) {
+    ACK_PROFILE_SCOPE(ComputeErrors);
     double velocityError = targetVelocity - currentVelocity;
-    std::cout << "Velocity Error: " << velocityError << "\n";
+    ACK_LOG_DEBUG("Velocity Error: " << velocityError);
 
     double headingError = targetHeading - currentHeading;
-    std::cout << "Heading Error: " << headingError * 180 / M_PI;
+    ACK_LOG_DEBUG("Heading Error: " << headingError * 180 / M_PI);
+
+    // Shift the derivative state and accumulate the clamped integrals.
+    velPrevError = velLastError;
+    velLastError = velocityError;
+    headPrevError = headLastError;
+    headLastError = headingError;
+    velIntegral = std::max(-velIntegralLimit,
+                     std::min(velIntegral + velocityError, velIntegralLimit));
+    headIntegral = std::max(-headIntegralLimit,
+                     std::min(headIntegral + headingError, headIntegralLimit));
+    sampleCount++;
 
-    // Store the computed errors in the respective vectors.
-    velocityErrors.push_back(velocityError);
-    headingErrors.push_back(headingError);
+    // Record the errors when the bounded history is enabled.
+    velocityErrors.push(velocityError);
+    headingErrors.push(headingError);
 }
 
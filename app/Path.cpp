@@ -0,0 +1,212 @@
+/**
+ * @file Path.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the polyline path.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Path.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Constructor for the Path class. Consecutive duplicate points are
+ *        dropped.
+ *
+ * @param x The x-coordinates of the points.
+ * @param y The y-coordinates of the points.
+ */
+Path::Path(const std::vector<double>& x, const std::vector<double>& y) {
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Path needs as many x as y coordinates");
+    }
+    x_.reserve(x.size());
+    y_.reserve(y.size());
+    s_.reserve(x.size());
+    for (std::size_t i = 0; i < x.size(); i++) {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i])) {
+            throw std::invalid_argument("Path coordinates must be finite");
+        }
+        if (!x_.empty() && x[i] == x_.back() && y[i] == y_.back()) continue;
+        s_.push_back(x_.empty() ? 0.0 : s_.back() + std::hypot(
+                                             x[i] - x_.back(), y[i] - y_.back()));
+        x_.push_back(x[i]);
+        y_.push_back(y[i]);
+    }
+    if (x_.size() < 2) {
+        throw std::invalid_argument("Path needs at least two distinct points");
+    }
+}
+
+/**
+ * @brief Samples a Catmull-Rom spline through control points into a path.
+ *
+ * The first and last control points are repeated to give the end spans
+ * their outer neighbours.
+ *
+ * @param x The x-coordinates of the control points.
+ * @param y The y-coordinates of the control points.
+ * @param samplesPerSpan The points per span between control points.
+ * @return The path through the samples.
+ */
+Path Path::catmullRom(const std::vector<double>& x,
+                      const std::vector<double>& y,
+                      std::size_t samplesPerSpan) {
+    if (samplesPerSpan == 0) {
+        throw std::invalid_argument("A spline span needs at least one sample");
+    }
+    if (x.size() != y.size() || x.size() < 2) return Path(x, y);
+
+    const std::size_t last = x.size() - 1;
+    std::vector<double> px, py;
+    px.reserve(last * samplesPerSpan + 1);
+    py.reserve(last * samplesPerSpan + 1);
+    for (std::size_t span = 0; span < last; span++) {
+        std::size_t i0 = span == 0 ? 0 : span - 1;
+        std::size_t i3 = std::min(span + 2, last);
+        for (std::size_t k = 0; k < samplesPerSpan; k++) {
+            double f = static_cast<double>(k) / samplesPerSpan;
+            auto spline = [&](const std::vector<double>& p) {
+                double p0 = p[i0], p1 = p[span], p2 = p[span + 1], p3 = p[i3];
+                return p1 + 0.5 * f * ((p2 - p0) +
+                       f * ((2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3) +
+                       f * (3.0 * (p1 - p2) + p3 - p0)));
+            };
+            px.push_back(spline(x));
+            py.push_back(spline(y));
+        }
+    }
+    px.push_back(x[last]);
+    py.push_back(y[last]);
+    return Path(px, py);
+}
+
+/**
+ * @brief Projects a position onto the path, resuming the search from a
+ *        previous segment.
+ *
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @param hint The segment of the previous projection.
+ * @return The closest point found walking forward from the hint.
+ */
+PathProjection Path::project(double x, double y, std::size_t hint) const {
+    const std::size_t segments = x_.size() - 1;
+    std::size_t segment = std::min(hint, segments - 1);
+    double t;
+    double best = distanceSquared(segment, x, y, t);
+    // Ties move on, so a position past a shared vertex reaches the next
+    // segment
+    while (segment + 1 < segments) {
+        double nextT;
+        double next = distanceSquared(segment + 1, x, y, nextT);
+        if (next > best) break;
+        best = next;
+        t = nextT;
+        segment++;
+    }
+    return makeProjection(segment, t, x, y);
+}
+
+/**
+ * @brief Projects a position onto the path, scanning every segment.
+ *
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @return The closest point of the path; the first one on a tie.
+ */
+PathProjection Path::projectGlobal(double x, double y) const {
+    double best = std::numeric_limits<double>::infinity();
+    std::size_t bestSegment = 0;
+    double bestT = 0.0;
+    for (std::size_t segment = 0; segment + 1 < x_.size(); segment++) {
+        double t;
+        double distance = distanceSquared(segment, x, y, t);
+        if (distance < best) {
+            best = distance;
+            bestSegment = segment;
+            bestT = t;
+        }
+    }
+    return makeProjection(bestSegment, bestT, x, y);
+}
+
+/**
+ * @brief Finds the point at an arc length, resuming the search from a
+ *        previous segment.
+ *
+ * @param s The arc length, clamped to the path.
+ * @param hint The segment to start from; updated to the segment of the point
+ *        (input and output).
+ * @param x The x-coordinate of the point (output).
+ * @param y The y-coordinate of the point (output).
+ */
+void Path::pointAt(double s, std::size_t& hint, double& x, double& y) const {
+    const std::size_t segments = x_.size() - 1;
+    s = std::max(0.0, std::min(s, s_.back()));
+    std::size_t segment = std::min(hint, segments - 1);
+    while (segment > 0 && s < s_[segment]) segment--;
+    while (segment + 1 < segments && s > s_[segment + 1]) segment++;
+    hint = segment;
+
+    double t = (s - s_[segment]) / (s_[segment + 1] - s_[segment]);
+    x = x_[segment] + t * (x_[segment + 1] - x_[segment]);
+    y = y_[segment] + t * (y_[segment + 1] - y_[segment]);
+}
+
+/**
+ * @brief Retrieves the number of points.
+ *
+ * @return The number of points, at least two.
+ */
+std::size_t Path::size() const {
+    return x_.size();
+}
+
+/**
+ * @brief Retrieves the length of the path.
+ *
+ * @return The arc length of the last point.
+ */
+double Path::length() const {
+    return s_.back();
+}
+
+/// The squared distance from a position to a segment, and the position of
+/// the closest point along it.
+double Path::distanceSquared(std::size_t segment, double x, double y,
+                             double& t) const {
+    double dx = x_[segment + 1] - x_[segment];
+    double dy = y_[segment + 1] - y_[segment];
+    double rx = x - x_[segment];
+    double ry = y - y_[segment];
+    t = (rx * dx + ry * dy) / (dx * dx + dy * dy);
+    t = std::max(0.0, std::min(t, 1.0));
+    double ex = rx - t * dx;
+    double ey = ry - t * dy;
+    return ex * ex + ey * ey;
+}
+
+/// Fills in the projection of a position onto a point of a segment.
+PathProjection Path::makeProjection(std::size_t segment, double t, double x,
+                                    double y) const {
+    double dx = x_[segment + 1] - x_[segment];
+    double dy = y_[segment + 1] - y_[segment];
+    PathProjection projection;
+    projection.segment = segment;
+    projection.t = t;
+    projection.x = x_[segment] + t * dx;
+    projection.y = y_[segment] + t * dy;
+    projection.s = s_[segment] + t * (s_[segment + 1] - s_[segment]);
+    projection.heading = std::atan2(dy, dx);
+    double distance = std::hypot(x - projection.x, y - projection.y);
+    // The side follows from the cross product of the segment and the offset
+    double side = dx * (y - projection.y) - dy * (x - projection.x);
+    projection.crossTrack = side < 0.0 ? -distance : distance;
+    return projection;
+}
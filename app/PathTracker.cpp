@@ -0,0 +1,190 @@
+/**
+ * @file PathTracker.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of Pure Pursuit and Stanley path tracking.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "PathTracker.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "Clock.hpp"
+#include "RobotModel.hpp"
+
+namespace {
+
+/**
+ * @brief Wraps an angle into [-pi, pi].
+ */
+double wrapAngle(double angle) {
+    return std::remainder(angle, 2.0 * M_PI);
+}
+
+}  // namespace
+
+/**
+ * @brief Get the name of a tracking method, as used in scenario files.
+ *
+ * @param method The tracking method.
+ * @return "pure_pursuit" or "stanley".
+ */
+const char* trackingMethodName(TrackingMethod method) {
+    switch (method) {
+    case TrackingMethod::PurePursuit:
+        return "pure_pursuit";
+    case TrackingMethod::Stanley:
+        return "stanley";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of a tracking method.
+ *
+ * @param name Either pure_pursuit or stanley.
+ * @return The tracking method.
+ */
+TrackingMethod parseTrackingMethod(const std::string& name) {
+    const TrackingMethod methods[] = {TrackingMethod::PurePursuit,
+                                      TrackingMethod::Stanley};
+    for (TrackingMethod method : methods) {
+        if (name == trackingMethodName(method)) return method;
+    }
+    throw std::invalid_argument("unknown tracking method '" + name + "'");
+}
+
+/**
+ * @brief Constructor for the PathTracker class.
+ *
+ * @param path The path to follow.
+ * @param wheelbase The distance between the front and rear axles.
+ * @param params The steering law and its gains.
+ */
+PathTracker::PathTracker(std::shared_ptr<const Path> path, double wheelbase,
+                         const TrackingParams& params)
+    : path_(std::move(path)), wheelbase_(wheelbase), params_(params),
+      located_(false), lookaheadSegment_(0) {
+    if (!path_) {
+        throw std::invalid_argument("PathTracker needs a path");
+    }
+    if (!(wheelbase > 0.0)) {
+        throw std::invalid_argument("Wheelbase must be positive");
+    }
+}
+
+/**
+ * @brief Computes the steering angle for a rear-axle pose.
+ *
+ * @param x The x-coordinate of the rear axle.
+ * @param y The y-coordinate of the rear axle.
+ * @param theta The orientation (radians).
+ * @param speed The forward speed.
+ * @return The steering angle, positive to turn left, clamped to
+ *         maxSteeringAngle.
+ */
+double PathTracker::computeSteering(double x, double y, double theta,
+                                    double speed) {
+    double steering;
+    if (params_.method == TrackingMethod::Stanley) {
+        // Track the front axle
+        double fx = x + wheelbase_ * std::cos(theta);
+        double fy = y + wheelbase_ * std::sin(theta);
+        projection_ = located_ ? path_->project(fx, fy, projection_.segment)
+                               : path_->projectGlobal(fx, fy);
+        // Left of the path, the cross-track term steers right
+        steering = wrapAngle(projection_.heading - theta) -
+                   std::atan2(params_.stanleyGain * projection_.crossTrack,
+                              params_.softening + std::abs(speed));
+    } else {
+        projection_ = located_ ? path_->project(x, y, projection_.segment)
+                               : path_->projectGlobal(x, y);
+        if (!located_) lookaheadSegment_ = projection_.segment;
+        double lookahead = std::max(params_.minLookahead,
+                                    params_.lookaheadGain * std::abs(speed));
+        double tx, ty;
+        path_->pointAt(projection_.s + lookahead, lookaheadSegment_, tx, ty);
+        // Curvature of the arc through the lookahead point: 2 sin(alpha) / d
+        double alpha = wrapAngle(std::atan2(ty - y, tx - x) - theta);
+        double distance = std::hypot(tx - x, ty - y);
+        steering = distance > 0.0
+                       ? std::atan2(2.0 * wheelbase_ * std::sin(alpha),
+                                    distance)
+                       : 0.0;
+    }
+    located_ = true;
+    return std::max(-params_.maxSteeringAngle,
+                    std::min(steering, params_.maxSteeringAngle));
+}
+
+/**
+ * @brief Steers a robot model for one time step with updateState().
+ *
+ * @param robot The model to drive.
+ * @param dt The time step.
+ * @return The steering angle, positive to turn left.
+ */
+double PathTracker::step(RobotModel& robot, double dt) {
+    std::uint64_t start = monotonicNow();
+    double x, y, theta, velocity;
+    robot.getState(x, y, theta, velocity);
+    double steering = computeSteering(x, y, theta, velocity);
+    // updateState() turns clockwise for a positive steering angle
+    robot.updateState(-steering, dt);
+    stats_.tickLatency.record(monotonicNow() - start);
+
+    double error = std::abs(projection_.crossTrack);
+    stats_.ticks++;
+    stats_.sumAbsCrossTrack += error;
+    stats_.sumSquaredCrossTrack += error * error;
+    stats_.maxAbsCrossTrack = std::max(stats_.maxAbsCrossTrack, error);
+    return steering;
+}
+
+/**
+ * @brief Makes the next tick search the whole path again, e.g. after the
+ *        vehicle was moved.
+ */
+void PathTracker::reset() {
+    located_ = false;
+}
+
+/**
+ * @brief Checks whether the tracked axle has reached the end of the path.
+ *
+ * @return True once the projection lies at the last point.
+ */
+bool PathTracker::isFinished() const {
+    return located_ && projection_.segment + 2 == path_->size() &&
+           projection_.t >= 1.0;
+}
+
+/**
+ * @brief Retrieves the projection of the tracked axle on the last tick.
+ *
+ * @return The projection.
+ */
+const PathProjection& PathTracker::getProjection() const {
+    return projection_;
+}
+
+/**
+ * @brief Retrieves the statistics of the ticks run by step().
+ *
+ * @return The statistics.
+ */
+const TrackingStats& PathTracker::getStats() const {
+    return stats_;
+}
+
+/**
+ * @brief Retrieves the settings.
+ *
+ * @return The steering law and its gains.
+ */
+const TrackingParams& PathTracker::getParams() const {
+    return params_;
+}
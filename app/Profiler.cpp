@@ -0,0 +1,328 @@
+/**
+ * @file Profiler.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Implementation of the per-stage timing of the control loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "Profiler.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "Clock.hpp"
+
+std::atomic<bool> Profiler::enabled_(false);
+std::atomic<double> Profiler::nanosecondsPerTick_(1.0);
+thread_local Profiler::ThreadProfile* Profiler::current_ = nullptr;
+
+namespace {
+
+/**
+ * @brief The profiles of the live threads, and the merged profiles of the
+ *        threads that have ended.
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<Profiler::ThreadProfile*> live;
+    Profiler::ThreadProfile retired;
+    std::size_t retiredThreads = 0;
+    bool calibrated = false;
+};
+
+/**
+ * @brief The registry, never destroyed so that threads ending during exit
+ *        can still retire their profiles.
+ */
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+/**
+ * @brief Adds one thread profile to another.
+ */
+void mergeProfile(Profiler::ThreadProfile& into,
+                  const Profiler::ThreadProfile& from) {
+    for (std::size_t i = 0; i < kProfileStageCount; i++) {
+        into.stages[i].merge(from.stages[i]);
+    }
+    for (std::size_t i = 0; i < kProfileCounterCount; i++) {
+        into.counters[i] += from.counters[i];
+    }
+}
+
+/**
+ * @brief Owns the profile of one thread and retires it when the thread
+ *        ends.
+ */
+struct ThreadProfileOwner {
+    std::unique_ptr<Profiler::ThreadProfile> profile;
+
+    ~ThreadProfileOwner() {
+        if (!profile) return;
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        mergeProfile(shared.retired, *profile);
+        shared.retiredThreads++;
+        shared.live.erase(std::remove(shared.live.begin(), shared.live.end(),
+                                      profile.get()),
+                          shared.live.end());
+    }
+};
+
+thread_local ThreadProfileOwner threadProfileOwner;
+
+/**
+ * @brief Measures the length of a profile clock tick over 20 ms.
+ */
+double calibrateClock() {
+#ifdef ACKERMANN_PROFILE_TSC
+    const std::uint64_t startNs = monotonicNow();
+    const std::uint64_t startTicks = Profiler::now();
+    std::uint64_t endNs = startNs;
+    while (endNs - startNs < 20000000u) endNs = monotonicNow();
+    const std::uint64_t endTicks = Profiler::now();
+    if (endTicks <= startTicks) return 1.0;
+    return static_cast<double>(endNs - startNs) /
+           static_cast<double>(endTicks - startTicks);
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * @brief Writes a nanosecond duration with a unit, e.g. "1.25us".
+ */
+void writeDuration(std::ostream& output, std::uint64_t nanoseconds) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    if (nanoseconds < 10000) {
+        text << nanoseconds << "ns";
+    } else if (nanoseconds < 10000000) {
+        text << nanoseconds / 1e3 << "us";
+    } else {
+        text << nanoseconds / 1e6 << "ms";
+    }
+    output << std::setw(11) << text.str();
+}
+
+}  // namespace
+
+/**
+ * @brief Get the name of a stage, as used in reports.
+ *
+ * @param stage The stage.
+ * @return The name, e.g. "compute_errors".
+ */
+const char* profileStageName(ProfileStage stage) {
+    switch (stage) {
+    case ProfileStage::ComputeErrors:
+        return "compute_errors";
+    case ProfileStage::ComputePID:
+        return "compute_pid";
+    case ProfileStage::SimulateRobotModel:
+        return "simulate_robot_model";
+    case ProfileStage::UpdateState:
+        return "update_state";
+    case ProfileStage::ControlStep:
+        return "control_step";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Get the name of a counter, as used in reports.
+ *
+ * @param counter The counter.
+ * @return The name, e.g. "derivative_evaluations".
+ */
+const char* profileCounterName(ProfileCounter counter) {
+    switch (counter) {
+    case ProfileCounter::DerivativeEvaluations:
+        return "derivative_evaluations";
+    case ProfileCounter::SteeringTableMisses:
+        return "steering_table_misses";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Get the name of a report format, as used on the command line.
+ *
+ * @param format The format.
+ * @return "text" or "prometheus".
+ */
+const char* profileFormatName(ProfileFormat format) {
+    switch (format) {
+    case ProfileFormat::Text:
+        return "text";
+    case ProfileFormat::Prometheus:
+        return "prometheus";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of a report format.
+ *
+ * @param name Either text or prometheus.
+ * @return The format.
+ */
+ProfileFormat parseProfileFormat(const std::string& name) {
+    const ProfileFormat formats[] = {ProfileFormat::Text,
+                                     ProfileFormat::Prometheus};
+    for (ProfileFormat format : formats) {
+        if (name == profileFormatName(format)) return format;
+    }
+    throw std::invalid_argument("unknown profile format '" + name + "'");
+}
+
+/**
+ * @brief Writes the snapshot as a report.
+ *
+ * @param output The stream receiving the report.
+ * @param format The report format.
+ */
+void ProfileSnapshot::write(std::ostream& output,
+                            ProfileFormat format) const {
+    if (format == ProfileFormat::Text) {
+        output << std::left << std::setw(22) << "stage" << std::right
+               << std::setw(12) << "count" << std::setw(11) << "mean"
+               << std::setw(11) << "p50" << std::setw(11) << "p99"
+               << std::setw(11) << "max" << '\n';
+        for (std::size_t i = 0; i < kProfileStageCount; i++) {
+            const LatencyHistogram& stage = stages[i];
+            output << std::left << std::setw(22)
+                   << profileStageName(static_cast<ProfileStage>(i))
+                   << std::right << std::setw(12) << stage.getCount();
+            writeDuration(output, static_cast<std::uint64_t>(
+                                      stage.getMean() + 0.5));
+            writeDuration(output, stage.getPercentile(0.5));
+            writeDuration(output, stage.getPercentile(0.99));
+            writeDuration(output, stage.getMax());
+            output << '\n';
+        }
+        for (std::size_t i = 0; i < kProfileCounterCount; i++) {
+            output << std::left << std::setw(22)
+                   << profileCounterName(static_cast<ProfileCounter>(i))
+                   << std::right << std::setw(12) << counters[i] << '\n';
+        }
+        return;
+    }
+
+    const char* metric = "ackermann_stage_duration_nanoseconds";
+    output << "# HELP " << metric << " Time spent in one pass through a "
+              "control stage.\n"
+           << "# TYPE " << metric << " summary\n";
+    const double quantiles[] = {0.5, 0.99};
+    for (std::size_t i = 0; i < kProfileStageCount; i++) {
+        const char* name = profileStageName(static_cast<ProfileStage>(i));
+        for (double quantile : quantiles) {
+            output << metric << "{stage=\"" << name << "\",quantile=\""
+                   << quantile << "\"} "
+                   << stages[i].getPercentile(quantile) << '\n';
+        }
+        output << metric << "_sum{stage=\"" << name << "\"} "
+               << stages[i].getSum() << '\n'
+               << metric << "_count{stage=\"" << name << "\"} "
+               << stages[i].getCount() << '\n';
+    }
+    metric = "ackermann_stage_duration_max_nanoseconds";
+    output << "# HELP " << metric << " Longest pass through a control "
+              "stage.\n"
+           << "# TYPE " << metric << " gauge\n";
+    for (std::size_t i = 0; i < kProfileStageCount; i++) {
+        output << metric << "{stage=\""
+               << profileStageName(static_cast<ProfileStage>(i)) << "\"} "
+               << stages[i].getMax() << '\n';
+    }
+    for (std::size_t i = 0; i < kProfileCounterCount; i++) {
+        const char* name = profileCounterName(static_cast<ProfileCounter>(i));
+        output << "# TYPE ackermann_" << name << "_total counter\n"
+               << "ackermann_" << name << "_total " << counters[i] << '\n';
+    }
+}
+
+/**
+ * @brief Starts or stops recording. The clock is calibrated by the first
+ *        call that enables recording.
+ *
+ * @param enabled True to record.
+ */
+void Profiler::setEnabled(bool enabled) {
+    if (enabled) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (!shared.calibrated) {
+            nanosecondsPerTick_.store(calibrateClock(),
+                                      std::memory_order_relaxed);
+            shared.calibrated = true;
+        }
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Merges the measurements of all threads.
+ *
+ * @return The merged measurements.
+ */
+ProfileSnapshot Profiler::snapshot() {
+    ProfileSnapshot snapshot;
+    ThreadProfile merged;
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    mergeProfile(merged, shared.retired);
+    snapshot.threads = shared.retiredThreads;
+    for (const ThreadProfile* profile : shared.live) {
+        mergeProfile(merged, *profile);
+        snapshot.threads++;
+    }
+    for (std::size_t i = 0; i < kProfileStageCount; i++) {
+        snapshot.stages[i].merge(merged.stages[i]);
+    }
+    std::copy(merged.counters, merged.counters + kProfileCounterCount,
+              snapshot.counters);
+    return snapshot;
+}
+
+/**
+ * @brief Removes the measurements of all threads.
+ */
+void Profiler::reset() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (ThreadProfile* profile : shared.live) *profile = ThreadProfile();
+    shared.retired = ThreadProfile();
+    shared.retiredThreads = 0;
+}
+
+/**
+ * @brief Get the length of a clock tick.
+ *
+ * @return Nanoseconds per tick; 1 until calibrated.
+ */
+double Profiler::getNanosecondsPerTick() {
+    return nanosecondsPerTick_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Creates the profile of the calling thread on its first record.
+ *
+ * @return The profile of the calling thread.
+ */
+Profiler::ThreadProfile* Profiler::registerThread() {
+    threadProfileOwner.profile.reset(new ThreadProfile());
+    current_ = threadProfileOwner.profile.get();
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.live.push_back(current_);
+    return current_;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file RateGroupScheduler.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Implementation of the rate-group scheduler.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "RateGroupScheduler.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Greatest common divisor of two positive numbers.
+ */
+std::uint64_t greatestCommonDivisor(std::uint64_t a, std::uint64_t b) {
+    while (b != 0) {
+        std::uint64_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the RateGroupScheduler class.
+ *
+ * @param basePeriod The length of a tick (seconds).
+ */
+RateGroupScheduler::RateGroupScheduler(double basePeriod)
+    : basePeriod_(basePeriod), tick_(0) {
+    if (!(basePeriod > 0.0)) {
+        throw std::invalid_argument("the base period must be positive");
+    }
+}
+
+/**
+ * @brief Adds a rate group.
+ *
+ * @param name The name of the group, for reports.
+ * @param divisor The number of ticks between runs.
+ * @param task The task to run.
+ * @param offset The first tick the group runs on, below divisor.
+ * @return The index of the group.
+ */
+std::size_t RateGroupScheduler::addGroup(const std::string& name,
+                                         std::uint32_t divisor, Task task,
+                                         std::uint32_t offset) {
+    if (divisor == 0) {
+        throw std::invalid_argument("rate group '" + name +
+                                    "' needs a divisor of at least 1");
+    }
+    if (offset >= divisor) {
+        throw std::invalid_argument("rate group '" + name +
+                                    "' has an offset beyond its divisor");
+    }
+    Group group;
+    group.name = name;
+    group.divisor = divisor;
+    group.offset = offset;
+    // Join the schedule as if it had run from tick 0
+    std::uint64_t phase = (tick_ + divisor - offset) % divisor;
+    group.countdown = static_cast<std::uint32_t>((divisor - phase) %
+                                                 divisor);
+    group.runs = 0;
+    group.task = std::move(task);
+    groups_.push_back(std::move(group));
+    return groups_.size() - 1;
+}
+
+/**
+ * @brief Runs the groups due on the current tick, then advances it.
+ */
+void RateGroupScheduler::tick() {
+    for (Group& group : groups_) {
+        if (group.countdown == 0) {
+            group.task(tick_);
+            group.runs++;
+            group.countdown = group.divisor;
+        }
+        group.countdown--;
+    }
+    tick_++;
+}
+
+/**
+ * @brief Runs a number of ticks.
+ *
+ * @param ticks The number of ticks.
+ */
+void RateGroupScheduler::run(std::uint64_t ticks) {
+    for (std::uint64_t i = 0; i < ticks; i++) tick();
+}
+
+/**
+ * @brief Restarts the schedule at tick 0 and clears the run counts.
+ */
+void RateGroupScheduler::reset() {
+    tick_ = 0;
+    for (Group& group : groups_) {
+        group.countdown = group.offset;
+        group.runs = 0;
+    }
+}
+
+/**
+ * @brief Get the number of the next tick.
+ *
+ * @return The number of ticks run.
+ */
+std::uint64_t RateGroupScheduler::getTick() const {
+    return tick_;
+}
+
+/**
+ * @brief Get the time of the next tick.
+ *
+ * @return The number of ticks run times the base period (seconds).
+ */
+double RateGroupScheduler::getTime() const {
+    return static_cast<double>(tick_) * basePeriod_;
+}
+
+/**
+ * @brief Get the length of a tick.
+ *
+ * @return The base period (seconds).
+ */
+double RateGroupScheduler::getBasePeriod() const {
+    return basePeriod_;
+}
+
+/**
+ * @brief Get the length after which the whole schedule repeats.
+ *
+ * @return The least common multiple of the divisors, in ticks.
+ */
+std::uint64_t RateGroupScheduler::getHyperperiod() const {
+    std::uint64_t hyperperiod = 1;
+    for (const Group& group : groups_) {
+        hyperperiod = hyperperiod /
+                      greatestCommonDivisor(hyperperiod, group.divisor) *
+                      group.divisor;
+    }
+    return hyperperiod;
+}
+
+/**
+ * @brief Get the number of rate groups.
+ *
+ * @return The number of groups.
+ */
+std::size_t RateGroupScheduler::getGroupCount() const {
+    return groups_.size();
+}
+
+/**
+ * @brief Get the name of a group.
+ *
+ * @param group The group index.
+ * @return The name given to addGroup().
+ */
+const std::string& RateGroupScheduler::getGroupName(std::size_t group) const {
+    return groups_.at(group).name;
+}
+
+/**
+ * @brief Get the period of a group.
+ *
+ * @param group The group index.
+ * @return The divisor times the base period (seconds).
+ */
+double RateGroupScheduler::getGroupPeriod(std::size_t group) const {
+    return groups_.at(group).divisor * basePeriod_;
+}
+
+/**
+ * @brief Get the number of times a group ran.
+ *
+ * @param group The group index.
+ * @return The run count since construction or reset().
+ */
+std::uint64_t RateGroupScheduler::getRunCount(std::size_t group) const {
+    return groups_.at(group).runs;
+}
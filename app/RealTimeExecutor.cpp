@@ -0,0 +1,222 @@
+/**
+ * @file RealTimeExecutor.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Runs a control step at a fixed period against the wall clock.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "RealTimeExecutor.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "Clock.hpp"
+
+namespace {
+
+const std::int64_t kNsPerSecond = 1000000000;
+
+/**
+ * @brief Sleeps until an absolute CLOCK_MONOTONIC time in nanoseconds.
+ */
+void sleepUntil(std::int64_t deadline) {
+    timespec wake;
+    wake.tv_sec = static_cast<time_t>(deadline / kNsPerSecond);
+    wake.tv_nsec = static_cast<long>(deadline % kNsPerSecond);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) ==
+           EINTR) {
+    }
+}
+
+/**
+ * @brief Applies the scheduling settings to the calling thread and
+ *        restores the previous ones when destroyed.
+ */
+class SchedulingScope {
+public:
+    explicit SchedulingScope(const RealTimeOptions& options)
+        : thread_(pthread_self()), policyChanged_(false),
+          affinityChanged_(false), memoryLocked_(false) {
+        try {
+            if (options.cpu >= 0) pin(options.cpu);
+            if (options.priority > 0) elevate(options.priority);
+            if (options.lockMemory) lock();
+        } catch (...) {
+            restore();
+            throw;
+        }
+    }
+
+    ~SchedulingScope() {
+        restore();
+    }
+
+    SchedulingScope(const SchedulingScope&) = delete;
+    SchedulingScope& operator=(const SchedulingScope&) = delete;
+
+private:
+    void pin(int cpu) {
+        if (cpu >= CPU_SETSIZE) {
+            throw std::runtime_error("CPU " + std::to_string(cpu) +
+                                     " is out of range");
+        }
+        check(pthread_getaffinity_np(thread_, sizeof(oldAffinity_),
+                                     &oldAffinity_), "read CPU affinity");
+        cpu_set_t affinity;
+        CPU_ZERO(&affinity);
+        CPU_SET(cpu, &affinity);
+        check(pthread_setaffinity_np(thread_, sizeof(affinity), &affinity),
+              "pin to CPU " + std::to_string(cpu));
+        affinityChanged_ = true;
+    }
+
+    void elevate(int priority) {
+        check(pthread_getschedparam(thread_, &oldPolicy_, &oldParam_),
+              "read scheduling policy");
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        check(pthread_setschedparam(thread_, SCHED_FIFO, &param),
+              "set SCHED_FIFO priority " + std::to_string(priority));
+        policyChanged_ = true;
+    }
+
+    void lock() {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            check(errno, "lock memory");
+        }
+        memoryLocked_ = true;
+    }
+
+    void restore() {
+        if (memoryLocked_) munlockall();
+        if (policyChanged_) {
+            pthread_setschedparam(thread_, oldPolicy_, &oldParam_);
+        }
+        if (affinityChanged_) {
+            pthread_setaffinity_np(thread_, sizeof(oldAffinity_),
+                                   &oldAffinity_);
+        }
+        memoryLocked_ = policyChanged_ = affinityChanged_ = false;
+    }
+
+    static void check(int status, const std::string& what) {
+        if (status != 0) {
+            throw std::runtime_error("cannot " + what + ": " +
+                                     std::strerror(status));
+        }
+    }
+
+    pthread_t thread_;
+    bool policyChanged_;
+    bool affinityChanged_;
+    bool memoryLocked_;
+    int oldPolicy_;
+    sched_param oldParam_;
+    cpu_set_t oldAffinity_;
+};
+
+}  // namespace
+
+/**
+ * @brief Constructor for the RealTimeExecutor class.
+ *
+ * @param options The period and scheduling settings.
+ */
+RealTimeExecutor::RealTimeExecutor(const RealTimeOptions& options)
+    : options_(options), stopRequested_(false) {
+    if (!(options.period > 0.0)) {
+        throw std::invalid_argument("the period must be positive");
+    }
+    periodNs_ = static_cast<std::int64_t>(
+        std::llround(options.period * kNsPerSecond));
+    if (periodNs_ < 1) periodNs_ = 1;
+}
+
+/**
+ * @brief Runs the step on the calling thread until it returns false,
+ *        maxSteps steps have run, or requestStop() is called.
+ *
+ * @param step The control step.
+ * @param maxSteps The maximum number of steps.
+ * @return The timing statistics of the run.
+ */
+const RealTimeStats& RealTimeExecutor::run(const Step& step,
+                                           std::uint64_t maxSteps) {
+    stats_ = RealTimeStats();
+    // Cleared before the loop, so a stop that arrives as the loop ends
+    // is kept for the caller
+    stopRequested_.store(false, std::memory_order_relaxed);
+    SchedulingScope scope(options_);
+
+    // Release the first step one period from now
+    std::int64_t release =
+        static_cast<std::int64_t>(monotonicNow()) + periodNs_;
+    for (std::uint64_t i = 0;
+         i < maxSteps && !stopRequested_.load(std::memory_order_relaxed);
+         i++) {
+        sleepUntil(release);
+        std::int64_t wake = static_cast<std::int64_t>(monotonicNow());
+        bool keepGoing = step(i);
+        std::int64_t done = static_cast<std::int64_t>(monotonicNow());
+
+        stats_.steps++;
+        stats_.wakeupJitter.record(
+            static_cast<std::uint64_t>(wake > release ? wake - release : 0));
+        stats_.stepLatency.record(static_cast<std::uint64_t>(done - wake));
+
+        release += periodNs_;
+        if (done > release) {
+            // Skip the periods the step overran instead of bursting
+            stats_.missedDeadlines++;
+            std::int64_t behind = (done - release) / periodNs_ + 1;
+            stats_.skippedPeriods += static_cast<std::uint64_t>(behind);
+            release += behind * periodNs_;
+        }
+
+        if (!keepGoing) break;
+    }
+    return stats_;
+}
+
+/**
+ * @brief Asks a running loop to stop after its current step.
+ */
+void RealTimeExecutor::requestStop() {
+    stopRequested_.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether a stop was requested since the last run started.
+ *
+ * @return True if requestStop() was called.
+ */
+bool RealTimeExecutor::isStopRequested() const {
+    return stopRequested_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the statistics of the last run.
+ *
+ * @return The timing statistics.
+ */
+const RealTimeStats& RealTimeExecutor::getStats() const {
+    return stats_;
+}
+
+/**
+ * @brief Get the loop settings.
+ *
+ * @return The period and scheduling settings.
+ */
+const RealTimeOptions& RealTimeExecutor::getOptions() const {
+    return options_;
+}
@@ -0,0 +1,524 @@
+/**
+ * @file RobotFleet.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Structure-of-arrays container stepping many Ackermann vehicles.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "RobotFleet.hpp"
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ACKERMANN_FLEET_AVX2 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Constructor for the RobotFleet class.
+ *
+ * @param count The number of vehicles.
+ */
+RobotFleet::RobotFleet(std::size_t count) : simdEnabled_(true) {
+    resize(count);
+}
+
+/**
+ * @brief Changes the number of vehicles.
+ *
+ * @param count The number of vehicles.
+ */
+void RobotFleet::resize(std::size_t count) {
+    wheelbase_.resize(count, 0.5);
+    wheelRadius_.resize(count, 1.0);
+    trackWidth_.resize(count, 1.0);
+    maxSteeringAngle_.resize(count, 0.0);
+    x_.resize(count, 0.0);
+    y_.resize(count, 0.0);
+    theta_.resize(count, 0.0);
+    velocity_.resize(count, 0.0);
+    alpha_i_.resize(count, 0.0);
+    alpha_o_.resize(count, 0.0);
+    omega_i_.resize(count, 0.0);
+    omega_o_.resize(count, 0.0);
+    heading_.resize(count, 0.0);
+    speed_.resize(count, 0.0);
+}
+
+/**
+ * @brief Retrieves the number of vehicles.
+ *
+ * @return The number of vehicles.
+ */
+std::size_t RobotFleet::size() const {
+    return x_.size();
+}
+
+/**
+ * @brief Sets the geometry of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param wheelbase The distance between the front and rear axles.
+ * @param wheelRadius The radius of the drive wheels.
+ * @param trackWidth The distance between the left and right wheels.
+ * @param maxSteeringAngle The steering limit applied by updateState.
+ */
+void RobotFleet::setGeometry(std::size_t i, double wheelbase,
+                             double wheelRadius, double trackWidth,
+                             double maxSteeringAngle) {
+    wheelbase_[i] = wheelbase;
+    wheelRadius_[i] = wheelRadius;
+    trackWidth_[i] = trackWidth;
+    maxSteeringAngle_[i] = maxSteeringAngle;
+}
+
+/**
+ * @brief Sets the initial state of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param x The initial x-coordinate.
+ * @param y The initial y-coordinate.
+ * @param theta The initial orientation (in radians).
+ * @param velocity The initial velocity.
+ */
+void RobotFleet::setInitialState(std::size_t i, double x, double y,
+                                 double theta, double velocity) {
+    x_[i] = x;
+    y_[i] = y;
+    theta_[i] = theta;
+    velocity_[i] = velocity;
+    heading_[i] = theta;
+    speed_[i] = velocity;
+    if (wheelRadius_[i] != 0.0) {
+        omega_i_[i] = velocity / wheelRadius_[i];
+        omega_o_[i] = omega_i_[i];
+    }
+}
+
+/**
+ * @brief Advances every vehicle by one time step.
+ *
+ * @param headingCommands The PID heading output of each vehicle.
+ * @param velocityCommands The PID velocity output of each vehicle.
+ * @param dt The time step.
+ */
+void RobotFleet::step(const double* headingCommands,
+                      const double* velocityCommands, double dt) {
+    stepRange(0, size(), headingCommands, velocityCommands, dt);
+}
+
+/**
+ * @brief Advances the vehicles in [begin, end) by one time step.
+ *
+ * @param begin The index of the first vehicle.
+ * @param end One past the index of the last vehicle.
+ * @param headingCommands The PID heading output of each vehicle.
+ * @param velocityCommands The PID velocity output of each vehicle.
+ * @param dt The time step.
+ */
+void RobotFleet::stepRange(std::size_t begin, std::size_t end,
+                           const double* headingCommands,
+                           const double* velocityCommands, double dt) {
+    if (isSimdActive()) {
+        stepAvx2(begin, end, headingCommands, velocityCommands, dt);
+    } else {
+        stepScalar(begin, end, headingCommands, velocityCommands, dt);
+    }
+}
+
+/**
+ * @brief Enables or disables the AVX2 kernel.
+ *
+ * @param enabled True to use AVX2 when the CPU supports it.
+ */
+void RobotFleet::setSimdEnabled(bool enabled) {
+    simdEnabled_ = enabled;
+}
+
+/**
+ * @brief Checks whether steps run on the AVX2 kernel.
+ *
+ * @return True if the AVX2 kernel is enabled and supported.
+ */
+bool RobotFleet::isSimdActive() const {
+    return simdEnabled_ && simdSupported();
+}
+
+/**
+ * @brief Checks whether the CPU and the build support the AVX2 kernel.
+ *
+ * @return True if the AVX2 kernel can be used.
+ */
+bool RobotFleet::simdSupported() {
+#ifdef ACKERMANN_FLEET_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2") &&
+                                  __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Retrieves the pose of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param x The x-coordinate (output).
+ * @param y The y-coordinate (output).
+ * @param theta The orientation in radians (output).
+ * @param velocity The velocity (output).
+ */
+void RobotFleet::getState(std::size_t i, double& x, double& y, double& theta,
+                          double& velocity) const {
+    x = x_[i];
+    y = y_[i];
+    theta = theta_[i];
+    velocity = velocity_[i];
+}
+
+/**
+ * @brief Retrieves the wheel outputs of one vehicle.
+ *
+ * @param i The index of the vehicle.
+ * @param alphaI The inner steering angle (output).
+ * @param alphaO The outer steering angle (output).
+ * @param omegaI The inner wheel angular velocity (output).
+ * @param omegaO The outer wheel angular velocity (output).
+ */
+void RobotFleet::getWheelState(std::size_t i, double& alphaI, double& alphaO,
+                               double& omegaI, double& omegaO) const {
+    alphaI = alpha_i_[i];
+    alphaO = alpha_o_[i];
+    omegaI = omega_i_[i];
+    omegaO = omega_o_[i];
+}
+
+/**
+ * @brief Scalar kernel, written expression for expression like RobotModel
+ *        so both produce bit-identical results.
+ */
+void RobotFleet::stepScalar(std::size_t begin, std::size_t end,
+                            const double* headingCommands,
+                            const double* velocityCommands, double dt) {
+    for (std::size_t i = begin; i < end; i++) {
+        const double L = wheelbase_[i];
+        const double r = wheelRadius_[i];
+        const double w = trackWidth_[i];
+        const double h = headingCommands[i];
+        const double u = velocityCommands[i];
+        double R;
+        double deltaTheta = 0;
+        double newSpeed = 0;
+
+        // Simulate_robot_model
+        if (h > 0) {
+            R = L * 1 / std::tan(h);
+            alpha_i_[i] = std::atan(L / (R - (w / 2)));
+            alpha_o_[i] = std::atan(L / (R + (w / 2)));
+            omega_o_[i] += u;
+            deltaTheta = (r * omega_o_[i] * dt) / (R + (w / 2));
+            omega_i_[i] = (deltaTheta * (R - (w / 2))) / (r * dt);
+            newSpeed = std::abs((R * deltaTheta) / dt);
+        } else if (h < 0) {
+            R = L * 1 / std::tan(h);
+            alpha_o_[i] = std::atan(L / (R - (w / 2)));
+            alpha_i_[i] = std::atan(L / (R + (w / 2)));
+            omega_i_[i] += u;
+            deltaTheta = (r * omega_i_[i] * dt) / (R + (w / 2));
+            omega_o_[i] = (deltaTheta * (R - (w / 2))) / (r * dt);
+            newSpeed = std::abs((R * deltaTheta) / dt);
+        } else {
+            alpha_o_[i] = 0;
+            alpha_i_[i] = 0;
+            if (omega_i_[i] >= omega_o_[i]) {
+                omega_o_[i] += u;
+                omega_i_[i] = omega_o_[i];
+            } else {
+                omega_i_[i] += u;
+                omega_o_[i] = omega_i_[i];
+            }
+            newSpeed = omega_i_[i] * r;
+        }
+        heading_[i] += deltaTheta;
+        speed_[i] = newSpeed;
+
+        // updateState
+        double steeringAngle = h;
+        if (std::abs(steeringAngle) > maxSteeringAngle_[i]) {
+            steeringAngle = std::copysign(maxSteeringAngle_[i], steeringAngle);
+        }
+        double curvature = std::tan(steeringAngle) / L;
+        double leftWheelVelocity = velocity_[i] * (1.0 - curvature * (w / 2.0));
+        double rightWheelVelocity = velocity_[i] * (1.0 + curvature * (w / 2.0));
+        double turn = (leftWheelVelocity - rightWheelVelocity) / w * dt;
+        double deltaX = 0.5 * (leftWheelVelocity + rightWheelVelocity)
+                            * std::cos(theta_[i]) * dt;
+        double deltaY = 0.5 * (leftWheelVelocity + rightWheelVelocity)
+                            * std::sin(theta_[i]) * dt;
+        x_[i] += deltaX;
+        y_[i] += deltaY;
+        theta_[i] += turn;
+    }
+}
+
+#ifdef ACKERMANN_FLEET_AVX2
+
+#define ACK_AVX2 __attribute__((target("avx2,fma")))
+
+namespace {
+
+/// Arguments beyond this magnitude lose accuracy in the Cody-Waite
+/// reduction below, so blocks containing them use the scalar kernel.
+const double kMaxReducedArgument = 1.0e8;
+
+ACK_AVX2 inline __m256d absPd(__m256d x) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+
+ACK_AVX2 inline __m256d polyPd(__m256d x, const double* c, int n) {
+    __m256d result = _mm256_set1_pd(c[0]);
+    for (int k = 1; k < n; k++) {
+        result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(c[k]));
+    }
+    return result;
+}
+
+/**
+ * @brief Four-lane sine and cosine (Cephes sin.c / cos.c).
+ */
+ACK_AVX2 inline void sinCosPd(__m256d x, __m256d* sinOut, __m256d* cosOut) {
+    static const double sinCoefficients[] = {
+        1.58962301576546568060E-10, -2.50507477628578072866E-8,
+        2.75573136213857245213E-6, -1.98412698295895385996E-4,
+        8.33333333332211858878E-3, -1.66666666666666307295E-1};
+    static const double cosCoefficients[] = {
+        -1.13585365213876817300E-11, 2.08757008419747316778E-9,
+        -2.75573141792967388112E-7, 2.48015872888517045348E-5,
+        -1.38888888888730564116E-3, 4.16666666666665929218E-2};
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+
+    __m256d sinSign = _mm256_and_pd(x, signMask);
+    __m256d ax = absPd(x);
+
+    // Octant index, rounded up to an even value, and its residue mod 8.
+    __m256d y = _mm256_floor_pd(
+        _mm256_mul_pd(ax, _mm256_set1_pd(1.27323954473516268615)));
+    __m256d octant = _mm256_sub_pd(y, _mm256_mul_pd(_mm256_set1_pd(8.0),
+        _mm256_floor_pd(_mm256_mul_pd(y, _mm256_set1_pd(0.125)))));
+    __m256d odd = _mm256_cmp_pd(
+        _mm256_sub_pd(octant, _mm256_mul_pd(two, _mm256_floor_pd(
+            _mm256_mul_pd(octant, _mm256_set1_pd(0.5))))), one, _CMP_EQ_OQ);
+    y = _mm256_add_pd(y, _mm256_and_pd(odd, one));
+    octant = _mm256_add_pd(octant, _mm256_and_pd(odd, one));
+
+    // Extended precision reduction to [-pi/4, pi/4].
+    __m256d z = _mm256_fnmadd_pd(y, _mm256_set1_pd(7.85398125648498535156E-1),
+                                 ax);
+    z = _mm256_fnmadd_pd(y, _mm256_set1_pd(3.77489470793079817668E-8), z);
+    z = _mm256_fnmadd_pd(y, _mm256_set1_pd(2.69515142907905952645E-15), z);
+    __m256d zz = _mm256_mul_pd(z, z);
+
+    __m256d sinPoly = _mm256_fmadd_pd(_mm256_mul_pd(z, zz),
+                                      polyPd(zz, sinCoefficients, 6), z);
+    __m256d cosPoly = _mm256_add_pd(
+        _mm256_fnmadd_pd(_mm256_set1_pd(0.5), zz, one),
+        _mm256_mul_pd(_mm256_mul_pd(zz, zz), polyPd(zz, cosCoefficients, 6)));
+
+    // Octants 2 and 6 swap the polynomials; 4 and 6 flip the sine sign;
+    // 2 and 4 flip the cosine sign.
+    __m256d isTwo = _mm256_cmp_pd(octant, two, _CMP_EQ_OQ);
+    __m256d isFour = _mm256_cmp_pd(octant, four, _CMP_EQ_OQ);
+    __m256d isSix = _mm256_cmp_pd(octant, _mm256_set1_pd(6.0), _CMP_EQ_OQ);
+    __m256d swap = _mm256_or_pd(isTwo, isSix);
+    __m256d s = _mm256_blendv_pd(sinPoly, cosPoly, swap);
+    __m256d c = _mm256_blendv_pd(cosPoly, sinPoly, swap);
+    sinSign = _mm256_xor_pd(sinSign,
+                            _mm256_and_pd(_mm256_or_pd(isFour, isSix),
+                                          signMask));
+    __m256d cosSign = _mm256_and_pd(_mm256_or_pd(isTwo, isFour), signMask);
+    *sinOut = _mm256_xor_pd(s, sinSign);
+    *cosOut = _mm256_xor_pd(c, cosSign);
+}
+
+/**
+ * @brief Four-lane tangent computed from sinCosPd().
+ */
+ACK_AVX2 inline __m256d tanPd(__m256d x) {
+    __m256d s, c;
+    sinCosPd(x, &s, &c);
+    return _mm256_div_pd(s, c);
+}
+
+/**
+ * @brief Four-lane arctangent (Cephes atan.c).
+ */
+ACK_AVX2 inline __m256d atanPd(__m256d x) {
+    static const double p[] = {
+        -8.750608600031904122785E-1, -1.615753718733365076637E1,
+        -7.500855792314704667340E1, -1.228866684490136173410E2,
+        -6.485021904942025371773E1};
+    static const double q[] = {
+        1.0, 2.485846490142306297962E1, 1.650270098316988542046E2,
+        4.328810604912902668951E2, 4.853903996359136964868E2,
+        1.945506571482613964425E2};
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const double moreBits = 6.123233995736765886130E-17;
+
+    __m256d sign = _mm256_and_pd(x, signMask);
+    __m256d ax = absPd(x);
+
+    __m256d big = _mm256_cmp_pd(ax, _mm256_set1_pd(2.41421356237309504880),
+                                _CMP_GT_OQ);
+    __m256d mid = _mm256_andnot_pd(big,
+        _mm256_cmp_pd(ax, _mm256_set1_pd(0.66), _CMP_GT_OQ));
+
+    __m256d reduced = _mm256_blendv_pd(ax,
+        _mm256_div_pd(_mm256_sub_pd(ax, one), _mm256_add_pd(ax, one)), mid);
+    reduced = _mm256_blendv_pd(reduced,
+        _mm256_div_pd(_mm256_set1_pd(-1.0), ax), big);
+    __m256d offset = _mm256_blendv_pd(_mm256_setzero_pd(),
+        _mm256_set1_pd(M_PI / 4.0), mid);
+    offset = _mm256_blendv_pd(offset, _mm256_set1_pd(M_PI / 2.0), big);
+    __m256d extra = _mm256_blendv_pd(_mm256_setzero_pd(),
+        _mm256_set1_pd(0.5 * moreBits), mid);
+    extra = _mm256_blendv_pd(extra, _mm256_set1_pd(moreBits), big);
+
+    __m256d z = _mm256_mul_pd(reduced, reduced);
+    __m256d ratio = _mm256_div_pd(_mm256_mul_pd(z, polyPd(z, p, 5)),
+                                  polyPd(z, q, 6));
+    __m256d result = _mm256_fmadd_pd(reduced, ratio, reduced);
+    result = _mm256_add_pd(offset, _mm256_add_pd(result, extra));
+    return _mm256_xor_pd(result, sign);
+}
+
+}  // namespace
+
+/**
+ * @brief AVX2 kernel advancing four vehicles per iteration.
+ *
+ * Left turns, right turns and straight driving are all evaluated and
+ * blended per lane. The transcendental functions are Cephes polynomial
+ * approximations, so results agree with the scalar kernel to within a few
+ * ulps rather than bit for bit.
+ */
+ACK_AVX2 void RobotFleet::stepAvx2(std::size_t begin, std::size_t end,
+                                   const double* headingCommands,
+                                   const double* velocityCommands,
+                                   double dt) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d vdt = _mm256_set1_pd(dt);
+    const __m256d limit = _mm256_set1_pd(kMaxReducedArgument);
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d h = _mm256_loadu_pd(headingCommands + i);
+        __m256d theta = _mm256_loadu_pd(&theta_[i]);
+        __m256d outOfRange = _mm256_or_pd(
+            _mm256_cmp_pd(absPd(h), limit, _CMP_NLE_UQ),
+            _mm256_cmp_pd(absPd(theta), limit, _CMP_NLE_UQ));
+        if (_mm256_movemask_pd(outOfRange) != 0) {
+            stepScalar(i, i + 4, headingCommands, velocityCommands, dt);
+            continue;
+        }
+
+        __m256d u = _mm256_loadu_pd(velocityCommands + i);
+        __m256d L = _mm256_loadu_pd(&wheelbase_[i]);
+        __m256d r = _mm256_loadu_pd(&wheelRadius_[i]);
+        __m256d w = _mm256_loadu_pd(&trackWidth_[i]);
+        __m256d halfW = _mm256_div_pd(w, _mm256_set1_pd(2.0));
+        __m256d omegaI = _mm256_loadu_pd(&omega_i_[i]);
+        __m256d omegaO = _mm256_loadu_pd(&omega_o_[i]);
+
+        // Simulate_robot_model
+        __m256d left = _mm256_cmp_pd(h, zero, _CMP_GT_OQ);
+        __m256d right = _mm256_cmp_pd(h, zero, _CMP_LT_OQ);
+        __m256d turning = _mm256_or_pd(left, right);
+
+        __m256d R = _mm256_div_pd(L, tanPd(h));
+        __m256d rMinus = _mm256_sub_pd(R, halfW);
+        __m256d rPlus = _mm256_add_pd(R, halfW);
+        __m256d angleMinus = atanPd(_mm256_div_pd(L, rMinus));
+        __m256d anglePlus = atanPd(_mm256_div_pd(L, rPlus));
+
+        // The outer wheel drives left turns, the inner wheel right turns.
+        __m256d driven = _mm256_add_pd(
+            _mm256_blendv_pd(omegaI, omegaO, left), u);
+        __m256d turnTheta = _mm256_div_pd(
+            _mm256_mul_pd(_mm256_mul_pd(r, driven), vdt), rPlus);
+        __m256d follower = _mm256_div_pd(_mm256_mul_pd(turnTheta, rMinus),
+                                         _mm256_mul_pd(r, vdt));
+        __m256d turnSpeed = absPd(_mm256_div_pd(_mm256_mul_pd(R, turnTheta),
+                                                vdt));
+
+        // Straight driving equalises both wheels on the slower one.
+        __m256d innerFaster = _mm256_cmp_pd(omegaI, omegaO, _CMP_GE_OQ);
+        __m256d straight = _mm256_add_pd(
+            _mm256_blendv_pd(omegaI, omegaO, innerFaster), u);
+
+        __m256d alphaI = _mm256_and_pd(turning,
+            _mm256_blendv_pd(anglePlus, angleMinus, left));
+        __m256d alphaO = _mm256_and_pd(turning,
+            _mm256_blendv_pd(angleMinus, anglePlus, left));
+        __m256d newOmegaI = _mm256_blendv_pd(straight,
+            _mm256_blendv_pd(driven, follower, left), turning);
+        __m256d newOmegaO = _mm256_blendv_pd(straight,
+            _mm256_blendv_pd(follower, driven, left), turning);
+        __m256d deltaTheta = _mm256_and_pd(turning, turnTheta);
+        __m256d newSpeed = _mm256_blendv_pd(_mm256_mul_pd(straight, r),
+                                            turnSpeed, turning);
+
+        _mm256_storeu_pd(&alpha_i_[i], alphaI);
+        _mm256_storeu_pd(&alpha_o_[i], alphaO);
+        _mm256_storeu_pd(&omega_i_[i], newOmegaI);
+        _mm256_storeu_pd(&omega_o_[i], newOmegaO);
+        _mm256_storeu_pd(&heading_[i], _mm256_add_pd(
+            _mm256_loadu_pd(&heading_[i]), deltaTheta));
+        _mm256_storeu_pd(&speed_[i], newSpeed);
+
+        // updateState
+        __m256d maxAngle = _mm256_loadu_pd(&maxSteeringAngle_[i]);
+        __m256d clamp = _mm256_cmp_pd(absPd(h), maxAngle, _CMP_GT_OQ);
+        __m256d steering = _mm256_blendv_pd(h,
+            _mm256_or_pd(maxAngle, _mm256_and_pd(h, signMask)), clamp);
+        __m256d curvature = _mm256_div_pd(tanPd(steering), L);
+        __m256d velocity = _mm256_loadu_pd(&velocity_[i]);
+        __m256d offset = _mm256_mul_pd(curvature, halfW);
+        __m256d leftWheel = _mm256_mul_pd(velocity, _mm256_sub_pd(one, offset));
+        __m256d rightWheel = _mm256_mul_pd(velocity, _mm256_add_pd(one, offset));
+        __m256d turn = _mm256_mul_pd(
+            _mm256_div_pd(_mm256_sub_pd(leftWheel, rightWheel), w), vdt);
+        __m256d forward = _mm256_mul_pd(
+            _mm256_mul_pd(half, _mm256_add_pd(leftWheel, rightWheel)), vdt);
+        __m256d s, c;
+        sinCosPd(theta, &s, &c);
+        _mm256_storeu_pd(&x_[i], _mm256_fmadd_pd(forward, c,
+                                                 _mm256_loadu_pd(&x_[i])));
+        _mm256_storeu_pd(&y_[i], _mm256_fmadd_pd(forward, s,
+                                                 _mm256_loadu_pd(&y_[i])));
+        _mm256_storeu_pd(&theta_[i], _mm256_add_pd(theta, turn));
+    }
+
+    stepScalar(i, end, headingCommands, velocityCommands, dt);
+}
+
+#else
+
+/**
+ * @brief Fallback used when the AVX2 kernel is not compiled in.
+ */
+void RobotFleet::stepAvx2(std::size_t begin, std::size_t end,
+                          const double* headingCommands,
+                          const double* velocityCommands, double dt) {
+    stepScalar(begin, end, headingCommands, velocityCommands, dt);
+}
+
+#endif
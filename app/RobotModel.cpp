@@ -10,7 +10,9 @@
 
 #include "RobotModel.hpp"
 #include <cmath>
-#include<iostream>
+#include <utility>
+#include "Logger.hpp"
+#include "Profiler.hpp"
 
 /**
  * @brief Constructor for the RobotModel class.
@@ -23,7 +25,8 @@ RobotModel::RobotModel(double wheelbase, double wheelRadius, double trackWidth)
     : wheelbase_(wheelbase), wheelRadius_(wheelRadius), trackWidth_(trackWidth),
       alpha_i_(0.0), alpha_o_(0.0), omega_i_(0.0), omega_o_(0.0),
       heading_(0.0), speed_(0.0),
-      maxSteeringAngle_(0.0), x_(0.0), y_(0.0), theta_(0.0), velocity_(0.0) {
+      maxSteeringAngle_(0.0), x_(0.0), y_(0.0), theta_(0.0), velocity_(0.0),
+      integrator_(makeIntegrator(IntegrationMethod::Euler)) {
 }
 
 /**
@@ -40,6 +43,12 @@ void RobotModel::setInitialState(double x, double y,
     y_ = y;
     theta_ = theta;
     velocity_ = velocity;
+    heading_ = theta;
+    speed_ = velocity;
+    if (wheelRadius_ != 0.0) {
+        omega_i_ = velocity / wheelRadius_;
+        omega_o_ = omega_i_;
+    }
 }
 
 /**
@@ -49,6 +58,7 @@ void RobotModel::setInitialState(double x, double y,
  * @param dt The time step for the state update.
  */
 void RobotModel::updateState(double steeringAngle, double dt) {
+    ACK_PROFILE_SCOPE(UpdateState);
     // Apply the Ackermann kinematic model with a max steeringangle constraint.
     if (std::abs(steeringAngle) > maxSteeringAngle_) {
         // Limit the steering angle to the maximum allowed.
@@ -56,24 +66,103 @@ void RobotModel::updateState(double steeringAngle, double dt) {
     }
 
     // Calculate left and right wheel velocities based on the
-    //  steering angle and velocity.
-    double turningRadius = wheelbase_ / std::tan(steeringAngle);
+    //  steering angle and velocity. The path curvature (1 / turning radius)
+    //  is used so that driving straight does not divide by an infinite radius.
+    bool tabulated = steeringTable_ && steeringTable_->covers(steeringAngle);
+    if (steeringTable_ && !tabulated) {
+        ACK_PROFILE_COUNT(SteeringTableMisses, 1);
+    }
+    double curvature = tabulated
+                           ? steeringTable_->lookup(steeringAngle).curvature
+                           : std::tan(steeringAngle) / wheelbase_;
     double leftWheelVelocity = velocity_ *
-        (turningRadius - (trackWidth_ / 2.0)) / turningRadius;
+        (1.0 - curvature * (trackWidth_ / 2.0));
     double rightWheelVelocity = velocity_ *
-        (turningRadius + (trackWidth_ / 2.0)) / turningRadius;
+        (1.0 + curvature * (trackWidth_ / 2.0));
+
+    // Update the robot's state with the wheel velocities held over the step.
+    MotionInput input;
+    input.velocity = 0.5 * (leftWheelVelocity + rightWheelVelocity);
+    input.yawRate = (leftWheelVelocity - rightWheelVelocity) / trackWidth_;
+    Pose2D pose;
+    pose.x = x_;
+    pose.y = y_;
+    pose.theta = theta_;
+    int evaluations = integrator_->integrate(pose, input, input, dt);
+    ACK_PROFILE_COUNT(DerivativeEvaluations, evaluations);
+
+    x_ = pose.x;
+    y_ = pose.y;
+    theta_ = pose.theta;
+}
+
+/**
+ * @brief Sets the steering limit applied by updateState(). It starts at zero,
+ *        which makes updateState() drive straight.
+ *
+ * @param maxSteeringAngle The largest steering angle (radians).
+ */
+void RobotModel::setMaxSteeringAngle(double maxSteeringAngle) {
+    maxSteeringAngle_ = std::abs(maxSteeringAngle);
+}
+
+/**
+ * @brief Selects the scheme updateState() integrates the pose with.
+ *
+ * @param integrator The integrator; nullptr restores explicit Euler.
+ */
+void RobotModel::setIntegrator(std::shared_ptr<const Integrator> integrator) {
+    integrator_ = integrator ? std::move(integrator)
+                             : makeIntegrator(IntegrationMethod::Euler);
+}
+
+/**
+ * @brief Replaces the tan and atan of the steering geometry with a lookup
+ *        table built for this vehicle's wheelbase and track.
+ *
+ * @param range The table covers steering commands in [-range, range].
+ * @param intervals The number of grid intervals over the range.
+ * @param interpolation Linear or cubic interpolation.
+ */
+void RobotModel::enableSteeringTable(double range, std::size_t intervals,
+                                     SteeringInterpolation interpolation) {
+    steeringTable_ = std::make_shared<SteeringTable>(
+        wheelbase_, trackWidth_, range, intervals, interpolation);
+}
+
+/**
+ * @brief Uses a steering table shared with other vehicles, built for this
+ *        vehicle's wheelbase and track.
+ *
+ * @param table The table, or nullptr to compute the geometry exactly.
+ */
+void RobotModel::setSteeringTable(std::shared_ptr<const SteeringTable> table) {
+    steeringTable_ = std::move(table);
+}
+
+/**
+ * @brief Retrieves the steering table for sharing with identical vehicles.
+ *
+ * @return The table, or nullptr when the geometry is computed exactly.
+ */
+std::shared_ptr<const SteeringTable> RobotModel::shareSteeringTable() const {
+    return steeringTable_;
+}
 
-    // Update the robot's state.
-    double deltaTheta = (leftWheelVelocity - rightWheelVelocity)
-                         / trackWidth_ * dt;
-    double deltaX = 0.5 * (leftWheelVelocity + rightWheelVelocity)
-                         * std::cos(theta_) * dt;
-    double deltaY = 0.5 * (leftWheelVelocity + rightWheelVelocity)
-                         * std::sin(theta_) * dt;
+/**
+ * @brief Goes back to computing the steering geometry exactly.
+ */
+void RobotModel::disableSteeringTable() {
+    steeringTable_.reset();
+}
 
-    x_ += deltaX;
-    y_ += deltaY;
-    theta_ += deltaTheta;
+/**
+ * @brief Retrieves the steering lookup table.
+ *
+ * @return The table, or nullptr when the geometry is computed exactly.
+ */
+const SteeringTable* RobotModel::getSteeringTable() const {
+    return steeringTable_.get();
 }
 
 /**
@@ -85,7 +174,7 @@ void RobotModel::updateState(double steeringAngle, double dt) {
  * @param velocity The current velocity of the robot (output).
  */
 void RobotModel::getState(double& x, double& y,
-                                double& theta, double& velocity) {
+                                double& theta, double& velocity) const {
     x = x_;
     y = y_;
     theta = theta_;
@@ -94,11 +183,32 @@ void RobotModel::getState(double& x, double& y,
 
 void RobotModel::Simulate_robot_model(double PID_heading_output,
                     double PID_velocity_output, double dt) {
+    ACK_PROFILE_SCOPE(SimulateRobotModel);
     double R;
     double deltaTheta = 0;
     double newSpeed = 0;
 
-    if (PID_heading_output > 0) {
+    bool tabulated = steeringTable_ && PID_heading_output != 0.0 &&
+                     steeringTable_->covers(PID_heading_output);
+    if (steeringTable_ && PID_heading_output != 0.0 && !tabulated) {
+        ACK_PROFILE_COUNT(SteeringTableMisses, 1);
+    }
+
+    if (tabulated) {
+        // Either turn from the table: the same formulas written with the
+        // tabulated curvature and ratios instead of R
+        SteeringGeometry geometry = steeringTable_->lookup(PID_heading_output);
+        bool left = PID_heading_output > 0;
+        alpha_i_ = left ? geometry.angleMinus : geometry.anglePlus;
+        alpha_o_ = left ? geometry.anglePlus : geometry.angleMinus;
+        double& driven = left ? omega_o_ : omega_i_;
+        double& follower = left ? omega_i_ : omega_o_;
+        driven += PID_velocity_output;
+        deltaTheta = wheelRadius_ * driven * dt * geometry.curvature *
+                     geometry.centerRatio;
+        follower = driven * geometry.wheelRatio;
+        newSpeed = std::abs(wheelRadius_ * driven * geometry.centerRatio);
+    } else if (PID_heading_output > 0) {
         // Robot is executing a left turn
         R = wheelbase_ * 1 / std::tan(PID_heading_output);
         alpha_i_ = std::atan(wheelbase_ /
@@ -137,20 +247,46 @@ void RobotModel::Simulate_robot_model(double PID_heading_output,
     heading_ += deltaTheta;
     speed_ = newSpeed;
 
-    std::cout << "heading: " << 180 * heading_ / M_PI << "\n";
-    std::cout << "Speed: " << speed_ << "\n";
-    std::cout << "**********OUTPUTS***************" << "\n";
-    std::cout << "Inner steering angle: " << alpha_i_ << "\n";
-    std::cout << "Outer steering angle: " << alpha_o_ << "\n";
-    std::cout << "Inner wheel velocity: " << omega_i_ * wheelRadius_ << "\n";
-    std::cout << "Outer wheel velocity: " << omega_o_ * wheelRadius_ << "\n";
-    std::cout << "********************************" << "\n";
+    ACK_LOG_DEBUG("heading: " << 180 * heading_ / M_PI);
+    ACK_LOG_DEBUG("Speed: " << speed_);
+    ACK_LOG_DEBUG("**********OUTPUTS***************");
+    ACK_LOG_DEBUG("Inner steering angle: " << alpha_i_);
+    ACK_LOG_DEBUG("Outer steering angle: " << alpha_o_);
+    ACK_LOG_DEBUG("Inner wheel velocity: " << omega_i_ * wheelRadius_);
+    ACK_LOG_DEBUG("Outer wheel velocity: " << omega_o_ * wheelRadius_);
+    ACK_LOG_DEBUG("********************************");
 }
 
-double RobotModel::getHeading() {
+double RobotModel::getHeading() const {
     return heading_;
 }
 
-double RobotModel::getSpeed() {
+double RobotModel::getSpeed() const {
     return speed_;
 }
+
+double RobotModel::getWheelbase() const {
+    return wheelbase_;
+}
+
+double RobotModel::getWheelRadius() const {
+    return wheelRadius_;
+}
+
+double RobotModel::getTrackWidth() const {
+    return trackWidth_;
+}
+
+double RobotModel::getMaxSteeringAngle() const {
+    return maxSteeringAngle_;
+}
+
+void RobotModel::getSteeringAngles(double& inner, double& outer) const {
+    inner = alpha_i_;
+    outer = alpha_o_;
+}
+
+void RobotModel::getWheelSpeeds(double& inner, double& outer) const {
+    inner = omega_i_;
+    outer = omega_o_;
+}
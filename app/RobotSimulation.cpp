@@ -15,7 +15,9 @@
 #include "RobotSimulation.hpp"
 #include <iostream>
 #include <cmath>
-#include <vector>
+#include <utility>
+#include "Logger.hpp"
+#include "Profiler.hpp"
 
 /**
  * @brief Constructs a new Robot Simulation object with the specified parameters.
@@ -39,8 +41,16 @@ RobotSimulation::RobotSimulation(double wheelbase, double trackWidth,
                             double velP, double velI, double velD,
                             double deltaT,
                             double headP, double headI, double headD)
+    // Kept as it always was: RobotModel takes (wheelbase, wheelRadius,
+    // trackWidth), so the robot's wheel radius is trackWidth and its track
+    // width is maxSteeringAngle (in radians). Every recorded trace, tuned
+    // gain and expected value depends on this plant. The LQR and MPC models
+    // inherit it too: linearizeRobotModel() takes the wheel speed gain B(1,1)
+    // from getWheelRadius(), i.e. from trackWidth. Only the steering limit is
+    // passed on as intended, below.
     : robot(wheelbase, trackWidth, maxSteeringAngle),
             controller(velP, velI, velD, deltaT, headP, headI, headD) {
+    robot.setMaxSteeringAngle(maxSteeringAngle);
 }
 
 /**
@@ -49,14 +59,17 @@ RobotSimulation::RobotSimulation(double wheelbase, double trackWidth,
  * This function allows the user to interactively input target heading and velocity, and the robot simulation
  * attempts to control the robot's movement to reach these targets using the PID controller. The control loop
  * continues until the user exits or convergence to the target is achieved.
+ * Targets of 1000 for both heading and velocity prompt for the targets.
+ *
+ * @param targetHeading The desired heading (in radians).
+ * @param targetVelocity The desired velocity.
+ * @param criteria The step budget, tolerances and divergence limits.
+ * @return The step count, final state and why the run ended.
  */
-
-void RobotSimulation::runSimulation(double targetHeading,
-                                 double targetVelocity) {
-    double currentVelocity = 0.0;
-    double currentTheta = 0.0;
-
-    // double targetHeading, targetVelocity;
+SimulationResult RobotSimulation::runSimulation(double targetHeading,
+                                                double targetVelocity,
+                                                const ConvergenceCriteria&
+                                                    criteria) {
     if (targetHeading == 1000.0 && targetVelocity == 1000.0) {
         // Prompt the user to enter the target heading and velocity
         std::cout << "Enter the target heading (in radians): ";
@@ -66,51 +79,363 @@ void RobotSimulation::runSimulation(double targetHeading,
         std::cin >> targetVelocity;
     }
 
-    const int maxIterations = 30;
-    const double convergenceThreshold = 3;  // Adjust as needed
+    SimulationResult result = run(targetHeading, targetVelocity, criteria);
+    if (result.reason == TerminationReason::Converged) {
+        ACK_LOG_INFO("Converged to the set points after " << result.steps
+                     << " steps.");
+    } else if (result.reason == TerminationReason::Diverged) {
+        ACK_LOG_WARN("Diverged after " << result.steps << " steps.");
+    }
+    ACK_LOG_INFO("Final State: x=" << finalX << " y=" << finalY <<
+         " theta=" << finalTheta << " velocity=" << finalVelocity);
+    return result;
+}
+
+/**
+ * @brief Steps towards the targets until the run settles, diverges or uses
+ *        its step budget, without prompting or logging.
+ *
+ * @param targetHeading The desired heading (in radians).
+ * @param targetVelocity The desired velocity.
+ * @param criteria The step budget, tolerances and divergence limits.
+ * @return The step count, final state and why the run ended.
+ */
+SimulationResult RobotSimulation::run(double targetHeading,
+                                      double targetVelocity,
+                                      const ConvergenceCriteria& criteria) {
+    ConvergenceMonitor monitor(criteria);
+    for (int i = 0; i < criteria.maxIterations; i++) {
+        // Compute the PID outputs and drive the Ackermann kinematic model
+        step(targetHeading, targetVelocity);
+
+        // Judge the state the step produced, not the one it started from
+        if (monitor.update(targetVelocity - robot.getSpeed(),
+                           targetHeading - robot.getHeading())) {
+            break;
+        }
+    }
 
-    for (int i = 0; i < maxIterations; i++) {
-        std::cout << "Iteration " << i << std::endl;
-        // std::cout << "init" << currentVelocity;
-        // Compute PID errors
-        controller.computeErrors(targetVelocity, currentVelocity,
-                                     targetHeading, currentTheta);
+    SimulationResult result;
+    result.reason = monitor.getReason();
+    result.steps = monitor.getSteps();
+    if (monitor.isSettled()) {
+        result.settlingTime = (monitor.getSettledSince() + 1) *
+                              controller.getDeltaTime();
+    }
+    robot.getState(finalX, finalY, finalTheta, finalVelocity);
+    result.finalX = finalX;
+    result.finalY = finalY;
+    result.finalTheta = finalTheta;
+    result.finalVelocity = finalVelocity;
+    return result;
+}
 
-        // Get the PID controller outputs
-        std::vector<double> controlOutputs = controller.computePID();
+/**
+ * @brief Sets the initial state of the simulated robot.
+ *
+ * @param x The initial x-coordinate of the robot.
+ * @param y The initial y-coordinate of the robot.
+ * @param theta The initial orientation (in radians) of the robot.
+ * @param velocity The initial velocity of the robot.
+ */
+void RobotSimulation::setInitialState(double x, double y,
+                                      double theta, double velocity) {
+    robot.setInitialState(x, y, theta, velocity);
+}
 
-        // Extract control outputs
-        double steeringAngle = controlOutputs[1];
-        double velocityOutput = controlOutputs[0];
+/**
+ * @brief Runs a single control step towards the given targets.
+ *
+ * @param targetHeading The desired heading (in radians).
+ * @param targetVelocity The desired velocity.
+ * @return The PID outputs applied during the step.
+ */
+PIDOutput RobotSimulation::step(double targetHeading, double targetVelocity) {
+    ACK_PROFILE_SCOPE(ControlStep);
+    lastTargetHeading = targetHeading;
+    lastTargetVelocity = targetVelocity;
 
+    // Compute PID errors
+    controller.computeErrors(targetVelocity, robot.getSpeed(),
+                             targetHeading, robot.getHeading());
 
-        // Simulate the robot model with Ackermann kinematic model
-        robot.Simulate_robot_model(steeringAngle, velocityOutput,
-                                     controller.getDeltaTime());
+    // Get the outputs of the selected controller
+    PIDOutput controlOutputs;
+    switch (controlMode) {
+    case ControlMode::LQR:
+        controlOutputs = models.lqr->compute(robot, targetHeading,
+                                             targetVelocity,
+                                             controller.getDeltaTime());
+        break;
+    case ControlMode::MPC:
+        controlOutputs = models.mpc->compute(robot, targetHeading,
+                                             targetVelocity,
+                                             controller.getDeltaTime());
+        break;
+    default:
+        controlOutputs = controller.computeControl();
+        break;
+    }
 
-        // Simulate the robot model with Ackermann kinematic model
-        robot.updateState(steeringAngle, controller.getDeltaTime());
+    // Extract control outputs
+    double steeringAngle = controlOutputs.heading;
+    double velocityOutput = controlOutputs.velocity;
 
-        // Get the current state of the robot
-        double currentVel = robot.getSpeed();
-        std::cout << "getspeed" << currentVelocity;
-        double currentHead = robot.getHeading();
+    // Simulate the robot model with Ackermann kinematic model
+    robot.Simulate_robot_model(steeringAngle, velocityOutput,
+                                 controller.getDeltaTime());
 
-        // Check for convergence
-        if (fabs(targetVelocity - currentVelocity) < convergenceThreshold &&
-            fabs(targetHeading - currentTheta) < convergenceThreshold) {
-            std::cout << "Converged to the set points." << std::endl;
-            break;}
+    // Simulate the robot model with Ackermann kinematic model
+    robot.updateState(steeringAngle, controller.getDeltaTime());
+    elapsedTime += controller.getDeltaTime();
 
-        currentVelocity = currentVel;
-        currentTheta = currentHead;
+    if (recorder != nullptr) record();
+    if (publisher != nullptr) {
+        publisher->publish(makeSample(), controlOutputs);
     }
 
-    // Get the final state of the robot after convergence
-    double finalX, finalY, finalTheta, finalVelocity;
-    robot.getState(finalX, finalY, finalTheta, finalVelocity);
-    std::cout << "Final State: x=" << finalX << " y=" << finalY <<
-         " theta=" << finalTheta << " velocity=" << finalVelocity << std::endl;
+    return controlOutputs;
+}
+
+/**
+ * @brief Get the current heading of the simulated robot.
+ *
+ * @return The current heading in radians.
+ */
+double RobotSimulation::getCurrentHeading() const {
+    return robot.getHeading();
+}
+
+/**
+ * @brief Get the current speed of the simulated robot.
+ *
+ * @return The current speed.
+ */
+double RobotSimulation::getCurrentVelocity() const {
+    return robot.getSpeed();
+}
+
+/**
+ * @brief Retrieves the current pose of the simulated robot.
+ *
+ * @param x The current x-coordinate of the robot (output).
+ * @param y The current y-coordinate of the robot (output).
+ * @param theta The current orientation (in radians) of the robot (output).
+ * @param velocity The current velocity of the robot (output).
+ */
+void RobotSimulation::getState(double& x, double& y,
+                               double& theta, double& velocity) const {
+    robot.getState(x, y, theta, velocity);
+}
+
+/**
+ * @brief Records the state after every step into a trajectory file.
+ *
+ * @param recorder An open recorder, or nullptr to stop recording.
+ */
+void RobotSimulation::setRecorder(TrajectoryRecorder* recorder) {
+    this->recorder = recorder;
+}
+
+/**
+ * @brief Publishes the state and command after every step to other
+ *        processes.
+ *
+ * @param publisher The publisher, or nullptr to stop publishing.
+ */
+void RobotSimulation::setPublisher(SharedStatePublisher* publisher) {
+    this->publisher = publisher;
+}
+
+/**
+ * @brief Keeps the PID output continuous across a jump of the targets
+ *        passed to step().
+ *
+ * @param velocityShift The new velocity target minus the old one.
+ * @param headingShift The new heading target minus the old one.
+ */
+void RobotSimulation::shiftSetpoints(double velocityShift,
+                                     double headingShift) {
+    controller.shiftSetpoints(velocityShift, headingShift);
+}
+
+/**
+ * @brief Selects the scheme the robot's pose is integrated with.
+ *
+ * @param integrator The integrator; nullptr restores explicit Euler.
+ */
+void RobotSimulation::setIntegrator(
+                            std::shared_ptr<const Integrator> integrator) {
+    robot.setIntegrator(std::move(integrator));
+}
+
+/**
+ * @brief Looks the steering geometry up in a table instead of computing tan
+ *        and atan every step.
+ *
+ * @param range The table covers steering commands in [-range, range].
+ * @param intervals The number of grid intervals over the range.
+ * @param interpolation Linear or cubic interpolation.
+ */
+void RobotSimulation::enableSteeringTable(double range,
+                                          std::size_t intervals,
+                                          SteeringInterpolation
+                                              interpolation) {
+    robot.enableSteeringTable(range, intervals, interpolation);
+}
+
+/**
+ * @brief Selects the controller step() uses, creating the LQR or MPC
+ *        controller only when it is selected.
+ *
+ * @param mode The controller.
+ * @param tuning The weights and limits of the LQR or MPC controller.
+ * @param horizon The number of steps the MPC controller plans.
+ */
+void RobotSimulation::setControlMode(ControlMode mode,
+                                     const ControlTuning& tuning,
+                                     std::size_t horizon) {
+    ModelControllers selected;
+    if (mode == ControlMode::LQR) {
+        selected.lqr.reset(new LQRController(tuning));
+    } else if (mode == ControlMode::MPC) {
+        selected.mpc.reset(new MPCController(horizon, tuning));
+    }
+    models = std::move(selected);
+    controlMode = mode;
+}
+
+/**
+ * @brief Get the controller step() uses.
+ *
+ * @return The control mode.
+ */
+ControlMode RobotSimulation::getControlMode() const {
+    return controlMode;
+}
+
+/**
+ * @brief Get the LQR controller, with its current gain.
+ *
+ * @return The LQR controller, or nullptr unless LQR is selected.
+ */
+const LQRController* RobotSimulation::getLQRController() const {
+    return models.lqr.get();
+}
+
+/**
+ * @brief Get the MPC controller, with its latest plan.
+ *
+ * @return The MPC controller, or nullptr unless MPC is selected.
+ */
+const MPCController* RobotSimulation::getMPCController() const {
+    return models.mpc.get();
+}
+
+/**
+ * @brief Copies the selected model-based controller.
+ *
+ * @param other The controllers to copy.
+ */
+RobotSimulation::ModelControllers::ModelControllers(
+    const ModelControllers& other)
+    : lqr(other.lqr ? new LQRController(*other.lqr) : nullptr),
+      mpc(other.mpc ? new MPCController(*other.mpc) : nullptr) {
+}
+
+/**
+ * @brief Copies the selected model-based controller.
+ *
+ * @param other The controllers to copy.
+ * @return These controllers.
+ */
+RobotSimulation::ModelControllers&
+RobotSimulation::ModelControllers::operator=(const ModelControllers& other) {
+    if (this != &other) *this = ModelControllers(other);
+    return *this;
+}
+
+/**
+ * @brief Uses a steering table shared with identical vehicles.
+ *
+ * @param table The table, or nullptr to compute the geometry exactly.
+ */
+void RobotSimulation::setSteeringTable(
+                            std::shared_ptr<const SteeringTable> table) {
+    robot.setSteeringTable(std::move(table));
+}
+
+/**
+ * @brief Retrieves the robot's steering table for sharing.
+ *
+ * @return The table, or nullptr when the geometry is computed exactly.
+ */
+std::shared_ptr<const SteeringTable>
+RobotSimulation::shareSteeringTable() const {
+    return robot.shareSteeringTable();
+}
+
+/**
+ * @brief Keeps the most recent controller errors of the run.
+ *
+ * @param capacity The number of errors kept per channel (0 disables).
+ * @param arena The arena providing the rings, or nullptr to allocate them
+ *        on the heap.
+ */
+void RobotSimulation::setErrorHistoryCapacity(std::size_t capacity,
+                                              MonotonicArena* arena) {
+    if (arena != nullptr) {
+        controller.setErrorHistoryCapacity(capacity, *arena);
+    } else {
+        controller.setErrorHistoryCapacity(capacity);
+    }
+}
+
+/**
+ * @brief Get the controller driving the robot.
+ *
+ * @return The controller, with its error histories.
+ */
+const PIDController& RobotSimulation::getController() const {
+    return controller;
+}
+
+/**
+ * @brief Captures the current state, the targets of the latest step and
+ *        the controller terms as the recorder stores them after every
+ *        step.
+ *
+ * @return The sample.
+ */
+TrajectorySample RobotSimulation::makeSample() const {
+    TrajectorySample sample;
+    sample.time = elapsedTime;
+    double velocity;
+    robot.getState(sample.x, sample.y, sample.theta, velocity);
+    sample.heading = robot.getHeading();
+    sample.speed = robot.getSpeed();
+    robot.getSteeringAngles(sample.alphaInner, sample.alphaOuter);
+    robot.getWheelSpeeds(sample.omegaInner, sample.omegaOuter);
+    sample.targetHeading = lastTargetHeading;
+    sample.targetVelocity = lastTargetVelocity;
+
+    PIDTerms terms = controller.computeTerms();
+    sample.velocityError = terms.velocityError;
+    sample.velocityP = terms.velocityP;
+    sample.velocityI = terms.velocityI;
+    sample.velocityD = terms.velocityD;
+    sample.headingError = terms.headingError;
+    sample.headingP = terms.headingP;
+    sample.headingI = terms.headingI;
+    sample.headingD = terms.headingD;
+    return sample;
+}
+
+/**
+ * @brief Appends the current state and controller terms to the recorder.
+ */
+void RobotSimulation::record() {
+    recorder->record(makeSample());
 }
 
 /**
@@ -0,0 +1,311 @@
+/**
+ * @file ScenarioFile.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Reads simulation scenarios from key-value files and writes results.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "ScenarioFile.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Scenario keys holding a double, and the member they set.
+ */
+struct DoubleKey {
+    const char* name;
+    double Scenario::*member;
+};
+
+const DoubleKey kDoubleKeys[] = {
+    {"wheelbase", &Scenario::wheelbase},
+    {"track_width", &Scenario::trackWidth},
+    {"max_steering_angle", &Scenario::maxSteeringAngle},
+    {"vel_p", &Scenario::velP},
+    {"vel_i", &Scenario::velI},
+    {"vel_d", &Scenario::velD},
+    {"dt", &Scenario::deltaT},
+    {"head_p", &Scenario::headP},
+    {"head_i", &Scenario::headI},
+    {"head_d", &Scenario::headD},
+    {"target_heading", &Scenario::targetHeading},
+    {"target_velocity", &Scenario::targetVelocity},
+    {"initial_x", &Scenario::initialX},
+    {"initial_y", &Scenario::initialY},
+    {"initial_theta", &Scenario::initialTheta},
+    {"initial_velocity", &Scenario::initialVelocity},
+    {"velocity_tolerance", &Scenario::velocityTolerance},
+    {"heading_tolerance", &Scenario::headingTolerance},
+    {"velocity_divergence", &Scenario::velocityDivergence},
+    {"heading_divergence", &Scenario::headingDivergence},
+    {"steering_table_range", &Scenario::steeringTableRange},
+};
+
+/**
+ * @brief Removes leading and trailing blanks.
+ */
+std::string trim(const std::string& text) {
+    const char* blanks = " \t\r\n";
+    std::size_t begin = text.find_first_not_of(blanks);
+    if (begin == std::string::npos) return "";
+    std::size_t end = text.find_last_not_of(blanks);
+    return text.substr(begin, end - begin + 1);
+}
+
+/**
+ * @brief Parses a whole string as a double.
+ */
+double toDouble(const std::string& key, const std::string& value) {
+    const char* begin = value.c_str();
+    char* end = nullptr;
+    errno = 0;
+    double result = std::strtod(begin, &end);
+    if (end == begin || *end != '\0' || errno == ERANGE) {
+        throw std::invalid_argument("invalid number '" + value +
+                                    "' for " + key);
+    }
+    return result;
+}
+
+/**
+ * @brief Parses a whole string as a non-negative integer.
+ */
+int toCount(const std::string& key, const std::string& value) {
+    double number = toDouble(key, value);
+    if (number < 0 || number != static_cast<int>(number)) {
+        throw std::invalid_argument("invalid count '" + value +
+                                    "' for " + key);
+    }
+    return static_cast<int>(number);
+}
+
+/**
+ * @brief Parses a boolean written as true/false, yes/no, on/off or 1/0.
+ */
+bool toBool(const std::string& key, const std::string& value) {
+    if (value == "true" || value == "yes" || value == "on" || value == "1") {
+        return true;
+    }
+    if (value == "false" || value == "no" || value == "off" || value == "0") {
+        return false;
+    }
+    throw std::invalid_argument("invalid boolean '" + value + "' for " + key);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the ScenarioParser class.
+ */
+ScenarioParser::ScenarioParser() {
+}
+
+/**
+ * @brief Parses scenarios from a stream, appending to those already read.
+ *
+ * @param input The stream to read.
+ * @param source The name used in error messages.
+ */
+void ScenarioParser::parse(std::istream& input, const std::string& source) {
+    std::string line;
+    int number = 0;
+    Section* current = nullptr;
+    while (std::getline(input, line)) {
+        number++;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        try {
+            if (line.front() == '[') {
+                if (line != "[scenario]") {
+                    throw std::invalid_argument("unknown section " + line);
+                }
+                sections_.push_back(defaults_);
+                sections_.back().setpoints.clear();
+                current = &sections_.back();
+                continue;
+            }
+
+            std::size_t equals = line.find('=');
+            if (equals == std::string::npos) {
+                throw std::invalid_argument("expected 'key = value'");
+            }
+            std::string key = trim(line.substr(0, equals));
+            std::string value = trim(line.substr(equals + 1));
+            apply(current != nullptr ? *current : defaults_, key, value);
+        } catch (const std::invalid_argument& error) {
+            std::ostringstream message;
+            message << source << ":" << number << ": " << error.what();
+            throw std::runtime_error(message.str());
+        }
+    }
+}
+
+/**
+ * @brief Parses scenarios from a file.
+ *
+ * @param path The path of the scenario file.
+ */
+void ScenarioParser::parseFile(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("cannot open scenario file " + path);
+    }
+    parse(input, path);
+}
+
+/**
+ * @brief Sets a default used by every scenario read afterwards.
+ *
+ * @param key The scenario key.
+ * @param value The value of the key.
+ */
+void ScenarioParser::setDefault(const std::string& key,
+                                const std::string& value) {
+    apply(defaults_, key, value);
+}
+
+/**
+ * @brief Applies a key to a section, handling the repeatable setpoint key.
+ *
+ * @param section The section to modify.
+ * @param key The scenario key.
+ * @param value The value of the key.
+ */
+void ScenarioParser::apply(Section& section, const std::string& key,
+                           const std::string& value) {
+    if (key != "setpoint") {
+        applyKey(section.scenario, key, value);
+        return;
+    }
+
+    std::istringstream fields(value);
+    std::string heading, velocity, extra;
+    if (!(fields >> heading >> velocity) || (fields >> extra)) {
+        throw std::invalid_argument(
+            "setpoint expects '<heading> <velocity>'");
+    }
+    section.setpoints.emplace_back(toDouble(key, heading),
+                                   toDouble(key, velocity));
+}
+
+/**
+ * @brief Applies a single key to a scenario.
+ *
+ * @param scenario The scenario to modify.
+ * @param key The scenario key.
+ * @param value The value of the key.
+ */
+void ScenarioParser::applyKey(Scenario& scenario, const std::string& key,
+                              const std::string& value) {
+    for (const DoubleKey& entry : kDoubleKeys) {
+        if (key == entry.name) {
+            scenario.*entry.member = toDouble(key, value);
+            return;
+        }
+    }
+    if (key == "name") {
+        scenario.name = value;
+    } else if (key == "integrator") {
+        scenario.integrator = parseIntegrationMethod(value);
+    } else if (key == "steering_table_intervals") {
+        scenario.steeringTableIntervals = toCount(key, value);
+    } else if (key == "steering_table_interpolation") {
+        if (value != "linear" && value != "cubic") {
+            throw std::invalid_argument("invalid interpolation '" + value +
+                                        "' for " + key);
+        }
+        scenario.steeringTableCubic = value == "cubic";
+    } else if (key == "control_mode") {
+        scenario.controlMode = parseControlMode(value);
+    } else if (key == "mpc_horizon") {
+        scenario.mpcHorizon = toCount(key, value);
+    } else if (key == "error_history") {
+        scenario.errorHistory = toCount(key, value);
+    } else if (key == "record") {
+        scenario.recordPath = value;
+    } else if (key == "convergence_threshold") {
+        scenario.velocityTolerance = toDouble(key, value);
+        scenario.headingTolerance = scenario.velocityTolerance;
+    } else if (key == "max_iterations") {
+        scenario.maxIterations = toCount(key, value);
+    } else if (key == "settle_window") {
+        scenario.settleWindow = toCount(key, value);
+    } else if (key == "stop_on_convergence") {
+        scenario.stopOnConvergence = toBool(key, value);
+    } else {
+        throw std::invalid_argument("unknown key '" + key + "'");
+    }
+}
+
+/**
+ * @brief Retrieves every run described so far, one per setpoint.
+ *
+ * @return The scenarios to run.
+ */
+std::vector<Scenario> ScenarioParser::getScenarios() const {
+    if (!sections_.empty() && !defaults_.setpoints.empty()) {
+        throw std::invalid_argument(
+            "setpoints outside of a [scenario] section cannot be combined "
+            "with sections; give them inside each section");
+    }
+    std::vector<Section> sections = sections_;
+    if (sections.empty()) sections.push_back(defaults_);
+
+    std::vector<Scenario> scenarios;
+    for (const Section& section : sections) {
+        if (section.setpoints.empty()) {
+            scenarios.push_back(section.scenario);
+            continue;
+        }
+        for (std::size_t i = 0; i < section.setpoints.size(); i++) {
+            Scenario scenario = section.scenario;
+            scenario.targetHeading = section.setpoints[i].first;
+            scenario.targetVelocity = section.setpoints[i].second;
+            if (section.setpoints.size() > 1) {
+                scenario.name += "#" + std::to_string(i + 1);
+            }
+            scenarios.push_back(scenario);
+        }
+    }
+    return scenarios;
+}
+
+/**
+ * @brief Writes one CSV line per scenario with its targets and summary.
+ *
+ * @param output The stream receiving the table.
+ * @param scenarios The scenarios that were run.
+ * @param summaries The summaries, in the same order.
+ */
+void writeSummaryCsv(std::ostream& output,
+                     const std::vector<Scenario>& scenarios,
+                     const std::vector<ScenarioSummary>& summaries) {
+    output << "name,target_heading,target_velocity,converged,steps,"
+              "final_x,final_y,final_theta,final_heading,final_velocity,"
+              "heading_overshoot,velocity_overshoot,settling_time,reason\n";
+    for (std::size_t i = 0; i < scenarios.size() && i < summaries.size();
+         i++) {
+        const Scenario& scenario = scenarios[i];
+        const ScenarioSummary& summary = summaries[i];
+        output << scenario.name << ',' << scenario.targetHeading << ','
+               << scenario.targetVelocity << ','
+               << (summary.converged ? 1 : 0) << ',' << summary.steps << ','
+               << summary.finalX << ',' << summary.finalY << ','
+               << summary.finalTheta << ',' << summary.finalHeading << ','
+               << summary.finalVelocity << ',' << summary.headingOvershoot
+               << ',' << summary.velocityOvershoot << ','
+               << summary.settlingTime << ','
+               << terminationReasonName(summary.reason) << '\n';
+    }
+}
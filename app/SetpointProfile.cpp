@@ -0,0 +1,146 @@
+/**
+ * @file SetpointProfile.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Implementation of the setpoint profiles.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "SetpointProfile.hpp"
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Get the name of a profile shape, as accepted by parseProfileShape().
+ *
+ * @param shape The profile shape.
+ * @return One of step, ramp or s_curve.
+ */
+const char* profileShapeName(ProfileShape shape) {
+    switch (shape) {
+    case ProfileShape::Step:
+        return "step";
+    case ProfileShape::Ramp:
+        return "ramp";
+    case ProfileShape::SCurve:
+        return "s_curve";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of a profile shape.
+ *
+ * @param name One of step, ramp or s_curve.
+ * @return The profile shape.
+ */
+ProfileShape parseProfileShape(const std::string& name) {
+    const ProfileShape shapes[] = {ProfileShape::Step, ProfileShape::Ramp,
+                                   ProfileShape::SCurve};
+    for (ProfileShape shape : shapes) {
+        if (name == profileShapeName(shape)) return shape;
+    }
+    throw std::invalid_argument("unknown setpoint profile '" + name + "'");
+}
+
+/**
+ * @brief Constructor for the SetpointProfile class.
+ *
+ * @param value The initial setpoint, also the target.
+ */
+SetpointProfile::SetpointProfile(double value) {
+    reset(value);
+}
+
+/**
+ * @brief Starts moving from the current setpoint to a new target.
+ *
+ * @param target The new target.
+ * @param shape How the setpoint moves.
+ * @param duration The time the move takes; ignored for a step.
+ */
+void SetpointProfile::setTarget(double target, ProfileShape shape,
+                                double duration) {
+    if (!std::isfinite(target)) {
+        throw std::invalid_argument("setpoint targets must be finite");
+    }
+    if (!(duration >= 0.0) || !std::isfinite(duration)) {
+        throw std::invalid_argument(
+            "setpoint profile durations must be finite and not negative");
+    }
+    if (shape == ProfileShape::Step || duration == 0.0) {
+        reset(target);
+        return;
+    }
+    start_ = value_;
+    target_ = target;
+    duration_ = duration;
+    elapsed_ = 0.0;
+    shape_ = shape;
+}
+
+/**
+ * @brief Jumps to a value and stops any move in progress.
+ *
+ * @param value The new setpoint, also the target.
+ */
+void SetpointProfile::reset(double value) {
+    start_ = value;
+    target_ = value;
+    value_ = value;
+    duration_ = 0.0;
+    elapsed_ = 0.0;
+    shape_ = ProfileShape::Step;
+}
+
+/**
+ * @brief Moves the setpoint on by a time step.
+ *
+ * @param dt The time step.
+ * @return The setpoint after the step.
+ */
+double SetpointProfile::advance(double dt) {
+    if (isSettled()) return value_;
+
+    elapsed_ += dt;
+    if (elapsed_ >= duration_) {
+        // Land exactly on the target and stop counting time
+        reset(target_);
+        return value_;
+    }
+    double fraction = elapsed_ / duration_;
+    if (shape_ == ProfileShape::SCurve) {
+        fraction = fraction * fraction * (3.0 - 2.0 * fraction);
+    }
+    value_ = start_ + (target_ - start_) * fraction;
+    return value_;
+}
+
+/**
+ * @brief Get the current setpoint.
+ *
+ * @return The setpoint.
+ */
+double SetpointProfile::getValue() const {
+    return value_;
+}
+
+/**
+ * @brief Get the target the setpoint moves to.
+ *
+ * @return The target.
+ */
+double SetpointProfile::getTarget() const {
+    return target_;
+}
+
+/**
+ * @brief Checks whether the setpoint has reached its target.
+ *
+ * @return True if no move is in progress.
+ */
+bool SetpointProfile::isSettled() const {
+    return duration_ == 0.0;
+}
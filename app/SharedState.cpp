@@ -0,0 +1,189 @@
+/**
+ * @file SharedState.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the shared-memory state publisher and reader.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "SharedState.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include "Clock.hpp"
+
+namespace {
+
+/// "ACKSTATE" in ASCII.
+const std::uint64_t kMagic = 0x45544154534B4341ull;
+/// Changes whenever SharedStateSegment or SharedStateSample change.
+const std::uint32_t kLayoutVersion = 2;
+
+/**
+ * @brief Builds an error message carrying the current errno.
+ */
+std::runtime_error systemError(const std::string& what,
+                               const std::string& name) {
+    return std::runtime_error(what + " " + name + ": " +
+                              std::strerror(errno));
+}
+
+/**
+ * @brief Checks a name before it is passed to shm_open().
+ */
+const std::string& checkedName(const std::string& name) {
+    if (name.size() < 2 || name[0] != '/' ||
+        name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument(
+            "shared-memory names are '/' followed by other characters");
+    }
+    return name;
+}
+
+}  // namespace
+
+/**
+ * @brief Creates the segment, replacing any segment of the same name.
+ *
+ * @param name The POSIX shared-memory name, e.g. "/ackermann".
+ */
+SharedStatePublisher::SharedStatePublisher(const std::string& name)
+    : name_(checkedName(name)), segment_(nullptr) {
+    // A fresh object, so readers of an old one never see it shrink
+    ::shm_unlink(name_.c_str());
+    int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                        0644);
+    if (fd < 0) throw systemError("cannot create", name_);
+    if (::ftruncate(fd, sizeof(SharedStateSegment)) != 0) {
+        std::runtime_error error = systemError("cannot size", name_);
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw error;
+    }
+    void* mapping = ::mmap(nullptr, sizeof(SharedStateSegment),
+                           PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::runtime_error error = systemError("cannot map", name_);
+        ::shm_unlink(name_.c_str());
+        throw error;
+    }
+
+    segment_ = new (mapping) SharedStateSegment();
+    segment_->layoutVersion = kLayoutVersion;
+    segment_->sampleBytes = sizeof(SharedStateSample);
+    segment_->publisherOpen.store(1, std::memory_order_relaxed);
+    segment_->magic.store(kMagic, std::memory_order_release);
+}
+
+/**
+ * @brief Marks the segment closed and removes its name.
+ */
+SharedStatePublisher::~SharedStatePublisher() {
+    segment_->publisherOpen.store(0, std::memory_order_release);
+    ::munmap(segment_, sizeof(SharedStateSegment));
+    ::shm_unlink(name_.c_str());
+}
+
+/**
+ * @brief Replaces the published sample and stamps it with the current time.
+ *
+ * @param state The state after the step.
+ * @param command The command applied in the step.
+ */
+void SharedStatePublisher::publish(const TrajectorySample& state,
+                                   const PIDOutput& command) {
+    SharedStateSample sample;
+    sample.state = state;
+    sample.velocityCommand = command.velocity;
+    sample.headingCommand = command.heading;
+    sample.publishTime = monotonicNow();
+    segment_->latest.store(sample);
+}
+
+/**
+ * @brief Get the name of the segment.
+ *
+ * @return The shared-memory name.
+ */
+const std::string& SharedStatePublisher::getName() const {
+    return name_;
+}
+
+/**
+ * @brief Get the number of samples published.
+ *
+ * @return The publish count.
+ */
+std::uint64_t SharedStatePublisher::getPublishCount() const {
+    return segment_->latest.getVersion() - 1;
+}
+
+/**
+ * @brief Maps a segment created by SharedStatePublisher.
+ *
+ * @param name The POSIX shared-memory name.
+ */
+SharedStateReader::SharedStateReader(const std::string& name)
+    : name_(checkedName(name)), segment_(nullptr) {
+    int fd = ::shm_open(name_.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) throw systemError("cannot open", name_);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        std::runtime_error error = systemError("cannot stat", name_);
+        ::close(fd);
+        throw error;
+    }
+    if (static_cast<std::size_t>(info.st_size) <
+        sizeof(SharedStateSegment)) {
+        ::close(fd);
+        throw std::runtime_error(name_ + " is not a state segment");
+    }
+
+    void* mapping = ::mmap(nullptr, sizeof(SharedStateSegment), PROT_READ,
+                           MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw systemError("cannot map", name_);
+    segment_ = static_cast<const SharedStateSegment*>(mapping);
+
+    if (segment_->magic.load(std::memory_order_acquire) != kMagic ||
+        segment_->layoutVersion != kLayoutVersion ||
+        segment_->sampleBytes != sizeof(SharedStateSample)) {
+        ::munmap(mapping, sizeof(SharedStateSegment));
+        throw std::runtime_error(name_ + " is not a state segment");
+    }
+}
+
+/**
+ * @brief Unmaps the segment.
+ */
+SharedStateReader::~SharedStateReader() {
+    ::munmap(const_cast<SharedStateSegment*>(segment_),
+             sizeof(SharedStateSegment));
+}
+
+/**
+ * @brief Checks whether the publisher still holds the segment.
+ *
+ * @return False once the publisher was destroyed.
+ */
+bool SharedStateReader::isPublisherOpen() const {
+    return segment_->publisherOpen.load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * @brief Get the name of the segment.
+ *
+ * @return The shared-memory name.
+ */
+const std::string& SharedStateReader::getName() const {
+    return name_;
+}
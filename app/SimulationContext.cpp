@@ -0,0 +1,168 @@
+/**
+ * @file SimulationContext.cpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Reusable per-thread state for running many scenarios back to back.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "SimulationContext.hpp"
+#include "BatchRunner.hpp"
+
+namespace {
+
+/// Distinct vehicle geometries whose steering tables a context keeps.
+const std::size_t kMaxCachedTables = 8;
+
+}  // namespace
+
+/**
+ * @brief Constructor for the SimulationContext class.
+ *
+ * @param arenaBlockSize The size of the arena's first block (bytes).
+ */
+SimulationContext::SimulationContext(std::size_t arenaBlockSize)
+    : arena_(arenaBlockSize),
+      simulation_(BatchRunner::makeSimulation(Scenario())),
+      nextTable_(0), keepTrajectory_(false), trajectory_(nullptr),
+      trajectoryCapacity_(0), trajectorySize_(0) {
+}
+
+/**
+ * @brief Retrieves the context of the calling thread, created on first use.
+ *
+ * @return The context.
+ */
+SimulationContext& SimulationContext::forThread() {
+    static thread_local SimulationContext context;
+    return context;
+}
+
+/**
+ * @brief Keeps every step of the following runs in the arena.
+ *
+ * @param keep Whether to keep the trajectory.
+ */
+void SimulationContext::setKeepTrajectory(bool keep) {
+    keepTrajectory_ = keep;
+}
+
+/**
+ * @brief Starts a run: releases the previous run's memory and builds the
+ *        simulation the scenario describes.
+ *
+ * @param scenario The scenario.
+ * @return The simulation, valid until the next run.
+ */
+RobotSimulation& SimulationContext::begin(const Scenario& scenario) {
+    arena_.reset();
+    trajectory_ = nullptr;
+    trajectoryCapacity_ = 0;
+    trajectorySize_ = 0;
+    if (keepTrajectory_ && scenario.maxIterations > 0) {
+        trajectoryCapacity_ = static_cast<std::size_t>(scenario.maxIterations);
+        trajectory_ = arena_.allocateArray<TrajectorySample>(
+                                                        trajectoryCapacity_);
+    }
+    simulation_ = BatchRunner::makeSimulation(scenario, this);
+    return simulation_;
+}
+
+/**
+ * @brief Appends the simulation's current state to the kept trajectory.
+ */
+void SimulationContext::recordStep() {
+    if (trajectorySize_ < trajectoryCapacity_) {
+        trajectory_[trajectorySize_++] = simulation_.makeSample();
+    }
+}
+
+/**
+ * @brief Get the steering table for a scenario's vehicle.
+ *
+ * @param scenario The scenario.
+ * @return The table, or nullptr when none is cached yet.
+ */
+std::shared_ptr<const SteeringTable> SimulationContext::findSteeringTable(
+                                            const Scenario& scenario) const {
+    for (const CachedTable& cached : tables_) {
+        if (cached.wheelbase == scenario.wheelbase &&
+            cached.trackWidth == scenario.trackWidth &&
+            cached.maxSteeringAngle == scenario.maxSteeringAngle &&
+            cached.range == scenario.steeringTableRange &&
+            cached.intervals == scenario.steeringTableIntervals &&
+            cached.cubic == scenario.steeringTableCubic) {
+            return cached.table;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Caches the steering table of a scenario's vehicle, dropping the
+ *        oldest entry when the cache is full.
+ *
+ * @param scenario The scenario the table was built for.
+ * @param table The table.
+ */
+void SimulationContext::storeSteeringTable(
+                                const Scenario& scenario,
+                                std::shared_ptr<const SteeringTable> table) {
+    CachedTable cached{scenario.wheelbase, scenario.trackWidth,
+                       scenario.maxSteeringAngle, scenario.steeringTableRange,
+                       scenario.steeringTableIntervals,
+                       scenario.steeringTableCubic, std::move(table)};
+    if (tables_.size() < kMaxCachedTables) {
+        tables_.push_back(std::move(cached));
+    } else {
+        tables_[nextTable_] = std::move(cached);
+        nextTable_ = (nextTable_ + 1) % kMaxCachedTables;
+    }
+}
+
+/**
+ * @brief Get the simulation of the current run.
+ *
+ * @return The simulation.
+ */
+RobotSimulation& SimulationContext::getSimulation() {
+    return simulation_;
+}
+
+/**
+ * @brief Get the steps kept in the current run.
+ *
+ * @return The first sample, or nullptr when nothing is kept.
+ */
+const TrajectorySample* SimulationContext::getTrajectory() const {
+    return trajectory_;
+}
+
+/**
+ * @brief Get the number of steps kept in the current run.
+ *
+ * @return The number of samples.
+ */
+std::size_t SimulationContext::getTrajectorySize() const {
+    return trajectorySize_;
+}
+
+/**
+ * @brief Get the number of cached steering tables.
+ *
+ * @return The cache size.
+ */
+std::size_t SimulationContext::getCachedSteeringTables() const {
+    return tables_.size();
+}
+
+/**
+ * @brief Get the arena holding the per-run buffers.
+ *
+ * @return The arena.
+ */
+MonotonicArena& SimulationContext::getArena() {
+    return arena_;
+}
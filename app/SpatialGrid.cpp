@@ -0,0 +1,288 @@
+/**
+ * @file SpatialGrid.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the uniform-grid spatial index.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+const std::int64_t kMinCell = std::numeric_limits<std::int32_t>::min();
+const std::int64_t kMaxCell = std::numeric_limits<std::int32_t>::max();
+
+}  // namespace
+
+const std::size_t SpatialGrid::npos;
+
+/**
+ * @brief Constructor for the SpatialGrid class.
+ *
+ * @param cellSize The side of a cell; about the usual query radius works
+ *        best.
+ */
+SpatialGrid::SpatialGrid(double cellSize)
+    : cellSize_(cellSize), inverseCellSize_(1.0 / cellSize), slotBits_(4),
+      slotStart_(std::size_t(1) << slotBits_, 0) {
+    if (!(cellSize > 0.0) || !std::isfinite(cellSize)) {
+        throw std::invalid_argument("Cell size must be positive and finite");
+    }
+    slotStart_.push_back(0);
+}
+
+/// The cell column or row of a coordinate, clamped to the int32 range.
+std::int64_t SpatialGrid::cellCoordinate(double value) const {
+    double cell = std::floor(value * inverseCellSize_);
+    if (!(cell > static_cast<double>(kMinCell))) return kMinCell;
+    if (cell >= static_cast<double>(kMaxCell)) return kMaxCell;
+    return static_cast<std::int64_t>(cell);
+}
+
+/// Packs a cell's column and row into one key.
+std::uint64_t SpatialGrid::cellKey(std::int64_t cx, std::int64_t cy) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+           static_cast<std::uint32_t>(cy);
+}
+
+/// Fibonacci hash of a cell key onto the slot table.
+std::size_t SpatialGrid::slotOf(std::uint64_t key) const {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >>
+                                    (64 - slotBits_));
+}
+
+/// Calls visit on every entry in the cells [minX, maxX] x [minY, maxY].
+/// Cells beyond the clamped range hold no points and are skipped.
+template <typename Visit>
+void SpatialGrid::forEachInBox(std::int64_t minX, std::int64_t maxX,
+                               std::int64_t minY, std::int64_t maxY,
+                               Visit visit) const {
+    minX = std::max(minX, kMinCell);
+    maxX = std::min(maxX, kMaxCell);
+    minY = std::max(minY, kMinCell);
+    maxY = std::min(maxY, kMaxCell);
+    for (std::int64_t cx = minX; cx <= maxX; cx++) {
+        for (std::int64_t cy = minY; cy <= maxY; cy++) {
+            std::uint64_t key = cellKey(cx, cy);
+            std::size_t slot = slotOf(key);
+            for (std::size_t k = slotStart_[slot]; k < slotStart_[slot + 1];
+                 k++) {
+                if (entries_[k].cell == key) visit(entries_[k]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Replaces the indexed points. Point i is (x[i], y[i]); points with
+ *        a non-finite coordinate are left out.
+ *
+ * @param x The x-coordinates.
+ * @param y The y-coordinates.
+ * @param count The number of points.
+ */
+void SpatialGrid::build(const double* x, const double* y, std::size_t count) {
+    slotBits_ = 4;
+    while ((std::size_t(1) << slotBits_) < 2 * count) slotBits_++;
+    const std::size_t slots = std::size_t(1) << slotBits_;
+
+    // Count the points of every slot, then turn the counts into offsets
+    slotStart_.assign(slots + 1, 0);
+    pointSlot_.resize(count);
+    std::size_t indexed = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i])) {
+            pointSlot_[i] = npos;
+            continue;
+        }
+        std::size_t slot = slotOf(cellKey(cellCoordinate(x[i]),
+                                          cellCoordinate(y[i])));
+        pointSlot_[i] = slot;
+        slotStart_[slot + 1]++;
+        indexed++;
+    }
+    for (std::size_t s = 0; s < slots; s++) {
+        slotStart_[s + 1] += slotStart_[s];
+    }
+
+    // Place the points; slotStart_[s] runs up to the end of slot s and is
+    // shifted back afterwards
+    entries_.resize(indexed);
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t slot = pointSlot_[i];
+        if (slot == npos) continue;
+        Entry& entry = entries_[slotStart_[slot]++];
+        entry.x = x[i];
+        entry.y = y[i];
+        entry.cell = cellKey(cellCoordinate(x[i]), cellCoordinate(y[i]));
+        entry.index = i;
+    }
+    for (std::size_t s = slots; s > 0; s--) {
+        slotStart_[s] = slotStart_[s - 1];
+    }
+    slotStart_[0] = 0;
+}
+
+/**
+ * @brief Finds the indexed point closest to a position.
+ *
+ * Searches square rings of cells outwards from the cell of the position.
+ * Once ring r is done, every point not yet seen is at least
+ * r * cellSize away, so the search stops when the best distance is within
+ * that bound.
+ *
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @param exclude A point to skip, e.g. the one at the position.
+ * @param distance The distance to the closest point (output).
+ * @return The index of the closest point, or npos if there is none.
+ */
+std::size_t SpatialGrid::nearest(double x, double y, std::size_t exclude,
+                                 double& distance) const {
+    double best = std::numeric_limits<double>::infinity();
+    std::size_t bestIndex = npos;
+    auto visit = [&](const Entry& entry) {
+        if (entry.index == exclude) return;
+        double dx = entry.x - x;
+        double dy = entry.y - y;
+        double d2 = dx * dx + dy * dy;
+        if (d2 < best || (d2 == best && entry.index < bestIndex)) {
+            best = d2;
+            bestIndex = entry.index;
+        }
+    };
+
+    const std::size_t slots = std::size_t(1) << slotBits_;
+    std::int64_t cx = cellCoordinate(x);
+    std::int64_t cy = cellCoordinate(y);
+    // A clamped cell gives no distance bound; scan everything instead
+    bool bounded = std::isfinite(x) && std::isfinite(y) &&
+                   cx > kMinCell && cx < kMaxCell &&
+                   cy > kMinCell && cy < kMaxCell;
+
+    for (std::int64_t r = 0; bounded; r++) {
+        if (bestIndex != npos) {
+            double reach = static_cast<double>(r - 1) * cellSize_;
+            if (r > 0 && best < reach * reach) break;
+        }
+        std::int64_t side = 2 * r + 1;
+        if (static_cast<double>(side) * static_cast<double>(side) >
+            static_cast<double>(slots)) {
+            bounded = false;
+            break;
+        }
+        if (r == 0) {
+            forEachInBox(cx, cx, cy, cy, visit);
+            continue;
+        }
+        forEachInBox(cx - r, cx + r, cy - r, cy - r, visit);
+        forEachInBox(cx - r, cx + r, cy + r, cy + r, visit);
+        forEachInBox(cx - r, cx - r, cy - r + 1, cy + r - 1, visit);
+        forEachInBox(cx + r, cx + r, cy - r + 1, cy + r - 1, visit);
+    }
+
+    if (!bounded) {
+        best = std::numeric_limits<double>::infinity();
+        bestIndex = npos;
+        for (const Entry& entry : entries_) visit(entry);
+    }
+    distance = std::sqrt(best);
+    return bestIndex;
+}
+
+/**
+ * @brief Appends every indexed point within a radius of a position.
+ *
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @param radius The search radius.
+ * @param result The indices found, appended in no particular order.
+ */
+void SpatialGrid::queryRadius(double x, double y, double radius,
+                              std::vector<std::size_t>& result) const {
+    if (!(radius >= 0.0)) return;
+    const double radius2 = radius * radius;
+    auto visit = [&](const Entry& entry) {
+        double dx = entry.x - x;
+        double dy = entry.y - y;
+        if (dx * dx + dy * dy <= radius2) result.push_back(entry.index);
+    };
+
+    std::int64_t minX = cellCoordinate(x - radius);
+    std::int64_t maxX = cellCoordinate(x + radius);
+    std::int64_t minY = cellCoordinate(y - radius);
+    std::int64_t maxY = cellCoordinate(y + radius);
+    double cells = static_cast<double>(maxX - minX + 1) *
+                   static_cast<double>(maxY - minY + 1);
+    if (!std::isfinite(x) || !std::isfinite(y) ||
+        cells > static_cast<double>(std::size_t(1) << slotBits_)) {
+        for (const Entry& entry : entries_) visit(entry);
+        return;
+    }
+    forEachInBox(minX, maxX, minY, maxY, visit);
+}
+
+/**
+ * @brief Appends every pair of indexed points at most a radius apart, for
+ *        the points at sorted positions [begin, end).
+ *
+ * @param radius The largest distance of a pair.
+ * @param begin The first sorted position.
+ * @param end One past the last sorted position.
+ * @param pairs The pairs found, appended.
+ */
+void SpatialGrid::findPairs(double radius, std::size_t begin, std::size_t end,
+                            std::vector<std::pair<std::size_t, std::size_t>>&
+                                pairs) const {
+    if (!(radius >= 0.0)) return;
+    end = std::min(end, entries_.size());
+    const double radius2 = radius * radius;
+    const double slots = static_cast<double>(std::size_t(1) << slotBits_);
+
+    for (std::size_t k = begin; k < end; k++) {
+        const Entry& self = entries_[k];
+        auto visit = [&](const Entry& entry) {
+            if (entry.index <= self.index) return;
+            double dx = entry.x - self.x;
+            double dy = entry.y - self.y;
+            if (dx * dx + dy * dy <= radius2) {
+                pairs.emplace_back(self.index, entry.index);
+            }
+        };
+        std::int64_t minX = cellCoordinate(self.x - radius);
+        std::int64_t maxX = cellCoordinate(self.x + radius);
+        std::int64_t minY = cellCoordinate(self.y - radius);
+        std::int64_t maxY = cellCoordinate(self.y + radius);
+        double cells = static_cast<double>(maxX - minX + 1) *
+                       static_cast<double>(maxY - minY + 1);
+        if (cells > slots) {
+            for (const Entry& entry : entries_) visit(entry);
+        } else {
+            forEachInBox(minX, maxX, minY, maxY, visit);
+        }
+    }
+}
+
+/**
+ * @brief Retrieves the number of indexed points.
+ *
+ * @return The number of points with finite coordinates.
+ */
+std::size_t SpatialGrid::size() const {
+    return entries_.size();
+}
+
+/**
+ * @brief Retrieves the side of a cell.
+ *
+ * @return The cell size.
+ */
+double SpatialGrid::getCellSize() const {
+    return cellSize_;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file SteeringTable.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Lookup table of the Ackermann steering geometry of one vehicle.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "SteeringTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+double SteeringGeometry::* const SteeringTable::kFields[5] = {
+    &SteeringGeometry::curvature, &SteeringGeometry::angleMinus,
+    &SteeringGeometry::anglePlus, &SteeringGeometry::wheelRatio,
+    &SteeringGeometry::centerRatio};
+
+/**
+ * @brief Computes the geometry with tan and atan.
+ *
+ * @param wheelbase The distance between the front and rear axles.
+ * @param trackWidth The distance between the left and right wheels.
+ * @param steeringAngle The commanded steering angle (radians).
+ * @return The geometry.
+ */
+SteeringGeometry SteeringGeometry::compute(double wheelbase,
+                                           double trackWidth,
+                                           double steeringAngle) {
+    // Written in the curvature so that driving straight stays finite
+    SteeringGeometry geometry;
+    geometry.curvature = std::tan(steeringAngle) / wheelbase;
+    double half = geometry.curvature * trackWidth / 2.0;
+    double lateral = wheelbase * geometry.curvature;
+    geometry.angleMinus = std::atan(lateral / (1.0 - half));
+    geometry.anglePlus = std::atan(lateral / (1.0 + half));
+    geometry.wheelRatio = (1.0 - half) / (1.0 + half);
+    geometry.centerRatio = 1.0 / (1.0 + half);
+    return geometry;
+}
+
+/**
+ * @brief Constructor for the SteeringTable class. Samples the geometry and
+ *        measures the interpolation error.
+ *
+ * @param wheelbase The distance between the front and rear axles.
+ * @param trackWidth The distance between the left and right wheels.
+ * @param range The table covers steering angles in [-range, range].
+ * @param intervals The number of grid intervals over the range.
+ * @param interpolation Linear or cubic interpolation.
+ */
+SteeringTable::SteeringTable(double wheelbase, double trackWidth,
+                             double range, std::size_t intervals,
+                             SteeringInterpolation interpolation)
+    : range_(range), intervals_(intervals), interpolation_(interpolation) {
+    if (!(range > 0.0) || intervals < 2) {
+        throw std::invalid_argument("a steering table needs a positive range "
+                                    "and at least two intervals");
+    }
+    if (!(wheelbase > 0.0)) {
+        throw std::invalid_argument("the wheelbase must be positive");
+    }
+    step_ = 2.0 * range / static_cast<double>(intervals);
+    inverseStep_ = 1.0 / step_;
+
+    double pole = trackWidth != 0.0
+                      ? std::atan(2.0 * wheelbase / std::abs(trackWidth))
+                      : M_PI / 2.0;
+    if (!(range + step_ < pole)) {
+        throw std::invalid_argument("the steering table reaches the pole of "
+                                    "the wheel angles");
+    }
+
+    samples_.resize(intervals + 3);
+    for (std::size_t i = 0; i < samples_.size(); i++) {
+        double angle = -range + (static_cast<double>(i) - 1.0) * step_;
+        samples_[i] = SteeringGeometry::compute(wheelbase, trackWidth, angle);
+    }
+
+    splines_.resize(4 * intervals);
+    for (std::size_t i = 0; i < intervals; i++) {
+        const SteeringGeometry* p = &samples_[i];
+        SteeringGeometry* c = &splines_[4 * i];
+        for (double SteeringGeometry::*field : kFields) {
+            double p0 = p[0].*field;
+            double p1 = p[1].*field;
+            double p2 = p[2].*field;
+            double p3 = p[3].*field;
+            c[0].*field = p1;
+            c[1].*field = 0.5 * (p2 - p0);
+            c[2].*field = 0.5 * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3);
+            c[3].*field = 0.5 * (3.0 * (p1 - p2) + p3 - p0);
+        }
+    }
+
+    // Probe eight points inside every interval
+    for (std::size_t i = 0; i < intervals; i++) {
+        for (int k = 0; k < 8; k++) {
+            double angle = -range + (static_cast<double>(i) +
+                                     (k + 0.5) / 8.0) * step_;
+            SteeringGeometry exact =
+                SteeringGeometry::compute(wheelbase, trackWidth, angle);
+            SteeringGeometry table = lookup(angle);
+            for (double SteeringGeometry::*field : kFields) {
+                maxError_.*field = std::max(maxError_.*field,
+                    std::abs(table.*field - exact.*field));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the largest interpolation error of each quantity, measured at
+ *        construction between the samples.
+ *
+ * @return The largest absolute error of every field.
+ */
+const SteeringGeometry& SteeringTable::getMaxError() const {
+    return maxError_;
+}
+
+/**
+ * @brief Retrieves the largest covered steering angle.
+ *
+ * @return The range in radians.
+ */
+double SteeringTable::getRange() const {
+    return range_;
+}
+
+/**
+ * @brief Retrieves the number of grid intervals.
+ *
+ * @return The number of intervals.
+ */
+std::size_t SteeringTable::getIntervals() const {
+    return intervals_;
+}
+
+/**
+ * @brief Retrieves the interpolation scheme.
+ *
+ * @return Linear or cubic.
+ */
+SteeringInterpolation SteeringTable::getInterpolation() const {
+    return interpolation_;
+}
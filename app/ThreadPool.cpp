@@ -0,0 +1,156 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Work-stealing thread pool used by the parallel runners.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor for the ThreadPool class.
+ *
+ * @param threads The number of worker threads (0 = one per core).
+ */
+ThreadPool::ThreadPool(std::size_t threads)
+    : pendingChunks_(0), generation_(0), stopping_(false) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        queues_.emplace_back(new WorkQueue());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Stops and joins all worker threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+
+/**
+ * @brief Retrieves the number of worker threads.
+ *
+ * @return The number of worker threads.
+ */
+std::size_t ThreadPool::size() const {
+    return workers_.size();
+}
+
+/**
+ * @brief Runs task(i) for every i in [0, count) and waits for completion.
+ *
+ * @param count The number of indices to process.
+ * @param task The task invoked with each index.
+ * @param grain The number of indices per chunk (0 picks a default).
+ */
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& task,
+                             std::size_t grain) {
+    if (count == 0) return;
+    std::lock_guard<std::mutex> call(callMutex_);
+
+    if (grain == 0) {
+        // Several chunks per worker leave room for stealing to balance load.
+        grain = std::max<std::size_t>(1, count / (workers_.size() * 8));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t chunks = 0;
+    for (std::size_t begin = 0; begin < count; begin += grain, chunks++) {
+        WorkQueue& queue = *queues_[chunks % queues_.size()];
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        Chunk chunk = {begin, std::min(count, begin + grain), &task};
+        queue.chunks.push_back(chunk);
+    }
+    pendingChunks_ = chunks;
+    error_ = nullptr;
+    generation_++;
+    wake_.notify_all();
+    done_.wait(lock, [this]() { return pendingChunks_ == 0; });
+
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Takes a chunk from the worker's own queue or steals one.
+ *
+ * Owners take from the back of their queue while thieves take from the
+ * front, so the two rarely contend for the same chunk.
+ *
+ * @param id The index of the calling worker.
+ * @param chunk The chunk taken (output).
+ * @return True if a chunk was taken.
+ */
+bool ThreadPool::takeChunk(std::size_t id, Chunk& chunk) {
+    {
+        WorkQueue& own = *queues_[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t offset = 1; offset < queues_.size(); offset++) {
+        WorkQueue& victim = *queues_[(id + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Main loop of a worker thread.
+ *
+ * @param id The index of the worker.
+ */
+void ThreadPool::workerLoop(std::size_t id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen]() {
+                return stopping_ || generation_ != seen;
+            });
+            if (stopping_) return;
+            seen = generation_;
+        }
+
+        Chunk chunk;
+        while (takeChunk(id, chunk)) {
+            try {
+                for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+                    (*chunk.task)(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pendingChunks_ == 0) done_.notify_all();
+        }
+    }
+}
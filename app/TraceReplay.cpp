@@ -0,0 +1,237 @@
+/**
+ * @file TraceReplay.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Implementation of the golden-trace replay.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "TraceReplay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "BatchRunner.hpp"
+#include "PIDController.hpp"
+
+namespace {
+
+const std::size_t kColumns = TrajectorySample::kColumnCount;
+
+/// The column index of a TrajectorySample field.
+#define TRAJECTORY_COLUMN(field) \
+    (offsetof(TrajectorySample, field) / sizeof(double))
+
+const std::size_t kHeadingColumn = TRAJECTORY_COLUMN(heading);
+const std::size_t kSpeedColumn = TRAJECTORY_COLUMN(speed);
+const std::size_t kTargetHeadingColumn = TRAJECTORY_COLUMN(targetHeading);
+const std::size_t kTargetVelocityColumn = TRAJECTORY_COLUMN(targetVelocity);
+/// The controller columns are contiguous, from the velocity error to the
+/// heading derivative term.
+const std::size_t kFirstControllerColumn = TRAJECTORY_COLUMN(velocityError);
+const std::size_t kLastControllerColumn = TRAJECTORY_COLUMN(headingD);
+
+#undef TRAJECTORY_COLUMN
+
+/**
+ * @brief Checks one value and records its difference.
+ *
+ * @return True if the value is within tolerance.
+ */
+bool compareValue(double actual, double expected, double absolute,
+                  double relative, std::size_t tick, ColumnDiff& diff) {
+    if (actual == expected || (actual != actual && expected != expected)) {
+        return true;
+    }
+    double error = std::abs(actual - expected);
+    if (error != error) error = std::numeric_limits<double>::infinity();
+    bool within = error <= absolute + relative * std::max(std::abs(actual),
+                                                          std::abs(expected));
+    if (error > diff.maxError) {
+        diff.maxError = error;
+        diff.worstTick = tick;
+    }
+    if (!within) diff.mismatches++;
+    return within;
+}
+
+}  // namespace
+
+const std::size_t ReplayReport::npos;
+
+/**
+ * @brief Get the name of a replay mode, as used on the command line.
+ *
+ * @param mode The replay mode.
+ * @return "closed_loop" or "controller".
+ */
+const char* replayModeName(ReplayMode mode) {
+    switch (mode) {
+    case ReplayMode::ClosedLoop:
+        return "closed_loop";
+    case ReplayMode::Controller:
+        return "controller";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parses the name of a replay mode.
+ *
+ * @param name Either closed_loop or controller.
+ * @return The replay mode.
+ */
+ReplayMode parseReplayMode(const std::string& name) {
+    const ReplayMode modes[] = {ReplayMode::ClosedLoop, ReplayMode::Controller};
+    for (ReplayMode mode : modes) {
+        if (name == replayModeName(mode)) return mode;
+    }
+    throw std::invalid_argument("unknown replay mode '" + name + "'");
+}
+
+/**
+ * @brief Constructor for the ReplayTolerance struct.
+ *
+ * @param absolute The absolute tolerance of every column.
+ * @param relative The relative tolerance of every column.
+ */
+ReplayTolerance::ReplayTolerance(double absolute, double relative) {
+    std::fill(this->absolute, this->absolute + kColumns, absolute);
+    std::fill(this->relative, this->relative + kColumns, relative);
+}
+
+/**
+ * @brief Finds the column with the largest difference.
+ *
+ * @return The column index, or npos if every value matched.
+ */
+std::size_t ReplayReport::worstColumn() const {
+    std::size_t worst = npos;
+    for (std::size_t column = 0; column < kColumns; column++) {
+        if (columns[column].mismatches == 0) continue;
+        if (worst == npos ||
+            columns[column].maxError > columns[worst].maxError) {
+            worst = column;
+        }
+    }
+    return worst;
+}
+
+/**
+ * @brief Replays a scenario against its golden trace.
+ *
+ * The golden trace is read a chunk at a time, one column pointer each, so
+ * the comparison costs no lookups per value. The targets of every tick
+ * come from the trace.
+ *
+ * @param scenario The scenario, possibly with changed gains or plant.
+ * @param golden The recorded trajectory.
+ * @param mode What to re-run.
+ * @param tolerance The allowed difference per column.
+ * @return The differences.
+ */
+ReplayReport replayTrace(const Scenario& scenario,
+                         const TrajectoryReader& golden, ReplayMode mode,
+                         const ReplayTolerance& tolerance) {
+    ReplayReport report;
+    report.mode = mode;
+    report.ticks = golden.getSampleCount();
+    for (std::size_t column = 0; column < kColumns; column++) {
+        report.compared[column] = mode == ReplayMode::ClosedLoop ||
+                                  (column >= kFirstControllerColumn &&
+                                   column <= kLastControllerColumn);
+    }
+
+    RobotSimulation simulation = BatchRunner::makeSimulation(scenario);
+    PIDController controller(scenario.velP, scenario.velI, scenario.velD,
+                             scenario.deltaT, scenario.headP, scenario.headI,
+                             scenario.headD);
+    double measuredHeading = scenario.initialTheta;
+    double measuredSpeed = scenario.initialVelocity;
+
+    const std::size_t chunkRows = golden.getChunkRows();
+    const double* expected[kColumns];
+    double actual[kColumns] = {};
+    for (std::size_t first = 0; first < report.ticks; first += chunkRows) {
+        for (std::size_t column = 0; column < kColumns; column++) {
+            expected[column] = golden.getColumn(first / chunkRows, column);
+        }
+        const std::size_t rows = std::min(chunkRows, report.ticks - first);
+        for (std::size_t row = 0; row < rows; row++) {
+            const double targetHeading = expected[kTargetHeadingColumn][row];
+            const double targetVelocity =
+                expected[kTargetVelocityColumn][row];
+            if (mode == ReplayMode::ClosedLoop) {
+                simulation.step(targetHeading, targetVelocity);
+                TrajectorySample sample = simulation.makeSample();
+                std::memcpy(actual, &sample, sizeof(actual));
+            } else {
+                controller.computeErrors(targetVelocity, measuredSpeed,
+                                         targetHeading, measuredHeading);
+                PIDTerms terms = controller.computeTerms();
+                TrajectorySample sample;
+                std::memset(&sample, 0, sizeof(sample));
+                sample.targetHeading = targetHeading;
+                sample.targetVelocity = targetVelocity;
+                sample.velocityError = terms.velocityError;
+                sample.headingError = terms.headingError;
+                sample.velocityP = terms.velocityP;
+                sample.velocityI = terms.velocityI;
+                sample.velocityD = terms.velocityD;
+                sample.headingP = terms.headingP;
+                sample.headingI = terms.headingI;
+                sample.headingD = terms.headingD;
+                std::memcpy(actual, &sample, sizeof(actual));
+                measuredHeading = expected[kHeadingColumn][row];
+                measuredSpeed = expected[kSpeedColumn][row];
+            }
+
+            const std::size_t tick = first + row;
+            bool within = true;
+            for (std::size_t column = 0; column < kColumns; column++) {
+                if (!report.compared[column]) continue;
+                within &= compareValue(actual[column], expected[column][row],
+                                       tolerance.absolute[column],
+                                       tolerance.relative[column], tick,
+                                       report.columns[column]);
+            }
+            if (!within) {
+                if (report.mismatchedTicks == 0) report.firstMismatch = tick;
+                report.mismatchedTicks++;
+            }
+        }
+    }
+    return report;
+}
+
+/**
+ * @brief Writes one CSV line per replay, with a header line.
+ *
+ * @param output The stream receiving the table.
+ * @param scenarios The replayed scenarios.
+ * @param reports The report of each scenario.
+ */
+void writeReplayCsv(std::ostream& output,
+                    const std::vector<Scenario>& scenarios,
+                    const std::vector<ReplayReport>& reports) {
+    output << "name,mode,ticks,mismatched_ticks,first_mismatch,"
+              "worst_column,max_error\n";
+    for (std::size_t i = 0; i < reports.size() && i < scenarios.size(); i++) {
+        const ReplayReport& report = reports[i];
+        output << scenarios[i].name << ',' << replayModeName(report.mode)
+               << ',' << report.ticks << ',' << report.mismatchedTicks << ',';
+        std::size_t worst = report.worstColumn();
+        if (worst != ReplayReport::npos) {
+            output << report.firstMismatch << ','
+                   << TrajectorySample::columnName(worst) << ','
+                   << report.columns[worst].maxError;
+        } else {
+            output << ",,";
+        }
+        output << '\n';
+    }
+}
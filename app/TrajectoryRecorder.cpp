@@ -0,0 +1,494 @@
+/**
+ * @file TrajectoryRecorder.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Records per-tick simulation state into a columnar binary file.
+ * @version 0.1
+ * @date 2023
+ */
+
+#include "TrajectoryRecorder.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+const std::size_t TrajectorySample::kColumnCount;
+const std::size_t TrajectoryRecorder::kDefaultChunkRows;
+
+namespace {
+
+const char kMagic[8] = {'A', 'C', 'K', 'T', 'R', 'A', 'J', '\0'};
+const std::uint32_t kVersion = 2;
+
+/**
+ * @brief Layout of the 64 byte file header.
+ */
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t columnCount;
+    std::uint64_t chunkRows;
+    unsigned char reserved[40];
+};
+
+/**
+ * @brief Layout of the 64 byte header in front of every chunk.
+ */
+struct ChunkHeader {
+    std::uint64_t rowCount;
+    unsigned char reserved[56];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(ChunkHeader) == 64, "ChunkHeader must be 64 bytes");
+
+const char* const kColumnNames[TrajectorySample::kColumnCount] = {
+    "time", "x", "y", "theta", "heading", "speed",
+    "alpha_i", "alpha_o", "omega_i", "omega_o",
+    "target_heading", "target_velocity",
+    "velocity_error", "heading_error",
+    "velocity_p", "velocity_i", "velocity_d",
+    "heading_p", "heading_i", "heading_d",
+};
+
+/**
+ * @brief Size of a chunk holding the given number of rows.
+ */
+std::size_t chunkSize(std::size_t chunkRows) {
+    return sizeof(ChunkHeader) +
+           TrajectorySample::kColumnCount * chunkRows * sizeof(double);
+}
+
+/**
+ * @brief Builds an error message carrying the current errno.
+ */
+std::runtime_error systemError(const std::string& what,
+                               const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " +
+                              std::strerror(errno));
+}
+
+}  // namespace
+
+/**
+ * @brief Get the name of a column, as used in the CSV header.
+ *
+ * @param column The column index.
+ * @return The column name, or an empty string if out of range.
+ */
+const char* TrajectorySample::columnName(std::size_t column) {
+    return column < kColumnCount ? kColumnNames[column] : "";
+}
+
+/**
+ * @brief Constructor for the TrajectoryRecorder class.
+ */
+TrajectoryRecorder::TrajectoryRecorder()
+    : fd_(-1), chunkRows_(0), chunkBytes_(0), chunks_(0), row_(0),
+      samples_(0), current_(), ready_(), retired_(), wantChunk_(false),
+      stopping_(false) {
+}
+
+/**
+ * @brief Destructor, closes the file.
+ */
+TrajectoryRecorder::~TrajectoryRecorder() {
+    close();
+}
+
+/**
+ * @brief Creates or truncates a trajectory file and starts preparing its
+ *        first chunk.
+ *
+ * @param path The path of the file.
+ * @param chunkRows The number of samples per chunk.
+ */
+void TrajectoryRecorder::open(const std::string& path,
+                              std::size_t chunkRows) {
+    close();
+    if (chunkRows == 0) {
+        throw std::invalid_argument("chunkRows must be positive");
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0644);
+    if (fd < 0) throw systemError("cannot create", path);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.columnCount = TrajectorySample::kColumnCount;
+    header.chunkRows = chunkRows;
+    if (::pwrite(fd, &header, sizeof(header), 0) !=
+        static_cast<ssize_t>(sizeof(header))) {
+        std::runtime_error error = systemError("cannot write", path);
+        ::close(fd);
+        throw error;
+    }
+
+    fd_ = fd;
+    chunkRows_ = chunkRows;
+    chunkBytes_ = chunkSize(chunkRows);
+    chunks_ = 0;
+    // The first record() swaps in the first chunk
+    row_ = chunkRows;
+    samples_ = 0;
+    wantChunk_ = true;
+    helper_ = std::thread(&TrajectoryRecorder::prepareChunks, this);
+}
+
+/**
+ * @brief Swaps in the chunk prepared by the helper thread and hands the
+ *        full one back to it for unmapping.
+ */
+void TrajectoryRecorder::nextChunk() {
+    if (fd_ < 0) {
+        throw std::runtime_error("trajectory recorder is not open");
+    }
+
+    Chunk stale = Chunk();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] {
+            return ready_.mapping != nullptr || error_;
+        });
+        if (ready_.mapping == nullptr) std::rethrow_exception(error_);
+
+        // The helper normally unmapped the previous chunk long ago
+        stale = retired_;
+        retired_ = current_;
+        current_ = ready_;
+        ready_ = Chunk();
+        wantChunk_ = true;
+    }
+    wake_.notify_all();
+    unmapChunk(stale);
+
+    chunks_++;
+    row_ = 0;
+}
+
+/**
+ * @brief Body of the helper thread: maps chunks ahead and unmaps the
+ *        retired ones until the recorder is closed.
+ */
+void TrajectoryRecorder::prepareChunks() {
+    std::size_t index = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] {
+            return stopping_ || wantChunk_ || retired_.mapping != nullptr;
+        });
+        if (stopping_) return;
+
+        if (retired_.mapping != nullptr) {
+            Chunk retired = retired_;
+            retired_ = Chunk();
+            lock.unlock();
+            unmapChunk(retired);
+            lock.lock();
+            continue;
+        }
+
+        wantChunk_ = false;
+        lock.unlock();
+        try {
+            Chunk chunk = mapChunk(index++);
+            lock.lock();
+            ready_ = chunk;
+        } catch (...) {
+            lock.lock();
+            error_ = std::current_exception();
+        }
+        wake_.notify_all();
+    }
+}
+
+/**
+ * @brief Allocates a chunk of the file and maps it writable.
+ *
+ * @param index The index of the chunk in the file.
+ * @return The mapped chunk.
+ */
+TrajectoryRecorder::Chunk TrajectoryRecorder::mapChunk(std::size_t index) {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t offset = sizeof(FileHeader) + index * chunkBytes_;
+    const std::size_t mapOffset = offset - offset % page;
+
+    // Reserve the blocks up front so page faults never wait for the
+    // file system, then fault the whole chunk in with one call.
+    int status = ::posix_fallocate(fd_, static_cast<off_t>(offset),
+                                   static_cast<off_t>(chunkBytes_));
+    if (status == EOPNOTSUPP || status == EINVAL) {
+        status = ::ftruncate(fd_, static_cast<off_t>(offset + chunkBytes_))
+                     == 0 ? 0 : errno;
+    }
+    if (status != 0) {
+        errno = status;
+        throw systemError("cannot grow", "trajectory file");
+    }
+
+    Chunk chunk;
+    chunk.mappingBytes = offset - mapOffset + chunkBytes_;
+    chunk.mapping = ::mmap(nullptr, chunk.mappingBytes,
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           fd_, static_cast<off_t>(mapOffset));
+    if (chunk.mapping == MAP_FAILED) {
+        throw systemError("cannot map", "trajectory file");
+    }
+
+#ifdef MADV_POPULATE_WRITE
+    // Shared file pages start write-protected; fault them in writable now
+    // instead of taking one write fault per page while recording.
+    ::madvise(chunk.mapping, chunk.mappingBytes, MADV_POPULATE_WRITE);
+#endif
+
+    unsigned char* start = static_cast<unsigned char*>(chunk.mapping) +
+                           (offset - mapOffset);
+    chunk.rowCount = reinterpret_cast<std::uint64_t*>(start);
+    chunk.data = reinterpret_cast<double*>(start + sizeof(ChunkHeader));
+    return chunk;
+}
+
+/**
+ * @brief Unmaps a chunk, if it is mapped.
+ *
+ * @param chunk The chunk to unmap; it is cleared.
+ */
+void TrajectoryRecorder::unmapChunk(Chunk& chunk) {
+    if (chunk.mapping != nullptr) {
+        ::munmap(chunk.mapping, chunk.mappingBytes);
+    }
+    chunk = Chunk();
+}
+
+/**
+ * @brief Unmaps and closes the file, dropping the chunk prepared ahead.
+ */
+void TrajectoryRecorder::close() {
+    if (helper_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        helper_.join();
+    }
+    unmapChunk(current_);
+    unmapChunk(ready_);
+    unmapChunk(retired_);
+
+    if (fd_ >= 0) {
+        // Drop the chunk mapped ahead but never written
+        if (::ftruncate(fd_, static_cast<off_t>(sizeof(FileHeader) +
+                                                chunks_ * chunkBytes_)) != 0) {
+            // The unused chunk only holds a zero row count; keep going
+        }
+        ::close(fd_);
+    }
+    fd_ = -1;
+    row_ = chunkRows_ = 0;
+    wantChunk_ = stopping_ = false;
+    error_ = nullptr;
+}
+
+/**
+ * @brief Checks whether a file is open.
+ *
+ * @return True if samples can be recorded.
+ */
+bool TrajectoryRecorder::isOpen() const {
+    return fd_ >= 0;
+}
+
+/**
+ * @brief Get the number of samples recorded since open().
+ *
+ * @return The number of samples.
+ */
+std::size_t TrajectoryRecorder::getSampleCount() const {
+    return samples_;
+}
+
+/**
+ * @brief Constructor for the TrajectoryReader class.
+ *
+ * @param path The path of a file written by TrajectoryRecorder.
+ */
+TrajectoryReader::TrajectoryReader(const std::string& path)
+    : mapping_(nullptr), mappingBytes_(0), chunkRows_(0), chunkBytes_(0),
+      chunks_(0), samples_(0) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw systemError("cannot open", path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        std::runtime_error error = systemError("cannot stat", path);
+        ::close(fd);
+        throw error;
+    }
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    if (size < sizeof(FileHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a trajectory file");
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw systemError("cannot map", path);
+    mapping_ = static_cast<const unsigned char*>(mapping);
+    mappingBytes_ = size;
+
+    FileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion ||
+        header.columnCount != TrajectorySample::kColumnCount ||
+        header.chunkRows == 0 ||
+        header.chunkRows > std::numeric_limits<std::size_t>::max() /
+                               (TrajectorySample::kColumnCount * 8)) {
+        ::munmap(mapping, size);
+        throw std::runtime_error(path + " is not a trajectory file");
+    }
+
+    chunkRows_ = static_cast<std::size_t>(header.chunkRows);
+    chunkBytes_ = chunkSize(chunkRows_);
+    chunks_ = (size - sizeof(FileHeader)) / chunkBytes_;
+
+    // Every chunk but the last one is full
+    for (std::size_t chunk = 0; chunk < chunks_; chunk++) {
+        ChunkHeader chunkHeader;
+        std::memcpy(&chunkHeader,
+                    mapping_ + sizeof(FileHeader) + chunk * chunkBytes_,
+                    sizeof(chunkHeader));
+        std::size_t rows = static_cast<std::size_t>(chunkHeader.rowCount);
+        if (rows > chunkRows_) rows = chunkRows_;
+        samples_ += rows;
+        if (rows < chunkRows_) {
+            chunks_ = chunk + 1;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Destructor, unmaps the file.
+ */
+TrajectoryReader::~TrajectoryReader() {
+    if (mapping_ != nullptr) {
+        ::munmap(const_cast<unsigned char*>(mapping_), mappingBytes_);
+    }
+}
+
+/**
+ * @brief Get the number of samples in the file.
+ *
+ * @return The number of samples.
+ */
+std::size_t TrajectoryReader::getSampleCount() const {
+    return samples_;
+}
+
+/**
+ * @brief Get the start of a column inside a chunk.
+ */
+const double* TrajectoryReader::columnData(std::size_t chunk,
+                                           std::size_t column) const {
+    const unsigned char* start = mapping_ + sizeof(FileHeader) +
+                                 chunk * chunkBytes_ + sizeof(ChunkHeader);
+    return reinterpret_cast<const double*>(start) + column * chunkRows_;
+}
+
+/**
+ * @brief Reads one sample.
+ *
+ * @param index The sample index, from 0 to getSampleCount() - 1.
+ * @return The sample.
+ */
+TrajectorySample TrajectoryReader::getSample(std::size_t index) const {
+    if (index >= samples_) {
+        throw std::out_of_range("trajectory sample index out of range");
+    }
+    double values[TrajectorySample::kColumnCount];
+    const std::size_t chunk = index / chunkRows_;
+    const std::size_t row = index % chunkRows_;
+    for (std::size_t column = 0; column < TrajectorySample::kColumnCount;
+         column++) {
+        values[column] = columnData(chunk, column)[row];
+    }
+    TrajectorySample sample;
+    std::memcpy(&sample, values, sizeof(sample));
+    return sample;
+}
+
+/**
+ * @brief Reads one value of a column.
+ *
+ * @param index The sample index, from 0 to getSampleCount() - 1.
+ * @param column The column index.
+ * @return The value.
+ */
+double TrajectoryReader::getValue(std::size_t index,
+                                  std::size_t column) const {
+    if (index >= samples_ || column >= TrajectorySample::kColumnCount) {
+        throw std::out_of_range("trajectory value out of range");
+    }
+    return columnData(index / chunkRows_, column)[index % chunkRows_];
+}
+
+/**
+ * @brief Retrieves the number of samples per chunk.
+ *
+ * @return The rows of a chunk.
+ */
+std::size_t TrajectoryReader::getChunkRows() const {
+    return chunkRows_;
+}
+
+/**
+ * @brief Gives direct access to one column of a chunk.
+ *
+ * @param chunk The chunk index.
+ * @param column The column index.
+ * @return The values of the column in that chunk.
+ */
+const double* TrajectoryReader::getColumn(std::size_t chunk,
+                                          std::size_t column) const {
+    if (chunk >= chunks_ || column >= TrajectorySample::kColumnCount) {
+        throw std::out_of_range("trajectory column out of range");
+    }
+    return columnData(chunk, column);
+}
+
+/**
+ * @brief Writes a trajectory as CSV with a header line.
+ *
+ * @param output The stream receiving the table.
+ * @param reader The trajectory to convert.
+ */
+void writeTrajectoryCsv(std::ostream& output, const TrajectoryReader& reader) {
+    for (std::size_t column = 0; column < TrajectorySample::kColumnCount;
+         column++) {
+        output << (column == 0 ? "" : ",")
+               << TrajectorySample::columnName(column);
+    }
+    output << '\n';
+
+    std::streamsize precision = output.precision(17);
+    for (std::size_t i = 0; i < reader.getSampleCount(); i++) {
+        for (std::size_t column = 0; column < TrajectorySample::kColumnCount;
+             column++) {
+            if (column != 0) output << ',';
+            output << reader.getValue(i, column);
+        }
+        output << '\n';
+    }
+    output.precision(precision);
+}
@@ -4,23 +4,424 @@
  * @author Driver: Manav Nagda, Navigator: Sameer Arjun S, Design Keeper: Ishaan Parikh
  */
 #define M_PI 3.14159265358979323846
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BatchRunner.hpp"
+#include "GainTuner.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "RealTimeExecutor.hpp"
 #include "RobotSimulation.hpp"
+#include "ScenarioFile.hpp"
+#include "SharedState.hpp"
+#include "ThreadPool.hpp"
+#include "TraceReplay.hpp"
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage() {
+    std::cout <<
+        "Usage: shell-app [options]\n"
+        "Without options the target heading and velocity are read from "
+        "stdin.\n"
+        "Scenario options apply to the scenarios read after them.\n"
+        "  --scenario FILE   run every scenario in FILE (repeatable)\n"
+        "  --set KEY=VALUE   set a scenario key, e.g. --set vel_p=2\n"
+        "  --setpoint H V    add a run towards heading H and velocity V\n"
+        "  --threads N       worker threads for batch runs (0 = all cores)\n"
+        "  --record DIR      write DIR/<name>.traj for every run\n"
+        "  --replay DIR      replay every run against DIR/<name>.traj and exit\n"
+        "                    with status 1 if any tick differs\n"
+        "  --replay-mode M   closed_loop (default) or controller\n"
+        "  --tolerance ABS   absolute tolerance of a replayed value\n"
+        "  --profile FILE    time the control stages and write a report to\n"
+        "                    FILE (- for stderr) when the runs end\n"
+        "  --profile-format F  text (default) or prometheus\n"
+        "  --tune            search the PID gains for the given setpoints and\n"
+        "                    print them as scenario keys\n"
+        "  --realtime        run the scenarios one by one, one step per dt of\n"
+        "                    wall-clock time, and report timing on stderr\n"
+        "  --priority N      SCHED_FIFO priority of the real-time loop\n"
+        "  --cpu N           pin the real-time loop to CPU N\n"
+        "  --lock-memory     lock the process in memory while running\n"
+        "  --publish NAME    publish the state after every real-time step to\n"
+        "                    the shared-memory segment NAME (e.g. /ackermann)\n"
+        "  --verbose         print the per-iteration controller output\n"
+        "  --help            show this message\n";
+}
+
+/**
+ * @brief Parses the value of --tolerance.
+ *
+ * @param value The whole option value.
+ * @return The tolerance.
+ * @throws std::invalid_argument If the value is not a finite, non-negative
+ *         number.
+ */
+static double parseTolerance(const char* value) {
+    char* end = nullptr;
+    errno = 0;
+    double tolerance = std::strtod(value, &end);
+    if (end == value || *end != '\0' || errno == ERANGE ||
+        !std::isfinite(tolerance) || tolerance < 0.0) {
+        throw std::invalid_argument("invalid tolerance '" +
+                                    std::string(value) + "'");
+    }
+    return tolerance;
+}
+
+/// Executor of the real-time run in progress, stopped by SIGINT.
+static RealTimeExecutor* activeExecutor = nullptr;
+/// Set by SIGINT; no further scenario starts once it is set.
+static volatile std::sig_atomic_t interrupted = 0;
+
+/**
+ * @brief Stops the real-time loop after its current step.
+ */
+static void stopRealTime(int) {
+    interrupted = 1;
+    if (activeExecutor != nullptr) activeExecutor->requestStop();
+}
+
+/**
+ * @brief Runs the scenarios one after another at their control period.
+ *
+ * The summaries go to stdout as CSV; the timing of every run goes to
+ * stderr, in microseconds.
+ *
+ * @param scenarios The scenarios to run.
+ * @param options The scheduling settings; the period is taken from each
+ *        scenario's dt.
+ * @param publisher Receives the state after every step, or nullptr.
+ * @return The process exit status.
+ */
+static int runRealTime(const std::vector<Scenario>& scenarios,
+                       RealTimeOptions options,
+                       SharedStatePublisher* publisher) {
+    std::vector<ScenarioSummary> summaries;
+    std::cerr << "name,steps,missed_deadlines,skipped_periods,"
+                 "jitter_p50_us,jitter_p99_us,jitter_max_us,"
+                 "step_p50_us,step_p99_us,step_max_us\n";
+    interrupted = 0;
+    std::signal(SIGINT, stopRealTime);
+    std::vector<Scenario> completed;
+    for (const Scenario& scenario : scenarios) {
+        if (interrupted) break;
+        options.period = scenario.deltaT;
+        RealTimeExecutor executor(options);
+        activeExecutor = &executor;
+        summaries.push_back(BatchRunner::runScenario(scenario, &executor,
+                                                     nullptr, publisher));
+        activeExecutor = nullptr;
+        completed.push_back(scenario);
+
+        const RealTimeStats& stats = executor.getStats();
+        const LatencyHistogram& jitter = stats.wakeupJitter;
+        const LatencyHistogram& latency = stats.stepLatency;
+        std::cerr << scenario.name << ',' << stats.steps << ','
+                  << stats.missedDeadlines << ',' << stats.skippedPeriods
+                  << ',' << jitter.getPercentile(0.5) / 1e3 << ','
+                  << jitter.getPercentile(0.99) / 1e3 << ','
+                  << jitter.getMax() / 1e3 << ','
+                  << latency.getPercentile(0.5) / 1e3 << ','
+                  << latency.getPercentile(0.99) / 1e3 << ','
+                  << latency.getMax() / 1e3 << '\n';
+    }
+    std::signal(SIGINT, SIG_DFL);
+    writeSummaryCsv(std::cout, completed, summaries);
+    return interrupted ? 130 : 0;
+}
+
+/**
+ * @brief Tunes the gains for the targets of all scenarios.
+ *
+ * The first scenario supplies the plant, dt, initial state and starting
+ * gains. The best gains go to stdout as scenario keys, the convergence
+ * report to stderr.
+ *
+ * @param scenarios The scenarios whose targets are tuned for.
+ * @param threads The number of worker threads.
+ * @return The process exit status.
+ */
+static int runTuning(const std::vector<Scenario>& scenarios,
+                     std::size_t threads) {
+    TuningProblem problem;
+    problem.base = scenarios.front();
+    problem.base.name = "tuned";
+    for (const Scenario& scenario : scenarios) {
+        problem.setpoints.emplace_back(scenario.targetHeading,
+                                       scenario.targetVelocity);
+    }
+
+    GainTuner tuner(threads);
+    TuningReport report = tuner.tune(problem);
+
+    std::cerr << "iteration,best_cost,step,evaluations,pruned\n";
+    for (std::size_t i = 0; i < report.history.size(); i++) {
+        const TuningIteration& iteration = report.history[i];
+        std::cerr << i << ',' << iteration.bestCost << ',' << iteration.step
+                  << ',' << iteration.evaluations << ','
+                  << iteration.pruned << '\n';
+    }
+    std::cerr << "cost " << report.initialCost << " -> " << report.bestCost
+              << " after " << report.evaluations << " evaluations ("
+              << report.pruned << " stopped early) in "
+              << report.elapsedSeconds << " s on " << tuner.getThreadCount()
+              << " threads\n";
+    writeSummaryCsv(std::cerr, report.scenarios, report.summaries);
+
+    const PIDGains& best = report.best;
+    std::cout << "vel_p = " << best.velP << "\nvel_i = " << best.velI
+              << "\nvel_d = " << best.velD << "\nhead_p = " << best.headP
+              << "\nhead_i = " << best.headI << "\nhead_d = " << best.headD
+              << "\n";
+    return 0;
+}
+
+/**
+ * @brief Replays every scenario against its golden trace, in parallel.
+ *
+ * One CSV line per scenario goes to stdout.
+ *
+ * @param scenarios The scenarios to replay.
+ * @param directory The directory holding <name>.traj for every scenario.
+ * @param mode What to re-run.
+ * @param tolerance The allowed difference of every value.
+ * @param threads The number of worker threads.
+ * @return 0 if every replay matched, 1 otherwise.
+ */
+static int runReplay(const std::vector<Scenario>& scenarios,
+                     const std::string& directory, ReplayMode mode,
+                     const ReplayTolerance& tolerance, std::size_t threads) {
+    std::vector<ReplayReport> reports(scenarios.size());
+    ThreadPool pool(threads);
+    pool.parallelFor(scenarios.size(), [&](std::size_t i) {
+        TrajectoryReader golden(directory + "/" + scenarios[i].name +
+                                ".traj");
+        reports[i] = replayTrace(scenarios[i], golden, mode, tolerance);
+    }, 1);
+    writeReplayCsv(std::cout, scenarios, reports);
+    for (const ReplayReport& report : reports) {
+        if (!report.passed()) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes the stage timings of every thread.
+ *
+ * @param path The report file, or "-" for stderr.
+ * @param format The report format.
+ * @return False if the file could not be written.
+ */
+static bool writeProfile(const std::string& path, ProfileFormat format) {
+    ProfileSnapshot snapshot = Profiler::snapshot();
+    if (path == "-") {
+        snapshot.write(std::cerr, format);
+        return true;
+    }
+    std::ofstream output(path);
+    snapshot.write(output, format);
+    if (!output) {
+        std::cerr << "shell-app: cannot write profile to '" << path << "'\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the scenarios in batch mode and prints one CSV line each.
+ *
+ * @param parser The parser holding the scenarios.
+ * @param threads The number of worker threads.
+ * @param recordDirectory Directory receiving one trajectory per run, or
+ *        empty to not record.
+ * @param realTime The scheduling settings when running in real time, or
+ *        nullptr to run as fast as possible.
+ * @param tune True to tune the gains instead of running the scenarios.
+ * @param replayDirectory Directory holding the golden trace of every run
+ *        to replay against, or empty to run normally.
+ * @param replayMode What a replay re-runs.
+ * @param tolerance The allowed difference of a replayed value.
+ * @param publishName Shared-memory segment the real-time runs publish
+ *        their state to, or empty to not publish.
+ * @return The process exit status.
+ */
+static int runBatch(const ScenarioParser& parser, std::size_t threads,
+                    const std::string& recordDirectory,
+                    const RealTimeOptions* realTime, bool tune,
+                    const std::string& replayDirectory, ReplayMode replayMode,
+                    double tolerance, const std::string& publishName) {
+    if (!publishName.empty() && realTime == nullptr) {
+        throw std::invalid_argument("--publish needs --realtime");
+    }
+    std::vector<Scenario> scenarios = parser.getScenarios();
+    if (tune) return runTuning(scenarios, threads);
+    if (!replayDirectory.empty()) {
+        return runReplay(scenarios, replayDirectory, replayMode,
+                         ReplayTolerance(tolerance), threads);
+    }
+    if (!recordDirectory.empty()) {
+        for (Scenario& scenario : scenarios) {
+            scenario.recordPath = recordDirectory + "/" + scenario.name +
+                                  ".traj";
+        }
+    }
+    if (realTime != nullptr) {
+        std::unique_ptr<SharedStatePublisher> publisher;
+        if (!publishName.empty()) {
+            publisher.reset(new SharedStatePublisher(publishName));
+        }
+        return runRealTime(scenarios, *realTime, publisher.get());
+    }
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    threads = std::max<std::size_t>(1, std::min(threads, scenarios.size()));
+    BatchRunner runner(threads);
+    std::vector<ScenarioSummary> summaries = runner.run(scenarios);
+    writeSummaryCsv(std::cout, scenarios, summaries);
+    return 0;
+}
 
 /**
  * @brief The main function that runs the robot simulation
  *
  * This function creates an instance of the RobotSimulation class with appropriate parameters
- * and runs the simulation for Ackermann kinematic model
+ * and runs the simulation for Ackermann kinematic model. Without options the targets are read
+ * interactively; scenario files and --set options run non-interactively in batch mode.
  *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return An integer indicating the exit s0 indicates a successful execution of code
  */
-int main() {
+int main(int argc, char** argv) {
+    // Print the simulation results on the console
+    StreamSink console(std::cout);
+    Logger::setSink(&console);
+    Logger::setLevel(LogLevel::Info);
+
+    ScenarioParser parser;
+    bool batch = false;
+    std::size_t threads = 0;
+    std::string recordDirectory;
+    bool realTime = false;
+    bool tune = false;
+    std::string replayDirectory;
+    ReplayMode replayMode = ReplayMode::ClosedLoop;
+    double tolerance = 0.0;
+    std::string profilePath;
+    ProfileFormat profileFormat = ProfileFormat::Text;
+    RealTimeOptions realTimeOptions;
+    std::string publishName;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (option == "--verbose") {
+                Logger::setLevel(LogLevel::Debug);
+            } else if (option == "--help") {
+                printUsage();
+                return 0;
+            } else if (option == "--scenario" && hasValue) {
+                parser.parseFile(argv[++i]);
+                batch = true;
+            } else if (option == "--set" && hasValue) {
+                std::string assignment = argv[++i];
+                std::size_t equals = assignment.find('=');
+                if (equals == std::string::npos) {
+                    throw std::invalid_argument("--set expects KEY=VALUE");
+                }
+                parser.setDefault(assignment.substr(0, equals),
+                                  assignment.substr(equals + 1));
+                batch = true;
+            } else if (option == "--setpoint" && i + 2 < argc) {
+                parser.setDefault("setpoint", std::string(argv[i + 1]) +
+                                  " " + argv[i + 2]);
+                i += 2;
+                batch = true;
+            } else if (option == "--threads" && hasValue) {
+                threads = std::strtoul(argv[++i], nullptr, 10);
+            } else if (option == "--record" && hasValue) {
+                recordDirectory = argv[++i];
+                batch = true;
+            } else if (option == "--replay" && hasValue) {
+                replayDirectory = argv[++i];
+                batch = true;
+            } else if (option == "--replay-mode" && hasValue) {
+                replayMode = parseReplayMode(argv[++i]);
+            } else if (option == "--tolerance" && hasValue) {
+                tolerance = parseTolerance(argv[++i]);
+            } else if (option == "--profile" && hasValue) {
+                profilePath = argv[++i];
+            } else if (option == "--profile-format" && hasValue) {
+                profileFormat = parseProfileFormat(argv[++i]);
+            } else if (option == "--tune") {
+                tune = true;
+                batch = true;
+            } else if (option == "--realtime") {
+                realTime = true;
+                batch = true;
+            } else if (option == "--priority" && hasValue) {
+                realTimeOptions.priority = std::atoi(argv[++i]);
+            } else if (option == "--cpu" && hasValue) {
+                realTimeOptions.cpu = std::atoi(argv[++i]);
+            } else if (option == "--lock-memory") {
+                realTimeOptions.lockMemory = true;
+            } else if (option == "--publish" && hasValue) {
+                publishName = argv[++i];
+            } else {
+                std::cerr << "Unknown or incomplete option: " << option
+                          << "\n";
+                printUsage();
+                return 2;
+            }
+        }
+
+        if (!profilePath.empty()) Profiler::setEnabled(true);
+        if (batch) {
+            // Keep the per-run messages out of the result table
+            if (Logger::getLevel() == LogLevel::Info) {
+                Logger::setLevel(LogLevel::Warn);
+            }
+            int status = runBatch(parser, threads, recordDirectory,
+                                  realTime ? &realTimeOptions : nullptr,
+                                  tune, replayDirectory, replayMode,
+                                  tolerance, publishName);
+            if (!profilePath.empty() &&
+                !writeProfile(profilePath, profileFormat)) {
+                status = 1;
+            }
+            Logger::setSink(nullptr);
+            return status;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << "shell-app: " << error.what() << "\n";
+        Logger::setSink(nullptr);
+        return 1;
+    }
+
     // Create an instance of RobotSimulation with appropriate parameters
     RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0,
                              0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
 
     // Running the simulation
     simulation.runSimulation(1000.0, 1000.0);
+    int status = 0;
+    if (!profilePath.empty() && !writeProfile(profilePath, profileFormat)) {
+        status = 1;
+    }
 
-    return 0;
+    Logger::setSink(nullptr);
+    return status;
 }
@@ -0,0 +1,105 @@
+/**
+ * @file statereader.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Prints the state a running shell-app publishes to shared memory.
+ * @version 0.1
+ * @date 2023
+ */
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "Clock.hpp"
+#include "LatencyHistogram.hpp"
+#include "SharedState.hpp"
+
+namespace {
+
+/**
+ * @brief Maps the segment, waiting up to ten seconds for the publisher to
+ *        create it.
+ */
+std::unique_ptr<SharedStateReader> waitForSegment(const std::string& name) {
+    for (int attempt = 0;; attempt++) {
+        try {
+            return std::unique_ptr<SharedStateReader>(
+                new SharedStateReader(name));
+        } catch (const std::runtime_error&) {
+            if (attempt == 1000) throw;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Follows the segment named on the command line.
+ *
+ * Usage: statereader NAME [COUNT]. Every update seen is printed to stdout
+ * as a CSV line, until COUNT lines were printed or the publisher closes
+ * the segment. The number of updates missed and the delay from
+ * publication to observation are then reported on stderr. The reader
+ * polls without sleeping, so it keeps one core busy.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 on success, 1 if the segment cannot be read, 2 on bad usage.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: statereader NAME [COUNT]\n";
+        return 2;
+    }
+    std::uint64_t limit = argc == 3 ? std::strtoull(argv[2], nullptr, 10)
+                                    : 0;
+
+    try {
+        std::unique_ptr<SharedStateReader> reader = waitForSegment(argv[1]);
+        std::cout << "publish_count,time,x,y,theta,heading,speed,"
+                     "velocity_command,heading_command,latency_us\n";
+        LatencyHistogram latency;
+        std::uint64_t seen = reader->getPublishCount();
+        std::uint64_t printed = 0;
+        std::uint64_t missed = 0;
+        while (limit == 0 || printed < limit) {
+            std::uint64_t count = reader->getPublishCount();
+            if (count == seen) {
+                if (!reader->isPublisherOpen()) break;
+                continue;
+            }
+            // The count is taken from the same read as the sample, which
+            // may be newer than the count polled above
+            SharedStateSample sample = reader->read(count);
+            std::uint64_t now = monotonicNow();
+            missed += count - seen - 1;
+            seen = count;
+            std::uint64_t delay = now > sample.publishTime
+                                      ? now - sample.publishTime
+                                      : 0;
+            latency.record(delay);
+            const TrajectorySample& state = sample.state;
+            std::cout << count << ',' << state.time << ',' << state.x << ','
+                      << state.y << ',' << state.theta << ','
+                      << state.heading << ',' << state.speed << ','
+                      << sample.velocityCommand << ','
+                      << sample.headingCommand << ',' << delay / 1e3 << '\n';
+            printed++;
+        }
+        std::cerr << "updates,missed,latency_p50_us,latency_p99_us,"
+                     "latency_max_us\n"
+                  << printed << ',' << missed << ','
+                  << latency.getPercentile(0.5) / 1e3 << ','
+                  << latency.getPercentile(0.99) / 1e3 << ','
+                  << latency.getMax() / 1e3 << '\n';
+        return std::cout ? 0 : 1;
+    } catch (const std::exception& error) {
+        std::cerr << "statereader: " << error.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * @file traj2csv.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Converts a binary trajectory file to CSV.
+ * @version 0.1
+ * @date 2023
+ */
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include "TrajectoryRecorder.hpp"
+
+/**
+ * @brief Converts the trajectory named on the command line.
+ *
+ * Usage: traj2csv INPUT.traj [OUTPUT.csv]. Without an output file the
+ * table is written to stdout.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 on success, 1 on a read or write error, 2 on bad usage.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: traj2csv INPUT.traj [OUTPUT.csv]\n";
+        return 2;
+    }
+
+    try {
+        TrajectoryReader reader(argv[1]);
+        if (argc == 2) {
+            writeTrajectoryCsv(std::cout, reader);
+            return std::cout ? 0 : 1;
+        }
+        std::ofstream output(argv[2]);
+        if (!output) {
+            std::cerr << "traj2csv: cannot create " << argv[2] << "\n";
+            return 1;
+        }
+        writeTrajectoryCsv(output, reader);
+        return output ? 0 : 1;
+    } catch (const std::exception& error) {
+        std::cerr << "traj2csv: " << error.what() << "\n";
+        return 1;
+    }
+}
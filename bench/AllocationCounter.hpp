@@ -0,0 +1,63 @@
+/**
+ * @file AllocationCounter.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Heap allocation counter shared by the benchmarks.
+ *
+ * bench/main.cpp replaces the global operator new to increment the counter
+ * and to track the bytes in use. Unlike the peak RSS of the process, the
+ * heap peak can be reset, so every benchmark can measure its own.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+/**
+ * @brief Retrieves the number of heap allocations made so far.
+ *
+ * @return The number of calls to the global operator new.
+ */
+std::uint64_t allocationCount();
+
+/**
+ * @brief Retrieves the heap memory in use through operator new.
+ *
+ * @return The usable size of the live allocations (bytes).
+ */
+std::uint64_t heapBytesInUse();
+
+/**
+ * @brief Retrieves the most heap memory in use since the last
+ *        resetHeapPeak().
+ *
+ * @return The peak of heapBytesInUse() (bytes).
+ */
+std::uint64_t heapPeakBytes();
+
+/**
+ * @brief Starts a new peak at the memory currently in use.
+ */
+void resetHeapPeak();
+
+/**
+ * @brief Reports per-step time and allocation counters on a benchmark.
+ *
+ * @param state The benchmark state.
+ * @param steps The number of control steps executed in total.
+ * @param allocations The number of allocations made by those steps.
+ */
+inline void reportPerStep(benchmark::State& state, double steps,
+                          std::uint64_t allocations) {
+    state.counters["time/step"] = benchmark::Counter(
+        steps, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/step"] =
+        benchmark::Counter(static_cast<double>(allocations) / steps);
+}
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,541 @@
+/**
+ * @file controller_bench.cpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Microbenchmarks of the PID controller, the Ackermann model and the
+ *        full simulation loop.
+ *
+ * Every benchmark reports the time per control step and the number of heap
+ * allocations per step.
+ * @version 0.1
+ * @date 2023
+ */
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "AllocationCounter.hpp"
+#include "BatchRunner.hpp"
+#include "ControlSession.hpp"
+#include "FixedGainPIDController.hpp"
+#include "LQRController.hpp"
+#include "MPCController.hpp"
+#include "MultiRateSimulation.hpp"
+#include "NumericSimulation.hpp"
+#include "PIDController.hpp"
+#include "Profiler.hpp"
+#include "RobotModel.hpp"
+#include "RobotSimulation.hpp"
+#include "SharedState.hpp"
+#include "SimulationContext.hpp"
+#include "SteeringTable.hpp"
+
+/**
+ * @brief computeErrors() followed by the allocation-free computeControl().
+ */
+static void BM_PIDComputeErrorsAndControl(benchmark::State& state) {
+    PIDController controller(1.0, 0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+    double measurement = 0.0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        controller.computeErrors(20.0, measurement, 0.8, measurement);
+        PIDOutput output = controller.computeControl();
+        benchmark::DoNotOptimize(output);
+        measurement += 1e-6;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_PIDComputeErrorsAndControl);
+
+/**
+ * @brief Gains of the runtime controller benchmarks, fixed at build time.
+ */
+struct BenchGains {
+    static constexpr double velP = 1.0;
+    static constexpr double velI = 0.1;
+    static constexpr double velD = 0.01;
+    static constexpr double dt = 0.1;
+    static constexpr double headP = 1.0;
+    static constexpr double headI = 0.1;
+    static constexpr double headD = 0.01;
+};
+
+/**
+ * @brief Same step as BM_PIDComputeErrorsAndControl with compile-time gains.
+ */
+static void BM_FixedGainPIDComputeErrorsAndControl(benchmark::State& state) {
+    FixedGainPIDController<BenchGains> controller;
+    double measurement = 0.0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        controller.computeErrors(20.0, measurement, 0.8, measurement);
+        PIDOutput output = controller.computeControl();
+        benchmark::DoNotOptimize(output);
+        measurement += 1e-6;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_FixedGainPIDComputeErrorsAndControl);
+
+/**
+ * @brief Compile-time gains with the I and D terms removed.
+ */
+struct BenchProportionalGains {
+    static constexpr double velP = 1.0;
+    static constexpr double velI = 0.0;
+    static constexpr double velD = 0.0;
+    static constexpr double dt = 0.1;
+    static constexpr double headP = 1.0;
+    static constexpr double headI = 0.0;
+    static constexpr double headD = 0.0;
+};
+
+/**
+ * @brief A proportional-only step with compile-time gains.
+ */
+static void BM_FixedGainPComputeErrorsAndControl(benchmark::State& state) {
+    FixedGainPIDController<BenchProportionalGains> controller;
+    double measurement = 0.0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        controller.computeErrors(20.0, measurement, 0.8, measurement);
+        PIDOutput output = controller.computeControl();
+        benchmark::DoNotOptimize(output);
+        measurement += 1e-6;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_FixedGainPComputeErrorsAndControl);
+
+/**
+ * @brief computeErrors() followed by the vector-returning computePID().
+ */
+static void BM_PIDComputeErrorsAndPID(benchmark::State& state) {
+    PIDController controller(1.0, 0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+    double measurement = 0.0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        controller.computeErrors(20.0, measurement, 0.8, measurement);
+        std::vector<double> output = controller.computePID();
+        benchmark::DoNotOptimize(output.data());
+        measurement += 1e-6;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_PIDComputeErrorsAndPID);
+
+/**
+ * @brief RobotModel::updateState() with a small steering angle.
+ */
+static void BM_RobotModelUpdateState(benchmark::State& state) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.setInitialState(0.0, 0.0, 0.0, 1.0);
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        robot.updateState(0.1, 0.01);
+        benchmark::ClobberMemory();
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_RobotModelUpdateState);
+
+/**
+ * @brief RobotModel::Simulate_robot_model() alternating left and right turns.
+ */
+static void BM_RobotModelSimulate(benchmark::State& state) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    double heading = 0.2;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        robot.Simulate_robot_model(heading, 0.001, 0.01);
+        heading = -heading;
+        benchmark::ClobberMemory();
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_RobotModelSimulate);
+
+/**
+ * @brief Same turns as BM_RobotModelSimulate with the steering geometry
+ *        looked up in a 512-interval table; state.range(0) = 1 for cubic.
+ */
+static void BM_RobotModelSimulateTable(benchmark::State& state) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.enableSteeringTable(0.6, 512,
+                              state.range(0) ? SteeringInterpolation::Cubic
+                                             : SteeringInterpolation::Linear);
+    double heading = 0.2;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        robot.Simulate_robot_model(heading, 0.001, 0.01);
+        heading = -heading;
+        benchmark::ClobberMemory();
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_RobotModelSimulateTable)->Arg(0)->Arg(1);
+
+/**
+ * @brief Steering angles swept over [-0.6, 0.6] by the geometry benchmarks.
+ */
+static std::vector<double> steeringSweep() {
+    std::vector<double> angles(1024);
+    for (std::size_t i = 0; i < angles.size(); i++) {
+        angles[i] = -0.6 + 1.2 * std::fmod(i * 0.618034, 1.0);
+    }
+    return angles;
+}
+
+/**
+ * @brief The steering geometry computed with tan and atan.
+ */
+static void BM_SteeringGeometryExact(benchmark::State& state) {
+    std::vector<double> angles = steeringSweep();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        SteeringGeometry geometry =
+            SteeringGeometry::compute(0.5, 1.0, angles[i++ & 1023]);
+        benchmark::DoNotOptimize(geometry);
+    }
+}
+BENCHMARK(BM_SteeringGeometryExact);
+
+/**
+ * @brief The steering geometry interpolated from a table of state.range(1)
+ *        intervals; state.range(0) = 1 for cubic. Reports the largest
+ *        wheel angle and speed ratio errors.
+ */
+static void BM_SteeringGeometryTable(benchmark::State& state) {
+    SteeringTable table(0.5, 1.0, 0.6,
+                        static_cast<std::size_t>(state.range(1)),
+                        state.range(0) ? SteeringInterpolation::Cubic
+                                       : SteeringInterpolation::Linear);
+    std::vector<double> angles = steeringSweep();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        SteeringGeometry geometry = table.lookup(angles[i++ & 1023]);
+        benchmark::DoNotOptimize(geometry);
+    }
+    const SteeringGeometry& error = table.getMaxError();
+    state.counters["angle_error"] =
+        std::max(error.angleMinus, error.anglePlus);
+    state.counters["ratio_error"] =
+        std::max(error.wheelRatio, error.centerRatio);
+}
+BENCHMARK(BM_SteeringGeometryTable)
+    ->ArgsProduct({{0, 1}, {64, 512, 4096}});
+
+/**
+ * @brief Full control loop of state.range(0) steps on a fresh simulation.
+ */
+static void BM_SimulationLoop(benchmark::State& state) {
+    const int horizon = static_cast<int>(state.range(0));
+    std::uint64_t allocations = 0;
+    for (auto _ : state) {
+        RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0,
+                                   0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+        std::uint64_t before = allocationCount();
+        for (int i = 0; i < horizon; i++) {
+            PIDOutput output = simulation.step(0.8, 20.0);
+            benchmark::DoNotOptimize(output);
+        }
+        allocations += allocationCount() - before;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()) * horizon,
+                  allocations);
+}
+BENCHMARK(BM_SimulationLoop)->RangeMultiplier(10)->Range(10, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief RobotSimulation::runSimulation() with its built-in iteration budget.
+ *
+ * The loop may stop early on convergence, so the per-step counters here are
+ * per call to runSimulation().
+ */
+static void BM_RunSimulation(benchmark::State& state) {
+    std::uint64_t allocations = 0;
+    for (auto _ : state) {
+        RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0,
+                                   0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+        std::uint64_t before = allocationCount();
+        simulation.runSimulation(0.8, 20.0);
+        allocations += allocationCount() - before;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocations);
+}
+BENCHMARK(BM_RunSimulation);
+
+/**
+ * @brief An empty profiled scope with recording off (0) or on (1): the
+ *        overhead the instrumentation adds to every stage.
+ */
+static void BM_ProfileScope(benchmark::State& state) {
+    Profiler::setEnabled(state.range(0) != 0);
+    for (auto _ : state) {
+        ACK_PROFILE_SCOPE(ComputeErrors);
+        benchmark::ClobberMemory();
+    }
+    Profiler::setEnabled(false);
+    Profiler::reset();
+}
+BENCHMARK(BM_ProfileScope)->Arg(0)->Arg(1);
+
+/**
+ * @brief RobotSimulation::step() with profiling off (0) or on (1); five
+ *        stages are timed per step.
+ */
+static void BM_SimulationStepProfiled(benchmark::State& state) {
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0,
+                               0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+    Profiler::setEnabled(state.range(0) != 0);
+    double target = 0.3;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        PIDOutput output = simulation.step(target, 1.0);
+        benchmark::DoNotOptimize(output);
+        target = -target;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+    Profiler::setEnabled(false);
+    Profiler::reset();
+}
+BENCHMARK(BM_SimulationStepProfiled)->Arg(0)->Arg(1);
+
+/**
+ * @brief One base tick of the single-rate loop, RobotSimulation::step(),
+ *        as the baseline of BM_MultiRateTick.
+ */
+static void BM_SingleRateTick(benchmark::State& state) {
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 0.2, 0.01, 0.01, 0.01,
+                               0.3, 0.01, 0.01);
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        PIDOutput output = simulation.step(0.3, 2.0);
+        benchmark::DoNotOptimize(output);
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_SingleRateTick);
+
+/**
+ * @brief One base tick of MultiRateSimulation with the heading, velocity
+ *        and plant divisors state.range(0), state.range(1) and
+ *        state.range(2).
+ */
+static void BM_MultiRateTick(benchmark::State& state) {
+    PIDController controller(0.2, 0.01, 0.01, 0.01, 0.3, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4.0);
+    RateConfig rates;
+    rates.headingDivisor = static_cast<std::uint32_t>(state.range(0));
+    rates.velocityDivisor = static_cast<std::uint32_t>(state.range(1));
+    rates.plantDivisor = static_cast<std::uint32_t>(state.range(2));
+    MultiRateSimulation simulation(controller, robot, rates);
+    simulation.setTargets(0.3, 2.0);
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        simulation.tick();
+        benchmark::DoNotOptimize(simulation.getCommand());
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_MultiRateTick)
+    ->Args({1, 1, 1})->Args({1, 10, 1})->Args({2, 10, 2})->Args({5, 50, 5});
+
+/**
+ * @brief One LQR control step, re-solving the Riccati equation because the
+ *        speed changes every step.
+ */
+static void BM_LQRStep(benchmark::State& state) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.setMaxSteeringAngle(0.5);
+    LQRController lqr;
+    double speed = 1.0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        robot.setInitialState(0.0, 0.0, 0.0, speed);
+        PIDOutput output = lqr.compute(robot, 0.3, 2.0, 0.1);
+        benchmark::DoNotOptimize(output);
+        speed = speed == 1.0 ? 1.5 : 1.0;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_LQRStep);
+
+/**
+ * @brief One MPC control step with a horizon of state.range(0): the
+ *        programme is rebuilt for a new speed every step, and with
+ *        state.range(1) = 1 the targets are far enough to saturate the
+ *        steering and wheel speed limits.
+ */
+static void BM_MPCStep(benchmark::State& state) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.setMaxSteeringAngle(0.2);
+    ControlTuning tuning;
+    tuning.maxWheelSpeedChange = 0.5;
+    MPCController mpc(static_cast<std::size_t>(state.range(0)), tuning);
+    double heading = state.range(1) != 0 ? 2.0 : 0.01;
+    double speed = 1.0;
+    int iterations = 0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        robot.setInitialState(0.0, 0.0, 0.0, speed);
+        mpc.reset();
+        PIDOutput output = mpc.compute(robot, heading, 4.0 * heading, 0.1);
+        benchmark::DoNotOptimize(output);
+        iterations += mpc.getLastIterations();
+        heading = -heading;
+        speed = speed == 1.0 ? 1.5 : 1.0;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+    state.counters["active_set_iterations"] = benchmark::Counter(
+        iterations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MPCStep)->Args({10, 0})->Args({20, 0})->Args({20, 1});
+
+/**
+ * @brief One step of the PID closed loop computed in T, restarting from
+ *        the initial state every 1000 steps; steps/s is the throughput.
+ */
+template <typename T>
+static void BM_NumericStep(benchmark::State& state) {
+    PIDController controller(0.1, 0.001, 0.001, 0.01, 1.0, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4.0);
+    robot.setMaxSteeringAngle(M_PI / 4.0);
+    const NumericSimulation<T> initial(controller, robot);
+    NumericSimulation<T> simulation = initial;
+    T targetHeading = NumericPolicy<T>::fromDouble(0.3);
+    T targetVelocity = NumericPolicy<T>::fromDouble(2.0);
+    int step = 0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        NumericPIDOutput<T> output =
+            simulation.step(targetHeading, targetVelocity);
+        benchmark::DoNotOptimize(output);
+        if (++step == 1000) {
+            simulation = initial;
+            step = 0;
+        }
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+    state.counters["steps/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_NumericStep, double);
+BENCHMARK_TEMPLATE(BM_NumericStep, float);
+BENCHMARK_TEMPLATE(BM_NumericStep, Fixed16);
+
+/**
+ * @brief Publishing one sample to shared memory (state.range(0) = 0), and
+ *        reading it back through a second mapping (1).
+ */
+static void BM_SharedStatePublish(benchmark::State& state) {
+    SharedStatePublisher publisher("/ackermann_bench");
+    SharedStateReader reader("/ackermann_bench");
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0,
+                               0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+    PIDOutput command = simulation.step(0.3, 2.0);
+    TrajectorySample sample = simulation.makeSample();
+    publisher.publish(sample, command);
+    bool read = state.range(0) != 0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        if (read) {
+            SharedStateSample latest = reader.read();
+            benchmark::DoNotOptimize(latest);
+        } else {
+            publisher.publish(sample, command);
+            benchmark::ClobberMemory();
+        }
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_SharedStatePublish)->Arg(0)->Arg(1);
+
+/**
+ * @brief One step of a ControlSession that receives a new command, with a
+ *        ramp, S-curve or step profile in turn, every 1000 steps.
+ */
+static void BM_ControlSessionStep(benchmark::State& state) {
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 0.1, 0.001, 0.001, 0.01,
+                               1.0, 0.01, 0.01);
+    ControlSession session(simulation);
+    const ProfileShape shapes[] = {ProfileShape::Ramp, ProfileShape::SCurve,
+                                   ProfileShape::Step};
+    int step = 0;
+    int commands = 0;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        if (step++ % 1000 == 0) {
+            bool high = commands % 2 == 0;
+            session.command(high ? 0.5 : 0.2, high ? 3.0 : 1.5,
+                            shapes[commands % 3], 2.0);
+            commands++;
+        }
+        PIDOutput output = session.step();
+        benchmark::DoNotOptimize(output);
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+}
+BENCHMARK(BM_ControlSessionStep);
+
+/**
+ * @brief Short scenarios with a steering table and an error history run
+ *        back to back on one thread, each building its own simulation (0)
+ *        or reusing a SimulationContext (1). The per-step counters are per
+ *        scenario. peak_heap_KiB is the most heap memory the variant held
+ *        above what was in use when it started, retained_heap_KiB what it
+ *        still holds after the runs; both leave out earlier benchmarks.
+ */
+static void BM_ScenarioBatch(benchmark::State& state) {
+    const std::uint64_t baseline = heapBytesInUse();
+    resetHeapPeak();
+    std::vector<Scenario> scenarios(64);
+    for (std::size_t i = 0; i < scenarios.size(); i++) {
+        scenarios[i].targetHeading = 0.01 * i;
+        scenarios[i].targetVelocity = 2.0;
+        scenarios[i].steeringTableIntervals = 256;
+        scenarios[i].errorHistory = 64;
+    }
+    SimulationContext context;
+    SimulationContext* reused = state.range(0) != 0 ? &context : nullptr;
+    for (const Scenario& scenario : scenarios) {
+        BatchRunner::runScenario(scenario, nullptr, reused);
+    }
+
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        for (const Scenario& scenario : scenarios) {
+            ScenarioSummary summary = BatchRunner::runScenario(scenario,
+                                                               nullptr,
+                                                               reused);
+            benchmark::DoNotOptimize(summary);
+        }
+    }
+    reportPerStep(state,
+                  static_cast<double>(state.iterations() * scenarios.size()),
+                  allocationCount() - before);
+    const double start = static_cast<double>(baseline);
+    state.counters["peak_heap_KiB"] =
+        (static_cast<double>(heapPeakBytes()) - start) / 1024.0;
+    state.counters["retained_heap_KiB"] =
+        (static_cast<double>(heapBytesInUse()) - start) / 1024.0;
+}
+BENCHMARK(BM_ScenarioBatch)->Arg(0)->Arg(1);
@@ -0,0 +1,166 @@
+/**
+ * @file fleet_bench.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Throughput of the RobotFleet step kernels in vehicle-steps/second,
+ *        and of the closed-loop FleetSimulation and its spatial queries.
+ * @version 0.1
+ * @date 2023
+ */
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "FleetSimulation.hpp"
+#include "RobotFleet.hpp"
+
+/**
+ * @brief Steps a fleet of state.range(0) vehicles with fixed commands.
+ *
+ * @param state The benchmark state.
+ * @param simd True to use the AVX2 kernel.
+ */
+static void stepFleet(benchmark::State& state, bool simd) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    if (simd && !RobotFleet::simdSupported()) {
+        state.SkipWithError("AVX2 is not available on this machine");
+        return;
+    }
+
+    RobotFleet fleet(count);
+    fleet.setSimdEnabled(simd);
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> command(-1.0, 1.0);
+    std::vector<double> headings(count), velocities(count);
+    for (std::size_t i = 0; i < count; i++) {
+        fleet.setGeometry(i, 0.5, 0.1, 1.0, 0.6);
+        fleet.setInitialState(i, 0.0, 0.0, 0.0, 1.0);
+        headings[i] = command(generator);
+        velocities[i] = 0.01 * command(generator);
+    }
+
+    for (auto _ : state) {
+        fleet.step(headings.data(), velocities.data(), 0.01);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["vehicle_steps/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * count),
+        benchmark::Counter::kIsRate);
+}
+
+static void BM_FleetStepScalar(benchmark::State& state) {
+    stepFleet(state, false);
+}
+
+static void BM_FleetStepAvx2(benchmark::State& state) {
+    stepFleet(state, true);
+}
+
+BENCHMARK(BM_FleetStepScalar)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_FleetStepAvx2)->RangeMultiplier(10)->Range(10, 100000);
+
+/**
+ * @brief Scatters a closed-loop fleet over a square with about one
+ *        vehicle per 25 m^2, with varied targets.
+ *
+ * @param fleet The fleet.
+ */
+static void scatterFleet(FleetSimulation& fleet) {
+    const std::size_t count = fleet.size();
+    std::mt19937 generator(7);
+    const double side = 5.0 * std::sqrt(static_cast<double>(count));
+    std::uniform_real_distribution<double> position(0.0, side);
+    std::uniform_real_distribution<double> target(-1.0, 1.0);
+    for (std::size_t i = 0; i < count; i++) {
+        fleet.getFleet().setGeometry(i, 0.5, 0.1, 1.0, 0.6);
+        fleet.getFleet().setInitialState(i, position(generator),
+                                         position(generator), 0.0, 1.0);
+        fleet.setGains(i, 0.05, 0.0, 0.0, 0.5, 0.0, 0.0);
+        fleet.setTarget(i, target(generator), 2.0 + target(generator));
+    }
+    fleet.setCellSize(5.0);
+}
+
+/**
+ * @brief One closed-loop tick: every controller, every vehicle and the
+ *        rebuild of the spatial index.
+ */
+static void BM_FleetSimulationTick(benchmark::State& state) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    FleetSimulation fleet(count, 0.01);
+    scatterFleet(fleet);
+    for (auto _ : state) {
+        fleet.step();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["ticks/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_FleetSimulationTick)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Nearest other vehicle of every vehicle, with the grid or by
+ *        scanning all vehicles.
+ */
+static void nearestOfAll(benchmark::State& state, bool useGrid) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    FleetSimulation fleet(count, 0.01);
+    scatterFleet(fleet);
+    const std::vector<double>& x = fleet.getFleet().x();
+    const std::vector<double>& y = fleet.getFleet().y();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            double distance = 0.0;
+            if (useGrid) {
+                benchmark::DoNotOptimize(fleet.nearest(i, distance));
+            } else {
+                double best = std::numeric_limits<double>::infinity();
+                for (std::size_t j = 0; j < count; j++) {
+                    double dx = x[j] - x[i];
+                    double dy = y[j] - y[i];
+                    double d2 = dx * dx + dy * dy;
+                    if (j != i && d2 < best) best = d2;
+                }
+                distance = std::sqrt(best);
+            }
+            benchmark::DoNotOptimize(distance);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_FleetNearestGrid(benchmark::State& state) {
+    nearestOfAll(state, true);
+}
+
+static void BM_FleetNearestBruteForce(benchmark::State& state) {
+    nearestOfAll(state, false);
+}
+
+BENCHMARK(BM_FleetNearestGrid)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FleetNearestBruteForce)->RangeMultiplier(10)->Range(1000, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief All pairs of vehicles within 5 m of each other.
+ */
+static void BM_FleetFindPairs(benchmark::State& state) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    FleetSimulation fleet(count, 0.01);
+    scatterFleet(fleet);
+    std::size_t pairs = 0;
+    for (auto _ : state) {
+        pairs = fleet.findPairs(5.0).size();
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["pairs"] = static_cast<double>(pairs);
+}
+BENCHMARK(BM_FleetFindPairs)->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,119 @@
+/**
+ * @file integrator_bench.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Steps each pose integrator needs to reach a given position error.
+ *
+ * The maneuver is a 10 s tightening spiral: the speed ramps from 2 to 7 m/s
+ * and the yaw rate from 0.2 to 3.2 rad/s, so the robot turns about 17 rad.
+ * Both inputs are linear in time, so a linearly interpolated input is
+ * exact at any step count. The reference end point comes from RK45 at a
+ * tolerance of 1e-13.
+ *
+ * Per scheme, the setup searches for the smallest step count whose end
+ * point is within 1 mm of the reference; the loop then times that run.
+ * The counters are the step count, the derivative evaluations and the
+ * reached error.
+ * @version 0.1
+ * @date 2023
+ */
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "Integrator.hpp"
+
+namespace {
+
+const double kDuration = 10.0;
+const double kTargetError = 1e-3;
+
+MotionInput inputAt(double t) {
+    MotionInput input;
+    input.velocity = 2.0 + 0.5 * t;
+    input.yawRate = 0.2 + 0.3 * t;
+    return input;
+}
+
+/**
+ * @brief Integrates the maneuver in equal steps.
+ *
+ * @param integrator The scheme.
+ * @param steps The step count.
+ * @param evaluations The derivative evaluations used (output).
+ * @return The end pose.
+ */
+Pose2D integrateManeuver(const Integrator& integrator, long steps,
+                         long& evaluations) {
+    Pose2D pose;
+    evaluations = 0;
+    const double dt = kDuration / steps;
+    for (long i = 0; i < steps; i++) {
+        evaluations += integrator.integrate(pose, inputAt(i * dt),
+                                            inputAt((i + 1) * dt), dt);
+    }
+    return pose;
+}
+
+double distance(const Pose2D& a, const Pose2D& b) {
+    return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+const Pose2D& reference() {
+    static const Pose2D pose = [] {
+        long evaluations;
+        return integrateManeuver(RK45Integrator(1e-13, 100000), 1,
+                                 evaluations);
+    }();
+    return pose;
+}
+
+/**
+ * @brief Finds the smallest step count reaching kTargetError.
+ *
+ * Assumes the error shrinks with the step count: doubles until the target
+ * is met, then bisects.
+ */
+long stepsToAccuracy(const Integrator& integrator) {
+    long evaluations;
+    auto within = [&](long steps) {
+        return distance(integrateManeuver(integrator, steps, evaluations),
+                        reference()) <= kTargetError;
+    };
+    long high = 1;
+    while (!within(high)) high *= 2;
+    long low = high / 2;
+    while (high - low > 1) {
+        long middle = low + (high - low) / 2;
+        if (within(middle)) {
+            high = middle;
+        } else {
+            low = middle;
+        }
+    }
+    return high;
+}
+
+}  // namespace
+
+/**
+ * @brief Times the maneuver at the step count reaching 1 mm.
+ */
+static void BM_StepsToAccuracy(benchmark::State& state,
+                               IntegrationMethod method) {
+    const Integrator& integrator = *makeIntegrator(method);
+    long steps = stepsToAccuracy(integrator);
+
+    long evaluations = 0;
+    Pose2D pose;
+    for (auto _ : state) {
+        pose = integrateManeuver(integrator, steps, evaluations);
+        benchmark::DoNotOptimize(pose);
+    }
+    state.counters["steps"] = static_cast<double>(steps);
+    state.counters["evaluations"] = static_cast<double>(evaluations);
+    state.counters["error_m"] = distance(pose, reference());
+}
+BENCHMARK_CAPTURE(BM_StepsToAccuracy, euler, IntegrationMethod::Euler);
+BENCHMARK_CAPTURE(BM_StepsToAccuracy, arc, IntegrationMethod::Arc);
+BENCHMARK_CAPTURE(BM_StepsToAccuracy, rk4, IntegrationMethod::RK4);
+BENCHMARK_CAPTURE(BM_StepsToAccuracy, rk45, IntegrationMethod::RK45);
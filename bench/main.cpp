@@ -0,0 +1,61 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the benchmark suite.
+ * @author Driver: Sameer Arjun S, Navigator: Ishaan Parikh, Design Keeper: Manav Nagda
+ */
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include "AllocationCounter.hpp"
+
+/// Number of heap allocations made by the benchmark binary so far.
+static std::atomic<std::uint64_t> allocations(0);
+/// Usable size of the live allocations, and its peak.
+static std::atomic<std::uint64_t> bytesInUse(0);
+static std::atomic<std::uint64_t> peakBytes(0);
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    std::uint64_t inUse =
+        bytesInUse.fetch_add(malloc_usable_size(ptr),
+                             std::memory_order_relaxed) +
+        malloc_usable_size(ptr);
+    std::uint64_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (inUse > peak &&
+           !peakBytes.compare_exchange_weak(peak, inUse,
+                                            std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    bytesInUse.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+std::uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t heapBytesInUse() {
+    return bytesInUse.load(std::memory_order_relaxed);
+}
+
+std::uint64_t heapPeakBytes() {
+    return peakBytes.load(std::memory_order_relaxed);
+}
+
+void resetHeapPeak() {
+    peakBytes.store(heapBytesInUse(), std::memory_order_relaxed);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/**
+ * @file recorder_bench.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Cost of recording trajectories, per recorded tick.
+ *
+ * Chunk allocation is included in the measurement, so the time per step is
+ * the amortised cost of a long recording.
+ * @version 0.1
+ * @date 2023
+ */
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include "AllocationCounter.hpp"
+#include "BatchRunner.hpp"
+#include "RobotSimulation.hpp"
+#include "TraceReplay.hpp"
+#include "TrajectoryRecorder.hpp"
+
+/**
+ * @brief Path of a scratch trajectory file for this process.
+ */
+static std::string scratchPath() {
+    return "/tmp/ackermann_bench_" + std::to_string(::getpid()) + ".traj";
+}
+
+/**
+ * @brief TrajectoryRecorder::record() alone.
+ */
+static void BM_TrajectoryRecord(benchmark::State& state) {
+    std::string path = scratchPath();
+    TrajectoryRecorder recorder;
+    recorder.open(path);
+    TrajectorySample sample = {};
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        recorder.record(sample);
+        sample.time += 0.01;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+    recorder.close();
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_TrajectoryRecord);
+
+/**
+ * @brief RobotSimulation::step() with recording off (0) or on (1).
+ */
+static void BM_SimulationStepRecorded(benchmark::State& state) {
+    std::string path = scratchPath();
+    TrajectoryRecorder recorder;
+    RobotSimulation simulation(0.5, 1.0, 0.6, 1.0, 0.1, 0.01, 0.01,
+                               1.0, 0.1, 0.01);
+    simulation.setInitialState(0.0, 0.0, 0.0, 1.0);
+    if (state.range(0) != 0) {
+        recorder.open(path);
+        simulation.setRecorder(&recorder);
+    }
+    double target = 0.3;
+    std::uint64_t before = allocationCount();
+    for (auto _ : state) {
+        PIDOutput output = simulation.step(target, 1.0);
+        benchmark::DoNotOptimize(output);
+        target = -target;
+    }
+    reportPerStep(state, static_cast<double>(state.iterations()),
+                  allocationCount() - before);
+    simulation.setRecorder(nullptr);
+    recorder.close();
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_SimulationStepRecorded)->Arg(0)->Arg(1);
+
+/**
+ * @brief replayTrace() over a 1e6-tick golden trace, in closed loop (0) or
+ *        controller (1) mode. ticks_per_second is the replay rate.
+ */
+static void BM_TraceReplay(benchmark::State& state) {
+    Scenario scenario;
+    scenario.velP = 0.2;
+    scenario.headP = 0.3;
+    scenario.targetHeading = 0.3;
+    scenario.targetVelocity = 2.0;
+    scenario.maxIterations = 1000000;
+    scenario.recordPath = scratchPath();
+    BatchRunner::runScenario(scenario);
+    TrajectoryReader golden(scenario.recordPath);
+    ReplayMode mode = state.range(0) == 0 ? ReplayMode::ClosedLoop
+                                          : ReplayMode::Controller;
+    for (auto _ : state) {
+        ReplayReport report = replayTrace(scenario, golden, mode);
+        if (!report.passed()) state.SkipWithError("replay mismatch");
+        benchmark::DoNotOptimize(report);
+    }
+    state.counters["ticks_per_second"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) *
+            static_cast<double>(golden.getSampleCount()),
+        benchmark::Counter::kIsRate);
+    std::remove(scenario.recordPath.c_str());
+}
+BENCHMARK(BM_TraceReplay)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
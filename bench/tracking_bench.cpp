@@ -0,0 +1,99 @@
+/**
+ * @file tracking_bench.cpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Per-tick latency of path tracking on a path of millions of points.
+ *
+ * The path is a 20 km sine wave sampled every centimetre: 2 million
+ * points. A RobotModel drives along it at 10 m/s with 1 ms ticks, so it
+ * passes about one segment per tick. BM_TrackingTick resumes the
+ * nearest-segment search from the previous tick. BM_TrackingTickGlobalScan
+ * projects by scanning the whole path every tick, for comparison. The
+ * counters are the tick latency percentiles from TrackingStats and the RMS
+ * cross-track error.
+ * @version 0.1
+ * @date 2023
+ */
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "PathTracker.hpp"
+#include "RobotModel.hpp"
+
+namespace {
+
+const std::size_t kPathPoints = 2000000;
+
+const std::shared_ptr<const Path>& longPath() {
+    static const std::shared_ptr<const Path> path = [] {
+        std::vector<double> x(kPathPoints), y(kPathPoints);
+        for (std::size_t i = 0; i < kPathPoints; i++) {
+            x[i] = 0.01 * i;
+            y[i] = 20.0 * std::sin(0.01 * x[i]);
+        }
+        return std::make_shared<const Path>(x, y);
+    }();
+    return path;
+}
+
+/**
+ * @brief Restarts the robot at the beginning of the path when it reaches
+ *        the end.
+ */
+void restartAtEnd(PathTracker& tracker, RobotModel& robot) {
+    if (tracker.isFinished()) {
+        robot.setInitialState(0.0, 0.0, 0.0, 10.0);
+        tracker.reset();
+    }
+}
+
+void reportStats(benchmark::State& state, const TrackingStats& stats) {
+    state.counters["p50_ns"] =
+        static_cast<double>(stats.tickLatency.getPercentile(0.5));
+    state.counters["p99_ns"] =
+        static_cast<double>(stats.tickLatency.getPercentile(0.99));
+    state.counters["rms_cross_track_mm"] = 1000.0 * stats.rmsCrossTrack();
+}
+
+}  // namespace
+
+/**
+ * @brief One tracking tick with the resumed nearest-segment search.
+ */
+static void BM_TrackingTick(benchmark::State& state, TrackingMethod method) {
+    TrackingParams params;
+    params.method = method;
+    PathTracker tracker(longPath(), 0.5, params);
+    RobotModel robot(0.5, 0.1, 1.0);
+    robot.setMaxSteeringAngle(params.maxSteeringAngle);
+    robot.setInitialState(0.0, 0.0, 0.0, 10.0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tracker.step(robot, 0.001));
+        restartAtEnd(tracker, robot);
+    }
+    reportStats(state, tracker.getStats());
+}
+BENCHMARK_CAPTURE(BM_TrackingTick, pure_pursuit, TrackingMethod::PurePursuit);
+BENCHMARK_CAPTURE(BM_TrackingTick, stanley, TrackingMethod::Stanley);
+
+/**
+ * @brief One tracking tick that scans every segment of the path.
+ */
+static void BM_TrackingTickGlobalScan(benchmark::State& state) {
+    TrackingParams params;
+    params.method = TrackingMethod::Stanley;
+    PathTracker tracker(longPath(), 0.5, params);
+    RobotModel robot(0.5, 0.1, 1.0);
+    robot.setMaxSteeringAngle(params.maxSteeringAngle);
+    robot.setInitialState(0.0, 0.0, 0.0, 10.0);
+
+    for (auto _ : state) {
+        tracker.reset();
+        benchmark::DoNotOptimize(tracker.step(robot, 0.001));
+    }
+    reportStats(state, tracker.getStats());
+}
+BENCHMARK(BM_TrackingTickGlobalScan)->Unit(benchmark::kMillisecond);
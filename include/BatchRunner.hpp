@@ -0,0 +1,87 @@
+/**
+ * @file BatchRunner.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Runs many independent simulation scenarios across cores.
+ *
+ * Every scenario owns its own RobotSimulation and results are stored by
+ * scenario index, so the summaries are bit-identical for any thread count.
+ * Every worker runs its scenarios through its own SimulationContext, so
+ * after warm-up a run makes no heap allocations.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "RealTimeExecutor.hpp"
+#include "RobotSimulation.hpp"
+#include "Scenario.hpp"
+#include "ThreadPool.hpp"
+
+class SimulationContext;
+
+class BatchRunner {
+public:
+    /**
+     * @brief Constructor for the BatchRunner class.
+     *
+     * @param threads The number of worker threads (0 = one per core).
+     */
+    explicit BatchRunner(std::size_t threads = 0);
+
+    /**
+     * @brief Runs all scenarios in parallel.
+     *
+     * @param scenarios The scenarios to run.
+     * @return One summary per scenario, in the same order.
+     */
+    std::vector<ScenarioSummary> run(const std::vector<Scenario>& scenarios);
+
+    /**
+     * @brief Builds the simulation a scenario describes, in its initial
+     *        state.
+     *
+     * @param scenario The scenario.
+     * @param context Supplies cached steering tables and the arena the
+     *        error histories are taken from, when given.
+     * @return The simulation, ready to step.
+     */
+    static RobotSimulation makeSimulation(const Scenario& scenario,
+                                          SimulationContext* context =
+                                              nullptr);
+
+    /**
+     * @brief Runs a single scenario on the calling thread.
+     *
+     * @param scenario The scenario to run.
+     * @param executor Paces the steps against the wall clock when given;
+     *        otherwise the steps run back to back.
+     * @param context Holds the simulation and its buffers when given, so
+     *        the run reuses the memory of earlier runs.
+     * @param publisher Receives the state and command after every step
+     *        when given, for other processes to read.
+     * @return The summary of the run.
+     */
+    static ScenarioSummary runScenario(const Scenario& scenario,
+                                       RealTimeExecutor* executor = nullptr,
+                                       SimulationContext* context = nullptr,
+                                       SharedStatePublisher* publisher =
+                                           nullptr);
+
+    /**
+     * @brief Retrieves the number of worker threads.
+     *
+     * @return The number of worker threads.
+     */
+    std::size_t getThreadCount() const;
+
+private:
+    ThreadPool pool_;
+};
+
+#endif // BATCH_RUNNER_HPP
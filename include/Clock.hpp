@@ -0,0 +1,33 @@
+/**
+ * @file Clock.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Monotonic timestamps shared by the latency measurements.
+ *
+ * Timestamps are CLOCK_MONOTONIC in nanoseconds, the unit LatencyHistogram
+ * records. They are comparable across threads and processes on one
+ * machine, so the shared-state reader can subtract a publisher's stamp.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <time.h>
+#include <cstdint>
+
+/**
+ * @brief Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ * @return The current time.
+ */
+inline std::uint64_t monotonicNow() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<std::uint64_t>(now.tv_sec) * 1000000000u +
+           static_cast<std::uint64_t>(now.tv_nsec);
+}
+
+#endif // CLOCK_HPP
@@ -0,0 +1,203 @@
+/**
+ * @file ConcurrentSimulation.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Controller and plant on separate threads, connected by lock-free
+ *        channels.
+ *
+ * The controller thread owns a PIDController and the plant thread owns a
+ * RobotModel. Their channels are:
+ * - setpoints: an SpscQueue from the caller to the controller; the latest
+ *   one queued before a step applies to it;
+ * - commands: an SpscQueue from the controller to the plant;
+ * - state: a Seqlock holding the latest plant state, which the controller
+ *   and any other thread read;
+ * - telemetry: an SpscQueue from the plant to one consumer, e.g. a logger
+ *   or a display.
+ *
+ * The two threads run in lockstep. Command k is computed from state k and
+ * turned into state k + 1, so a run reproduces RobotSimulation::step()
+ * exactly. The plant never waits for the telemetry consumer. When the
+ * telemetry queue is full, the sample is dropped and counted, so a slow
+ * consumer cannot stall the control loop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef CONCURRENT_SIMULATION_HPP
+#define CONCURRENT_SIMULATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "LatencyHistogram.hpp"
+#include "PIDController.hpp"
+#include "RobotModel.hpp"
+#include "Seqlock.hpp"
+#include "SpscQueue.hpp"
+
+/**
+ * @brief Target heading and velocity sent to the controller thread.
+ */
+struct Setpoint {
+    double heading = 0.0;
+    double velocity = 0.0;
+};
+
+/**
+ * @brief One control output sent from the controller to the plant thread.
+ */
+struct CommandMessage {
+    /// The step the command was computed for.
+    std::uint64_t step = 0;
+    double heading = 0.0;
+    double velocity = 0.0;
+    /// CLOCK_MONOTONIC time the command was sent, in nanoseconds.
+    std::uint64_t sentNs = 0;
+};
+
+/**
+ * @brief The plant state after a step, with the command that produced it.
+ */
+struct StateSample {
+    /// The number of steps applied; 0 is the initial state.
+    std::uint64_t step = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double theta = 0.0;
+    double heading = 0.0;
+    double speed = 0.0;
+    double headingCommand = 0.0;
+    double velocityCommand = 0.0;
+};
+
+/**
+ * @brief Channel statistics of the last run.
+ */
+struct ChannelStats {
+    /// Number of steps applied by the plant.
+    std::uint64_t steps = 0;
+    /// Number of setpoints the controller received.
+    std::uint64_t setpoints = 0;
+    /// Number of telemetry samples dropped because the queue was full.
+    std::uint64_t telemetryDropped = 0;
+    /// Time from sending a command to the plant starting to apply it.
+    LatencyHistogram commandLatency;
+    /// Time from a state being published to the command computed from it
+    /// being sent, i.e. the controller's reaction time.
+    LatencyHistogram controlLatency;
+};
+
+class ConcurrentSimulation {
+public:
+    /**
+     * @brief Constructor for the ConcurrentSimulation class.
+     *
+     * @param controller The controller, copied; its time step is the
+     *        plant's time step.
+     * @param robot The plant in its initial state, copied.
+     * @param queueCapacity The slots of every queue.
+     */
+    ConcurrentSimulation(const PIDController& controller,
+                         const RobotModel& robot,
+                         std::size_t queueCapacity = 1024);
+
+    /**
+     * @brief Stops and joins the threads.
+     */
+    ~ConcurrentSimulation();
+
+    ConcurrentSimulation(const ConcurrentSimulation&) = delete;
+    ConcurrentSimulation& operator=(const ConcurrentSimulation&) = delete;
+
+    /**
+     * @brief Queues a new setpoint for the controller. Call from one thread
+     *        only.
+     *
+     * @param heading The target heading (radians).
+     * @param velocity The target velocity.
+     * @return False if the setpoint queue is full.
+     */
+    bool setSetpoint(double heading, double velocity);
+
+    /**
+     * @brief Starts the controller and plant threads.
+     *
+     * @param maxSteps The number of steps after which both threads end.
+     * @throws std::logic_error If the threads are already running.
+     */
+    void start(std::uint64_t maxSteps);
+
+    /**
+     * @brief Asks both threads to end after the current step, and joins
+     *        them.
+     */
+    void stop();
+
+    /**
+     * @brief Waits for both threads to end.
+     *
+     * @return The channel statistics of the run.
+     */
+    const ChannelStats& join();
+
+    /**
+     * @brief Checks whether the plant is still stepping.
+     *
+     * @return True until maxSteps steps have run or stop() was called.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Takes the oldest telemetry sample. Call from one consumer
+     *        thread only.
+     *
+     * @param sample The sample (output).
+     * @return False if no sample is queued.
+     */
+    bool pollTelemetry(StateSample& sample);
+
+    /**
+     * @brief Reads the latest plant state. Safe from any thread.
+     *
+     * @return The state after the latest step.
+     */
+    StateSample getLatestState() const;
+
+    /**
+     * @brief Retrieves the channel statistics. Complete after join().
+     *
+     * @return The statistics.
+     */
+    const ChannelStats& getStats() const;
+
+private:
+    /// A published state with the time it was published.
+    struct PublishedState {
+        StateSample sample;
+        std::uint64_t publishedNs;
+    };
+
+    void runController(std::uint64_t maxSteps);
+    void runPlant(std::uint64_t maxSteps);
+    void publish(const StateSample& sample);
+
+    PIDController controller_;
+    RobotModel robot_;
+    SpscQueue<Setpoint> setpoints_;
+    SpscQueue<CommandMessage> commands_;
+    SpscQueue<StateSample> telemetry_;
+    Seqlock<PublishedState> state_;
+    std::atomic<bool> stopRequested_;
+    std::atomic<bool> running_;
+    ChannelStats stats_;
+    /// Written by the controller thread, merged into stats_ by join().
+    LatencyHistogram controlLatency_;
+    std::uint64_t setpointCount_;
+    std::thread controllerThread_;
+    std::thread plantThread_;
+};
+
+#endif // CONCURRENT_SIMULATION_HPP
@@ -0,0 +1,136 @@
+/**
+ * @file ControlSession.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Long-running closed loop whose targets can change at any step.
+ *
+ * A session owns one RobotSimulation and steps it towards setpoints that
+ * follow SetpointProfile moves. command() starts a new move from wherever
+ * the setpoints are, without rebuilding the simulation or resetting the
+ * controller, so a vehicle can follow a stream of commands in one object.
+ *
+ * A ramp or S-curve moves the setpoints smoothly, so the controller output
+ * stays smooth by itself. A step makes the setpoints jump; with bumpless
+ * transfer on (the default) the PID controller's stored errors and
+ * integral are shifted so that its output does not jump with them (see
+ * PIDController::shiftSetpoints()). The LQR and MPC controllers keep no
+ * error state, so they need no transfer.
+ *
+ * Stepping does not allocate and the session's state does not grow with
+ * the number of steps or commands.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef CONTROL_SESSION_HPP
+#define CONTROL_SESSION_HPP
+
+#include <cstdint>
+#include "RobotSimulation.hpp"
+#include "SetpointProfile.hpp"
+
+class ControlSession {
+public:
+    /**
+     * @brief Constructor for the ControlSession class.
+     *
+     * The setpoints start at the simulation's current heading and speed.
+     *
+     * @param simulation The simulation to drive, copied.
+     */
+    explicit ControlSession(const RobotSimulation& simulation);
+
+    /**
+     * @brief Starts moving both setpoints to new targets.
+     *
+     * @param heading The target heading (radians).
+     * @param velocity The target velocity.
+     * @param shape How the setpoints move.
+     * @param duration The time the move takes; ignored for a step.
+     * @throws std::invalid_argument If SetpointProfile rejects the move.
+     */
+    void command(double heading, double velocity,
+                 ProfileShape shape = ProfileShape::Step,
+                 double duration = 0.0);
+
+    /**
+     * @brief Turns bumpless transfer of step commands on or off.
+     *
+     * @param enabled True to keep the PID output continuous across steps.
+     */
+    void setBumpless(bool enabled);
+
+    /**
+     * @brief Advances the setpoints by one time step and steps the
+     *        simulation towards them.
+     *
+     * @return The controller outputs applied in this step.
+     */
+    PIDOutput step();
+
+    /**
+     * @brief Runs a number of steps.
+     *
+     * @param steps The number of steps.
+     */
+    void run(std::uint64_t steps);
+
+    /**
+     * @brief Get the heading setpoint the last step used.
+     *
+     * @return The heading setpoint (radians).
+     */
+    double getHeadingSetpoint() const;
+
+    /**
+     * @brief Get the velocity setpoint the last step used.
+     *
+     * @return The velocity setpoint.
+     */
+    double getVelocitySetpoint() const;
+
+    /**
+     * @brief Get the heading setpoint's profile.
+     *
+     * @return The profile, with its target.
+     */
+    const SetpointProfile& getHeadingProfile() const;
+
+    /**
+     * @brief Get the velocity setpoint's profile.
+     *
+     * @return The profile, with its target.
+     */
+    const SetpointProfile& getVelocityProfile() const;
+
+    /**
+     * @brief Get the number of steps run.
+     *
+     * @return The step count.
+     */
+    std::uint64_t getSteps() const;
+
+    /**
+     * @brief Get the simulation, e.g. to attach a recorder or publisher.
+     *
+     * @return The simulation.
+     */
+    RobotSimulation& getSimulation();
+
+    /**
+     * @brief Get the simulation.
+     *
+     * @return The simulation.
+     */
+    const RobotSimulation& getSimulation() const;
+
+private:
+    RobotSimulation simulation_;
+    SetpointProfile heading_;
+    SetpointProfile velocity_;
+    bool bumpless_;
+    std::uint64_t steps_;
+};
+
+#endif // CONTROL_SESSION_HPP
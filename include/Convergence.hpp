@@ -0,0 +1,116 @@
+/**
+ * @file Convergence.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief When a simulation run counts as converged or diverged, and when it
+ *        should stop.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef CONVERGENCE_HPP
+#define CONVERGENCE_HPP
+
+/**
+ * @brief Why a simulation run ended.
+ */
+enum class TerminationReason {
+    /// Both channels stayed within tolerance for the settle window.
+    Converged,
+    /// An error became non-finite or exceeded its divergence limit.
+    Diverged,
+    /// The iteration budget ran out first.
+    MaxIterations,
+};
+
+/**
+ * @brief Get the name of a termination reason, e.g. "converged".
+ *
+ * @param reason The termination reason.
+ * @return Its lower-case name.
+ */
+const char* terminationReasonName(TerminationReason reason);
+
+/**
+ * @brief Tolerances, settle window and limits of a simulation run.
+ */
+struct ConvergenceCriteria {
+    /// Largest number of control steps.
+    int maxIterations = 30;
+    /// Largest velocity error that counts as on target.
+    double velocityTolerance = 3.0;
+    /// Largest heading error (radians) that counts as on target.
+    double headingTolerance = 3.0;
+    /// Consecutive steps both channels must stay within tolerance.
+    int settleWindow = 1;
+    /// Stop as soon as the run has settled instead of using the whole
+    /// iteration budget.
+    bool stopOnConvergence = true;
+    /// Velocity error beyond which the run is abandoned as diverged.
+    double velocityDivergence = 1e6;
+    /// Heading error (radians) beyond which the run is abandoned.
+    double headingDivergence = 1e6;
+};
+
+/**
+ * @brief Applies ConvergenceCriteria to the errors of consecutive steps.
+ */
+class ConvergenceMonitor {
+public:
+    /**
+     * @brief Constructor for the ConvergenceMonitor class.
+     *
+     * @param criteria The tolerances, settle window and limits.
+     */
+    explicit ConvergenceMonitor(const ConvergenceCriteria& criteria);
+
+    /**
+     * @brief Checks the errors after one step.
+     *
+     * @param velocityError The velocity error after the step.
+     * @param headingError The heading error after the step.
+     * @return True if the run should stop: it diverged, settled with
+     *         stopOnConvergence set, or used its iteration budget.
+     */
+    bool update(double velocityError, double headingError);
+
+    /**
+     * @brief Get the reason the run ended, or would end now.
+     *
+     * @return Diverged if a limit was exceeded, Converged if the run is
+     *         settled, MaxIterations otherwise.
+     */
+    TerminationReason getReason() const;
+
+    /**
+     * @brief Checks whether both channels have been within tolerance for
+     *        the settle window, up to the latest step.
+     *
+     * @return True if settled.
+     */
+    bool isSettled() const;
+
+    /**
+     * @brief Get the first step of the current stretch within tolerance.
+     *
+     * @return The zero-based step index, or -1 if the latest step was out
+     *         of tolerance.
+     */
+    int getSettledSince() const;
+
+    /**
+     * @brief Get the number of steps checked.
+     *
+     * @return The number of steps.
+     */
+    int getSteps() const;
+
+private:
+    ConvergenceCriteria criteria_;
+    int steps_;
+    int settledSince_;
+    bool diverged_;
+};
+
+#endif // CONVERGENCE_HPP
@@ -0,0 +1,130 @@
+/**
+ * @file ErrorHistory.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Bounded ring buffer used to record recent controller errors.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef ERROR_HISTORY_HPP
+#define ERROR_HISTORY_HPP
+
+#include <cstddef>
+#include <vector>
+#include "MonotonicArena.hpp"
+
+class ErrorHistory {
+public:
+    /**
+     * @brief Constructor for the ErrorHistory class.
+     *
+     * @param capacity The maximum number of samples kept. A capacity of
+     *                 zero disables recording.
+     */
+    explicit ErrorHistory(std::size_t capacity = 0);
+
+    /**
+     * @brief Copies a history; a ring taken from an arena is shared with
+     *        the copy.
+     *
+     * @param other The history to copy.
+     */
+    ErrorHistory(const ErrorHistory& other);
+
+    /**
+     * @brief Copies a history; a ring taken from an arena is shared with
+     *        the copy.
+     *
+     * @param other The history to copy.
+     * @return This history.
+     */
+    ErrorHistory& operator=(const ErrorHistory& other);
+
+    /**
+     * @brief Moves a history, taking over its ring without copying; the
+     *        moved-from history is left empty with capacity zero.
+     *
+     * @param other The history to move.
+     */
+    ErrorHistory(ErrorHistory&& other) noexcept;
+
+    /**
+     * @brief Moves a history, taking over its ring without copying; the
+     *        moved-from history is left empty with capacity zero.
+     *
+     * @param other The history to move.
+     * @return This history.
+     */
+    ErrorHistory& operator=(ErrorHistory&& other) noexcept;
+
+    /**
+     * @brief Changes the capacity of the buffer and discards stored samples.
+     *
+     * All storage is allocated here so that push() never allocates.
+     *
+     * @param capacity The maximum number of samples kept.
+     */
+    void setCapacity(std::size_t capacity);
+
+    /**
+     * @brief Changes the capacity and takes the ring from an arena, so
+     *        that setting up a history for a run does not touch the heap.
+     *
+     * The storage is valid until the arena is reset; set the capacity
+     * again before using the history after that. Reading values()
+     * allocates its ordered copy on the heap.
+     *
+     * @param capacity The maximum number of samples kept.
+     * @param arena The arena providing the ring.
+     */
+    void setCapacity(std::size_t capacity, MonotonicArena& arena);
+
+    /**
+     * @brief Retrieves the maximum number of samples kept.
+     *
+     * @return The capacity of the buffer.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Retrieves the number of samples currently stored.
+     *
+     * @return The number of stored samples.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Records a sample, overwriting the oldest one when full.
+     *
+     * @param value The sample to record.
+     */
+    void push(double value);
+
+    /**
+     * @brief Discards all stored samples while keeping the capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Retrieves the stored samples in chronological order.
+     *
+     * @return The stored samples, oldest first.
+     */
+    const std::vector<double>& values() const;
+
+private:
+    void releaseAfterMove();
+
+    /// The ring when it is owned, empty when it comes from an arena.
+    std::vector<double> owned_;
+    double* buffer_;
+    std::size_t capacity_;
+    std::size_t next_;
+    std::size_t size_;
+    mutable std::vector<double> ordered_;
+    mutable bool dirty_;
+};
+
+#endif // ERROR_HISTORY_HPP
@@ -0,0 +1,207 @@
+/**
+ * @file Fixed16.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Signed Q16.16 fixed-point number with saturating arithmetic.
+ *
+ * A value is a 32-bit integer counting steps of 2^-16, so it covers
+ * [-32768, 32768) with a resolution of about 1.5e-5. Every operation
+ * rounds to the nearest step and saturates at the ends of the range
+ * instead of wrapping, so an overflowing controller pins its output at
+ * the limit rather than flipping sign. Division by zero saturates towards
+ * the sign of the dividend. Conversions from double saturate the same way
+ * and map NaN to zero.
+ *
+ * sin, cos, tan and atan are evaluated with polynomials in fixed-point
+ * arithmetic, to within about 1e-4 of the exact values over the ranges
+ * the robot model uses.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef FIXED16_HPP
+#define FIXED16_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+class Fixed16 {
+public:
+    /// Number of fractional bits.
+    static const int kFractionBits = 16;
+    /// The raw value of 1.0.
+    static const std::int32_t kOne = std::int32_t(1) << kFractionBits;
+
+    /**
+     * @brief Constructor for the Fixed16 class; the value is zero.
+     */
+    Fixed16() : raw_(0) {
+    }
+
+    /**
+     * @brief Builds a value from its raw representation.
+     *
+     * @param raw The value in steps of 2^-16.
+     * @return The value.
+     */
+    static Fixed16 fromRaw(std::int32_t raw) {
+        Fixed16 value;
+        value.raw_ = raw;
+        return value;
+    }
+
+    /**
+     * @brief Converts a double, rounding to the nearest step.
+     *
+     * @param value The value; out-of-range values saturate, NaN gives 0.
+     * @return The fixed-point value.
+     */
+    static Fixed16 fromDouble(double value) {
+        if (std::isnan(value)) return Fixed16();
+        return fromRaw(saturate(std::llround(std::fmax(
+            std::fmin(value * kOne, 4294967296.0), -4294967296.0))));
+    }
+
+    /**
+     * @brief Get the largest representable value.
+     *
+     * @return 32768 - 2^-16.
+     */
+    static Fixed16 max() {
+        return fromRaw(std::numeric_limits<std::int32_t>::max());
+    }
+
+    /**
+     * @brief Get the most negative representable value.
+     *
+     * @return -32768.
+     */
+    static Fixed16 lowest() {
+        return fromRaw(std::numeric_limits<std::int32_t>::min());
+    }
+
+    /**
+     * @brief Get the raw representation.
+     *
+     * @return The value in steps of 2^-16.
+     */
+    std::int32_t raw() const {
+        return raw_;
+    }
+
+    /**
+     * @brief Converts to double exactly.
+     *
+     * @return The value.
+     */
+    double toDouble() const {
+        return static_cast<double>(raw_) / kOne;
+    }
+
+    Fixed16 operator-() const {
+        return fromRaw(saturate(-static_cast<std::int64_t>(raw_)));
+    }
+
+    Fixed16& operator+=(Fixed16 other) {
+        raw_ = saturate(static_cast<std::int64_t>(raw_) + other.raw_);
+        return *this;
+    }
+
+    Fixed16& operator-=(Fixed16 other) {
+        raw_ = saturate(static_cast<std::int64_t>(raw_) - other.raw_);
+        return *this;
+    }
+
+    Fixed16& operator*=(Fixed16 other) {
+        std::int64_t product = static_cast<std::int64_t>(raw_) * other.raw_;
+        // Round half up; the shift of a negative product floors
+        raw_ = saturate((product + (std::int64_t(1) << (kFractionBits - 1)))
+                        >> kFractionBits);
+        return *this;
+    }
+
+    Fixed16& operator/=(Fixed16 other) {
+        if (other.raw_ == 0) {
+            raw_ = raw_ > 0 ? max().raw_ : raw_ < 0 ? lowest().raw_ : 0;
+            return *this;
+        }
+        std::int64_t numerator = static_cast<std::int64_t>(raw_) * kOne;
+        std::int64_t divisor = std::abs(static_cast<std::int64_t>(other.raw_));
+        // Round half away from zero; the quotient truncates towards zero
+        bool negative = (numerator < 0) != (other.raw_ < 0);
+        std::int64_t quotient = (std::abs(numerator) + divisor / 2) / divisor;
+        raw_ = saturate(negative ? -quotient : quotient);
+        return *this;
+    }
+
+    friend Fixed16 operator+(Fixed16 a, Fixed16 b) { return a += b; }
+    friend Fixed16 operator-(Fixed16 a, Fixed16 b) { return a -= b; }
+    friend Fixed16 operator*(Fixed16 a, Fixed16 b) { return a *= b; }
+    friend Fixed16 operator/(Fixed16 a, Fixed16 b) { return a /= b; }
+    friend bool operator==(Fixed16 a, Fixed16 b) { return a.raw_ == b.raw_; }
+    friend bool operator!=(Fixed16 a, Fixed16 b) { return a.raw_ != b.raw_; }
+    friend bool operator<(Fixed16 a, Fixed16 b) { return a.raw_ < b.raw_; }
+    friend bool operator>(Fixed16 a, Fixed16 b) { return a.raw_ > b.raw_; }
+    friend bool operator<=(Fixed16 a, Fixed16 b) { return a.raw_ <= b.raw_; }
+    friend bool operator>=(Fixed16 a, Fixed16 b) { return a.raw_ >= b.raw_; }
+
+private:
+    static std::int32_t saturate(std::int64_t value) {
+        if (value > std::numeric_limits<std::int32_t>::max()) {
+            return std::numeric_limits<std::int32_t>::max();
+        }
+        if (value < std::numeric_limits<std::int32_t>::min()) {
+            return std::numeric_limits<std::int32_t>::min();
+        }
+        return static_cast<std::int32_t>(value);
+    }
+
+    std::int32_t raw_;
+};
+
+/**
+ * @brief Get the absolute value, saturating -32768 to the largest value.
+ *
+ * @param value The value.
+ * @return |value|.
+ */
+inline Fixed16 abs(Fixed16 value) {
+    return value < Fixed16() ? -value : value;
+}
+
+/**
+ * @brief Get the sine.
+ *
+ * @param angle The angle (radians), any value.
+ * @return sin(angle).
+ */
+Fixed16 sin(Fixed16 angle);
+
+/**
+ * @brief Get the cosine.
+ *
+ * @param angle The angle (radians), any value.
+ * @return cos(angle).
+ */
+Fixed16 cos(Fixed16 angle);
+
+/**
+ * @brief Get the tangent, saturating near odd multiples of pi / 2.
+ *
+ * @param angle The angle (radians), any value.
+ * @return tan(angle).
+ */
+Fixed16 tan(Fixed16 angle);
+
+/**
+ * @brief Get the arc tangent.
+ *
+ * @param value The value.
+ * @return atan(value), in [-pi / 2, pi / 2].
+ */
+Fixed16 atan(Fixed16 value);
+
+#endif // FIXED16_HPP
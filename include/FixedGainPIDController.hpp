@@ -0,0 +1,232 @@
+/**
+ * @file FixedGainPIDController.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief PID controller with gains and time step fixed at compile time.
+ *
+ * The gains come from a config struct with static constexpr members:
+ *
+ *     struct CruiseGains {
+ *         static constexpr double velP = 1.0;
+ *         static constexpr double velI = 0.1;
+ *         static constexpr double velD = 0.0;
+ *         static constexpr double dt = 0.001;
+ *         static constexpr double headP = 1.0;
+ *         static constexpr double headI = 0.0;
+ *         static constexpr double headD = 0.01;
+ *     };
+ *     FixedGainPIDController<CruiseGains> controller;
+ *
+ * The class has the control interface of PIDController. Kd / dt is folded
+ * into one coefficient at compile time, and a zero gain removes its term
+ * and, for the integral, the accumulation as well. Because of the folded
+ * coefficient the derivative term can differ from PIDController's in the
+ * last bits. There is no error history; use PIDController when one is
+ * needed.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef FIXED_GAIN_PID_CONTROLLER_HPP
+#define FIXED_GAIN_PID_CONTROLLER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "PIDController.hpp"
+
+template <typename Gains>
+class FixedGainPIDController {
+public:
+    static_assert(Gains::dt > 0.0, "the time step must be positive");
+
+    static constexpr double kVelP = Gains::velP;
+    static constexpr double kVelI = Gains::velI;
+    static constexpr double kVelD = Gains::velD;
+    static constexpr double kHeadP = Gains::headP;
+    static constexpr double kHeadI = Gains::headI;
+    static constexpr double kHeadD = Gains::headD;
+    static constexpr double kDeltaT = Gains::dt;
+    /// Derivative gains divided by the time step.
+    static constexpr double kVelDOverDt = Gains::velD / Gains::dt;
+    static constexpr double kHeadDOverDt = Gains::headD / Gains::dt;
+
+    /**
+     * @brief Constructor for the FixedGainPIDController class.
+     */
+    FixedGainPIDController()
+        : velIntegralLimit(std::numeric_limits<double>::infinity()),
+          headIntegralLimit(std::numeric_limits<double>::infinity()) {
+        reset();
+    }
+
+    /**
+     * @brief Computes the PID control outputs for velocity and heading.
+     *
+     * @return A vector containing the computed PID values for velocity and
+     *         heading, or an empty vector before the first computeErrors().
+     */
+    std::vector<double> computePID() const {
+        std::vector<double> pidOut;
+        if (sampleCount == 0) return pidOut;
+        PIDOutput output = computeControl();
+        pidOut.push_back(output.velocity);
+        pidOut.push_back(output.heading);
+        return pidOut;
+    }
+
+    /**
+     * @brief Computes the PID control outputs without allocating.
+     *
+     * @return The computed PID values for velocity and heading.
+     */
+    PIDOutput computeControl() const {
+        PIDTerms terms = computeTerms();
+        PIDOutput output;
+        output.velocity = terms.velocityP + terms.velocityI + terms.velocityD;
+        output.heading = terms.headingP + terms.headingI + terms.headingD;
+        return output;
+    }
+
+    /**
+     * @brief Computes the individual terms behind computeControl().
+     *
+     * @return The latest errors and the P, I and D terms of both channels.
+     */
+    PIDTerms computeTerms() const {
+        PIDTerms terms = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        if (sampleCount == 0) return terms;
+
+        terms.velocityError = velLastError;
+        terms.headingError = headLastError;
+        // Constant conditions: a zero gain compiles to nothing
+        if (kVelP != 0.0) terms.velocityP = kVelP * velLastError;
+        if (kVelI != 0.0) terms.velocityI = kVelI * velIntegral;
+        if (kHeadP != 0.0) terms.headingP = kHeadP * headLastError;
+        if (kHeadI != 0.0) terms.headingI = kHeadI * headIntegral;
+        if (sampleCount >= 2) {
+            if (kVelD != 0.0) {
+                terms.velocityD = kVelDOverDt * (velLastError - velPrevError);
+            }
+            if (kHeadD != 0.0) {
+                terms.headingD =
+                    kHeadDOverDt * (headLastError - headPrevError);
+            }
+        }
+        return terms;
+    }
+
+    /**
+     * @brief Computes and stores the velocity and heading errors.
+     *
+     * @param targetVelocity The desired velocity.
+     * @param currentVelocity The current velocity.
+     * @param targetHeading The desired heading (in radians).
+     * @param currentHeading The current heading (in radians).
+     */
+    void computeErrors(double targetVelocity, double currentVelocity,
+                       double targetHeading, double currentHeading) {
+        double velocityError = targetVelocity - currentVelocity;
+        double headingError = targetHeading - currentHeading;
+
+        velPrevError = velLastError;
+        velLastError = velocityError;
+        headPrevError = headLastError;
+        headLastError = headingError;
+        if (kVelI != 0.0) {
+            velIntegral = std::max(-velIntegralLimit,
+                std::min(velIntegral + velocityError, velIntegralLimit));
+        }
+        if (kHeadI != 0.0) {
+            headIntegral = std::max(-headIntegralLimit,
+                std::min(headIntegral + headingError, headIntegralLimit));
+        }
+        if (sampleCount < 2) sampleCount++;
+    }
+
+    /**
+     * @brief Sets the anti-windup limits of the accumulated errors.
+     *
+     * @param velocityLimit The limit of the accumulated velocity error.
+     * @param headingLimit The limit of the accumulated heading error.
+     */
+    void setIntegralLimits(double velocityLimit, double headingLimit) {
+        velIntegralLimit = std::abs(velocityLimit);
+        headIntegralLimit = std::abs(headingLimit);
+        velIntegral = std::max(-velIntegralLimit,
+                               std::min(velIntegral, velIntegralLimit));
+        headIntegral = std::max(-headIntegralLimit,
+                                std::min(headIntegral, headIntegralLimit));
+    }
+
+    /**
+     * @brief Retrieves the accumulated velocity error.
+     *
+     * @return The running sum of velocity errors, or 0 if velI is zero.
+     */
+    double getVelocityIntegral() const { return velIntegral; }
+
+    /**
+     * @brief Retrieves the accumulated heading error.
+     *
+     * @return The running sum of heading errors, or 0 if headI is zero.
+     */
+    double getHeadingIntegral() const { return headIntegral; }
+
+    /**
+     * @brief Clears the integral and derivative state.
+     */
+    void reset() {
+        velIntegral = 0.0;
+        headIntegral = 0.0;
+        velLastError = 0.0;
+        velPrevError = 0.0;
+        headLastError = 0.0;
+        headPrevError = 0.0;
+        sampleCount = 0;
+    }
+
+    /// @name Gains, as in PIDController
+    /// @{
+    static constexpr double getVelocityProportionalConstant() { return kVelP; }
+    static constexpr double getVelocityIntegralConstant() { return kVelI; }
+    static constexpr double getVelocityDerivativeConstant() { return kVelD; }
+    static constexpr double getDeltaTime() { return kDeltaT; }
+    static constexpr double getHeadingProportionalConstant() { return kHeadP; }
+    static constexpr double getHeadingIntegralConstant() { return kHeadI; }
+    static constexpr double getHeadingDerivativeConstant() { return kHeadD; }
+    /// @}
+
+private:
+    double velIntegral;
+    double headIntegral;
+    double velIntegralLimit;
+    double headIntegralLimit;
+    double velLastError;
+    double velPrevError;
+    double headLastError;
+    double headPrevError;
+    /// Number of samples seen, saturated at 2 (enough for the D term).
+    unsigned sampleCount;
+};
+
+template <typename Gains> constexpr double FixedGainPIDController<Gains>::kVelP;
+template <typename Gains> constexpr double FixedGainPIDController<Gains>::kVelI;
+template <typename Gains> constexpr double FixedGainPIDController<Gains>::kVelD;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kHeadP;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kHeadI;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kHeadD;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kDeltaT;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kVelDOverDt;
+template <typename Gains>
+constexpr double FixedGainPIDController<Gains>::kHeadDOverDt;
+
+#endif // FIXED_GAIN_PID_CONTROLLER_HPP
@@ -0,0 +1,153 @@
+/**
+ * @file FleetSimulation.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Closed-loop simulation of many vehicle/controller pairs with a
+ *        spatial index over their positions.
+ *
+ * Every vehicle has its own PID gains and targets. A tick runs the PID math
+ * of PIDController on each vehicle, then steps the vehicle in a RobotFleet.
+ * Vehicle i matches a RobotSimulation with the same geometry, gains and
+ * targets bit for bit. The vehicles are split into chunks that the thread
+ * pool steps in parallel. After the step, a SpatialGrid is rebuilt over
+ * the new positions, so nearest() and findPairs() always see the current
+ * tick.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef FLEET_SIMULATION_HPP
+#define FLEET_SIMULATION_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "RobotFleet.hpp"
+#include "SpatialGrid.hpp"
+#include "ThreadPool.hpp"
+
+class FleetSimulation {
+public:
+    /**
+     * @brief Constructor for the FleetSimulation class.
+     *
+     * Vehicles start at rest at the origin with the default RobotFleet
+     * geometry. Their gains are the Scenario defaults and their targets are
+     * zero.
+     *
+     * @param count The number of vehicles.
+     * @param dt The time step of a tick.
+     * @param threads The number of worker threads; zero uses one per core.
+     */
+    FleetSimulation(std::size_t count, double dt, std::size_t threads = 0);
+
+    /**
+     * @brief Sets the PID gains of one vehicle.
+     *
+     * @param i The index of the vehicle.
+     * @param velP The proportional gain for velocity control.
+     * @param velI The integral gain for velocity control.
+     * @param velD The derivative gain for velocity control.
+     * @param headP The proportional gain for heading control.
+     * @param headI The integral gain for heading control.
+     * @param headD The derivative gain for heading control.
+     */
+    void setGains(std::size_t i, double velP, double velI, double velD,
+                  double headP, double headI, double headD);
+
+    /**
+     * @brief Sets the targets of one vehicle.
+     *
+     * @param i The index of the vehicle.
+     * @param heading The target heading (radians).
+     * @param velocity The target velocity.
+     */
+    void setTarget(std::size_t i, double heading, double velocity);
+
+    /**
+     * @brief Advances every vehicle by one tick and rebuilds the index.
+     */
+    void step();
+
+    /**
+     * @brief Rebuilds the index, e.g. after moving vehicles through
+     *        getFleet().
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Changes the cell size of the index and rebuilds it.
+     *
+     * @param cellSize The side of a cell; about the usual query radius
+     *        works best.
+     * @throws std::invalid_argument If the cell size is not positive.
+     */
+    void setCellSize(double cellSize);
+
+    /**
+     * @brief Finds the vehicle closest to another one.
+     *
+     * @param i The index of the vehicle.
+     * @param distance The distance between the two (output).
+     * @return The index of the closest other vehicle, or SpatialGrid::npos.
+     */
+    std::size_t nearest(std::size_t i, double& distance) const;
+
+    /**
+     * @brief Lists every pair of vehicles at most a radius apart, searching
+     *        in parallel.
+     *
+     * @param radius The largest distance of a pair.
+     * @return The pairs (i, j) with i < j, sorted.
+     */
+    std::vector<std::pair<std::size_t, std::size_t>>
+    findPairs(double radius);
+
+    /**
+     * @brief Retrieves the number of vehicles.
+     *
+     * @return The number of vehicles.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Retrieves the vehicles, e.g. to set their geometry and
+     *        initial state.
+     *
+     * @return The fleet.
+     */
+    RobotFleet& getFleet();
+
+    /**
+     * @brief Retrieves the vehicles.
+     *
+     * @return The fleet.
+     */
+    const RobotFleet& getFleet() const;
+
+    /**
+     * @brief Retrieves the index over the positions of the last tick.
+     *
+     * @return The index.
+     */
+    const SpatialGrid& getIndex() const;
+
+private:
+    void stepChunk(std::size_t begin, std::size_t end);
+
+    double dt_;
+    RobotFleet fleet_;
+    SpatialGrid index_;
+    ThreadPool pool_;
+    // PID gains, targets and state of every vehicle
+    std::vector<double> velP_, velI_, velD_;
+    std::vector<double> headP_, headI_, headD_;
+    std::vector<double> targetHeading_, targetVelocity_;
+    std::vector<double> velLast_, velPrev_, velIntegral_;
+    std::vector<double> headLast_, headPrev_, headIntegral_;
+    std::vector<unsigned char> samples_;
+    std::vector<double> headingCommand_, velocityCommand_;
+};
+
+#endif // FLEET_SIMULATION_HPP
@@ -0,0 +1,198 @@
+/**
+ * @file GainTuner.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Searches the six PID gains of a RobotSimulation automatically.
+ *
+ * A candidate is scored by running it towards every setpoint of the
+ * problem. The cost adds up, per step, the time-weighted absolute errors
+ * (which rewards fast settling), any new overshoot and the squared
+ * control outputs. The cost only grows, so a run stops as soon as it
+ * exceeds the best cost found so far.
+ *
+ * The search is a parallel pattern search. It seeds from the starting
+ * gains plus a Latin hypercube sample. Each iteration then evaluates the
+ * incumbent plus and minus one step along each gain, all in parallel. It
+ * moves to the best improvement, or halves the step when nothing
+ * improves. Candidates are judged against the cost known before the
+ * iteration, so the result does not depend on the thread count.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef GAIN_TUNER_HPP
+#define GAIN_TUNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "Scenario.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief The six gains of the velocity and heading controllers.
+ */
+struct PIDGains {
+    double velP = 0.0;
+    double velI = 0.0;
+    double velD = 0.0;
+    double headP = 0.0;
+    double headI = 0.0;
+    double headD = 0.0;
+
+    /// Number of gains.
+    static const std::size_t kCount = 6;
+
+    /**
+     * @brief Access a gain by index, in declaration order.
+     *
+     * @param index The gain index, below kCount.
+     * @return The gain.
+     */
+    double& operator[](std::size_t index);
+    double operator[](std::size_t index) const;
+
+    /**
+     * @brief Reads the gains of a scenario.
+     *
+     * @param scenario The scenario.
+     * @return Its gains.
+     */
+    static PIDGains fromScenario(const Scenario& scenario);
+
+    /**
+     * @brief Writes the gains into a scenario.
+     *
+     * @param scenario The scenario to modify.
+     */
+    void applyTo(Scenario& scenario) const;
+};
+
+/**
+ * @brief Relative weights of the cost terms.
+ */
+struct TuningWeights {
+    /// Weight of the time-weighted absolute velocity and heading errors.
+    double error = 1.0;
+    /// Weight of the largest overshoot of each channel.
+    double overshoot = 10.0;
+    /// Weight of the squared PID outputs.
+    double effort = 0.001;
+};
+
+/**
+ * @brief What to tune: the plant, the setpoints and the search box.
+ */
+struct TuningProblem {
+    /// Geometry, dt, initial state, step budget and starting gains.
+    Scenario base;
+    /// Target heading and velocity of every run; empty uses the base
+    /// scenario's targets.
+    std::vector<std::pair<double, double>> setpoints;
+    /// Lower bound of every gain.
+    PIDGains lower;
+    /// Upper bound of every gain.
+    PIDGains upper;
+    TuningWeights weights;
+
+    /**
+     * @brief Constructor, with bounds that suit the default scenario.
+     */
+    TuningProblem();
+};
+
+/**
+ * @brief Search settings.
+ */
+struct TuningOptions {
+    /// Latin hypercube samples evaluated besides the starting gains.
+    std::size_t initialSamples = 64;
+    /// First pattern step, as a fraction of each gain's range.
+    double initialStep = 0.25;
+    /// The search stops once the step falls below this fraction.
+    double minStep = 1e-3;
+    /// The search stops after this many candidate evaluations.
+    std::size_t maxEvaluations = 20000;
+    /// Seed of the initial sample.
+    std::uint32_t seed = 1;
+};
+
+/**
+ * @brief State of the search after one iteration.
+ */
+struct TuningIteration {
+    double bestCost = 0.0;
+    double step = 0.0;
+    /// Candidates evaluated in this iteration.
+    std::size_t evaluations = 0;
+    /// Candidates stopped early because they could not win.
+    std::size_t pruned = 0;
+};
+
+/**
+ * @brief Outcome of a tuning run.
+ */
+struct TuningReport {
+    PIDGains best;
+    double bestCost = std::numeric_limits<double>::infinity();
+    /// Cost of the starting gains.
+    double initialCost = std::numeric_limits<double>::infinity();
+    std::size_t evaluations = 0;
+    std::size_t pruned = 0;
+    double elapsedSeconds = 0.0;
+    /// Iteration 0 is the initial sample.
+    std::vector<TuningIteration> history;
+    /// The runs of the best gains, one per setpoint.
+    std::vector<Scenario> scenarios;
+    std::vector<ScenarioSummary> summaries;
+};
+
+class GainTuner {
+public:
+    /**
+     * @brief Constructor for the GainTuner class.
+     *
+     * @param threads The number of worker threads (0 = one per core).
+     */
+    explicit GainTuner(std::size_t threads = 0);
+
+    /**
+     * @brief Searches for the gains with the lowest cost.
+     *
+     * @param problem The plant, setpoints and bounds.
+     * @param options The search settings.
+     * @return The best gains and a convergence report.
+     * @throws std::invalid_argument If a lower bound exceeds its upper
+     *         bound or the base scenario has no steps.
+     */
+    TuningReport tune(const TuningProblem& problem,
+                      const TuningOptions& options = TuningOptions());
+
+    /**
+     * @brief Computes the cost of a set of gains.
+     *
+     * @param problem The plant, setpoints and weights.
+     * @param gains The gains to score.
+     * @param bound The run stops as soon as the cost exceeds this value.
+     * @return The cost; a value above the bound when stopped early, or
+     *         infinity if the simulation diverged.
+     */
+    static double evaluate(const TuningProblem& problem, const PIDGains& gains,
+                           double bound =
+                               std::numeric_limits<double>::infinity());
+
+    /**
+     * @brief Retrieves the number of worker threads.
+     *
+     * @return The number of worker threads.
+     */
+    std::size_t getThreadCount() const;
+
+private:
+    ThreadPool pool_;
+};
+
+#endif // GAIN_TUNER_HPP
@@ -0,0 +1,174 @@
+/**
+ * @file Integrator.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Integration schemes for the planar pose of the Ackermann model.
+ *
+ * The pose (x, y, theta) follows x' = v cos(theta), y' = v sin(theta) and
+ * theta' = omega. The speed v and yaw rate omega vary linearly over a step,
+ * from the start input to the end input. RobotModel holds them constant.
+ *
+ * - Euler is first order. It reproduces the original updateState().
+ * - Arc follows the circular arc of the mean input. It is exact for a
+ *   constant input.
+ * - RK4 is the classic fourth-order Runge-Kutta scheme.
+ * - RK45 is the Dormand-Prince 5(4) pair. It splits the step into substeps
+ *   until the local error estimate is within tolerance.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef INTEGRATOR_HPP
+#define INTEGRATOR_HPP
+
+#include <memory>
+#include <string>
+
+/**
+ * @brief Position and orientation of the robot in the plane.
+ */
+struct Pose2D {
+    double x = 0.0;
+    double y = 0.0;
+    /// Orientation in radians.
+    double theta = 0.0;
+};
+
+/**
+ * @brief Speed and yaw rate driving the pose.
+ */
+struct MotionInput {
+    double velocity = 0.0;
+    /// Rate of change of theta, in radians per second.
+    double yawRate = 0.0;
+};
+
+/**
+ * @brief Advances a pose by one time step.
+ */
+class Integrator {
+public:
+    virtual ~Integrator() = default;
+
+    /**
+     * @brief Advances the pose by dt. The inputs vary linearly from start
+     *        to end over the step.
+     *
+     * @param pose The pose to advance (input and output).
+     * @param start The input at the beginning of the step.
+     * @param end The input at the end of the step.
+     * @param dt The time step.
+     * @return The number of derivative evaluations used.
+     */
+    virtual int integrate(Pose2D& pose, const MotionInput& start,
+                          const MotionInput& end, double dt) const = 0;
+};
+
+/**
+ * @brief Explicit Euler with the start input.
+ */
+class EulerIntegrator : public Integrator {
+public:
+    int integrate(Pose2D& pose, const MotionInput& start,
+                  const MotionInput& end, double dt) const override;
+};
+
+/**
+ * @brief Moves along the circular arc of the mean input.
+ */
+class ArcIntegrator : public Integrator {
+public:
+    int integrate(Pose2D& pose, const MotionInput& start,
+                  const MotionInput& end, double dt) const override;
+};
+
+/**
+ * @brief Classic fourth-order Runge-Kutta.
+ */
+class RK4Integrator : public Integrator {
+public:
+    int integrate(Pose2D& pose, const MotionInput& start,
+                  const MotionInput& end, double dt) const override;
+};
+
+/**
+ * @brief Adaptive Dormand-Prince 5(4) with local error control.
+ */
+class RK45Integrator : public Integrator {
+public:
+    /**
+     * @brief Constructor for the RK45Integrator class.
+     *
+     * @param tolerance The largest accepted local error of any pose
+     *        component, relative to max(1, |component|).
+     * @param maxSubsteps The largest number of trial substeps per step.
+     */
+    explicit RK45Integrator(double tolerance = 1e-6, int maxSubsteps = 1000);
+
+    /**
+     * @brief Advances the pose by dt in as many substeps as the tolerance
+     *        requires.
+     *
+     * @param pose The pose to advance (input and output).
+     * @param start The input at the beginning of the step.
+     * @param end The input at the end of the step.
+     * @param dt The time step.
+     * @return The number of derivative evaluations used.
+     * @throws std::runtime_error If the tolerance is not met within
+     *         maxSubsteps trial substeps.
+     */
+    int integrate(Pose2D& pose, const MotionInput& start,
+                  const MotionInput& end, double dt) const override;
+
+    /**
+     * @brief Retrieves the local error tolerance.
+     *
+     * @return The tolerance.
+     */
+    double getTolerance() const;
+
+private:
+    double tolerance_;
+    int maxSubsteps_;
+};
+
+/**
+ * @brief Integration schemes selectable by name.
+ */
+enum class IntegrationMethod {
+    Euler,
+    Arc,
+    RK4,
+    RK45,
+};
+
+/**
+ * @brief Get the name of an integration method: euler, arc, rk4 or rk45.
+ *
+ * @param method The integration method.
+ * @return Its lower-case name.
+ */
+const char* integrationMethodName(IntegrationMethod method);
+
+/**
+ * @brief Parses the name of an integration method.
+ *
+ * @param name One of euler, arc, rk4 or rk45.
+ * @return The integration method.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+IntegrationMethod parseIntegrationMethod(const std::string& name);
+
+/**
+ * @brief Get a shared integrator with default settings.
+ *
+ * The integrators are stateless, so one instance serves every model and
+ * thread.
+ *
+ * @param method The integration method.
+ * @return The integrator.
+ */
+std::shared_ptr<const Integrator> makeIntegrator(IntegrationMethod method);
+
+#endif // INTEGRATOR_HPP
@@ -0,0 +1,116 @@
+/**
+ * @file LQRController.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Discrete linear-quadratic regulator of heading and speed.
+ *
+ * The regulator minimises the sum over all future steps of
+ * e' Q e + u' R u for the linearized model of LinearizedModel.hpp, where e
+ * is the error from the targets. The optimal input is u = -K e with the
+ * gain K from the discrete algebraic Riccati equation, solved by fixed
+ * point iteration. The model depends on the speed, so the gain is solved
+ * again whenever the operating point moves. Inputs beyond the steering
+ * and wheel speed limits are clipped.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef LQR_CONTROLLER_HPP
+#define LQR_CONTROLLER_HPP
+
+#include "LinearizedModel.hpp"
+#include "PIDController.hpp"
+#include "RobotModel.hpp"
+
+class LQRController {
+public:
+    /**
+     * @brief Constructor for the LQRController class.
+     *
+     * @param tuning The weights and limits.
+     * @throws std::invalid_argument If the tuning is invalid.
+     */
+    explicit LQRController(const ControlTuning& tuning = ControlTuning());
+
+    /**
+     * @brief Solves the discrete algebraic Riccati equation
+     *        P = Q + A'PA - A'PB (R + B'PB)^-1 B'PA.
+     *
+     * @param model The model supplying A and B.
+     * @param stateWeights The state weights Q.
+     * @param inputWeights The input weights R.
+     * @return The cost-to-go matrix P.
+     * @throws std::runtime_error If the iteration does not converge.
+     */
+    static Matrix<kModelStates, kModelStates> solveRiccati(
+        const LinearizedModel& model,
+        const Matrix<kModelStates, kModelStates>& stateWeights,
+        const Matrix<kModelInputs, kModelInputs>& inputWeights);
+
+    /**
+     * @brief Uses a model and computes its gain.
+     *
+     * @param model The model.
+     */
+    void setModel(const LinearizedModel& model);
+
+    /**
+     * @brief Computes the input that drives an error to zero.
+     *
+     * @param error The heading and speed errors from the targets.
+     * @return The input, within the limits of the model.
+     */
+    ModelInput control(const ModelState& error) const;
+
+    /**
+     * @brief Runs one control step: linearizes the robot at its current
+     *        speed and computes the input towards the targets.
+     *
+     * @param robot The robot in its current state.
+     * @param targetHeading The desired heading (radians).
+     * @param targetVelocity The desired speed.
+     * @param dt The time step.
+     * @return The steering angle as heading and the wheel speed change as
+     *         velocity, as RobotModel::Simulate_robot_model() takes them.
+     */
+    PIDOutput compute(const RobotModel& robot, double targetHeading,
+                      double targetVelocity, double dt);
+
+    /**
+     * @brief Get the gain K of the current model.
+     *
+     * @return The gain.
+     */
+    const Matrix<kModelInputs, kModelStates>& getGain() const;
+
+    /**
+     * @brief Get the cost-to-go matrix P of the current model.
+     *
+     * @return The solution of the Riccati equation.
+     */
+    const Matrix<kModelStates, kModelStates>& getCostToGo() const;
+
+    /**
+     * @brief Get the model the gain was computed for.
+     *
+     * @return The model.
+     */
+    const LinearizedModel& getModel() const;
+
+    /**
+     * @brief Get the weights and limits.
+     *
+     * @return The tuning.
+     */
+    const ControlTuning& getTuning() const;
+
+private:
+    ControlTuning tuning_;
+    LinearizedModel model_;
+    bool hasModel_;
+    Matrix<kModelStates, kModelStates> costToGo_;
+    Matrix<kModelInputs, kModelStates> gain_;
+};
+
+#endif // LQR_CONTROLLER_HPP
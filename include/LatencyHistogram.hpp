@@ -0,0 +1,128 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Fixed-size log-linear histogram of durations in nanoseconds.
+ *
+ * Values below 32 ns are counted exactly; above that every power of two is
+ * split into 16 buckets, so a reported percentile is within about 6% of
+ * the true value. Recording never allocates.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class LatencyHistogram {
+public:
+    /// Number of buckets, enough for any 64-bit value.
+    static const std::size_t kBucketCount = 976;
+
+    /**
+     * @brief Constructor for the LatencyHistogram class.
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Adds one duration.
+     *
+     * @param nanoseconds The duration in nanoseconds.
+     */
+    void record(std::uint64_t nanoseconds) {
+        buckets_[bucketOf(nanoseconds)]++;
+        if (count_ == 0 || nanoseconds < min_) min_ = nanoseconds;
+        if (nanoseconds > max_) max_ = nanoseconds;
+        count_++;
+        sum_ += nanoseconds;
+    }
+
+    /**
+     * @brief Adds every value of another histogram.
+     *
+     * @param other The histogram to merge into this one.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Removes every value.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of recorded values.
+     *
+     * @return The number of values.
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * @brief Get the smallest recorded value.
+     *
+     * @return The minimum in nanoseconds, or 0 if empty.
+     */
+    std::uint64_t getMin() const;
+
+    /**
+     * @brief Get the largest recorded value.
+     *
+     * @return The maximum in nanoseconds, or 0 if empty.
+     */
+    std::uint64_t getMax() const;
+
+    /**
+     * @brief Get the sum of the recorded values.
+     *
+     * @return The sum in nanoseconds.
+     */
+    std::uint64_t getSum() const;
+
+    /**
+     * @brief Get the mean of the recorded values.
+     *
+     * @return The mean in nanoseconds, or 0 if empty.
+     */
+    double getMean() const;
+
+    /**
+     * @brief Get the value below which a fraction of the values fall.
+     *
+     * @param fraction The fraction, from 0 to 1 (e.g. 0.99).
+     * @return The upper edge of the bucket holding that value, clamped to
+     *         the recorded range, or 0 if empty.
+     */
+    std::uint64_t getPercentile(double fraction) const;
+
+    /**
+     * @brief Get the bucket index of a value.
+     *
+     * @param value The value in nanoseconds.
+     * @return The bucket index, below kBucketCount.
+     */
+    static std::size_t bucketOf(std::uint64_t value) {
+        if (value < 32) return static_cast<std::size_t>(value);
+        unsigned exponent = 59 - static_cast<unsigned>(__builtin_clzll(value));
+        return 16 * exponent + static_cast<std::size_t>(value >> exponent);
+    }
+
+    /**
+     * @brief Get the largest value counted in a bucket.
+     *
+     * @param bucket The bucket index.
+     * @return The upper edge of the bucket, inclusive.
+     */
+    static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+private:
+    std::uint64_t buckets_[kBucketCount];
+    std::uint64_t count_;
+    std::uint64_t min_;
+    std::uint64_t max_;
+    std::uint64_t sum_;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,157 @@
+/**
+ * @file LinearizedModel.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Kinematic bicycle model of RobotModel, linearized for the LQR and
+ *        MPC controllers.
+ *
+ * The state is the heading and speed the controllers regulate, and the
+ * inputs are what RobotModel::Simulate_robot_model() takes: the steering
+ * angle and the change of the driven wheel's angular velocity. Over one
+ * step of dt the robot follows the bicycle model
+ *
+ *     heading' = heading + dt * tan(steering) / wheelbase * speed'
+ *     speed'   = speed + wheelRadius * wheelSpeedChange
+ *
+ * Linearized about driving straight at speed v this is x' = A x + B u with
+ *
+ *     A = | 1  0 |    B = | dt * v / wheelbase  0           |
+ *         | 0  1 |        | 0                   wheelRadius |
+ *
+ * Holding a heading and speed needs no input, so the controllers act on
+ * the error from the targets.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef LINEARIZED_MODEL_HPP
+#define LINEARIZED_MODEL_HPP
+
+#include <limits>
+#include <string>
+#include "Matrix.hpp"
+#include "RobotModel.hpp"
+
+/// Number of states of the linearized model: heading and speed.
+const std::size_t kModelStates = 2;
+/// Number of inputs: steering angle and wheel speed change.
+const std::size_t kModelInputs = 2;
+
+using ModelState = Matrix<kModelStates, 1>;
+using ModelInput = Matrix<kModelInputs, 1>;
+
+/**
+ * @brief Discrete-time linear model x' = A x + B u of one control step,
+ *        with the bounds on the inputs.
+ */
+struct LinearizedModel {
+    Matrix<kModelStates, kModelStates> A;
+    Matrix<kModelStates, kModelInputs> B;
+    /// Largest steering angle (radians).
+    double maxSteeringAngle = 0.0;
+    /// Largest change of the wheel's angular velocity per step.
+    double maxWheelSpeedChange = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Weights and limits of the LQR and MPC controllers.
+ */
+struct ControlTuning {
+    /// Cost of a squared heading error (per rad^2).
+    double headingWeight = 1.0;
+    /// Cost of a squared speed error.
+    double speedWeight = 1.0;
+    /// Cost of a squared steering angle (per rad^2).
+    double steeringWeight = 0.1;
+    /// Cost of a squared wheel speed change.
+    double wheelSpeedWeight = 0.1;
+    /// The model is linearized at no less than this speed, so that the
+    /// heading stays controllable from a standstill.
+    double minimumSpeed = 0.5;
+    /// Largest change of the wheel's angular velocity per step.
+    double maxWheelSpeedChange = std::numeric_limits<double>::infinity();
+
+    /**
+     * @brief Checks the weights before a controller is built from them.
+     *
+     * @throws std::invalid_argument If a state weight is negative, an input
+     *         weight is not positive or a limit is not positive.
+     */
+    void validate() const;
+
+    /**
+     * @brief Get the state weight matrix Q.
+     *
+     * @return The diagonal of heading and speed weights.
+     */
+    Matrix<kModelStates, kModelStates> stateWeights() const {
+        return Matrix<kModelStates, kModelStates>::diagonal(
+            {headingWeight, speedWeight});
+    }
+
+    /**
+     * @brief Get the input weight matrix R.
+     *
+     * @return The diagonal of steering and wheel speed weights.
+     */
+    Matrix<kModelInputs, kModelInputs> inputWeights() const {
+        return Matrix<kModelInputs, kModelInputs>::diagonal(
+            {steeringWeight, wheelSpeedWeight});
+    }
+};
+
+/**
+ * @brief The controller RobotSimulation::step() uses.
+ */
+enum class ControlMode {
+    /// The two PID loops of PIDController.
+    PID,
+    /// Infinite-horizon linear-quadratic regulator, see LQRController.
+    LQR,
+    /// Model predictive control over a short horizon, see MPCController.
+    MPC,
+};
+
+/**
+ * @brief Get the name of a control mode, as accepted by parseControlMode().
+ *
+ * @param mode The control mode.
+ * @return One of pid, lqr or mpc.
+ */
+const char* controlModeName(ControlMode mode);
+
+/**
+ * @brief Parses the name of a control mode.
+ *
+ * @param name One of pid, lqr or mpc.
+ * @return The control mode.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+ControlMode parseControlMode(const std::string& name);
+
+/**
+ * @brief Linearizes a robot about driving straight at a speed.
+ *
+ * @param robot Supplies the wheelbase, wheel radius and steering limit.
+ * @param speed The operating speed.
+ * @param dt The time step.
+ * @param tuning Supplies the minimum speed and the wheel speed limit.
+ * @return The model of one step.
+ */
+LinearizedModel linearizeRobotModel(const RobotModel& robot, double speed,
+                                    double dt,
+                                    const ControlTuning& tuning =
+                                        ControlTuning());
+
+/**
+ * @brief Checks whether two models have the same matrices and limits, so a
+ *        controller can keep what it derived from the first.
+ *
+ * @param a The first model.
+ * @param b The second model.
+ * @return True if they are identical.
+ */
+bool sameModel(const LinearizedModel& a, const LinearizedModel& b);
+
+#endif // LINEARIZED_MODEL_HPP
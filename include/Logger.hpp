@@ -0,0 +1,307 @@
+/**
+ * @file Logger.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Levelled logging with pluggable sinks for the control loop.
+ *
+ * Log statements go through the ACK_LOG_* macros. Levels below
+ * ACKERMANN_LOG_COMPILE_LEVEL are removed by the preprocessor, and enabled
+ * levels cost a single relaxed load when no sink is installed, which is
+ * the default for library use.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+/**
+ * @brief Lowest log level compiled into the binary (0 = Trace, 5 = Off).
+ */
+#ifndef ACKERMANN_LOG_COMPILE_LEVEL
+#define ACKERMANN_LOG_COMPILE_LEVEL 0
+#endif
+
+/**
+ * @brief Severity of a log message.
+ */
+enum class LogLevel : int {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * @brief Destination of formatted log messages.
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Writes one log message.
+     *
+     * @param level The severity of the message.
+     * @param message The message text, without a trailing newline.
+     * @param length The number of characters in the message.
+     */
+    virtual void write(LogLevel level, const char* message,
+                       std::size_t length) = 0;
+};
+
+/**
+ * @brief Sink that discards every message.
+ */
+class NullSink : public LogSink {
+public:
+    void write(LogLevel level, const char* message,
+               std::size_t length) override;
+};
+
+/**
+ * @brief Sink that writes one line per message to an output stream.
+ */
+class StreamSink : public LogSink {
+public:
+    /**
+     * @brief Constructor for the StreamSink class.
+     *
+     * @param stream The stream receiving the messages.
+     */
+    explicit StreamSink(std::ostream& stream);
+
+    void write(LogLevel level, const char* message,
+               std::size_t length) override;
+
+private:
+    std::ostream& stream_;
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Lock-free in-memory sink drained by a background thread.
+ *
+ * Producers copy messages into a bounded multi-producer queue of fixed-size
+ * slots and never block; messages are dropped and counted when the queue is
+ * full. A single consumer, either the background thread started with
+ * start() or a caller of drain(), forwards them to a downstream sink.
+ */
+class RingBufferSink : public LogSink {
+public:
+    /// Longest message stored in a slot; longer messages are truncated.
+    static const std::size_t kMaxMessageLength = 240;
+
+    /**
+     * @brief Constructor for the RingBufferSink class.
+     *
+     * @param capacity The number of slots, rounded up to a power of two.
+     */
+    explicit RingBufferSink(std::size_t capacity = 1024);
+
+    /**
+     * @brief Stops the background thread and drains pending messages.
+     */
+    ~RingBufferSink() override;
+
+    void write(LogLevel level, const char* message,
+               std::size_t length) override;
+
+    /**
+     * @brief Starts a background thread forwarding messages to a sink.
+     *
+     * @param downstream The sink receiving the drained messages.
+     */
+    void start(LogSink& downstream);
+
+    /**
+     * @brief Stops the background thread after draining pending messages.
+     */
+    void stop();
+
+    /**
+     * @brief Forwards all pending messages to a sink on the calling thread.
+     *
+     * Must not be called while the background thread is running.
+     *
+     * @param downstream The sink receiving the drained messages.
+     * @return The number of messages forwarded.
+     */
+    std::size_t drain(LogSink& downstream);
+
+    /**
+     * @brief Retrieves the number of messages dropped because of overflow.
+     *
+     * @return The number of dropped messages.
+     */
+    std::uint64_t getDroppedCount() const;
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogLevel level;
+        std::size_t length;
+        char text[kMaxMessageLength];
+    };
+
+    bool pop(LogSink& downstream);
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    std::atomic<std::size_t> enqueuePos_;
+    std::atomic<std::size_t> dequeuePos_;
+    std::atomic<std::uint64_t> dropped_;
+    std::atomic<bool> running_;
+    std::thread worker_;
+};
+
+/**
+ * @brief Process-wide logger configuration.
+ */
+class Logger {
+public:
+    /**
+     * @brief Installs the sink receiving all messages.
+     *
+     * The sink must outlive its use by the logger. Passing nullptr restores
+     * the silent default.
+     *
+     * @param sink The sink to install.
+     */
+    static void setSink(LogSink* sink);
+
+    /**
+     * @brief Retrieves the installed sink.
+     *
+     * @return The installed sink, or nullptr when logging is silent.
+     */
+    static LogSink* getSink();
+
+    /**
+     * @brief Sets the lowest level forwarded to the sink.
+     *
+     * @param level The lowest enabled level.
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * @brief Retrieves the lowest level forwarded to the sink.
+     *
+     * @return The lowest enabled level.
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Checks whether a message of the given level would be written.
+     *
+     * @param level The level of the message.
+     * @return True if a sink is installed and the level is enabled.
+     */
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >=
+               threshold_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static void updateThreshold();
+
+    static std::atomic<LogSink*> sink_;
+    static std::atomic<int> level_;
+    static std::atomic<int> threshold_;
+};
+
+/**
+ * @brief Formats a single log message on the stack and emits it on scope exit.
+ */
+class LogLine {
+public:
+    /**
+     * @brief Constructor for the LogLine class.
+     *
+     * @param level The severity of the message being formatted.
+     */
+    explicit LogLine(LogLevel level);
+
+    /**
+     * @brief Writes the formatted message to the installed sink.
+     */
+    ~LogLine();
+
+    /**
+     * @brief Retrieves the stream used to format the message.
+     *
+     * @return The formatting stream.
+     */
+    std::ostream& stream() { return stream_; }
+
+private:
+    class FixedBuffer : public std::streambuf {
+    public:
+        FixedBuffer(char* begin, std::size_t size) {
+            setp(begin, begin + size);
+        }
+        std::size_t length() const {
+            return static_cast<std::size_t>(pptr() - pbase());
+        }
+    };
+
+    LogLevel level_;
+    char text_[RingBufferSink::kMaxMessageLength];
+    FixedBuffer buffer_;
+    std::ostream stream_;
+};
+
+/**
+ * @brief Logs a streamed expression at the given level when enabled.
+ */
+#define ACK_LOG(level, expr)                       \
+    do {                                           \
+        if (Logger::enabled(level)) {              \
+            LogLine ackLogLine_(level);            \
+            ackLogLine_.stream() << expr;          \
+        }                                          \
+    } while (0)
+
+#if ACKERMANN_LOG_COMPILE_LEVEL <= 0
+#define ACK_LOG_TRACE(expr) ACK_LOG(LogLevel::Trace, expr)
+#else
+#define ACK_LOG_TRACE(expr) do {} while (0)
+#endif
+
+#if ACKERMANN_LOG_COMPILE_LEVEL <= 1
+#define ACK_LOG_DEBUG(expr) ACK_LOG(LogLevel::Debug, expr)
+#else
+#define ACK_LOG_DEBUG(expr) do {} while (0)
+#endif
+
+#if ACKERMANN_LOG_COMPILE_LEVEL <= 2
+#define ACK_LOG_INFO(expr) ACK_LOG(LogLevel::Info, expr)
+#else
+#define ACK_LOG_INFO(expr) do {} while (0)
+#endif
+
+#if ACKERMANN_LOG_COMPILE_LEVEL <= 3
+#define ACK_LOG_WARN(expr) ACK_LOG(LogLevel::Warn, expr)
+#else
+#define ACK_LOG_WARN(expr) do {} while (0)
+#endif
+
+#if ACKERMANN_LOG_COMPILE_LEVEL <= 4
+#define ACK_LOG_ERROR(expr) ACK_LOG(LogLevel::Error, expr)
+#else
+#define ACK_LOG_ERROR(expr) do {} while (0)
+#endif
+
+#endif // LOGGER_HPP
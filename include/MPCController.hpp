@@ -0,0 +1,143 @@
+/**
+ * @file MPCController.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Model predictive control of heading and speed with input limits.
+ *
+ * Every step the controller plans the inputs u_0 ... u_{N-1} of the next N
+ * steps that minimise
+ *
+ *     sum_k e_{k+1}' Q e_{k+1} + u_k' R u_k
+ *
+ * for the linearized model, with the LQR cost-to-go P in place of Q on the
+ * last state, subject to the steering and wheel speed limits. Only u_0 is
+ * applied. Without active limits the plan matches the LQR gain; with them
+ * the controller plans around the saturation instead of clipping.
+ *
+ * The states are eliminated (condensed form), which leaves a quadratic
+ * programme in the 2N inputs with box constraints. It is solved exactly by
+ * a primal active-set method: each iteration solves for the free inputs by
+ * Cholesky factorisation and then either fixes the first input that hits
+ * a bound or releases a bound whose multiplier has the wrong sign. The
+ * plan of the previous step, shifted by one, is the starting point. All
+ * matrices have a fixed maximum size and are stored inside the controller
+ * or on the stack, so a solve never touches the heap.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef MPC_CONTROLLER_HPP
+#define MPC_CONTROLLER_HPP
+
+#include <cstddef>
+#include "LinearizedModel.hpp"
+#include "PIDController.hpp"
+#include "RobotModel.hpp"
+
+class MPCController {
+public:
+    /// Longest horizon the fixed-size storage holds.
+    static const std::size_t kMaxHorizon = 20;
+
+    /**
+     * @brief Constructor for the MPCController class.
+     *
+     * @param horizon The number of steps planned, in [1, kMaxHorizon].
+     * @param tuning The weights and limits.
+     * @throws std::invalid_argument If the horizon or tuning is invalid.
+     */
+    explicit MPCController(std::size_t horizon = kMaxHorizon,
+                           const ControlTuning& tuning = ControlTuning());
+
+    /**
+     * @brief Uses a model and builds the quadratic programme for it.
+     *
+     * @param model The model.
+     */
+    void setModel(const LinearizedModel& model);
+
+    /**
+     * @brief Plans the inputs that drive an error to zero within the
+     *        limits.
+     *
+     * @param error The heading and speed errors from the targets.
+     * @return The first input of the plan.
+     */
+    ModelInput control(const ModelState& error);
+
+    /**
+     * @brief Runs one control step: linearizes the robot at its current
+     *        speed and plans towards the targets.
+     *
+     * @param robot The robot in its current state.
+     * @param targetHeading The desired heading (radians).
+     * @param targetVelocity The desired speed.
+     * @param dt The time step.
+     * @return The steering angle as heading and the wheel speed change as
+     *         velocity, as RobotModel::Simulate_robot_model() takes them.
+     */
+    PIDOutput compute(const RobotModel& robot, double targetHeading,
+                      double targetVelocity, double dt);
+
+    /**
+     * @brief Forgets the previous plan, so the next solve starts from
+     *        zero inputs.
+     */
+    void reset();
+
+    /**
+     * @brief Get an input of the latest plan.
+     *
+     * @param step The step, less than getHorizon().
+     * @return The planned input.
+     */
+    ModelInput getPlannedInput(std::size_t step) const;
+
+    /**
+     * @brief Get the number of steps planned.
+     *
+     * @return The horizon.
+     */
+    std::size_t getHorizon() const;
+
+    /**
+     * @brief Get the active-set iterations of the latest solve.
+     *
+     * @return The iteration count.
+     */
+    int getLastIterations() const;
+
+    /**
+     * @brief Get the model the programme was built for.
+     *
+     * @return The model.
+     */
+    const LinearizedModel& getModel() const;
+
+    /**
+     * @brief Get the weights and limits.
+     *
+     * @return The tuning.
+     */
+    const ControlTuning& getTuning() const;
+
+private:
+    static const std::size_t kMaxVariables = kMaxHorizon * kModelInputs;
+
+    std::size_t horizon_;
+    ControlTuning tuning_;
+    LinearizedModel model_;
+    bool hasModel_;
+    /// The Hessian H of the programme, in its leading 2N x 2N block.
+    Matrix<kMaxVariables, kMaxVariables> hessian_;
+    /// The gradient at zero inputs is F_k e for the inputs of step k.
+    Matrix<kModelInputs, kModelStates> gradientGain_[kMaxHorizon];
+    double lower_[kMaxVariables];
+    double upper_[kMaxVariables];
+    /// The latest plan, the inputs of step k at 2k and 2k + 1.
+    double plan_[kMaxVariables];
+    int iterations_;
+};
+
+#endif // MPC_CONTROLLER_HPP
@@ -0,0 +1,201 @@
+/**
+ * @file Matrix.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Small dense matrices whose size is fixed at compile time.
+ *
+ * The elements are stored row-major inside the object, so matrices live
+ * on the stack or inside their owner and no operation touches the heap.
+ * Dimensions are checked by the compiler. The class is meant for the few
+ * states and inputs of the model-based controllers, not for large
+ * systems.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+template <std::size_t Rows, std::size_t Cols>
+class Matrix {
+    static_assert(Rows > 0 && Cols > 0,
+                  "Matrix dimensions must be positive");
+
+public:
+    /**
+     * @brief Constructor for the Matrix class; all elements are zero.
+     */
+    Matrix() : data_() {
+    }
+
+    /**
+     * @brief Get the identity matrix.
+     *
+     * @return The identity.
+     */
+    static Matrix identity() {
+        static_assert(Rows == Cols, "Only square matrices have an identity");
+        Matrix result;
+        for (std::size_t i = 0; i < Rows; i++) result(i, i) = 1.0;
+        return result;
+    }
+
+    /**
+     * @brief Get a diagonal matrix.
+     *
+     * @param values The Rows diagonal elements.
+     * @return The matrix.
+     */
+    static Matrix diagonal(const double (&values)[Rows]) {
+        static_assert(Rows == Cols, "Only square matrices are diagonal");
+        Matrix result;
+        for (std::size_t i = 0; i < Rows; i++) result(i, i) = values[i];
+        return result;
+    }
+
+    static constexpr std::size_t rows() { return Rows; }
+    static constexpr std::size_t cols() { return Cols; }
+
+    double& operator()(std::size_t row, std::size_t col) {
+        return data_[row * Cols + col];
+    }
+
+    double operator()(std::size_t row, std::size_t col) const {
+        return data_[row * Cols + col];
+    }
+
+    Matrix& operator+=(const Matrix& other) {
+        for (std::size_t i = 0; i < Rows * Cols; i++) {
+            data_[i] += other.data_[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator-=(const Matrix& other) {
+        for (std::size_t i = 0; i < Rows * Cols; i++) {
+            data_[i] -= other.data_[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator*=(double scale) {
+        for (std::size_t i = 0; i < Rows * Cols; i++) data_[i] *= scale;
+        return *this;
+    }
+
+    /**
+     * @brief Get the transpose.
+     *
+     * @return The transposed matrix.
+     */
+    Matrix<Cols, Rows> transpose() const {
+        Matrix<Cols, Rows> result;
+        for (std::size_t i = 0; i < Rows; i++) {
+            for (std::size_t j = 0; j < Cols; j++) {
+                result(j, i) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the largest absolute element.
+     *
+     * @return The max norm of the elements.
+     */
+    double maxAbs() const {
+        double largest = 0.0;
+        for (std::size_t i = 0; i < Rows * Cols; i++) {
+            largest = std::fmax(largest, std::abs(data_[i]));
+        }
+        return largest;
+    }
+
+private:
+    double data_[Rows * Cols];
+};
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator+(Matrix<Rows, Cols> a,
+                             const Matrix<Rows, Cols>& b) {
+    return a += b;
+}
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator-(Matrix<Rows, Cols> a,
+                             const Matrix<Rows, Cols>& b) {
+    return a -= b;
+}
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator*(double scale, Matrix<Rows, Cols> a) {
+    return a *= scale;
+}
+
+template <std::size_t Rows, std::size_t Inner, std::size_t Cols>
+Matrix<Rows, Cols> operator*(const Matrix<Rows, Inner>& a,
+                             const Matrix<Inner, Cols>& b) {
+    Matrix<Rows, Cols> result;
+    for (std::size_t i = 0; i < Rows; i++) {
+        for (std::size_t k = 0; k < Inner; k++) {
+            double aik = a(i, k);
+            for (std::size_t j = 0; j < Cols; j++) {
+                result(i, j) += aik * b(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Solves A X = B by Gaussian elimination with partial pivoting.
+ *
+ * @param a The square matrix A.
+ * @param b The right-hand sides B, one per column.
+ * @return The solution X.
+ * @throws std::runtime_error If A is singular.
+ */
+template <std::size_t N, std::size_t Cols>
+Matrix<N, Cols> solve(Matrix<N, N> a, Matrix<N, Cols> b) {
+    double scale = a.maxAbs();
+    for (std::size_t k = 0; k < N; k++) {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i < N; i++) {
+            if (std::abs(a(i, k)) > std::abs(a(pivot, k))) pivot = i;
+        }
+        if (!(std::abs(a(pivot, k)) > 1e-14 * scale)) {
+            throw std::runtime_error("Matrix is singular");
+        }
+        if (pivot != k) {
+            for (std::size_t j = 0; j < N; j++) {
+                std::swap(a(k, j), a(pivot, j));
+            }
+            for (std::size_t j = 0; j < Cols; j++) {
+                std::swap(b(k, j), b(pivot, j));
+            }
+        }
+        for (std::size_t i = k + 1; i < N; i++) {
+            double factor = a(i, k) / a(k, k);
+            for (std::size_t j = k; j < N; j++) a(i, j) -= factor * a(k, j);
+            for (std::size_t j = 0; j < Cols; j++) {
+                b(i, j) -= factor * b(k, j);
+            }
+        }
+    }
+    for (std::size_t k = N; k-- > 0;) {
+        for (std::size_t j = 0; j < Cols; j++) {
+            double sum = b(k, j);
+            for (std::size_t i = k + 1; i < N; i++) sum -= a(k, i) * b(i, j);
+            b(k, j) = sum / a(k, k);
+        }
+    }
+    return b;
+}
+
+#endif // MATRIX_HPP
@@ -0,0 +1,124 @@
+/**
+ * @file MonotonicArena.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Bump allocator whose memory is released all at once.
+ *
+ * allocate() hands out consecutive pieces of a block and takes a new block
+ * from the heap when the current one is full. Nothing is freed one at a
+ * time; reset() makes all memory reusable at once. When a cycle needed
+ * more than one block, reset() replaces them with one block of their total
+ * size. After the first few cycles of a repeating workload, every cycle
+ * then fits in one block and the arena stops calling the heap.
+ *
+ * Memory handed out is uninitialised and is not destroyed, so the arena is
+ * meant for trivially destructible data.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef MONOTONIC_ARENA_HPP
+#define MONOTONIC_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+class MonotonicArena {
+public:
+    /**
+     * @brief Constructor for the MonotonicArena class. No memory is taken
+     *        until the first allocation.
+     *
+     * @param blockSize The size of the first block (bytes).
+     */
+    explicit MonotonicArena(std::size_t blockSize = 64 * 1024);
+
+    /**
+     * @brief Returns every block to the heap.
+     */
+    ~MonotonicArena();
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /**
+     * @brief Hands out uninitialised memory, valid until reset().
+     *
+     * @param bytes The number of bytes.
+     * @param alignment The alignment, a power of two.
+     * @return The memory.
+     */
+    void* allocate(std::size_t bytes,
+                   std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Hands out an uninitialised array, valid until reset().
+     *
+     * @param count The number of elements.
+     * @return The first element.
+     */
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is never destroyed");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Makes all memory reusable, merging the blocks of the last
+     *        cycle into one.
+     */
+    void reset();
+
+    /**
+     * @brief Get the bytes handed out since the last reset().
+     *
+     * @return The bytes in use, including alignment padding.
+     */
+    std::size_t getBytesUsed() const;
+
+    /**
+     * @brief Get the most bytes in use in any cycle.
+     *
+     * @return The peak of getBytesUsed().
+     */
+    std::size_t getPeakBytesUsed() const;
+
+    /**
+     * @brief Get the memory the arena holds.
+     *
+     * @return The total size of the blocks (bytes).
+     */
+    std::size_t getBytesReserved() const;
+
+    /**
+     * @brief Get the number of blocks taken from the heap.
+     *
+     * @return The number of heap allocations made by the arena.
+     */
+    std::uint64_t getBlockAllocations() const;
+
+private:
+    /// Header at the start of every block.
+    struct Block {
+        Block* next;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minimumSize);
+    void releaseBlocks();
+
+    std::size_t blockSize_;
+    /// The newest block, which allocations come from.
+    Block* head_;
+    /// Offset of the first free byte in head_.
+    std::size_t offset_;
+    std::size_t usedBefore_;
+    std::size_t peak_;
+    std::size_t reserved_;
+    std::uint64_t blockAllocations_;
+};
+
+#endif // MONOTONIC_ARENA_HPP
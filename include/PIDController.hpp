@@ -11,7 +11,43 @@
 #ifndef PID_CONTROLLER_HPP
 #define PID_CONTROLLER_HPP
 
+#include <cstddef>
+#include <type_traits>
 #include <vector>
+#include "ErrorHistory.hpp"
+
+/**
+ * @brief Velocity and heading outputs of one PID control step.
+ *
+ * The struct is trivially copyable so a control step can be returned by
+ * value without touching the heap.
+ */
+struct PIDOutput {
+    double velocity;
+    double heading;
+};
+
+static_assert(std::is_trivially_copyable<PIDOutput>::value,
+              "PIDOutput must stay trivially copyable");
+
+/**
+ * @brief Latest errors and the individual P, I and D terms of both channels.
+ *
+ * Summing the three terms of a channel gives its PIDOutput value.
+ */
+struct PIDTerms {
+    double velocityError;
+    double velocityP;
+    double velocityI;
+    double velocityD;
+    double headingError;
+    double headingP;
+    double headingI;
+    double headingD;
+};
+
+static_assert(std::is_trivially_copyable<PIDTerms>::value,
+              "PIDTerms must stay trivially copyable");
 
 class PIDController {
 public:
@@ -35,69 +71,172 @@ public:
      */
     std::vector<double> computePID();
 
+    /**
+     * @brief Computes the PID control outputs without allocating.
+     *
+     * Both outputs are zero until the first call to computeErrors().
+     *
+     * @return The computed PID values for velocity and heading.
+     */
+    PIDOutput computeControl() const;
+
+    /**
+     * @brief Computes the individual terms behind computeControl().
+     *
+     * All terms are zero until the first call to computeErrors().
+     *
+     * @return The latest errors and the P, I and D terms of both channels.
+     */
+    PIDTerms computeTerms() const;
+
     /**
      * @brief Retrieves the velocity proportional constant (Kp).
      * 
      * @return The velocity proportional constant.
      */
-    double getVelocityProportionalConstant();
+    double getVelocityProportionalConstant() const;
 
     /**
      * @brief Retrieves the velocity integral constant (Ki).
      * 
      * @return The velocity integral constant.
      */
-    double getVelocityIntegralConstant();
+    double getVelocityIntegralConstant() const;
 
     /**
      * @brief Retrieves the velocity derivative constant (Kd).
      * 
      * @return The velocity derivative constant.
      */
-    double getVelocityDerivativeConstant();
+    double getVelocityDerivativeConstant() const;
 
     /**
      * @brief Retrieves the time step (deltaT).
      * 
      * @return The time step.
      */
-    double getDeltaTime();
+    double getDeltaTime() const;
 
     /**
      * @brief Retrieves the heading proportional constant (Kp).
      * 
      * @return The heading proportional constant.
      */
-    double getHeadingProportionalConstant();
+    double getHeadingProportionalConstant() const;
 
     /**
      * @brief Retrieves the heading integral constant (Ki).
      * 
      * @return The heading integral constant.
      */
-    double getHeadingIntegralConstant();
+    double getHeadingIntegralConstant() const;
 
     /**
      * @brief Retrieves the heading derivative constant (Kd).
      * 
      * @return The heading derivative constant.
      */
-    double getHeadingDerivativeConstant();
+    double getHeadingDerivativeConstant() const;
 
     /**
-     * @brief Retrieves the vector of velocity errors.
+     * @brief Retrieves the recorded velocity errors, oldest first.
+     *
+     * Only the most recent errors are kept, up to the capacity set with
+     * setErrorHistoryCapacity(). Recording is disabled by default.
      * 
      * @return The vector containing velocity errors.
      */
     const std::vector<double>& getVelocityErrors() const;
 
     /**
-     * @brief Retrieves the vector of heading errors.
+     * @brief Retrieves the recorded heading errors, oldest first.
+     *
+     * Only the most recent errors are kept, up to the capacity set with
+     * setErrorHistoryCapacity(). Recording is disabled by default.
      * 
      * @return The vector containing heading errors.
      */
     const std::vector<double>& getHeadingErrors() const;
 
+    /**
+     * @brief Enables recording of the most recent errors.
+     *
+     * The history is a fixed-size ring buffer, so recording never grows
+     * memory once enabled. Previously recorded errors are discarded.
+     *
+     * @param capacity The number of errors kept per channel (0 disables).
+     */
+    void setErrorHistoryCapacity(std::size_t capacity);
+
+    /**
+     * @brief Enables recording of the most recent errors into rings taken
+     *        from an arena. See ErrorHistory::setCapacity().
+     *
+     * @param capacity The number of errors kept per channel (0 disables).
+     * @param arena The arena providing the rings.
+     */
+    void setErrorHistoryCapacity(std::size_t capacity, MonotonicArena& arena);
+
+    /**
+     * @brief Sets the anti-windup limits of the accumulated errors.
+     *
+     * The running error sum of each channel is clamped to
+     * [-limit, limit] after every update.
+     *
+     * @param velocityLimit The limit of the accumulated velocity error.
+     * @param headingLimit The limit of the accumulated heading error.
+     */
+    void setIntegralLimits(double velocityLimit, double headingLimit);
+
+    /**
+     * @brief Retrieves the anti-windup limit of the velocity channel.
+     *
+     * @return The limit, infinite unless set.
+     */
+    double getVelocityIntegralLimit() const;
+
+    /**
+     * @brief Retrieves the anti-windup limit of the heading channel.
+     *
+     * @return The limit, infinite unless set.
+     */
+    double getHeadingIntegralLimit() const;
+
+    /**
+     * @brief Retrieves the accumulated velocity error.
+     *
+     * @return The running sum of velocity errors.
+     */
+    double getVelocityIntegral() const;
+
+    /**
+     * @brief Retrieves the accumulated heading error.
+     *
+     * @return The running sum of heading errors.
+     */
+    double getHeadingIntegral() const;
+
+    /**
+     * @brief Clears the integral, derivative and history state.
+     */
+    void reset();
+
+    /**
+     * @brief Prepares for a jump of the setpoints so that the output does
+     *        not jump with them (bumpless transfer).
+     *
+     * The stored errors move by the shift, so the derivative term sees only
+     * the change of the measurement, and the integral takes over the jump
+     * of the proportional term, so P + I keeps its value. A channel with a
+     * zero integral gain, or whose integral reaches its limit, keeps (part
+     * of) the proportional jump. Does nothing before the first
+     * computeErrors().
+     *
+     * @param velocityShift The new velocity target minus the old one.
+     * @param headingShift The new heading target minus the old one.
+     */
+    void shiftSetpoints(double velocityShift, double headingShift);
+
     /**
      * @brief Computes and stores the velocity and heading errors.
      * 
@@ -116,8 +255,17 @@ private:
     double headKp;
     double headKi;
     double headKd;
-    std::vector<double> velocityErrors;
-    std::vector<double> headingErrors;
+    double velIntegral;
+    double headIntegral;
+    double velIntegralLimit;
+    double headIntegralLimit;
+    double velLastError;
+    double velPrevError;
+    double headLastError;
+    double headPrevError;
+    std::size_t sampleCount;
+    ErrorHistory velocityErrors;
+    ErrorHistory headingErrors;
 };
 
 #endif // PID_CONTROLLER_HPP
@@ -0,0 +1,140 @@
+/**
+ * @file Path.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Polyline path with arc length, and the projection of positions
+ *        onto it.
+ *
+ * The points are stored column-wise, together with the arc length at each
+ * point. project() resumes the nearest-segment search from the segment
+ * found on the previous tick. It walks forward while the next segment is
+ * no farther away, so a vehicle advancing along the path costs O(1)
+ * segments per tick instead of a scan of the whole path. The search does
+ * not walk backwards; projectGlobal() scans every segment, to start or to
+ * recover after losing the path.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef PATH_HPP
+#define PATH_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The closest point of a path to a position.
+ */
+struct PathProjection {
+    /// The segment holding the closest point, from point segment to
+    /// point segment + 1.
+    std::size_t segment = 0;
+    /// The position of the closest point along the segment, from 0 to 1.
+    double t = 0.0;
+    /// The closest point.
+    double x = 0.0;
+    double y = 0.0;
+    /// The arc length of the closest point.
+    double s = 0.0;
+    /// The direction of the segment (radians).
+    double heading = 0.0;
+    /// The distance to the position, positive when the position lies left
+    /// of the path.
+    double crossTrack = 0.0;
+};
+
+class Path {
+public:
+    /**
+     * @brief Constructor for the Path class. Consecutive duplicate points
+     *        are dropped.
+     *
+     * @param x The x-coordinates of the points.
+     * @param y The y-coordinates of the points.
+     * @throws std::invalid_argument If the coordinate counts differ, a
+     *         coordinate is not finite, or fewer than two distinct points
+     *         remain.
+     */
+    Path(const std::vector<double>& x, const std::vector<double>& y);
+
+    /**
+     * @brief Samples a Catmull-Rom spline through control points into a
+     *        path.
+     *
+     * @param x The x-coordinates of the control points.
+     * @param y The y-coordinates of the control points.
+     * @param samplesPerSpan The points per span between control points.
+     * @return The path through the samples.
+     * @throws std::invalid_argument If samplesPerSpan is zero or the
+     *         Path constructor rejects the samples.
+     */
+    static Path catmullRom(const std::vector<double>& x,
+                           const std::vector<double>& y,
+                           std::size_t samplesPerSpan);
+
+    /**
+     * @brief Projects a position onto the path, resuming the search from a
+     *        previous segment.
+     *
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @param hint The segment of the previous projection.
+     * @return The closest point found walking forward from the hint.
+     */
+    PathProjection project(double x, double y, std::size_t hint) const;
+
+    /**
+     * @brief Projects a position onto the path, scanning every segment.
+     *
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @return The closest point of the path; the first one on a tie.
+     */
+    PathProjection projectGlobal(double x, double y) const;
+
+    /**
+     * @brief Finds the point at an arc length, resuming the search from a
+     *        previous segment.
+     *
+     * @param s The arc length, clamped to the path.
+     * @param hint The segment to start from; updated to the segment of the
+     *        point (input and output).
+     * @param x The x-coordinate of the point (output).
+     * @param y The y-coordinate of the point (output).
+     */
+    void pointAt(double s, std::size_t& hint, double& x, double& y) const;
+
+    /**
+     * @brief Retrieves the number of points.
+     *
+     * @return The number of points, at least two.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Retrieves the length of the path.
+     *
+     * @return The arc length of the last point.
+     */
+    double length() const;
+
+    /// x-coordinate of every point.
+    const std::vector<double>& x() const { return x_; }
+    /// y-coordinate of every point.
+    const std::vector<double>& y() const { return y_; }
+    /// Arc length of every point.
+    const std::vector<double>& s() const { return s_; }
+
+private:
+    double distanceSquared(std::size_t segment, double x, double y,
+                           double& t) const;
+    PathProjection makeProjection(std::size_t segment, double t, double x,
+                                  double y) const;
+
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> s_;
+};
+
+#endif // PATH_HPP
@@ -0,0 +1,186 @@
+/**
+ * @file PathTracker.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Path-tracking steering with Pure Pursuit or Stanley.
+ *
+ * Pure Pursuit steers the rear axle onto the arc through a lookahead point
+ * further along the path. The lookahead distance grows with the speed.
+ * Stanley steers the front axle by its heading error plus a term for its
+ * cross-track error. Each tick projects the tracked axle onto the path
+ * with Path::project(), resuming from the previous segment. The tracker
+ * collects cross-track error statistics and the latency of every tick.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef PATH_TRACKER_HPP
+#define PATH_TRACKER_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "LatencyHistogram.hpp"
+#include "Path.hpp"
+
+class RobotModel;
+
+/**
+ * @brief The steering law of PathTracker.
+ */
+enum class TrackingMethod {
+    PurePursuit,
+    Stanley,
+};
+
+/**
+ * @brief Get the name of a tracking method, as used in scenario files.
+ *
+ * @param method The tracking method.
+ * @return "pure_pursuit" or "stanley".
+ */
+const char* trackingMethodName(TrackingMethod method);
+
+/**
+ * @brief Parses the name of a tracking method.
+ *
+ * @param name Either pure_pursuit or stanley.
+ * @return The tracking method.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+TrackingMethod parseTrackingMethod(const std::string& name);
+
+/**
+ * @brief Settings of PathTracker.
+ */
+struct TrackingParams {
+    TrackingMethod method = TrackingMethod::PurePursuit;
+    /// Pure Pursuit lookahead distance per unit of speed (seconds).
+    double lookaheadGain = 0.5;
+    /// The shortest Pure Pursuit lookahead distance.
+    double minLookahead = 1.0;
+    /// Stanley gain on the cross-track error.
+    double stanleyGain = 2.0;
+    /// Added to the speed in the Stanley cross-track term, so that the
+    /// term stays bounded at low speed.
+    double softening = 0.1;
+    /// The largest steering command.
+    double maxSteeringAngle = M_PI / 4.0;
+};
+
+/**
+ * @brief Cross-track error and latency statistics of a tracked run.
+ *
+ * The cross-track error is measured at the tracked axle: the rear axle for
+ * Pure Pursuit, the front axle for Stanley.
+ */
+struct TrackingStats {
+    std::uint64_t ticks = 0;
+    double sumAbsCrossTrack = 0.0;
+    double sumSquaredCrossTrack = 0.0;
+    double maxAbsCrossTrack = 0.0;
+    /// Duration of every step() in nanoseconds.
+    LatencyHistogram tickLatency;
+
+    /// The mean absolute cross-track error, or 0 before the first tick.
+    double meanCrossTrack() const {
+        return ticks == 0 ? 0.0 : sumAbsCrossTrack / ticks;
+    }
+
+    /// The root mean square cross-track error, or 0 before the first tick.
+    double rmsCrossTrack() const {
+        return ticks == 0 ? 0.0 : std::sqrt(sumSquaredCrossTrack / ticks);
+    }
+};
+
+class PathTracker {
+public:
+    /**
+     * @brief Constructor for the PathTracker class.
+     *
+     * @param path The path to follow.
+     * @param wheelbase The distance between the front and rear axles.
+     * @param params The steering law and its gains.
+     * @throws std::invalid_argument If the path is null or the wheelbase
+     *         is not positive.
+     */
+    PathTracker(std::shared_ptr<const Path> path, double wheelbase,
+                const TrackingParams& params = TrackingParams());
+
+    /**
+     * @brief Computes the steering angle for a rear-axle pose.
+     *
+     * The first call after construction or reset() scans the whole path;
+     * later calls resume from the previous segment.
+     *
+     * @param x The x-coordinate of the rear axle.
+     * @param y The y-coordinate of the rear axle.
+     * @param theta The orientation (radians).
+     * @param speed The forward speed.
+     * @return The steering angle, positive to turn left, clamped to
+     *         maxSteeringAngle.
+     */
+    double computeSteering(double x, double y, double theta, double speed);
+
+    /**
+     * @brief Steers a robot model for one time step with updateState().
+     *
+     * The model's own steering limit still applies; see
+     * RobotModel::setMaxSteeringAngle().
+     *
+     * @param robot The model to drive.
+     * @param dt The time step.
+     * @return The steering angle, positive to turn left.
+     */
+    double step(RobotModel& robot, double dt);
+
+    /**
+     * @brief Makes the next tick search the whole path again, e.g. after
+     *        the vehicle was moved.
+     */
+    void reset();
+
+    /**
+     * @brief Checks whether the tracked axle has reached the end of the
+     *        path.
+     *
+     * @return True once the projection lies at the last point.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Retrieves the projection of the tracked axle on the last
+     *        tick.
+     *
+     * @return The projection.
+     */
+    const PathProjection& getProjection() const;
+
+    /**
+     * @brief Retrieves the statistics of the ticks run by step().
+     *
+     * @return The statistics.
+     */
+    const TrackingStats& getStats() const;
+
+    /**
+     * @brief Retrieves the settings.
+     *
+     * @return The steering law and its gains.
+     */
+    const TrackingParams& getParams() const;
+
+private:
+    std::shared_ptr<const Path> path_;
+    double wheelbase_;
+    TrackingParams params_;
+    bool located_;
+    PathProjection projection_;
+    /// The segment of the last Pure Pursuit lookahead point.
+    std::size_t lookaheadSegment_;
+    TrackingStats stats_;
+};
+
+#endif // PATH_TRACKER_HPP
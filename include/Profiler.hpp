@@ -0,0 +1,295 @@
+/**
+ * @file Profiler.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Per-stage timing of the control loop.
+ *
+ * The ACK_PROFILE_* macros time the stages of a control step and count
+ * events inside them. They are removed by the preprocessor when
+ * ACKERMANN_PROFILE is 0. When compiled in, they cost a single relaxed
+ * load until Profiler::setEnabled(true) is called. The flag publishes
+ * nothing: the clock calibration is a separate atomic, so a thread racing
+ * with the first setEnabled(true) may time a few passes with the
+ * uncalibrated tick of 1 ns, but never reads a torn value.
+ *
+ * Every thread records into its own histograms, so recording takes no lock
+ * and shares no cache line. On x86-64 the clock is the time-stamp counter,
+ * calibrated against CLOCK_MONOTONIC when profiling is first enabled.
+ * Elsewhere it is CLOCK_MONOTONIC. A snapshot merges the histograms of all
+ * threads. Threads that have ended are included. Take it while the
+ * profiled threads are idle, e.g. after a join or a
+ * ThreadPool::parallelFor() call.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "Clock.hpp"
+#include "LatencyHistogram.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ACKERMANN_PROFILE_TSC 1
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Whether the profiling macros are compiled in (1) or not (0).
+ */
+#ifndef ACKERMANN_PROFILE
+#define ACKERMANN_PROFILE 1
+#endif
+
+/**
+ * @brief A timed stage of the control step.
+ */
+enum class ProfileStage : int {
+    /// PIDController::computeErrors().
+    ComputeErrors = 0,
+    /// PIDController::computeControl(), which computePID() calls.
+    ComputePID = 1,
+    /// RobotModel::Simulate_robot_model().
+    SimulateRobotModel = 2,
+    /// RobotModel::updateState().
+    UpdateState = 3,
+    /// A whole RobotSimulation::step(), including the stages above.
+    ControlStep = 4,
+};
+
+/// Number of profile stages.
+const std::size_t kProfileStageCount = 5;
+
+/**
+ * @brief An event counted inside a stage.
+ */
+enum class ProfileCounter : int {
+    /// Pose derivative evaluations made by the integrator.
+    DerivativeEvaluations = 0,
+    /// Steering angles outside an enabled steering table.
+    SteeringTableMisses = 1,
+};
+
+/// Number of profile counters.
+const std::size_t kProfileCounterCount = 2;
+
+/**
+ * @brief Get the name of a stage, as used in reports.
+ *
+ * @param stage The stage.
+ * @return The name, e.g. "compute_errors".
+ */
+const char* profileStageName(ProfileStage stage);
+
+/**
+ * @brief Get the name of a counter, as used in reports.
+ *
+ * @param counter The counter.
+ * @return The name, e.g. "derivative_evaluations".
+ */
+const char* profileCounterName(ProfileCounter counter);
+
+/**
+ * @brief Format of a profile report.
+ */
+enum class ProfileFormat {
+    /// One aligned line per stage and counter, for reading.
+    Text,
+    /// Prometheus text exposition format, for scraping.
+    Prometheus,
+};
+
+/**
+ * @brief Get the name of a report format, as used on the command line.
+ *
+ * @param format The format.
+ * @return "text" or "prometheus".
+ */
+const char* profileFormatName(ProfileFormat format);
+
+/**
+ * @brief Parses the name of a report format.
+ *
+ * @param name Either text or prometheus.
+ * @return The format.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+ProfileFormat parseProfileFormat(const std::string& name);
+
+/**
+ * @brief The merged measurements of all threads.
+ */
+struct ProfileSnapshot {
+    /// Duration of every stage, in nanoseconds.
+    LatencyHistogram stages[kProfileStageCount];
+    /// Total of every counter.
+    std::uint64_t counters[kProfileCounterCount] = {};
+    /// Number of threads that recorded anything.
+    std::size_t threads = 0;
+
+    /**
+     * @brief Writes the snapshot as a report.
+     *
+     * @param output The stream receiving the report.
+     * @param format The report format.
+     */
+    void write(std::ostream& output,
+               ProfileFormat format = ProfileFormat::Text) const;
+};
+
+class Profiler {
+public:
+    /**
+     * @brief Starts or stops recording. The clock is calibrated by the
+     *        first call that enables recording.
+     *
+     * @param enabled True to record.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether the macros record.
+     *
+     * @return True if recording.
+     */
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reads the profile clock.
+     *
+     * @return The time in clock ticks.
+     */
+    static std::uint64_t now() {
+#ifdef ACKERMANN_PROFILE_TSC
+        return __rdtsc();
+#else
+        return monotonicNow();
+#endif
+    }
+
+    /**
+     * @brief Records one pass through a stage on the calling thread.
+     *
+     * @param stage The stage.
+     * @param start The clock at the start of the stage, from now().
+     */
+    static void recordStage(ProfileStage stage, std::uint64_t start) {
+        std::uint64_t ticks = now() - start;
+        ThreadProfile* profile = current_;
+        if (profile == nullptr) profile = registerThread();
+        profile->stages[static_cast<int>(stage)].record(
+            static_cast<std::uint64_t>(
+                static_cast<double>(ticks) *
+                nanosecondsPerTick_.load(std::memory_order_relaxed)));
+    }
+
+    /**
+     * @brief Adds to a counter on the calling thread.
+     *
+     * @param counter The counter.
+     * @param amount The amount to add.
+     */
+    static void addCount(ProfileCounter counter, std::uint64_t amount) {
+        ThreadProfile* profile = current_;
+        if (profile == nullptr) profile = registerThread();
+        profile->counters[static_cast<int>(counter)] += amount;
+    }
+
+    /**
+     * @brief Merges the measurements of all threads.
+     *
+     * @return The merged measurements.
+     */
+    static ProfileSnapshot snapshot();
+
+    /**
+     * @brief Removes the measurements of all threads.
+     */
+    static void reset();
+
+    /**
+     * @brief Get the length of a clock tick.
+     *
+     * @return Nanoseconds per tick; 1 until calibrated.
+     */
+    static double getNanosecondsPerTick();
+
+    /// The measurements of one thread.
+    struct ThreadProfile {
+        LatencyHistogram stages[kProfileStageCount];
+        std::uint64_t counters[kProfileCounterCount] = {};
+    };
+
+private:
+    static ThreadProfile* registerThread();
+
+    static std::atomic<bool> enabled_;
+    /// Written once by the first setEnabled(true), read by every thread.
+    static std::atomic<double> nanosecondsPerTick_;
+    static thread_local ThreadProfile* current_;
+};
+
+/**
+ * @brief Times the enclosing scope as one pass through a stage.
+ */
+class ProfileScope {
+public:
+    /**
+     * @brief Starts timing when recording is enabled.
+     *
+     * @param stage The stage.
+     */
+    explicit ProfileScope(ProfileStage stage)
+        : stage_(stage), start_(Profiler::enabled() ? Profiler::now() : 0) {
+    }
+
+    /**
+     * @brief Records the stage if timing was started.
+     */
+    ~ProfileScope() {
+        if (start_ != 0) Profiler::recordStage(stage_, start_);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileStage stage_;
+    std::uint64_t start_;
+};
+
+#if ACKERMANN_PROFILE
+/**
+ * @brief Times the rest of the enclosing scope as the given stage.
+ */
+#define ACK_PROFILE_SCOPE(stage) \
+    ProfileScope ackProfileScope_(ProfileStage::stage)
+
+/**
+ * @brief Adds an amount to the given counter.
+ */
+#define ACK_PROFILE_COUNT(counter, amount)                               \
+    do {                                                                 \
+        if (Profiler::enabled()) {                                       \
+            Profiler::addCount(ProfileCounter::counter, (amount));       \
+        }                                                                \
+    } while (0)
+#else
+#define ACK_PROFILE_SCOPE(stage) do {} while (0)
+// The amount is named but not evaluated, so variables that only feed a
+// counter do not warn as unused
+#define ACK_PROFILE_COUNT(counter, amount) \
+    do {                                    \
+        (void)sizeof(amount);               \
+    } while (0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,146 @@
+/**
+ * @file RateGroupScheduler.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Deterministic scheduler of tasks running at integer fractions of a
+ *        base rate.
+ *
+ * Time advances in ticks of a fixed base period. A rate group runs its
+ * task every divisor ticks, starting at tick offset, so its period is
+ * divisor * basePeriod. Groups that are due on the same tick run in the
+ * order they were added. Timing is counted in integer ticks, so the
+ * schedule never drifts and a run is the same on every machine.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef RATE_GROUP_SCHEDULER_HPP
+#define RATE_GROUP_SCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class RateGroupScheduler {
+public:
+    /// A task, called with the number of the tick it runs on.
+    using Task = std::function<void(std::uint64_t)>;
+
+    /**
+     * @brief Constructor for the RateGroupScheduler class.
+     *
+     * @param basePeriod The length of a tick (seconds).
+     * @throws std::invalid_argument If the period is not positive.
+     */
+    explicit RateGroupScheduler(double basePeriod);
+
+    /**
+     * @brief Adds a rate group.
+     *
+     * @param name The name of the group, for reports.
+     * @param divisor The number of ticks between runs.
+     * @param task The task to run.
+     * @param offset The first tick the group runs on, below divisor.
+     * @return The index of the group.
+     * @throws std::invalid_argument If the divisor is 0 or the offset is
+     *         not below it.
+     */
+    std::size_t addGroup(const std::string& name, std::uint32_t divisor,
+                         Task task, std::uint32_t offset = 0);
+
+    /**
+     * @brief Runs the groups due on the current tick, then advances it.
+     */
+    void tick();
+
+    /**
+     * @brief Runs a number of ticks.
+     *
+     * @param ticks The number of ticks.
+     */
+    void run(std::uint64_t ticks);
+
+    /**
+     * @brief Restarts the schedule at tick 0 and clears the run counts.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of the next tick.
+     *
+     * @return The number of ticks run.
+     */
+    std::uint64_t getTick() const;
+
+    /**
+     * @brief Get the time of the next tick.
+     *
+     * @return The number of ticks run times the base period (seconds).
+     */
+    double getTime() const;
+
+    /**
+     * @brief Get the length of a tick.
+     *
+     * @return The base period (seconds).
+     */
+    double getBasePeriod() const;
+
+    /**
+     * @brief Get the length after which the whole schedule repeats.
+     *
+     * @return The least common multiple of the divisors, in ticks.
+     */
+    std::uint64_t getHyperperiod() const;
+
+    /**
+     * @brief Get the number of rate groups.
+     *
+     * @return The number of groups.
+     */
+    std::size_t getGroupCount() const;
+
+    /**
+     * @brief Get the name of a group.
+     *
+     * @param group The group index.
+     * @return The name given to addGroup().
+     */
+    const std::string& getGroupName(std::size_t group) const;
+
+    /**
+     * @brief Get the period of a group.
+     *
+     * @param group The group index.
+     * @return The divisor times the base period (seconds).
+     */
+    double getGroupPeriod(std::size_t group) const;
+
+    /**
+     * @brief Get the number of times a group ran.
+     *
+     * @param group The group index.
+     * @return The run count since construction or reset().
+     */
+    std::uint64_t getRunCount(std::size_t group) const;
+
+private:
+    struct Group {
+        std::string name;
+        std::uint32_t divisor;
+        std::uint32_t offset;
+        /// Ticks left until the group is due; 0 means due now.
+        std::uint32_t countdown;
+        std::uint64_t runs;
+        Task task;
+    };
+
+    double basePeriod_;
+    std::uint64_t tick_;
+    std::vector<Group> groups_;
+};
+
+#endif // RATE_GROUP_SCHEDULER_HPP
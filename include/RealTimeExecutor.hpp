@@ -0,0 +1,126 @@
+/**
+ * @file RealTimeExecutor.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Runs a control step at a fixed period against the wall clock.
+ *
+ * Each step is released at an absolute deadline with clock_nanosleep on
+ * CLOCK_MONOTONIC, so the period does not drift with the step duration.
+ * A step that overruns its period counts as a missed deadline, and the
+ * periods it overran are skipped instead of being run back to back.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef REAL_TIME_EXECUTOR_HPP
+#define REAL_TIME_EXECUTOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "LatencyHistogram.hpp"
+
+/**
+ * @brief Timing and scheduling settings of a real-time loop.
+ */
+struct RealTimeOptions {
+    /// Period of the loop in seconds; 0.001 runs at 1 kHz.
+    double period = 0.001;
+    /// SCHED_FIFO priority (1-99) of the loop thread, or 0 to keep the
+    /// normal scheduler.
+    int priority = 0;
+    /// CPU the loop thread is pinned to, or -1 to leave it unpinned.
+    int cpu = -1;
+    /// Lock all current and future pages in memory (mlockall) while
+    /// running, so page faults cannot delay a step.
+    bool lockMemory = false;
+};
+
+/**
+ * @brief Timing statistics of the last run.
+ */
+struct RealTimeStats {
+    /// Number of steps executed.
+    std::uint64_t steps = 0;
+    /// Number of steps that ended after their next release time.
+    std::uint64_t missedDeadlines = 0;
+    /// Number of periods skipped because a step overran.
+    std::uint64_t skippedPeriods = 0;
+    /// Delay between the release time and the actual wake-up.
+    LatencyHistogram wakeupJitter;
+    /// Duration of the step callback.
+    LatencyHistogram stepLatency;
+};
+
+class RealTimeExecutor {
+public:
+    /**
+     * @brief A control step; receives the step index and returns false to
+     *        stop the loop.
+     */
+    typedef std::function<bool(std::uint64_t)> Step;
+
+    /**
+     * @brief Constructor for the RealTimeExecutor class.
+     *
+     * @param options The period and scheduling settings.
+     * @throws std::invalid_argument If the period is not positive.
+     */
+    explicit RealTimeExecutor(const RealTimeOptions& options);
+
+    /**
+     * @brief Runs the step on the calling thread until it returns false,
+     *        maxSteps steps have run, or requestStop() is called.
+     *
+     * A stop requested before the call is discarded when the loop starts;
+     * one requested during the loop stays set afterwards, see
+     * isStopRequested().
+     *
+     * The scheduling policy, CPU affinity and memory locking are applied
+     * for the duration of the call and restored afterwards.
+     *
+     * @param step The control step.
+     * @param maxSteps The maximum number of steps.
+     * @return The timing statistics of the run.
+     * @throws std::runtime_error If the scheduling settings cannot be
+     *         applied, e.g. without permission for SCHED_FIFO.
+     */
+    const RealTimeStats& run(const Step& step, std::uint64_t maxSteps);
+
+    /**
+     * @brief Asks a running loop to stop after its current step. Safe to
+     *        call from any thread or from a signal handler.
+     */
+    void requestStop();
+
+    /**
+     * @brief Checks whether a stop was requested since the last run
+     *        started.
+     *
+     * @return True if requestStop() was called.
+     */
+    bool isStopRequested() const;
+
+    /**
+     * @brief Get the statistics of the last run.
+     *
+     * @return The timing statistics.
+     */
+    const RealTimeStats& getStats() const;
+
+    /**
+     * @brief Get the loop settings.
+     *
+     * @return The period and scheduling settings.
+     */
+    const RealTimeOptions& getOptions() const;
+
+private:
+    RealTimeOptions options_;
+    std::int64_t periodNs_;
+    std::atomic<bool> stopRequested_;
+    RealTimeStats stats_;
+};
+
+#endif // REAL_TIME_EXECUTOR_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file RobotFleet.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Structure-of-arrays container stepping many Ackermann vehicles.
+ *
+ * Each vehicle follows exactly the math of RobotModel: a step is
+ * Simulate_robot_model() followed by updateState() with the same heading
+ * command and the default Euler integrator. Vehicles are stored
+ * column-wise so that the step kernel can advance four of them per AVX2
+ * instruction; a scalar kernel is used when AVX2 is not available.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef ROBOT_FLEET_HPP
+#define ROBOT_FLEET_HPP
+
+#include <cstddef>
+#include <vector>
+
+class RobotFleet {
+public:
+    /**
+     * @brief Constructor for the RobotFleet class.
+     *
+     * @param count The number of vehicles, all starting at rest at the origin
+     *              with the default RobotModel geometry.
+     */
+    explicit RobotFleet(std::size_t count = 0);
+
+    /**
+     * @brief Changes the number of vehicles. New vehicles use the default
+     *        geometry and start at rest at the origin.
+     *
+     * @param count The number of vehicles.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Retrieves the number of vehicles.
+     *
+     * @return The number of vehicles.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Sets the geometry of one vehicle.
+     *
+     * @param i The index of the vehicle.
+     * @param wheelbase The distance between the front and rear axles.
+     * @param wheelRadius The radius of the drive wheels.
+     * @param trackWidth The distance between the left and right wheels.
+     * @param maxSteeringAngle The steering limit applied by updateState.
+     */
+    void setGeometry(std::size_t i, double wheelbase, double wheelRadius,
+                     double trackWidth, double maxSteeringAngle = 0.0);
+
+    /**
+     * @brief Sets the initial state of one vehicle, as
+     *        RobotModel::setInitialState() does.
+     *
+     * @param i The index of the vehicle.
+     * @param x The initial x-coordinate.
+     * @param y The initial y-coordinate.
+     * @param theta The initial orientation (in radians).
+     * @param velocity The initial velocity.
+     */
+    void setInitialState(std::size_t i, double x, double y, double theta,
+                         double velocity);
+
+    /**
+     * @brief Advances every vehicle by one time step.
+     *
+     * @param headingCommands The PID heading output of each vehicle.
+     * @param velocityCommands The PID velocity output of each vehicle.
+     * @param dt The time step.
+     */
+    void step(const double* headingCommands, const double* velocityCommands,
+              double dt);
+
+    /**
+     * @brief Advances the vehicles in [begin, end) by one time step.
+     *
+     * Disjoint ranges may be stepped concurrently from different threads.
+     *
+     * @param begin The index of the first vehicle.
+     * @param end One past the index of the last vehicle.
+     * @param headingCommands The PID heading output of each vehicle.
+     * @param velocityCommands The PID velocity output of each vehicle.
+     * @param dt The time step.
+     */
+    void stepRange(std::size_t begin, std::size_t end,
+                   const double* headingCommands,
+                   const double* velocityCommands, double dt);
+
+    /**
+     * @brief Enables or disables the AVX2 kernel.
+     *
+     * @param enabled True to use AVX2 when the CPU supports it.
+     */
+    void setSimdEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether steps run on the AVX2 kernel.
+     *
+     * @return True if the AVX2 kernel is enabled and supported.
+     */
+    bool isSimdActive() const;
+
+    /**
+     * @brief Checks whether the CPU and the build support the AVX2 kernel.
+     *
+     * @return True if the AVX2 kernel can be used.
+     */
+    static bool simdSupported();
+
+    /**
+     * @brief Retrieves the pose of one vehicle, as RobotModel::getState().
+     *
+     * @param i The index of the vehicle.
+     * @param x The x-coordinate (output).
+     * @param y The y-coordinate (output).
+     * @param theta The orientation in radians (output).
+     * @param velocity The velocity (output).
+     */
+    void getState(std::size_t i, double& x, double& y, double& theta,
+                  double& velocity) const;
+
+    /**
+     * @brief Retrieves the wheel outputs of one vehicle.
+     *
+     * @param i The index of the vehicle.
+     * @param alphaI The inner steering angle (output).
+     * @param alphaO The outer steering angle (output).
+     * @param omegaI The inner wheel angular velocity (output).
+     * @param omegaO The outer wheel angular velocity (output).
+     */
+    void getWheelState(std::size_t i, double& alphaI, double& alphaO,
+                       double& omegaI, double& omegaO) const;
+
+    /// Simulated heading of every vehicle (RobotModel::getHeading()).
+    const std::vector<double>& heading() const { return heading_; }
+    /// Simulated speed of every vehicle (RobotModel::getSpeed()).
+    const std::vector<double>& speed() const { return speed_; }
+    /// x-coordinate of every vehicle.
+    const std::vector<double>& x() const { return x_; }
+    /// y-coordinate of every vehicle.
+    const std::vector<double>& y() const { return y_; }
+    /// Orientation of every vehicle.
+    const std::vector<double>& theta() const { return theta_; }
+
+private:
+    void stepScalar(std::size_t begin, std::size_t end,
+                    const double* headingCommands,
+                    const double* velocityCommands, double dt);
+    void stepAvx2(std::size_t begin, std::size_t end,
+                  const double* headingCommands,
+                  const double* velocityCommands, double dt);
+
+    std::vector<double> wheelbase_;
+    std::vector<double> wheelRadius_;
+    std::vector<double> trackWidth_;
+    std::vector<double> maxSteeringAngle_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> theta_;
+    std::vector<double> velocity_;
+    std::vector<double> alpha_i_;
+    std::vector<double> alpha_o_;
+    std::vector<double> omega_i_;
+    std::vector<double> omega_o_;
+    std::vector<double> heading_;
+    std::vector<double> speed_;
+    bool simdEnabled_;
+};
+
+#endif // ROBOT_FLEET_HPP
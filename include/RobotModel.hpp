@@ -11,6 +11,10 @@
 #ifndef ROBOT_MODEL_HPP
 #define ROBOT_MODEL_HPP
 
+#include <memory>
+#include "Integrator.hpp"
+#include "SteeringTable.hpp"
+
 class RobotModel {
 public:
     /**
@@ -24,6 +28,9 @@ public:
 
     /**
      * @brief Sets the initial state of the robot model.
+     *
+     * The simulated heading and speed start from the same values, with both
+     * wheels rolling at the initial velocity.
      * 
      * @param x The initial x-coordinate of the robot.
      * @param y The initial y-coordinate of the robot.
@@ -40,6 +47,66 @@ public:
      */
     void updateState(double steeringAngle, double dt);
 
+    /**
+     * @brief Sets the steering limit applied by updateState(). It starts at
+     *        zero, which makes updateState() drive straight.
+     *
+     * @param maxSteeringAngle The largest steering angle (radians).
+     */
+    void setMaxSteeringAngle(double maxSteeringAngle);
+
+    /**
+     * @brief Selects the scheme updateState() integrates the pose with.
+     *
+     * @param integrator The integrator; nullptr restores explicit Euler.
+     */
+    void setIntegrator(std::shared_ptr<const Integrator> integrator);
+
+    /**
+     * @brief Replaces the tan and atan of the steering geometry with a
+     *        lookup table built for this vehicle's wheelbase and track.
+     *
+     * Steering commands beyond the range still take the exact path.
+     *
+     * @param range The table covers steering commands in [-range, range].
+     * @param intervals The number of grid intervals over the range.
+     * @param interpolation Linear or cubic interpolation.
+     * @throws std::invalid_argument If SteeringTable rejects the settings.
+     */
+    void enableSteeringTable(double range, std::size_t intervals = 512,
+                             SteeringInterpolation interpolation =
+                                 SteeringInterpolation::Cubic);
+
+    /**
+     * @brief Uses a steering table shared with other vehicles.
+     *
+     * The table must have been built for this vehicle's wheelbase and
+     * track, e.g. taken from shareSteeringTable() of an identical one.
+     *
+     * @param table The table, or nullptr to compute the geometry exactly.
+     */
+    void setSteeringTable(std::shared_ptr<const SteeringTable> table);
+
+    /**
+     * @brief Retrieves the steering table for sharing with identical
+     *        vehicles.
+     *
+     * @return The table, or nullptr when the geometry is computed exactly.
+     */
+    std::shared_ptr<const SteeringTable> shareSteeringTable() const;
+
+    /**
+     * @brief Goes back to computing the steering geometry exactly.
+     */
+    void disableSteeringTable();
+
+    /**
+     * @brief Retrieves the steering lookup table.
+     *
+     * @return The table, or nullptr when the geometry is computed exactly.
+     */
+    const SteeringTable* getSteeringTable() const;
+
     /**
      * @brief Retrieves the current state of the robot model.
      * 
@@ -48,7 +115,7 @@ public:
      * @param theta The current orientation (in radians) of the robot (output).
      * @param velocity The current velocity of the robot (output).
      */
-    void getState(double& x, double& y, double& theta, double& velocity);
+    void getState(double& x, double& y, double& theta, double& velocity) const;
     /**
      * @brief Simulates the robot model's motion based on PID controller outputs.
      *
@@ -67,14 +134,58 @@ public:
      *
      * @return The current heading of the robot in radians.
      */
-    double getHeading();
+    double getHeading() const;
 
     /**
      * @brief Get the current speed of the robot in meters per second (m/s).
      *
      * @return The current speed of the robot in m/s.
      */
-    double getSpeed();
+    double getSpeed() const;
+
+    /**
+     * @brief Get the distance between the front and rear axles.
+     *
+     * @return The wheelbase.
+     */
+    double getWheelbase() const;
+
+    /**
+     * @brief Get the radius of the driven wheels.
+     *
+     * @return The wheel radius.
+     */
+    double getWheelRadius() const;
+
+    /**
+     * @brief Get the distance between the left and right wheels.
+     *
+     * @return The track width.
+     */
+    double getTrackWidth() const;
+
+    /**
+     * @brief Get the steering limit applied by updateState().
+     *
+     * @return The largest steering angle (radians).
+     */
+    double getMaxSteeringAngle() const;
+
+    /**
+     * @brief Get the inner and outer front wheel steering angles.
+     *
+     * @param inner The inner wheel steering angle in radians (output).
+     * @param outer The outer wheel steering angle in radians (output).
+     */
+    void getSteeringAngles(double& inner, double& outer) const;
+
+    /**
+     * @brief Get the inner and outer wheel angular velocities.
+     *
+     * @param inner The inner wheel angular velocity (output).
+     * @param outer The outer wheel angular velocity (output).
+     */
+    void getWheelSpeeds(double& inner, double& outer) const;
 
 private:
     double wheelbase_;
@@ -91,7 +202,8 @@ private:
     double omega_o_;
     double heading_;
     double speed_;
-
+    std::shared_ptr<const Integrator> integrator_;
+    std::shared_ptr<const SteeringTable> steeringTable_;
 };
 
 #endif // ROBOT_MODEL_HPP
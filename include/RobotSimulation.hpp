@@ -16,8 +16,32 @@
 #ifndef ROBOT_SIMULATION_HPP
 #define ROBOT_SIMULATION_HPP
 
+#include <memory>
+#include "Convergence.hpp"
+#include "LinearizedModel.hpp"
+#include "LQRController.hpp"
+#include "MPCController.hpp"
 #include "PIDController.hpp" // Include the PIDController header
 #include "RobotModel.hpp"    // Include the RobotModel header
+#include "SharedState.hpp"
+#include "TrajectoryRecorder.hpp"
+
+/**
+ * @brief Outcome of RobotSimulation::run().
+ */
+struct SimulationResult {
+    /// Why the run ended.
+    TerminationReason reason = TerminationReason::MaxIterations;
+    /// Number of control steps executed.
+    int steps = 0;
+    /// Time after which both channels stayed within their tolerances, or
+    /// -1 if the run did not end settled.
+    double settlingTime = -1.0;
+    double finalX = 0.0;
+    double finalY = 0.0;
+    double finalTheta = 0.0;
+    double finalVelocity = 0.0;
+};
 
 class RobotSimulation {
 public:
@@ -49,8 +73,203 @@ public:
      * This function allows the user to interactively input target heading and velocity, and the robot simulation
      * attempts to control the robot's movement to reach these targets using the PID controller. The control loop
      * continues until the user exits or convergence to the target is achieved.
+     * Targets of 1000 for both heading and velocity prompt for the targets.
+     *
+     * @param targetHeading The desired heading (in radians).
+     * @param targetVelocity The desired velocity.
+     * @param criteria The step budget, tolerances and divergence limits.
+     * @return The step count, final state and why the run ended.
      */
-    void runSimulation(double targetHeading, double targetVelocity);
+    SimulationResult runSimulation(double targetHeading, double targetVelocity,
+                                   const ConvergenceCriteria& criteria =
+                                       ConvergenceCriteria());
+
+    /**
+     * @brief Steps towards the targets until the run settles, diverges or
+     *        uses its step budget, without prompting or logging.
+     *
+     * Convergence is judged on the state after each step.
+     *
+     * @param targetHeading The desired heading (in radians).
+     * @param targetVelocity The desired velocity.
+     * @param criteria The step budget, tolerances and divergence limits.
+     * @return The step count, final state and why the run ended.
+     */
+    SimulationResult run(double targetHeading, double targetVelocity,
+                         const ConvergenceCriteria& criteria =
+                             ConvergenceCriteria());
+
+    /**
+     * @brief Sets the initial state of the simulated robot.
+     *
+     * @param x The initial x-coordinate of the robot.
+     * @param y The initial y-coordinate of the robot.
+     * @param theta The initial orientation (in radians) of the robot.
+     * @param velocity The initial velocity of the robot.
+     */
+    void setInitialState(double x, double y, double theta, double velocity);
+
+    /**
+     * @brief Runs a single control step towards the given targets.
+     *
+     * The errors are computed from the current heading and speed of the
+     * robot, and the outputs of the selected controller drive the
+     * Ackermann model.
+     *
+     * @param targetHeading The desired heading (in radians).
+     * @param targetVelocity The desired velocity.
+     * @return The PID outputs applied during the step.
+     */
+    PIDOutput step(double targetHeading, double targetVelocity);
+
+    /**
+     * @brief Get the current heading of the simulated robot.
+     *
+     * @return The current heading in radians.
+     */
+    double getCurrentHeading() const;
+
+    /**
+     * @brief Get the current speed of the simulated robot.
+     *
+     * @return The current speed.
+     */
+    double getCurrentVelocity() const;
+
+    /**
+     * @brief Retrieves the current pose of the simulated robot.
+     *
+     * @param x The current x-coordinate of the robot (output).
+     * @param y The current y-coordinate of the robot (output).
+     * @param theta The current orientation (in radians) of the robot (output).
+     * @param velocity The current velocity of the robot (output).
+     */
+    void getState(double& x, double& y, double& theta, double& velocity) const;
+
+    /**
+     * @brief Records the state after every step into a trajectory file.
+     *
+     * @param recorder An open recorder, or nullptr to stop recording. The
+     *        recorder must outlive the simulation or be detached first.
+     */
+    void setRecorder(TrajectoryRecorder* recorder);
+
+    /**
+     * @brief Publishes the state and command after every step to other
+     *        processes.
+     *
+     * @param publisher The publisher, or nullptr to stop publishing. The
+     *        publisher must outlive the simulation or be detached first.
+     */
+    void setPublisher(SharedStatePublisher* publisher);
+
+    /**
+     * @brief Keeps the PID output continuous across a jump of the targets
+     *        passed to step(). See PIDController::shiftSetpoints().
+     *
+     * @param velocityShift The new velocity target minus the old one.
+     * @param headingShift The new heading target minus the old one.
+     */
+    void shiftSetpoints(double velocityShift, double headingShift);
+
+    /**
+     * @brief Captures the current state, the targets of the latest step
+     *        and the controller terms as the recorder stores them after
+     *        every step.
+     *
+     * @return The sample.
+     */
+    TrajectorySample makeSample() const;
+
+    /**
+     * @brief Selects the scheme the robot's pose is integrated with.
+     *
+     * @param integrator The integrator; nullptr restores explicit Euler.
+     */
+    void setIntegrator(std::shared_ptr<const Integrator> integrator);
+
+    /**
+     * @brief Looks the steering geometry up in a table instead of computing
+     *        tan and atan every step. See RobotModel::enableSteeringTable().
+     *
+     * @param range The table covers steering commands in [-range, range].
+     * @param intervals The number of grid intervals over the range.
+     * @param interpolation Linear or cubic interpolation.
+     */
+    void enableSteeringTable(double range, std::size_t intervals = 512,
+                             SteeringInterpolation interpolation =
+                                 SteeringInterpolation::Cubic);
+
+    /**
+     * @brief Selects the controller step() uses. The PID controller always
+     *        computes the errors, so recorded samples keep their error
+     *        columns.
+     *
+     * The LQR and MPC controllers are created here, only when selected,
+     * so a PID-only simulation does not carry the MPC solver state.
+     *
+     * @param mode The controller.
+     * @param tuning The weights and limits of the LQR or MPC controller.
+     * @param horizon The number of steps the MPC controller plans.
+     * @throws std::invalid_argument If the tuning or horizon of the selected
+     *         controller is invalid.
+     */
+    void setControlMode(ControlMode mode,
+                        const ControlTuning& tuning = ControlTuning(),
+                        std::size_t horizon = MPCController::kMaxHorizon);
+
+    /**
+     * @brief Get the controller step() uses.
+     *
+     * @return The control mode.
+     */
+    ControlMode getControlMode() const;
+
+    /**
+     * @brief Get the LQR controller, with its current gain.
+     *
+     * @return The LQR controller, or nullptr unless LQR is selected.
+     */
+    const LQRController* getLQRController() const;
+
+    /**
+     * @brief Get the MPC controller, with its latest plan.
+     *
+     * @return The MPC controller, or nullptr unless MPC is selected.
+     */
+    const MPCController* getMPCController() const;
+
+    /**
+     * @brief Uses a steering table shared with identical vehicles. See
+     *        RobotModel::setSteeringTable().
+     *
+     * @param table The table, or nullptr to compute the geometry exactly.
+     */
+    void setSteeringTable(std::shared_ptr<const SteeringTable> table);
+
+    /**
+     * @brief Retrieves the robot's steering table for sharing.
+     *
+     * @return The table, or nullptr when the geometry is computed exactly.
+     */
+    std::shared_ptr<const SteeringTable> shareSteeringTable() const;
+
+    /**
+     * @brief Keeps the most recent controller errors of the run.
+     *
+     * @param capacity The number of errors kept per channel (0 disables).
+     * @param arena The arena providing the rings, or nullptr to allocate
+     *        them on the heap.
+     */
+    void setErrorHistoryCapacity(std::size_t capacity,
+                                 MonotonicArena* arena = nullptr);
+
+    /**
+     * @brief Get the controller driving the robot.
+     *
+     * @return The controller, with its error histories.
+     */
+    const PIDController& getController() const;
 
     /**
      * @brief Get the final velocity of the robot.
@@ -60,8 +279,33 @@ public:
     double getFinalVelocity() const;
 
 private:
+    /**
+     * @brief Owns the model-based controller selected by setControlMode().
+     *        Copies are deep, so copied simulations do not share a plan.
+     */
+    struct ModelControllers {
+        ModelControllers() = default;
+        ModelControllers(const ModelControllers& other);
+        ModelControllers& operator=(const ModelControllers& other);
+        ModelControllers(ModelControllers&&) noexcept = default;
+        ModelControllers& operator=(ModelControllers&&) noexcept = default;
+
+        std::unique_ptr<LQRController> lqr;
+        std::unique_ptr<MPCController> mpc;
+    };
+
+    void record();
+
     RobotModel robot;
     PIDController controller;
+    ControlMode controlMode = ControlMode::PID;
+    ModelControllers models;
+    TrajectoryRecorder* recorder = nullptr;
+    SharedStatePublisher* publisher = nullptr;
+    double elapsedTime = 0.0;
+    /// The targets of the latest step(), recorded with every sample.
+    double lastTargetHeading = 0.0;
+    double lastTargetVelocity = 0.0;
     double finalX = 0.0;
     double finalY = 0.0;
     double finalTheta = 0.0;
@@ -0,0 +1,114 @@
+/**
+ * @file Scenario.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Description and summary of a single simulation scenario.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include <cmath>
+#include <string>
+#include "Convergence.hpp"
+#include "Integrator.hpp"
+#include "LinearizedModel.hpp"
+
+/**
+ * @brief Everything needed to run one simulation: geometry, gains, targets
+ *        and initial state.
+ */
+struct Scenario {
+    /// Label used when reporting results.
+    std::string name = "scenario";
+    double wheelbase = 0.5;
+    double trackWidth = 1.0;
+    double maxSteeringAngle = M_PI / 4.0;
+    double velP = 1.0;
+    double velI = 0.1;
+    double velD = 0.01;
+    double deltaT = 0.1;
+    double headP = 1.0;
+    double headI = 0.1;
+    double headD = 0.01;
+    double targetHeading = 0.0;
+    double targetVelocity = 0.0;
+    double initialX = 0.0;
+    double initialY = 0.0;
+    double initialTheta = 0.0;
+    double initialVelocity = 0.0;
+    /// Scheme integrating the pose of the robot.
+    IntegrationMethod integrator = IntegrationMethod::Euler;
+    /// Intervals of the steering lookup table, or 0 to compute the
+    /// steering geometry exactly.
+    int steeringTableIntervals = 0;
+    /// Steering commands the table covers, in [-range, range].
+    double steeringTableRange = 0.6;
+    bool steeringTableCubic = true;
+    /// Most recent controller errors kept per channel, or 0 to keep none.
+    int errorHistory = 0;
+    /// Controller driving the robot; the gains above apply to PID only.
+    ControlMode controlMode = ControlMode::PID;
+    /// Steps planned by the MPC controller.
+    int mpcHorizon = 20;
+    int maxIterations = 30;
+    /// Largest velocity error that counts as on target.
+    double velocityTolerance = 3.0;
+    /// Largest heading error (radians) that counts as on target.
+    double headingTolerance = 3.0;
+    /// Consecutive steps both channels must stay within tolerance.
+    int settleWindow = 1;
+    /// Stop once settled instead of running the whole iteration budget.
+    bool stopOnConvergence = false;
+    /// Errors beyond which the run is abandoned as diverged.
+    double velocityDivergence = 1e6;
+    double headingDivergence = 1e6;
+    /// Trajectory file receiving every step, or empty to not record.
+    std::string recordPath;
+
+    /**
+     * @brief Collects the step budget, tolerances and limits of the run.
+     *
+     * @return The convergence criteria of the scenario.
+     */
+    ConvergenceCriteria getConvergenceCriteria() const {
+        ConvergenceCriteria criteria;
+        criteria.maxIterations = maxIterations;
+        criteria.velocityTolerance = velocityTolerance;
+        criteria.headingTolerance = headingTolerance;
+        criteria.settleWindow = settleWindow;
+        criteria.stopOnConvergence = stopOnConvergence;
+        criteria.velocityDivergence = velocityDivergence;
+        criteria.headingDivergence = headingDivergence;
+        return criteria;
+    }
+};
+
+/**
+ * @brief Outcome of running one scenario.
+ */
+struct ScenarioSummary {
+    /// True if both channels ended settled within their tolerances.
+    bool converged = false;
+    /// Why the run ended.
+    TerminationReason reason = TerminationReason::MaxIterations;
+    /// Number of control steps executed.
+    int steps = 0;
+    double finalX = 0.0;
+    double finalY = 0.0;
+    double finalTheta = 0.0;
+    double finalHeading = 0.0;
+    double finalVelocity = 0.0;
+    /// Largest excursion of the velocity past its target.
+    double velocityOvershoot = 0.0;
+    /// Largest excursion of the heading past its target (radians).
+    double headingOvershoot = 0.0;
+    /// Time after which both channels stayed within their tolerances, or
+    /// -1 if the run did not end settled.
+    double settlingTime = -1.0;
+};
+
+#endif // SCENARIO_HPP
@@ -0,0 +1,122 @@
+/**
+ * @file ScenarioFile.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Reads simulation scenarios from key-value files and writes results.
+ *
+ * A scenario file is read one line at a time:
+ *
+ *     # Keys before the first section set the defaults of every scenario.
+ *     dt = 0.1
+ *     max_iterations = 200
+ *
+ *     [scenario]
+ *     name = gentle_left
+ *     vel_p = 0.8
+ *     setpoint = 0.3 10      # target heading (rad) and velocity
+ *     setpoint = 0.6 15
+ *
+ * Every [scenario] section starts from the defaults. Each setpoint line
+ * produces one run; a section without setpoints runs once with its
+ * target_heading and target_velocity. Setpoints belong to a section once
+ * there is one, so setpoints outside of any section (including those from
+ * the command line) are rejected when sections exist.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SCENARIO_FILE_HPP
+#define SCENARIO_FILE_HPP
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Scenario.hpp"
+
+class ScenarioParser {
+public:
+    /**
+     * @brief Constructor for the ScenarioParser class.
+     */
+    ScenarioParser();
+
+    /**
+     * @brief Parses scenarios from a stream, appending to those already read.
+     *
+     * @param input The stream to read.
+     * @param source The name used in error messages.
+     * @throws std::runtime_error On a malformed line or an unknown key.
+     */
+    void parse(std::istream& input, const std::string& source = "<input>");
+
+    /**
+     * @brief Parses scenarios from a file.
+     *
+     * @param path The path of the scenario file.
+     * @throws std::runtime_error If the file cannot be read or is malformed.
+     */
+    void parseFile(const std::string& path);
+
+    /**
+     * @brief Sets a default used by every scenario read afterwards, and by
+     *        the implicit scenario when no section is given.
+     *
+     * @param key The scenario key.
+     * @param value The value of the key.
+     * @throws std::invalid_argument On an unknown key or a bad value.
+     */
+    void setDefault(const std::string& key, const std::string& value);
+
+    /**
+     * @brief Applies a single key to a scenario.
+     *
+     * @param scenario The scenario to modify.
+     * @param key The scenario key, e.g. "vel_p" or "dt".
+     * @param value The value of the key.
+     * @throws std::invalid_argument On an unknown key or a bad value.
+     */
+    static void applyKey(Scenario& scenario, const std::string& key,
+                         const std::string& value);
+
+    /**
+     * @brief Retrieves every run described so far, one per setpoint.
+     *
+     * If no [scenario] section was read, the defaults and setpoints given
+     * outside of any section form a single scenario.
+     *
+     * @return The scenarios to run.
+     * @throws std::invalid_argument If setpoints were given outside of any
+     *         section while sections exist, as they would not be run.
+     */
+    std::vector<Scenario> getScenarios() const;
+
+private:
+    typedef std::pair<double, double> Setpoint;
+
+    struct Section {
+        Scenario scenario;
+        std::vector<Setpoint> setpoints;
+    };
+
+    void apply(Section& section, const std::string& key,
+               const std::string& value);
+
+    Section defaults_;
+    std::vector<Section> sections_;
+};
+
+/**
+ * @brief Writes one CSV line per scenario with its targets and summary.
+ *
+ * @param output The stream receiving the table.
+ * @param scenarios The scenarios that were run.
+ * @param summaries The summaries, in the same order.
+ */
+void writeSummaryCsv(std::ostream& output,
+                     const std::vector<Scenario>& scenarios,
+                     const std::vector<ScenarioSummary>& summaries);
+
+#endif // SCENARIO_FILE_HPP
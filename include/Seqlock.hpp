@@ -0,0 +1,138 @@
+/**
+ * @file Seqlock.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Latest-value cell with one writer and any number of readers.
+ *
+ * The writer makes the sequence counter odd, copies the value in, and makes
+ * the counter even again. A reader copies the value out between two reads
+ * of the counter. It retries if the counter was odd or changed in between,
+ * so it never sees a torn value. Readers never delay the writer. The value
+ * is copied word by word through relaxed atomics, so a reader that races
+ * the writer and retries is still free of data races.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Seqlock holds trivially copyable values");
+
+public:
+    /**
+     * @brief Constructor for the Seqlock class.
+     *
+     * @param value The initial value.
+     */
+    explicit Seqlock(const T& value = T()) : sequence_(0) {
+        for (std::atomic<std::uint64_t>& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+        store(value);
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    /**
+     * @brief Replaces the value. Writer thread only.
+     *
+     * @param value The new value.
+     */
+    void store(const T& value) {
+        std::uint64_t buffer[kWords] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; i++) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the value out, retrying while the writer is active.
+     *
+     * @return The latest complete value.
+     */
+    T load() const {
+        std::uint64_t version;
+        return load(version);
+    }
+
+    /**
+     * @brief Copies the value out, retrying while the writer is active.
+     *
+     * @param version The store count of the copied value (output), as
+     *        getVersion() would have returned it during the copy.
+     * @return The latest complete value.
+     */
+    T load(std::uint64_t& version) const {
+        T value;
+        while (!tryLoad(value, version)) {
+        }
+        return value;
+    }
+
+    /**
+     * @brief Copies the value out once.
+     *
+     * @param value The value (output); only valid when true is returned.
+     * @return False if the writer was active during the copy.
+     */
+    bool tryLoad(T& value) const {
+        std::uint64_t version;
+        return tryLoad(value, version);
+    }
+
+    /**
+     * @brief Copies the value out once, with the store count it belongs to.
+     *
+     * @param value The value (output); only valid when true is returned.
+     * @param version The store count of the value (output); only valid
+     *        when true is returned.
+     * @return False if the writer was active during the copy.
+     */
+    bool tryLoad(T& value, std::uint64_t& version) const {
+        std::uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        std::uint64_t buffer[kWords];
+        for (std::size_t i = 0; i < kWords; i++) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(&value, buffer, sizeof(T));
+        version = before / 2;
+        return true;
+    }
+
+    /**
+     * @brief Retrieves the number of completed stores, including the one
+     *        of the constructor.
+     *
+     * @return The store count.
+     */
+    std::uint64_t getVersion() const {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static const std::size_t kWords = (sizeof(T) + 7) / 8;
+
+    std::atomic<std::uint64_t> sequence_;
+    std::atomic<std::uint64_t> words_[kWords];
+};
+
+#endif // SEQLOCK_HPP
@@ -0,0 +1,122 @@
+/**
+ * @file SetpointProfile.hpp
+ * @author Driver - Manav Bhavesh Nagda
+ *         Navigator - Sameer Arjun Satheesh
+ *         Design Keeper - Ishaan Samir Parikh
+ * @brief Moves a setpoint from its current value to a new target over time.
+ *
+ * A step jumps at once. A ramp moves at constant rate over the given
+ * duration. An S-curve follows 3 s^2 - 2 s^3 of the elapsed fraction s, so
+ * it starts and ends with zero rate and moves 1.5 times as fast as the
+ * ramp in the middle. A new target starts from wherever the setpoint is,
+ * so changing the target mid-transition never makes the setpoint jump
+ * unless the new profile is a step.
+ *
+ * The state is a few numbers; it does not grow however long it runs.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SETPOINT_PROFILE_HPP
+#define SETPOINT_PROFILE_HPP
+
+#include <string>
+
+/**
+ * @brief How a setpoint moves to a new target.
+ */
+enum class ProfileShape {
+    /// Jumps to the target.
+    Step,
+    /// Moves at constant rate.
+    Ramp,
+    /// Accelerates and decelerates smoothly.
+    SCurve,
+};
+
+/**
+ * @brief Get the name of a profile shape, as accepted by
+ *        parseProfileShape().
+ *
+ * @param shape The profile shape.
+ * @return One of step, ramp or s_curve.
+ */
+const char* profileShapeName(ProfileShape shape);
+
+/**
+ * @brief Parses the name of a profile shape.
+ *
+ * @param name One of step, ramp or s_curve.
+ * @return The profile shape.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+ProfileShape parseProfileShape(const std::string& name);
+
+class SetpointProfile {
+public:
+    /**
+     * @brief Constructor for the SetpointProfile class.
+     *
+     * @param value The initial setpoint, also the target.
+     */
+    explicit SetpointProfile(double value = 0.0);
+
+    /**
+     * @brief Starts moving from the current setpoint to a new target.
+     *
+     * @param target The new target.
+     * @param shape How the setpoint moves.
+     * @param duration The time the move takes; ignored for a step, and a
+     *        ramp or S-curve of zero duration is a step.
+     * @throws std::invalid_argument If the target is not finite or the
+     *         duration is negative or not finite.
+     */
+    void setTarget(double target, ProfileShape shape = ProfileShape::Step,
+                   double duration = 0.0);
+
+    /**
+     * @brief Jumps to a value and stops any move in progress.
+     *
+     * @param value The new setpoint, also the target.
+     */
+    void reset(double value);
+
+    /**
+     * @brief Moves the setpoint on by a time step.
+     *
+     * @param dt The time step.
+     * @return The setpoint after the step.
+     */
+    double advance(double dt);
+
+    /**
+     * @brief Get the current setpoint.
+     *
+     * @return The setpoint.
+     */
+    double getValue() const;
+
+    /**
+     * @brief Get the target the setpoint moves to.
+     *
+     * @return The target.
+     */
+    double getTarget() const;
+
+    /**
+     * @brief Checks whether the setpoint has reached its target.
+     *
+     * @return True if no move is in progress.
+     */
+    bool isSettled() const;
+
+private:
+    double start_;
+    double target_;
+    double value_;
+    double duration_;
+    double elapsed_;
+    ProfileShape shape_;
+};
+
+#endif // SETPOINT_PROFILE_HPP
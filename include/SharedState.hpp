@@ -0,0 +1,212 @@
+/**
+ * @file SharedState.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Publishes the latest simulation state to other processes through
+ *        a POSIX shared-memory segment.
+ *
+ * The segment holds a small header and a Seqlock with the latest sample.
+ * The publisher, one per segment, writes the sample in place after every
+ * step; it never waits for readers. A reader maps the segment read-only
+ * and copies the sample out, retrying while a write is in progress. Once
+ * the segment is mapped, neither side makes a system call and no data is
+ * copied through the kernel, so an update becomes visible as fast as the
+ * cache line moves between cores.
+ *
+ * A reader that polls less often than the publisher writes sees only the
+ * latest sample; getPublishCount() tells how many were skipped. Samples
+ * are stored in native byte order and layout, so the processes must run
+ * on the same machine and be built from the same header.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SHARED_STATE_HPP
+#define SHARED_STATE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "PIDController.hpp"
+#include "Seqlock.hpp"
+#include "TrajectoryRecorder.hpp"
+
+/**
+ * @brief One published sample.
+ */
+struct SharedStateSample {
+    /// The state and PID terms, as RobotSimulation::makeSample() builds it.
+    TrajectorySample state;
+    /// The command applied in the step, from whichever controller is used.
+    double velocityCommand;
+    double headingCommand;
+    /// CLOCK_MONOTONIC time of the publication (nanoseconds).
+    std::uint64_t publishTime;
+};
+
+/**
+ * @brief Layout of the shared-memory segment.
+ */
+struct SharedStateSegment {
+    /// Written last by the publisher, once the segment is initialised.
+    std::atomic<std::uint64_t> magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t sampleBytes;
+    /// 1 while the publisher holds the segment, 0 after it closed it.
+    std::atomic<std::uint32_t> publisherOpen;
+    Seqlock<SharedStateSample> latest;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared-memory atomics must be lock-free");
+
+class SharedStatePublisher {
+public:
+    /**
+     * @brief Creates the segment, replacing any segment of the same name.
+     *
+     * Readers still mapping a replaced segment keep it but see no further
+     * updates.
+     *
+     * @param name The POSIX shared-memory name, e.g. "/ackermann".
+     * @throws std::invalid_argument If the name does not start with '/' or
+     *         contains another '/'.
+     * @throws std::runtime_error If the segment cannot be created.
+     */
+    explicit SharedStatePublisher(const std::string& name);
+
+    /**
+     * @brief Marks the segment closed and removes its name.
+     */
+    ~SharedStatePublisher();
+
+    SharedStatePublisher(const SharedStatePublisher&) = delete;
+    SharedStatePublisher& operator=(const SharedStatePublisher&) = delete;
+
+    /**
+     * @brief Replaces the published sample and stamps it with the current
+     *        time.
+     *
+     * @param state The state after the step.
+     * @param command The command applied in the step.
+     */
+    void publish(const TrajectorySample& state, const PIDOutput& command);
+
+    /**
+     * @brief Get the name of the segment.
+     *
+     * @return The shared-memory name.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Get the number of samples published.
+     *
+     * @return The publish count.
+     */
+    std::uint64_t getPublishCount() const;
+
+private:
+    std::string name_;
+    SharedStateSegment* segment_;
+};
+
+class SharedStateReader {
+public:
+    /**
+     * @brief Maps a segment created by SharedStatePublisher.
+     *
+     * @param name The POSIX shared-memory name.
+     * @throws std::runtime_error If the segment does not exist, is not yet
+     *         initialised or has another layout.
+     */
+    explicit SharedStateReader(const std::string& name);
+
+    /**
+     * @brief Unmaps the segment.
+     */
+    ~SharedStateReader();
+
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+    /**
+     * @brief Copies the latest sample out, retrying while it is written.
+     *
+     * @return The sample; all zero before the first publication.
+     */
+    SharedStateSample read() const {
+        return segment_->latest.load();
+    }
+
+    /**
+     * @brief Copies the latest sample out, retrying while it is written.
+     *
+     * @param publishCount The publish count of the sample (output), taken
+     *        from the same consistent read as the sample itself.
+     * @return The sample; all zero before the first publication.
+     */
+    SharedStateSample read(std::uint64_t& publishCount) const {
+        SharedStateSample sample = segment_->latest.load(publishCount);
+        // The constructor of the cell counts as one store
+        publishCount--;
+        return sample;
+    }
+
+    /**
+     * @brief Copies the latest sample out once.
+     *
+     * @param sample The sample (output); only valid when true is returned.
+     * @return False if the publisher was writing during the copy.
+     */
+    bool tryRead(SharedStateSample& sample) const {
+        return segment_->latest.tryLoad(sample);
+    }
+
+    /**
+     * @brief Copies the latest sample out once, with its publish count.
+     *
+     * @param sample The sample (output); only valid when true is returned.
+     * @param publishCount The publish count of the sample (output); only
+     *        valid when true is returned.
+     * @return False if the publisher was writing during the copy.
+     */
+    bool tryRead(SharedStateSample& sample,
+                 std::uint64_t& publishCount) const {
+        if (!segment_->latest.tryLoad(sample, publishCount)) return false;
+        publishCount--;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of samples published so far. Polling it is
+     *        the cheapest way to wait for an update.
+     *
+     * @return The publish count.
+     */
+    std::uint64_t getPublishCount() const {
+        // The constructor of the cell counts as one store
+        return segment_->latest.getVersion() - 1;
+    }
+
+    /**
+     * @brief Checks whether the publisher still holds the segment.
+     *
+     * @return False once the publisher was destroyed.
+     */
+    bool isPublisherOpen() const;
+
+    /**
+     * @brief Get the name of the segment.
+     *
+     * @return The shared-memory name.
+     */
+    const std::string& getName() const;
+
+private:
+    std::string name_;
+    const SharedStateSegment* segment_;
+};
+
+#endif // SHARED_STATE_HPP
@@ -0,0 +1,151 @@
+/**
+ * @file SimulationContext.hpp
+ * @author Driver - Ishaan Samir Parikh
+ *         Navigator - Manav Bhavesh Nagda
+ *         Design Keeper - Sameer Arjun Satheesh
+ * @brief Reusable per-thread state for running many scenarios back to back.
+ *
+ * A context owns a MonotonicArena that is reset at the start of every run.
+ * The per-run buffers of a scenario (the controller error histories and
+ * the kept trajectory) are taken from the arena, and steering tables are
+ * cached by vehicle geometry so identical vehicles share one table. Once
+ * the arena and the cache have warmed up, setting up and running a
+ * scenario makes no heap allocations.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SIMULATION_CONTEXT_HPP
+#define SIMULATION_CONTEXT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "MonotonicArena.hpp"
+#include "RobotSimulation.hpp"
+#include "Scenario.hpp"
+
+class SimulationContext {
+public:
+    /**
+     * @brief Constructor for the SimulationContext class.
+     *
+     * @param arenaBlockSize The size of the arena's first block (bytes).
+     */
+    explicit SimulationContext(std::size_t arenaBlockSize = 64 * 1024);
+
+    SimulationContext(const SimulationContext&) = delete;
+    SimulationContext& operator=(const SimulationContext&) = delete;
+
+    /**
+     * @brief Retrieves the context of the calling thread, created on first
+     *        use.
+     *
+     * @return The context.
+     */
+    static SimulationContext& forThread();
+
+    /**
+     * @brief Keeps every step of the following runs in the arena.
+     *
+     * @param keep Whether to keep the trajectory.
+     */
+    void setKeepTrajectory(bool keep);
+
+    /**
+     * @brief Starts a run: releases the previous run's memory and builds
+     *        the simulation the scenario describes.
+     *
+     * Memory from the previous run, including getTrajectory(), is no
+     * longer valid afterwards.
+     *
+     * @param scenario The scenario.
+     * @return The simulation, ready to step and valid until the next run.
+     */
+    RobotSimulation& begin(const Scenario& scenario);
+
+    /**
+     * @brief Appends the simulation's current state to the kept
+     *        trajectory. Does nothing when the trajectory is not kept or
+     *        is full.
+     */
+    void recordStep();
+
+    /**
+     * @brief Get the steering table for a scenario's vehicle, shared by
+     *        all runs of the context with the same geometry.
+     *
+     * @param scenario The scenario.
+     * @return The table, or nullptr when none is cached yet.
+     */
+    std::shared_ptr<const SteeringTable> findSteeringTable(
+                                            const Scenario& scenario) const;
+
+    /**
+     * @brief Caches the steering table of a scenario's vehicle. The oldest
+     *        entry is dropped when the cache is full.
+     *
+     * @param scenario The scenario the table was built for.
+     * @param table The table.
+     */
+    void storeSteeringTable(const Scenario& scenario,
+                            std::shared_ptr<const SteeringTable> table);
+
+    /**
+     * @brief Get the simulation of the current run.
+     *
+     * @return The simulation.
+     */
+    RobotSimulation& getSimulation();
+
+    /**
+     * @brief Get the steps kept in the current run.
+     *
+     * @return The first sample, or nullptr when nothing is kept.
+     */
+    const TrajectorySample* getTrajectory() const;
+
+    /**
+     * @brief Get the number of steps kept in the current run.
+     *
+     * @return The number of samples.
+     */
+    std::size_t getTrajectorySize() const;
+
+    /**
+     * @brief Get the number of cached steering tables.
+     *
+     * @return The cache size.
+     */
+    std::size_t getCachedSteeringTables() const;
+
+    /**
+     * @brief Get the arena holding the per-run buffers.
+     *
+     * @return The arena.
+     */
+    MonotonicArena& getArena();
+
+private:
+    /// A steering table with the geometry it was built for.
+    struct CachedTable {
+        double wheelbase;
+        double trackWidth;
+        double maxSteeringAngle;
+        double range;
+        int intervals;
+        bool cubic;
+        std::shared_ptr<const SteeringTable> table;
+    };
+
+    MonotonicArena arena_;
+    RobotSimulation simulation_;
+    std::vector<CachedTable> tables_;
+    std::size_t nextTable_;
+    bool keepTrajectory_;
+    TrajectorySample* trajectory_;
+    std::size_t trajectoryCapacity_;
+    std::size_t trajectorySize_;
+};
+
+#endif // SIMULATION_CONTEXT_HPP
@@ -0,0 +1,137 @@
+/**
+ * @file SpatialGrid.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Uniform-grid spatial index over 2D points, for nearest-neighbour
+ *        and proximity queries.
+ *
+ * The plane is divided into square cells. Cells are hashed into a table
+ * with at least two slots per point, so the workspace needs no bounds.
+ * build() counting-sorts the points by slot in O(n). Each slot's points
+ * are then contiguous, and their coordinates are copied next to the
+ * indices. A query visits only the cells its search region overlaps. It
+ * checks each candidate's cell key, so two cells sharing a slot are never
+ * confused. When a search region would span more cells than the table
+ * has slots, the query scans all points instead.
+ *
+ * Queries are const and may run concurrently. build() must not overlap
+ * them.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+class SpatialGrid {
+public:
+    /// Returned by nearest() when there is no candidate.
+    static const std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Constructor for the SpatialGrid class.
+     *
+     * @param cellSize The side of a cell; about the usual query radius
+     *        works best.
+     * @throws std::invalid_argument If the cell size is not positive.
+     */
+    explicit SpatialGrid(double cellSize = 1.0);
+
+    /**
+     * @brief Replaces the indexed points. Point i is (x[i], y[i]); points
+     *        with a non-finite coordinate are left out.
+     *
+     * @param x The x-coordinates.
+     * @param y The y-coordinates.
+     * @param count The number of points.
+     */
+    void build(const double* x, const double* y, std::size_t count);
+
+    /**
+     * @brief Finds the indexed point closest to a position.
+     *
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @param exclude A point to skip, e.g. the one at the position.
+     * @param distance The distance to the closest point (output).
+     * @return The index of the closest point, or npos if there is none.
+     */
+    std::size_t nearest(double x, double y, std::size_t exclude,
+                        double& distance) const;
+
+    /**
+     * @brief Appends every indexed point within a radius of a position.
+     *
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @param radius The search radius.
+     * @param result The indices found, appended in no particular order.
+     */
+    void queryRadius(double x, double y, double radius,
+                     std::vector<std::size_t>& result) const;
+
+    /**
+     * @brief Appends every pair of indexed points at most a radius apart,
+     *        for the points at sorted positions [begin, end).
+     *
+     * Each pair (i, j), i < j, is reported from the sorted position of i
+     * only, so disjoint ranges covering [0, size()) report every pair
+     * once and may run concurrently.
+     *
+     * @param radius The largest distance of a pair.
+     * @param begin The first sorted position.
+     * @param end One past the last sorted position.
+     * @param pairs The pairs found, appended.
+     */
+    void findPairs(double radius, std::size_t begin, std::size_t end,
+                   std::vector<std::pair<std::size_t, std::size_t>>& pairs)
+                   const;
+
+    /**
+     * @brief Retrieves the number of indexed points.
+     *
+     * @return The number of points with finite coordinates.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Retrieves the side of a cell.
+     *
+     * @return The cell size.
+     */
+    double getCellSize() const;
+
+private:
+    struct Entry {
+        double x;
+        double y;
+        std::uint64_t cell;
+        std::size_t index;
+    };
+
+    std::int64_t cellCoordinate(double value) const;
+    static std::uint64_t cellKey(std::int64_t cx, std::int64_t cy);
+    std::size_t slotOf(std::uint64_t key) const;
+    template <typename Visit>
+    void forEachInBox(std::int64_t minX, std::int64_t maxX,
+                      std::int64_t minY, std::int64_t maxY,
+                      Visit visit) const;
+
+    double cellSize_;
+    double inverseCellSize_;
+    unsigned slotBits_;
+    /// Entries of slot s are entries_[slotStart_[s], slotStart_[s + 1]).
+    std::vector<std::size_t> slotStart_;
+    std::vector<Entry> entries_;
+    /// Scratch of build(): the slot of every point, or npos.
+    std::vector<std::size_t> pointSlot_;
+};
+
+#endif // SPATIAL_GRID_HPP
@@ -0,0 +1,124 @@
+/**
+ * @file SpscQueue.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Bounded lock-free queue for one producer and one consumer thread.
+ *
+ * The queue is a power-of-two ring of slots indexed by two counters. The
+ * producer owns the tail and the consumer owns the head. Each side keeps a
+ * cached copy of the other side's counter and reloads it only when the ring
+ * looks full or empty, so most operations touch no shared cache line
+ * besides the slot itself. The counters are padded onto separate cache
+ * lines. Neither operation blocks: tryPush() fails when the ring is full
+ * and tryPop() fails when it is empty.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscQueue holds trivially copyable values");
+
+public:
+    /**
+     * @brief Constructor for the SpscQueue class.
+     *
+     * @param capacity The number of slots, rounded up to a power of two.
+     * @throws std::invalid_argument If the capacity is zero.
+     */
+    explicit SpscQueue(std::size_t capacity)
+        : head_(0), cachedTail_(0), tail_(0), cachedHead_(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        std::size_t slots = 1;
+        while (slots < capacity) slots <<= 1;
+        mask_ = slots - 1;
+        slots_.reset(new T[slots]);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Appends a value. Producer thread only.
+     *
+     * @param value The value.
+     * @return False if the queue is full and the value was not added.
+     */
+    bool tryPush(const T& value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) return false;
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest value. Consumer thread only.
+     *
+     * @param value The value (output).
+     * @return False if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Retrieves the number of queued values. Exact only when
+     *        neither thread is active.
+     *
+     * @return The number of values.
+     */
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Retrieves the number of slots.
+     *
+     * @return The capacity, a power of two.
+     */
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    static const std::size_t kCacheLine = 64;
+
+    std::unique_ptr<T[]> slots_;
+    std::size_t mask_;
+    char padding0_[kCacheLine];
+    // Consumer side
+    std::atomic<std::size_t> head_;
+    std::size_t cachedTail_;
+    char padding1_[kCacheLine];
+    // Producer side
+    std::atomic<std::size_t> tail_;
+    std::size_t cachedHead_;
+    char padding2_[kCacheLine];
+};
+
+#endif // SPSC_QUEUE_HPP
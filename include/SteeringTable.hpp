@@ -0,0 +1,191 @@
+/**
+ * @file SteeringTable.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Lookup table of the Ackermann steering geometry of one vehicle.
+ *
+ * For a commanded steering angle delta, the turning radius is
+ * R = wheelbase / tan(delta). RobotModel then needs the two front wheel
+ * angles and the wheel speed ratios, at the cost of one tan and two atan
+ * per tick. SteeringTable samples these quantities once on a uniform grid
+ * over [-range, range]. Each lookup then interpolates them, linearly or
+ * with a cubic Catmull-Rom spline.
+ *
+ * The wheel angle atan(wheelbase / (R - trackWidth / 2)) jumps where
+ * tan(delta) = 2 wheelbase / trackWidth. The table must end before that
+ * pole.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef STEERING_TABLE_HPP
+#define STEERING_TABLE_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Steering geometry for one commanded steering angle.
+ *
+ * R is the signed turning radius and T the track width.
+ */
+struct SteeringGeometry {
+    /// 1 / R, i.e. tan(delta) / wheelbase.
+    double curvature = 0.0;
+    /// atan(wheelbase / (R - T / 2)): the inner wheel angle of a left turn
+    /// and the outer wheel angle of a right turn.
+    double angleMinus = 0.0;
+    /// atan(wheelbase / (R + T / 2)): the other front wheel angle.
+    double anglePlus = 0.0;
+    /// (R - T / 2) / (R + T / 2): the ratio of the two wheel speeds.
+    double wheelRatio = 0.0;
+    /// R / (R + T / 2): the speed of the robot over the speed of the wheel
+    /// driving the turn.
+    double centerRatio = 0.0;
+
+    /**
+     * @brief Computes the geometry with tan and atan.
+     *
+     * @param wheelbase The distance between the front and rear axles.
+     * @param trackWidth The distance between the left and right wheels.
+     * @param steeringAngle The commanded steering angle (radians).
+     * @return The geometry.
+     */
+    static SteeringGeometry compute(double wheelbase, double trackWidth,
+                                    double steeringAngle);
+};
+
+/**
+ * @brief How SteeringTable interpolates between its samples.
+ */
+enum class SteeringInterpolation {
+    Linear,
+    Cubic,
+};
+
+class SteeringTable {
+public:
+    /**
+     * @brief Constructor for the SteeringTable class. Samples the geometry
+     *        and measures the interpolation error.
+     *
+     * @param wheelbase The distance between the front and rear axles.
+     * @param trackWidth The distance between the left and right wheels.
+     * @param range The table covers steering angles in [-range, range].
+     * @param intervals The number of grid intervals over the range.
+     * @param interpolation Linear or cubic interpolation.
+     * @throws std::invalid_argument If the range is not positive, there are
+     *         fewer than two intervals, or the table reaches the pole of
+     *         the wheel angles or pi / 2.
+     */
+    SteeringTable(double wheelbase, double trackWidth, double range,
+                  std::size_t intervals = 512,
+                  SteeringInterpolation interpolation =
+                      SteeringInterpolation::Cubic);
+
+    /**
+     * @brief Checks whether a steering angle lies within the table.
+     *
+     * @param steeringAngle The commanded steering angle (radians).
+     * @return True if |steeringAngle| <= range.
+     */
+    bool covers(double steeringAngle) const {
+        return steeringAngle >= -range_ && steeringAngle <= range_;
+    }
+
+    /**
+     * @brief Interpolates the geometry of a covered steering angle.
+     *
+     * @param steeringAngle The commanded steering angle (radians); must be
+     *        covered.
+     * @return The interpolated geometry.
+     */
+    SteeringGeometry lookup(double steeringAngle) const {
+        double position = (steeringAngle + range_) * inverseStep_;
+        std::size_t i = static_cast<std::size_t>(position);
+        if (i >= intervals_) i = intervals_ - 1;
+        double f = position - static_cast<double>(i);
+        // samples_[i + 1] is the sample at the start of interval i
+        const SteeringGeometry* p = &samples_[i];
+
+        SteeringGeometry result;
+        if (interpolation_ == SteeringInterpolation::Linear) {
+            result.curvature = linear(p, &SteeringGeometry::curvature, f);
+            result.angleMinus = linear(p, &SteeringGeometry::angleMinus, f);
+            result.anglePlus = linear(p, &SteeringGeometry::anglePlus, f);
+            result.wheelRatio = linear(p, &SteeringGeometry::wheelRatio, f);
+            result.centerRatio = linear(p, &SteeringGeometry::centerRatio, f);
+        } else {
+            const SteeringGeometry* c = &splines_[4 * i];
+            result.curvature = horner(c, &SteeringGeometry::curvature, f);
+            result.angleMinus = horner(c, &SteeringGeometry::angleMinus, f);
+            result.anglePlus = horner(c, &SteeringGeometry::anglePlus, f);
+            result.wheelRatio = horner(c, &SteeringGeometry::wheelRatio, f);
+            result.centerRatio = horner(c, &SteeringGeometry::centerRatio, f);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the largest interpolation error of each quantity,
+     *        measured at construction between the samples.
+     *
+     * @return The largest absolute error of every field.
+     */
+    const SteeringGeometry& getMaxError() const;
+
+    /**
+     * @brief Retrieves the largest covered steering angle.
+     *
+     * @return The range in radians.
+     */
+    double getRange() const;
+
+    /**
+     * @brief Retrieves the number of grid intervals.
+     *
+     * @return The number of intervals.
+     */
+    std::size_t getIntervals() const;
+
+    /**
+     * @brief Retrieves the interpolation scheme.
+     *
+     * @return Linear or cubic.
+     */
+    SteeringInterpolation getInterpolation() const;
+
+private:
+    /// The interpolated fields of SteeringGeometry.
+    static double SteeringGeometry::* const kFields[5];
+
+    /// Interpolates one field linearly between p[1] and p[2].
+    static double linear(const SteeringGeometry* p,
+                         double SteeringGeometry::*field, double f) {
+        double a = p[1].*field;
+        return a + (p[2].*field - a) * f;
+    }
+
+    /// Evaluates the cubic c[0] + f (c[1] + f (c[2] + f c[3])) of a field.
+    static double horner(const SteeringGeometry* c,
+                         double SteeringGeometry::*field, double f) {
+        return c[0].*field + f * (c[1].*field +
+                                  f * (c[2].*field + f * c[3].*field));
+    }
+
+    double range_;
+    std::size_t intervals_;
+    SteeringInterpolation interpolation_;
+    double step_;
+    double inverseStep_;
+    /// Samples at -range - step, -range, ..., range, range + step; the
+    /// outer two only serve the cubic spline.
+    std::vector<SteeringGeometry> samples_;
+    /// Four polynomial coefficients per interval of the Catmull-Rom spline
+    /// through the samples, lowest order first.
+    std::vector<SteeringGeometry> splines_;
+    SteeringGeometry maxError_;
+};
+
+#endif // STEERING_TABLE_HPP
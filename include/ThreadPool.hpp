@@ -0,0 +1,93 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Work-stealing thread pool used by the parallel runners.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor for the ThreadPool class.
+     *
+     * @param threads The number of worker threads. Zero uses one thread per
+     *                hardware core.
+     */
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /**
+     * @brief Stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Retrieves the number of worker threads.
+     *
+     * @return The number of worker threads.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Runs task(i) for every i in [0, count) and waits for completion.
+     *
+     * The index range is split into chunks that are dealt to the workers'
+     * queues; idle workers steal chunks from the front of other queues. The
+     * first exception thrown by a task is rethrown here once all chunks are
+     * done. Tasks must not call parallelFor() on the same pool.
+     *
+     * @param count The number of indices to process.
+     * @param task The task invoked with each index.
+     * @param grain The number of indices per chunk (0 picks a default).
+     */
+    void parallelFor(std::size_t count,
+                     const std::function<void(std::size_t)>& task,
+                     std::size_t grain = 0);
+
+private:
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+        const std::function<void(std::size_t)>* task;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void workerLoop(std::size_t id);
+    bool takeChunk(std::size_t id, Chunk& chunk);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::mutex callMutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::size_t pendingChunks_;
+    std::uint64_t generation_;
+    bool stopping_;
+    std::exception_ptr error_;
+};
+
+#endif // THREAD_POOL_HPP
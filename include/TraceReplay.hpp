@@ -0,0 +1,150 @@
+/**
+ * @file TraceReplay.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Replays a scenario against a recorded golden trajectory and diffs
+ *        every tick.
+ *
+ * The golden trace is a trajectory file written by TrajectoryRecorder for
+ * a scenario run, e.g. by shell-app --record. The targets of every tick
+ * are read from the trace, so runs whose setpoints change, such as a
+ * ControlSession, replay as recorded. A bumpless transfer changes the
+ * controller state between ticks and is not recorded, so a session that
+ * made one does not replay exactly. There are two modes:
+ * - ClosedLoop rebuilds the simulation from the scenario and steps it once
+ *   per recorded tick, comparing all columns.
+ * - Controller feeds the recorded measured heading and speed of the
+ *   previous tick through a PIDController, comparing only the controller
+ *   columns. A difference found this way lies in the controller, not in
+ *   the plant.
+ *
+ * A value matches when |actual - golden| <= absolute + relative *
+ * max(|actual|, |golden|). Two NaNs match. Both tolerances default to 0,
+ * so a replay with unchanged code and build must match bit for bit.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef TRACE_REPLAY_HPP
+#define TRACE_REPLAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Scenario.hpp"
+#include "TrajectoryRecorder.hpp"
+
+/**
+ * @brief What a replay re-runs.
+ */
+enum class ReplayMode {
+    ClosedLoop,
+    Controller,
+};
+
+/**
+ * @brief Get the name of a replay mode, as used on the command line.
+ *
+ * @param mode The replay mode.
+ * @return "closed_loop" or "controller".
+ */
+const char* replayModeName(ReplayMode mode);
+
+/**
+ * @brief Parses the name of a replay mode.
+ *
+ * @param name Either closed_loop or controller.
+ * @return The replay mode.
+ * @throws std::invalid_argument If the name is unknown.
+ */
+ReplayMode parseReplayMode(const std::string& name);
+
+/**
+ * @brief Allowed difference of every trajectory column.
+ */
+struct ReplayTolerance {
+    double absolute[TrajectorySample::kColumnCount];
+    double relative[TrajectorySample::kColumnCount];
+
+    /**
+     * @brief Constructor for the ReplayTolerance struct.
+     *
+     * @param absolute The absolute tolerance of every column.
+     * @param relative The relative tolerance of every column.
+     */
+    explicit ReplayTolerance(double absolute = 0.0, double relative = 0.0);
+};
+
+/**
+ * @brief Differences found in one column.
+ */
+struct ColumnDiff {
+    /// Number of ticks out of tolerance.
+    std::uint64_t mismatches = 0;
+    /// Largest absolute difference, infinite for a NaN against a number.
+    double maxError = 0.0;
+    /// Tick of the largest difference.
+    std::size_t worstTick = 0;
+};
+
+/**
+ * @brief Result of one replay.
+ */
+struct ReplayReport {
+    /// Marks firstMismatch and worstColumn() when nothing differs.
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    ReplayMode mode = ReplayMode::ClosedLoop;
+    /// Number of ticks replayed, i.e. the samples in the golden trace.
+    std::size_t ticks = 0;
+    /// Number of ticks with at least one column out of tolerance.
+    std::size_t mismatchedTicks = 0;
+    /// The first tick out of tolerance, or npos.
+    std::size_t firstMismatch = npos;
+    /// Which columns the mode compares.
+    bool compared[TrajectorySample::kColumnCount] = {};
+    ColumnDiff columns[TrajectorySample::kColumnCount];
+
+    /// True when every compared value is within tolerance.
+    bool passed() const { return mismatchedTicks == 0; }
+
+    /**
+     * @brief Finds the column with the largest difference.
+     *
+     * @return The column index, or npos if every value matched.
+     */
+    std::size_t worstColumn() const;
+};
+
+/**
+ * @brief Replays a scenario against its golden trace.
+ *
+ * @param scenario The scenario, possibly with changed gains or plant.
+ * @param golden The recorded trajectory.
+ * @param mode What to re-run.
+ * @param tolerance The allowed difference per column.
+ * @return The differences.
+ */
+ReplayReport replayTrace(const Scenario& scenario,
+                         const TrajectoryReader& golden,
+                         ReplayMode mode = ReplayMode::ClosedLoop,
+                         const ReplayTolerance& tolerance = ReplayTolerance());
+
+/**
+ * @brief Writes one CSV line per replay, with a header line.
+ *
+ * The columns are name, mode, ticks, mismatched_ticks, first_mismatch,
+ * worst_column and max_error; the last three are empty for a match.
+ *
+ * @param output The stream receiving the table.
+ * @param scenarios The replayed scenarios.
+ * @param reports The report of each scenario.
+ */
+void writeReplayCsv(std::ostream& output,
+                    const std::vector<Scenario>& scenarios,
+                    const std::vector<ReplayReport>& reports);
+
+#endif // TRACE_REPLAY_HPP
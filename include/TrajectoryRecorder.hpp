@@ -0,0 +1,277 @@
+/**
+ * @file TrajectoryRecorder.hpp
+ * @author Driver - Sameer Arjun S
+ *         Navigator - Ishaan Samir Parikh
+ *         Design Keeper - Manav Nagda
+ * @brief Records per-tick simulation state into a columnar binary file.
+ *
+ * A trajectory file is a 64 byte header followed by fixed-size chunks:
+ *
+ *     file:  | header | chunk 0 | chunk 1 | ...
+ *     chunk: | row count (64 bytes) | column 0 | column 1 | ... |
+ *
+ * Every column of a chunk holds chunkRows doubles, so a single signal can
+ * be read without touching the others. Chunks are allocated whole and
+ * written through a memory mapping; the row count of a chunk is updated
+ * with every sample, so the file stays readable if the writer dies. Values
+ * are stored in native byte order.
+ *
+ * A helper thread allocates and faults in the next chunk while the current
+ * one fills, and unmaps the chunks that are full, so record() itself never
+ * waits for the kernel unless it outruns the helper.
+ * @version 0.1
+ * @date 2023
+ */
+
+#ifndef TRAJECTORY_RECORDER_HPP
+#define TRAJECTORY_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief State of the simulation after one control tick.
+ *
+ * The members are the columns of a trajectory file, in file order.
+ */
+struct TrajectorySample {
+    double time;
+    double x;
+    double y;
+    double theta;
+    double heading;
+    double speed;
+    double alphaInner;
+    double alphaOuter;
+    double omegaInner;
+    double omegaOuter;
+    double targetHeading;
+    double targetVelocity;
+    double velocityError;
+    double headingError;
+    double velocityP;
+    double velocityI;
+    double velocityD;
+    double headingP;
+    double headingI;
+    double headingD;
+
+    /// Number of columns in a trajectory file.
+    static const std::size_t kColumnCount = 20;
+
+    /**
+     * @brief Get the name of a column, as used in the CSV header.
+     *
+     * @param column The column index.
+     * @return The column name, or an empty string if out of range.
+     */
+    static const char* columnName(std::size_t column);
+};
+
+static_assert(std::is_standard_layout<TrajectorySample>::value &&
+              sizeof(TrajectorySample) ==
+                  TrajectorySample::kColumnCount * sizeof(double),
+              "TrajectorySample must be a packed array of doubles");
+
+class TrajectoryRecorder {
+public:
+    /// Default number of samples per chunk (one chunk is about 640 KiB).
+    static const std::size_t kDefaultChunkRows = 4096;
+
+    /**
+     * @brief Constructor for the TrajectoryRecorder class.
+     *
+     * The recorder is closed until open() is called.
+     */
+    TrajectoryRecorder();
+
+    /**
+     * @brief Destructor, closes the file.
+     */
+    ~TrajectoryRecorder();
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    /**
+     * @brief Creates or truncates a trajectory file and starts preparing
+     *        its first chunk.
+     *
+     * @param path The path of the file.
+     * @param chunkRows The number of samples per chunk.
+     * @throws std::runtime_error If the file cannot be created or mapped.
+     */
+    void open(const std::string& path,
+              std::size_t chunkRows = kDefaultChunkRows);
+
+    /**
+     * @brief Appends one sample.
+     *
+     * Only the first sample of each chunk synchronises with the helper
+     * thread, to swap in the chunk it prepared.
+     *
+     * @param sample The sample to append.
+     * @throws std::runtime_error If the recorder is closed or a new chunk
+     *         could not be allocated.
+     */
+    void record(const TrajectorySample& sample) {
+        if (row_ == chunkRows_) nextChunk();
+        double values[TrajectorySample::kColumnCount];
+        std::memcpy(values, &sample, sizeof(values));
+        double* cell = current_.data + row_;
+        for (std::size_t column = 0; column < TrajectorySample::kColumnCount;
+             column++) {
+            cell[column * chunkRows_] = values[column];
+        }
+        *current_.rowCount = static_cast<std::uint64_t>(++row_);
+        samples_++;
+    }
+
+    /**
+     * @brief Unmaps and closes the file, dropping the chunk prepared ahead.
+     *        Safe to call more than once.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is open.
+     *
+     * @return True if samples can be recorded.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the number of samples recorded since open().
+     *
+     * @return The number of samples.
+     */
+    std::size_t getSampleCount() const;
+
+private:
+    /**
+     * @brief A mapped chunk of the file.
+     */
+    struct Chunk {
+        void* mapping;
+        std::size_t mappingBytes;
+        std::uint64_t* rowCount;
+        double* data;
+    };
+
+    void nextChunk();
+    void prepareChunks();
+    Chunk mapChunk(std::size_t index);
+    static void unmapChunk(Chunk& chunk);
+
+    int fd_;
+    std::size_t chunkRows_;
+    std::size_t chunkBytes_;
+    std::size_t chunks_;
+    std::size_t row_;
+    std::size_t samples_;
+    Chunk current_;
+
+    // Shared with the helper thread
+    std::thread helper_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    Chunk ready_;
+    Chunk retired_;
+    bool wantChunk_;
+    bool stopping_;
+    std::exception_ptr error_;
+};
+
+class TrajectoryReader {
+public:
+    /**
+     * @brief Constructor for the TrajectoryReader class.
+     *
+     * @param path The path of a file written by TrajectoryRecorder.
+     * @throws std::runtime_error If the file cannot be read or is not a
+     *         trajectory file.
+     */
+    explicit TrajectoryReader(const std::string& path);
+
+    /**
+     * @brief Destructor, unmaps the file.
+     */
+    ~TrajectoryReader();
+
+    TrajectoryReader(const TrajectoryReader&) = delete;
+    TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+    /**
+     * @brief Get the number of samples in the file.
+     *
+     * @return The number of samples.
+     */
+    std::size_t getSampleCount() const;
+
+    /**
+     * @brief Reads one sample.
+     *
+     * @param index The sample index, from 0 to getSampleCount() - 1.
+     * @return The sample.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    TrajectorySample getSample(std::size_t index) const;
+
+    /**
+     * @brief Reads one value of a column.
+     *
+     * @param index The sample index, from 0 to getSampleCount() - 1.
+     * @param column The column index.
+     * @return The value.
+     * @throws std::out_of_range If the index or column is out of range.
+     */
+    double getValue(std::size_t index, std::size_t column) const;
+
+    /**
+     * @brief Retrieves the number of samples per chunk. Sample i is row
+     *        i % getChunkRows() of chunk i / getChunkRows().
+     *
+     * @return The rows of a chunk.
+     */
+    std::size_t getChunkRows() const;
+
+    /**
+     * @brief Gives direct access to one column of a chunk, for scanning
+     *        many samples without a lookup per value.
+     *
+     * @param chunk The chunk index.
+     * @param column The column index.
+     * @return The values of the column in that chunk; only the rows below
+     *         the sample count are valid.
+     * @throws std::out_of_range If the chunk or column is out of range.
+     */
+    const double* getColumn(std::size_t chunk, std::size_t column) const;
+
+private:
+    const double* columnData(std::size_t chunk, std::size_t column) const;
+
+    const unsigned char* mapping_;
+    std::size_t mappingBytes_;
+    std::size_t chunkRows_;
+    std::size_t chunkBytes_;
+    std::size_t chunks_;
+    std::size_t samples_;
+};
+
+/**
+ * @brief Writes a trajectory as CSV with a header line.
+ *
+ * @param output The stream receiving the table.
+ * @param reader The trajectory to convert.
+ */
+void writeTrajectoryCsv(std::ostream& output, const TrajectoryReader& reader);
+
+#endif // TRAJECTORY_RECORDER_HPP
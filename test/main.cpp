@@ -1,4 +1,25 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// Number of heap allocations made by the test binary so far.
+std::atomic<long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
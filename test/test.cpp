@@ -8,12 +8,66 @@
  * @date 2023
  */
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/BatchRunner.hpp"
+#include "../include/ConcurrentSimulation.hpp"
+#include "../include/ControlSession.hpp"
+#include "../include/Fixed16.hpp"
+#include "../include/FixedGainPIDController.hpp"
+#include "../include/FleetSimulation.hpp"
+#include "../include/GainTuner.hpp"
+#include "../include/LatencyHistogram.hpp"
+#include "../include/LinearizedModel.hpp"
+#include "../include/Logger.hpp"
+#include "../include/LQRController.hpp"
+#include "../include/Matrix.hpp"
+#include "../include/MonotonicArena.hpp"
+#include "../include/MPCController.hpp"
+#include "../include/MultiRateSimulation.hpp"
+#include "../include/NumericSimulation.hpp"
+#include "../include/Path.hpp"
+#include "../include/PathTracker.hpp"
 #include "../include/PIDController.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/RateGroupScheduler.hpp"
+#include "../include/RealTimeExecutor.hpp"
+#include "../include/RobotFleet.hpp"
 #include "../include/RobotModel.hpp"
 #include "../include/RobotSimulation.hpp"
+#include "../include/ScenarioFile.hpp"
+#include "../include/SetpointProfile.hpp"
+#include "../include/SharedState.hpp"
+#include "../include/Seqlock.hpp"
+#include "../include/SimulationContext.hpp"
+#include "../include/SpatialGrid.hpp"
+#include "../include/SpscQueue.hpp"
+#include "../include/SteeringTable.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/TraceReplay.hpp"
+#include "../include/TrajectoryRecorder.hpp"
 #define M_PI 3.14159265358979323846
 
+/// Number of heap allocations made by the test binary so far, counted by
+/// the operator new that test/main.cpp replaces.
+extern std::atomic<long> allocationCount;
+
 /**
  * @brief This test case checks if the velocity proportional constant is set correctly.
  */
@@ -75,6 +129,7 @@ TEST(PIDControllerTest, TestHeadingDerivativeConstant) {
  */
 TEST(PIDControllerTest, TestComputeErrors) {
     PIDController PID(1.0, 0.5, 0.2, 0.01, 1.0, 0.5, 0.2);
+    PID.setErrorHistoryCapacity(8);
 
     // Set specific values for testing
     double targetVelocity = 10.0;
@@ -97,6 +152,199 @@ TEST(PIDControllerTest, TestComputeErrors) {
     EXPECT_DOUBLE_EQ(headingError, 3.0);
 }
 
+/**
+ * @brief This test case checks that error history is opt-in and bounded.
+ */
+TEST(PIDControllerTest, TestErrorHistoryIsBounded) {
+    PIDController PID(1.0, 0.5, 0.2, 0.01, 1.0, 0.5, 0.2);
+    PID.computeErrors(1.0, 0.0, 1.0, 0.0);
+    EXPECT_TRUE(PID.getVelocityErrors().empty());
+
+    PID.setErrorHistoryCapacity(3);
+    for (int i = 1; i <= 5; i++) {
+        PID.computeErrors(i, 0.0, 2.0 * i, 0.0);
+    }
+
+    std::vector<double> expectedVelocity = {3.0, 4.0, 5.0};
+    std::vector<double> expectedHeading = {6.0, 8.0, 10.0};
+    EXPECT_EQ(PID.getVelocityErrors(), expectedVelocity);
+    EXPECT_EQ(PID.getHeadingErrors(), expectedHeading);
+
+    // Moving a controller hands over the rings instead of copying them
+    PIDController assigned(1.0, 0.0, 0.0, 0.01, 1.0, 0.0, 0.0);
+    long before = allocationCount.load();
+    PIDController moved(std::move(PID));
+    assigned = std::move(moved);
+    EXPECT_EQ(allocationCount.load(), before);
+    EXPECT_EQ(assigned.getVelocityErrors(), expectedVelocity);
+    EXPECT_EQ(assigned.getHeadingErrors(), expectedHeading);
+    assigned.computeErrors(6.0, 0.0, 12.0, 0.0);
+    EXPECT_EQ(assigned.getVelocityErrors(),
+              std::vector<double>({4.0, 5.0, 6.0}));
+}
+
+/**
+ * @brief This test case checks the running integral and derivative terms.
+ */
+TEST(PIDControllerTest, TestStreamingPIDTerms) {
+    PIDController PID(2.0, 0.5, 0.1, 0.1, 1.0, 0.25, 0.2);
+    EXPECT_TRUE(PID.computePID().empty());
+
+    double errors[] = {4.0, 3.0, -1.0, 2.5};
+    double sum = 0.0;
+    for (double error : errors) {
+        PID.computeErrors(error, 0.0, -error, 0.0);
+        sum += error;
+    }
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), sum);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -sum);
+
+    std::vector<double> out = PID.computePID();
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_DOUBLE_EQ(out[0], 2.0 * 2.5 + 0.5 * sum + 0.1 * (3.5 / 0.1));
+    EXPECT_DOUBLE_EQ(out[1], -2.5 - 0.25 * sum + 0.2 * (-3.5 / 0.1));
+}
+
+/**
+ * @brief This test case checks the anti-windup clamp and reset.
+ */
+TEST(PIDControllerTest, TestIntegralAntiWindup) {
+    PIDController PID(1.0, 1.0, 0.0, 0.1, 1.0, 1.0, 0.0);
+    PID.setIntegralLimits(5.0, 2.0);
+    for (int i = 0; i < 100; i++) {
+        PID.computeErrors(10.0, 0.0, -10.0, 0.0);
+    }
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 5.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -2.0);
+
+    // The clamped integral unwinds as soon as the error changes sign.
+    PID.computeErrors(-1.0, 0.0, 1.0, 0.0);
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 4.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -1.0);
+
+    PID.reset();
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 0.0);
+    EXPECT_TRUE(PID.computePID().empty());
+}
+
+/**
+ * @brief This test case checks that computeControl matches computePID.
+ */
+TEST(PIDControllerTest, TestComputeControlMatchesComputePID) {
+    PIDController PID(1.0, 0.5, 0.2, 0.01, 1.0, 0.5, 0.2);
+    PIDOutput empty = PID.computeControl();
+    EXPECT_DOUBLE_EQ(empty.velocity, 0.0);
+    EXPECT_DOUBLE_EQ(empty.heading, 0.0);
+
+    PID.computeErrors(10.0, 4.0, 1.0, 0.5);
+    PID.computeErrors(10.0, 6.0, 1.0, 0.75);
+    PIDOutput output = PID.computeControl();
+    std::vector<double> legacy = PID.computePID();
+    EXPECT_DOUBLE_EQ(output.velocity, legacy[0]);
+    EXPECT_DOUBLE_EQ(output.heading, legacy[1]);
+}
+
+/**
+ * @brief This test case checks that the control loop never allocates.
+ */
+TEST(PIDControllerTest, TestControlLoopDoesNotAllocate) {
+    PIDController PID(1.0, 0.1, 0.01, 0.1, 1.0, 0.1, 0.01);
+    PID.setErrorHistoryCapacity(64);
+    RobotModel robot(0.5, 1.0, M_PI / 4.0);
+
+    // Warm up once so lazily initialised library state is excluded.
+    PID.computeErrors(20.0, robot.getSpeed(), 0.8, robot.getHeading());
+    PIDOutput output = PID.computeControl();
+    robot.Simulate_robot_model(output.heading, output.velocity, 0.1);
+    robot.updateState(output.heading, 0.1);
+
+    long before = allocationCount.load();
+    for (int i = 0; i < 1000000; i++) {
+        PID.computeErrors(20.0, robot.getSpeed(), 0.8, robot.getHeading());
+        output = PID.computeControl();
+        robot.Simulate_robot_model(output.heading, output.velocity, 0.1);
+        robot.updateState(output.heading, 0.1);
+    }
+    long after = allocationCount.load();
+
+    EXPECT_EQ(after - before, 0);
+}
+
+/**
+ * @brief Sink collecting messages in memory for the logging tests.
+ */
+class CaptureSink : public LogSink {
+public:
+    void write(LogLevel level, const char* message,
+               std::size_t length) override {
+        levels.push_back(level);
+        lines.emplace_back(message, length);
+    }
+    std::vector<LogLevel> levels;
+    std::vector<std::string> lines;
+};
+
+/**
+ * @brief This test case checks that logging is silent unless a sink is set.
+ */
+TEST(LoggerTest, TestSilentByDefaultAndLevelFilter) {
+    EXPECT_EQ(Logger::getSink(), nullptr);
+    EXPECT_FALSE(Logger::enabled(LogLevel::Error));
+
+    CaptureSink sink;
+    Logger::setSink(&sink);
+    Logger::setLevel(LogLevel::Info);
+    ACK_LOG_DEBUG("hidden " << 1);
+    ACK_LOG_INFO("shown " << 2);
+    ACK_LOG_WARN("shown " << 3.5);
+    Logger::setSink(nullptr);
+    ACK_LOG_ERROR("silenced");
+
+    ASSERT_EQ(sink.lines.size(), 2u);
+    EXPECT_EQ(sink.lines[0], "shown 2");
+    EXPECT_EQ(sink.lines[1], "shown 3.5");
+    EXPECT_EQ(sink.levels[1], LogLevel::Warn);
+}
+
+/**
+ * @brief This test case checks that the verbose model output can be captured.
+ */
+TEST(LoggerTest, TestStreamSinkWritesLines) {
+    std::ostringstream out;
+    StreamSink sink(out);
+    Logger::setSink(&sink);
+    Logger::setLevel(LogLevel::Debug);
+    PIDController PID(1.0, 0.5, 0.2, 0.01, 1.0, 0.5, 0.2);
+    PID.computeErrors(10.0, 5.0, 0.0, 0.0);
+    Logger::setSink(nullptr);
+    Logger::setLevel(LogLevel::Info);
+
+    EXPECT_EQ(out.str(), "Velocity Error: 5\nHeading Error: 0\n");
+}
+
+/**
+ * @brief This test case checks the ring buffer sink and its drain thread.
+ */
+TEST(LoggerTest, TestRingBufferSinkDrains) {
+    CaptureSink downstream;
+    RingBufferSink ring(4);
+    for (int i = 0; i < 6; i++) {
+        std::string text = "message " + std::to_string(i);
+        ring.write(LogLevel::Info, text.data(), text.size());
+    }
+    EXPECT_EQ(ring.getDroppedCount(), 2u);
+    EXPECT_EQ(ring.drain(downstream), 4u);
+    EXPECT_EQ(downstream.lines.back(), "message 3");
+
+    ring.start(downstream);
+    Logger::setSink(&ring);
+    ACK_LOG_INFO("from the control loop");
+    Logger::setSink(nullptr);
+    ring.stop();
+    ASSERT_EQ(downstream.lines.size(), 5u);
+    EXPECT_EQ(downstream.lines.back(), "from the control loop");
+}
+
 /**
  * @brief This test case checks the initial state of the RobotModel.
  */
@@ -124,6 +372,259 @@ TEST(RobotModelTest, SetInitialStateTest) {
     ASSERT_DOUBLE_EQ(velocity, 3.0);
 }
 
+/**
+ * @brief This test case compares every integrator with the exact arc of a
+ *        constant input.
+ */
+TEST(IntegratorTest, TestConstantInput) {
+    MotionInput input;
+    input.velocity = 3.0;
+    input.yawRate = 1.5;
+    const double dt = 0.4;
+    Pose2D start;
+    start.x = 1.0;
+    start.y = -2.0;
+    start.theta = 0.3;
+    double theta = start.theta + input.yawRate * dt;
+    double radius = input.velocity / input.yawRate;
+    double x = start.x + radius * (std::sin(theta) - std::sin(start.theta));
+    double y = start.y - radius * (std::cos(theta) - std::cos(start.theta));
+
+    const double tolerances[] = {0.5, 1e-12, 1e-4, 1e-6};
+    const IntegrationMethod methods[] = {
+        IntegrationMethod::Euler, IntegrationMethod::Arc,
+        IntegrationMethod::RK4, IntegrationMethod::RK45};
+    for (int i = 0; i < 4; i++) {
+        Pose2D pose = start;
+        makeIntegrator(methods[i])->integrate(pose, input, input, dt);
+        EXPECT_NEAR(pose.x, x, tolerances[i]) << i;
+        EXPECT_NEAR(pose.y, y, tolerances[i]) << i;
+        EXPECT_NEAR(pose.theta, theta, 1e-12) << i;
+    }
+
+    Pose2D pose = start;
+    EulerIntegrator().integrate(pose, input, input, dt);
+    EXPECT_DOUBLE_EQ(pose.x, start.x + 3.0 * std::cos(0.3) * dt);
+    EXPECT_GT(std::abs(pose.x - x), 1e-2);
+}
+
+/**
+ * @brief This test case checks the order of each scheme on a ramped input
+ *        and the names of the methods.
+ */
+TEST(IntegratorTest, TestOrderOfAccuracy) {
+    MotionInput start, end;
+    start.velocity = 2.0;
+    start.yawRate = 0.5;
+    end.velocity = 4.0;
+    end.yawRate = 3.0;
+    auto run = [&](const Integrator& integrator, int steps) {
+        Pose2D pose;
+        for (int i = 0; i < steps; i++) {
+            MotionInput from, to;
+            double a = static_cast<double>(i) / steps;
+            double b = static_cast<double>(i + 1) / steps;
+            from.velocity = start.velocity + (end.velocity - start.velocity) * a;
+            from.yawRate = start.yawRate + (end.yawRate - start.yawRate) * a;
+            to.velocity = start.velocity + (end.velocity - start.velocity) * b;
+            to.yawRate = start.yawRate + (end.yawRate - start.yawRate) * b;
+            integrator.integrate(pose, from, to, 2.0 / steps);
+        }
+        return pose;
+    };
+    Pose2D exact = run(RK45Integrator(1e-13, 100000), 1);
+    auto error = [&](const Integrator& integrator, int steps) {
+        Pose2D pose = run(integrator, steps);
+        return std::hypot(pose.x - exact.x, pose.y - exact.y);
+    };
+
+    // Halving the step divides the error by about 2^order
+    EXPECT_GT(error(EulerIntegrator(), 40) / error(EulerIntegrator(), 80),
+              1.8);
+    EXPECT_GT(error(ArcIntegrator(), 40) / error(ArcIntegrator(), 80), 3.5);
+    EXPECT_GT(error(RK4Integrator(), 40) / error(RK4Integrator(), 80), 14.0);
+    EXPECT_LT(error(RK45Integrator(1e-8), 1), 1e-6);
+    EXPECT_THROW(run(RK45Integrator(1e-12, 2), 1), std::runtime_error);
+
+    EXPECT_EQ(parseIntegrationMethod("rk45"), IntegrationMethod::RK45);
+    EXPECT_STREQ(integrationMethodName(IntegrationMethod::Arc), "arc");
+    EXPECT_THROW(parseIntegrationMethod("verlet"), std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks the steering geometry against the formulas
+ *        of Simulate_robot_model() and the error of both interpolations.
+ */
+TEST(SteeringTableTest, TestGeometryAndInterpolationError) {
+    const double wheelbase = 0.5, trackWidth = 1.0, delta = 0.3;
+    double R = wheelbase / std::tan(delta);
+    SteeringGeometry exact =
+        SteeringGeometry::compute(wheelbase, trackWidth, delta);
+    EXPECT_NEAR(1.0 / exact.curvature, R, 1e-12);
+    EXPECT_NEAR(exact.angleMinus,
+                std::atan(wheelbase / (R - trackWidth / 2)), 1e-12);
+    EXPECT_NEAR(exact.anglePlus,
+                std::atan(wheelbase / (R + trackWidth / 2)), 1e-12);
+    EXPECT_NEAR(exact.wheelRatio,
+                (R - trackWidth / 2) / (R + trackWidth / 2), 1e-12);
+    EXPECT_NEAR(exact.centerRatio, R / (R + trackWidth / 2), 1e-12);
+
+    SteeringTable linear(wheelbase, trackWidth, 0.6, 256,
+                         SteeringInterpolation::Linear);
+    SteeringTable cubic(wheelbase, trackWidth, 0.6, 256,
+                        SteeringInterpolation::Cubic);
+    SteeringTable finer(wheelbase, trackWidth, 0.6, 512,
+                        SteeringInterpolation::Cubic);
+    EXPECT_GT(linear.getMaxError().angleMinus, 0.0);
+    EXPECT_LT(linear.getMaxError().angleMinus, 1e-4);
+    EXPECT_LT(cubic.getMaxError().angleMinus,
+              linear.getMaxError().angleMinus / 100);
+    EXPECT_GT(cubic.getMaxError().angleMinus /
+                  finer.getMaxError().angleMinus, 8.0);
+
+    for (double angle : {-0.6, -0.25, 0.0, 0.1234, 0.6}) {
+        SteeringGeometry table = cubic.lookup(angle);
+        exact = SteeringGeometry::compute(wheelbase, trackWidth, angle);
+        EXPECT_NEAR(table.anglePlus, exact.anglePlus,
+                    cubic.getMaxError().anglePlus + 1e-15);
+        EXPECT_NEAR(table.wheelRatio, exact.wheelRatio,
+                    cubic.getMaxError().wheelRatio + 1e-15);
+    }
+    EXPECT_TRUE(cubic.covers(-0.6));
+    EXPECT_FALSE(cubic.covers(0.61));
+
+    // tan(delta) = 2 wheelbase / trackWidth at delta = pi / 4
+    EXPECT_THROW(SteeringTable(wheelbase, trackWidth, 0.8),
+                 std::invalid_argument);
+    EXPECT_THROW(SteeringTable(wheelbase, trackWidth, 0.6, 1),
+                 std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks path projection and arc-length lookup.
+ */
+TEST(PathTest, TestProjection) {
+    EXPECT_THROW(Path({0.0, 1.0}, {0.0}), std::invalid_argument);
+    EXPECT_THROW(Path({1.0, 1.0}, {2.0, 2.0}), std::invalid_argument);
+    EXPECT_THROW(Path::catmullRom({0.0, 1.0}, {0.0, 1.0}, 0),
+                 std::invalid_argument);
+
+    // Duplicates are dropped; the square has a length of 3
+    Path square({0.0, 1.0, 1.0, 1.0, 0.0}, {0.0, 0.0, 0.0, 1.0, 1.0});
+    EXPECT_EQ(square.size(), 4u);
+    EXPECT_DOUBLE_EQ(square.length(), 3.0);
+    PathProjection left = square.projectGlobal(0.5, 0.2);
+    EXPECT_EQ(left.segment, 0u);
+    EXPECT_DOUBLE_EQ(left.s, 0.5);
+    EXPECT_DOUBLE_EQ(left.crossTrack, 0.2);
+    EXPECT_DOUBLE_EQ(square.projectGlobal(0.5, -0.2).crossTrack, -0.2);
+    std::size_t hint = 0;
+    double x, y;
+    square.pointAt(2.25, hint, x, y);
+    EXPECT_EQ(hint, 2u);
+    EXPECT_DOUBLE_EQ(x, 0.75);
+    EXPECT_DOUBLE_EQ(y, 1.0);
+
+    // Along a smooth path, resuming from the last segment agrees with a
+    // scan of the whole path
+    std::vector<double> cx, cy;
+    for (int i = 0; i <= 20; i++) {
+        cx.push_back(5.0 * i);
+        cy.push_back(3.0 * std::sin(0.5 * i));
+    }
+    Path path = Path::catmullRom(cx, cy, 50);
+    EXPECT_EQ(path.size(), 20u * 50u + 1u);
+    EXPECT_DOUBLE_EQ(path.x().back(), 100.0);
+    std::size_t segment = 0;
+    for (double px = 0.0; px <= 100.0; px += 0.37) {
+        double py = 3.0 * std::sin(0.1 * px) + 0.3;
+        PathProjection resumed = path.project(px, py, segment);
+        PathProjection scanned = path.projectGlobal(px, py);
+        // On a shared vertex the two may name either segment
+        EXPECT_NEAR(resumed.s, scanned.s, 1e-9) << "x " << px;
+        EXPECT_DOUBLE_EQ(resumed.crossTrack, scanned.crossTrack);
+        segment = resumed.segment;
+    }
+}
+
+/**
+ * @brief This test case checks that both steering laws follow a path.
+ */
+TEST(PathTrackerTest, TestFollowsPath) {
+    EXPECT_EQ(parseTrackingMethod("stanley"), TrackingMethod::Stanley);
+    EXPECT_THROW(parseTrackingMethod("bang_bang"), std::invalid_argument);
+
+    std::vector<double> px, py;
+    for (int i = 0; i <= 4000; i++) {
+        px.push_back(0.025 * i);
+        py.push_back(3.0 * std::sin(0.1 * px.back()));
+    }
+    auto path = std::make_shared<const Path>(px, py);
+    EXPECT_THROW(PathTracker(path, 0.0), std::invalid_argument);
+
+    const TrackingMethod methods[] = {TrackingMethod::PurePursuit,
+                                      TrackingMethod::Stanley};
+    for (TrackingMethod method : methods) {
+        TrackingParams params;
+        params.method = method;
+        PathTracker tracker(path, 0.5, params);
+        RobotModel robot(0.5, 0.1, 1.0);
+        robot.setMaxSteeringAngle(params.maxSteeringAngle);
+        // Start 1 m beside the path
+        robot.setInitialState(0.0, -1.0, 0.0, 2.0);
+
+        int ticks = 0;
+        while (!tracker.isFinished() && ticks < 10000) {
+            tracker.step(robot, 0.02);
+            ticks++;
+        }
+        const TrackingStats& stats = tracker.getStats();
+        EXPECT_TRUE(tracker.isFinished()) << trackingMethodName(method);
+        EXPECT_EQ(stats.ticks, static_cast<std::uint64_t>(ticks));
+        EXPECT_EQ(stats.tickLatency.getCount(), stats.ticks);
+        EXPECT_GE(stats.maxAbsCrossTrack, 0.9);
+        EXPECT_LT(stats.rmsCrossTrack(), 0.3) << trackingMethodName(method);
+        EXPECT_LT(std::abs(tracker.getProjection().crossTrack), 0.05)
+            << trackingMethodName(method);
+    }
+}
+
+/**
+ * @brief This test case checks that a model with a steering table follows
+ *        the exact model.
+ */
+TEST(SteeringTableTest, TestRobotModelWithTable) {
+    RobotModel exact(0.5, 0.1, 1.0);
+    RobotModel table(0.5, 0.1, 1.0);
+    table.enableSteeringTable(0.6, 1024);
+    ASSERT_NE(table.getSteeringTable(), nullptr);
+    exact.setInitialState(0.0, 0.0, 0.0, 1.0);
+    table.setInitialState(0.0, 0.0, 0.0, 1.0);
+
+    const double commands[] = {0.2, -0.35, 0.0, 0.55, 0.9, -0.1};
+    for (double command : commands) {
+        exact.Simulate_robot_model(command, 0.5, 0.01);
+        table.Simulate_robot_model(command, 0.5, 0.01);
+        exact.updateState(command, 0.01);
+        table.updateState(command, 0.01);
+
+        double exactInner, exactOuter, tableInner, tableOuter;
+        exact.getSteeringAngles(exactInner, exactOuter);
+        table.getSteeringAngles(tableInner, tableOuter);
+        EXPECT_NEAR(tableInner, exactInner, 1e-9);
+        EXPECT_NEAR(tableOuter, exactOuter, 1e-9);
+        exact.getWheelSpeeds(exactInner, exactOuter);
+        table.getWheelSpeeds(tableInner, tableOuter);
+        EXPECT_NEAR(tableInner, exactInner, 1e-7);
+        EXPECT_NEAR(tableOuter, exactOuter, 1e-7);
+        EXPECT_NEAR(table.getHeading(), exact.getHeading(), 1e-9);
+        EXPECT_NEAR(table.getSpeed(), exact.getSpeed(), 1e-8);
+    }
+
+    table.disableSteeringTable();
+    EXPECT_EQ(table.getSteeringTable(), nullptr);
+}
+
 /**
  * @brief This test case checks if the RobotSimulation runs without exceptions.
  */
@@ -142,3 +643,1866 @@ TEST(RobotSimulation, Check_Simulation_FinalState) {
     // Check if finalVelocity is zero
     EXPECT_DOUBLE_EQ(simulation.getFinalVelocity(), 0);
 }
+
+/**
+ * @brief This test case checks the settle window and divergence limits.
+ */
+TEST(ConvergenceTest, TestMonitor) {
+    ConvergenceCriteria criteria;
+    criteria.maxIterations = 10;
+    criteria.velocityTolerance = 1.0;
+    criteria.headingTolerance = 0.1;
+    criteria.settleWindow = 3;
+
+    ConvergenceMonitor monitor(criteria);
+    EXPECT_FALSE(monitor.update(0.5, 0.05));
+    EXPECT_FALSE(monitor.update(0.5, 0.2));   // heading out: restart
+    EXPECT_FALSE(monitor.update(0.5, 0.05));
+    EXPECT_FALSE(monitor.update(-0.5, -0.05));
+    EXPECT_FALSE(monitor.isSettled());
+    EXPECT_TRUE(monitor.update(0.5, 0.05));
+    EXPECT_EQ(monitor.getReason(), TerminationReason::Converged);
+    EXPECT_EQ(monitor.getSettledSince(), 2);
+    EXPECT_EQ(monitor.getSteps(), 5);
+
+    criteria.stopOnConvergence = false;
+    ConvergenceMonitor budget(criteria);
+    for (int i = 0; i < 9; i++) EXPECT_FALSE(budget.update(0.0, 0.0));
+    EXPECT_TRUE(budget.update(0.0, 0.0));
+    EXPECT_EQ(budget.getReason(), TerminationReason::Converged);
+
+    criteria.velocityDivergence = 100.0;
+    ConvergenceMonitor runaway(criteria);
+    EXPECT_FALSE(runaway.update(50.0, 0.0));
+    EXPECT_TRUE(runaway.update(150.0, 0.0));
+    EXPECT_EQ(runaway.getReason(), TerminationReason::Diverged);
+
+    ConvergenceMonitor invalid(criteria);
+    EXPECT_TRUE(invalid.update(0.0, std::nan("")));
+    EXPECT_EQ(invalid.getReason(), TerminationReason::Diverged);
+    EXPECT_STREQ(terminationReasonName(invalid.getReason()), "diverged");
+}
+
+/**
+ * @brief This test case checks the result of a run and that convergence is
+ *        judged on the state each step produced.
+ */
+TEST(RobotSimulation, Check_Simulation_Result) {
+    RobotSimulation idle(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                         1.0, 0.1, 0.01);
+    SimulationResult result = idle.run(0.0, 0.0);
+    EXPECT_EQ(result.reason, TerminationReason::Converged);
+    EXPECT_EQ(result.steps, 1);
+    EXPECT_DOUBLE_EQ(result.settlingTime, 0.1);
+
+    // From rest, the first step lands within these tolerances and the
+    // second leaves them again
+    ConvergenceCriteria criteria;
+    criteria.maxIterations = 3;
+    criteria.velocityTolerance = 10.0;
+    criteria.headingTolerance = 3.0;
+    RobotSimulation fresh(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                          1.0, 0.1, 0.01);
+    result = fresh.run(0.8, 20.0, criteria);
+    EXPECT_EQ(result.reason, TerminationReason::Converged);
+    EXPECT_EQ(result.steps, 1);
+
+    criteria.settleWindow = 2;
+    RobotSimulation window(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                           1.0, 0.1, 0.01);
+    result = window.run(0.8, 20.0, criteria);
+    EXPECT_EQ(result.reason, TerminationReason::MaxIterations);
+    EXPECT_EQ(result.steps, 3);
+    EXPECT_DOUBLE_EQ(result.settlingTime, -1.0);
+
+    RobotSimulation runaway(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                            1.0, 0.1, 0.01);
+    criteria = ConvergenceCriteria();
+    criteria.maxIterations = 1000;
+    criteria.velocityTolerance = 0.5;
+    criteria.velocityDivergence = 1e3;
+    result = runaway.runSimulation(0.8, 20.0, criteria);
+    EXPECT_EQ(result.reason, TerminationReason::Diverged);
+    EXPECT_LT(result.steps, criteria.maxIterations);
+    EXPECT_DOUBLE_EQ(result.finalVelocity, runaway.getFinalVelocity());
+    double x, y, theta, velocity;
+    runaway.getState(x, y, theta, velocity);
+    EXPECT_DOUBLE_EQ(result.finalX, x);
+}
+
+/**
+ * @brief This test case checks the fixed-size matrix operations.
+ */
+TEST(MatrixTest, TestProductsAndSolve) {
+    Matrix<2, 3> a;
+    a(0, 0) = 1.0; a(0, 1) = 2.0; a(0, 2) = 3.0;
+    a(1, 0) = -1.0; a(1, 1) = 0.5; a(1, 2) = 4.0;
+    Matrix<3, 2> t = a.transpose();
+    EXPECT_EQ(t(2, 1), 4.0);
+    Matrix<2, 2> product = a * t;
+    EXPECT_DOUBLE_EQ(product(0, 0), 14.0);
+    EXPECT_DOUBLE_EQ(product(0, 1), 12.0);
+    EXPECT_DOUBLE_EQ(product(1, 0), product(0, 1));
+    EXPECT_DOUBLE_EQ((product - 2.0 * Matrix<2, 2>::identity())(1, 1),
+                     15.25);
+
+    Matrix<3, 3> m = Matrix<3, 3>::diagonal({2.0, 3.0, 4.0});
+    m(0, 2) = 1.0;
+    m(2, 0) = 0.0;
+    m(1, 0) = 5.0;
+    Matrix<3, 1> x;
+    x(0, 0) = 1.0; x(1, 0) = -2.0; x(2, 0) = 0.5;
+    Matrix<3, 1> solved = solve(m, m * x);
+    EXPECT_LT((solved - x).maxAbs(), 1e-12);
+
+    Matrix<2, 2> singular;
+    singular(0, 0) = 1.0; singular(0, 1) = 2.0;
+    singular(1, 0) = 2.0; singular(1, 1) = 4.0;
+    EXPECT_THROW(solve(singular, Matrix<2, 1>()), std::runtime_error);
+}
+
+/**
+ * @brief This test case checks the Riccati solution and that the LQR
+ *        controller steers the simulation to its targets within the
+ *        steering limit.
+ */
+TEST(LQRControllerTest, TestRiccatiAndClosedLoop) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.setMaxSteeringAngle(0.5);
+    ControlTuning tuning;
+    LinearizedModel model = linearizeRobotModel(robot, 2.0, 0.1, tuning);
+    EXPECT_DOUBLE_EQ(model.B(0, 0), 0.1 * 2.0 / 0.5);
+    EXPECT_DOUBLE_EQ(model.B(1, 1), 1.0);
+    // Below the minimum speed the heading stays controllable
+    EXPECT_DOUBLE_EQ(linearizeRobotModel(robot, 0.0, 0.1, tuning).B(0, 0),
+                     0.1 * tuning.minimumSpeed / 0.5);
+
+    LQRController lqr(tuning);
+    lqr.setModel(model);
+    Matrix<2, 2> p = lqr.getCostToGo();
+    Matrix<2, 2> q = tuning.stateWeights();
+    Matrix<2, 2> r = tuning.inputWeights();
+    Matrix<2, 2> k = solve(r + model.B.transpose() * p * model.B,
+                           model.B.transpose() * p * model.A);
+    Matrix<2, 2> residual = q + model.A.transpose() * p * model.A -
+                            model.A.transpose() * p * model.B * k - p;
+    EXPECT_LT(residual.maxAbs(), 1e-9);
+    EXPECT_LT((k - lqr.getGain()).maxAbs(), 1e-12);
+    // The model is decoupled, so the closed-loop poles are on the diagonal
+    Matrix<2, 2> closed = model.A - model.B * lqr.getGain();
+    EXPECT_LT(std::abs(closed(0, 0)), 1.0);
+    EXPECT_LT(std::abs(closed(1, 1)), 1.0);
+
+    ModelState error;
+    error(0, 0) = -10.0;
+    EXPECT_DOUBLE_EQ(lqr.control(error)(0, 0), 0.5);
+    EXPECT_THROW(LQRController(ControlTuning{1.0, 1.0, 0.0}),
+                 std::invalid_argument);
+
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                               1.0, 0.1, 0.01);
+    simulation.setInitialState(0.0, 0.0, 0.0, 1.0);
+    EXPECT_EQ(simulation.getLQRController(), nullptr);
+    simulation.setControlMode(ControlMode::LQR);
+    EXPECT_NE(simulation.getLQRController(), nullptr);
+    EXPECT_EQ(simulation.getMPCController(), nullptr);
+    ConvergenceCriteria criteria;
+    criteria.maxIterations = 200;
+    criteria.velocityTolerance = 0.01;
+    criteria.headingTolerance = 0.01;
+    criteria.settleWindow = 10;
+    criteria.stopOnConvergence = true;
+    SimulationResult result = simulation.run(0.3, 2.0, criteria);
+    EXPECT_EQ(result.reason, TerminationReason::Converged);
+    EXPECT_NEAR(simulation.getCurrentHeading(), 0.3, 0.01);
+    EXPECT_NEAR(simulation.getCurrentVelocity(), 2.0, 0.01);
+    // The steering limit reaches the robot, so the pose turns
+    EXPECT_NE(result.finalTheta, 0.0);
+}
+
+/**
+ * @brief This test case checks that MPC matches LQR while no limit is
+ *        active, plans within the limits otherwise and never allocates.
+ */
+TEST(MPCControllerTest, TestMatchesLQRAndRespectsLimits) {
+    RobotModel robot(0.5, 1.0, 1.0);
+    robot.setMaxSteeringAngle(0.2);
+    robot.setInitialState(0.0, 0.0, 0.0, 1.0);
+    ControlTuning tuning;
+    tuning.maxWheelSpeedChange = 0.5;
+    EXPECT_THROW(MPCController(0), std::invalid_argument);
+    EXPECT_THROW(MPCController(MPCController::kMaxHorizon + 1),
+                 std::invalid_argument);
+
+    LQRController lqr(tuning);
+    MPCController mpc(20, tuning);
+    PIDOutput expected = lqr.compute(robot, 0.01, 1.01, 0.1);
+    PIDOutput actual = mpc.compute(robot, 0.01, 1.01, 0.1);
+    EXPECT_NEAR(actual.heading, expected.heading, 1e-9);
+    EXPECT_NEAR(actual.velocity, expected.velocity, 1e-9);
+
+    // A large error saturates the first inputs of the plan
+    long before = allocationCount.load();
+    actual = mpc.compute(robot, 2.0, 4.0, 0.1);
+    long after = allocationCount.load();
+    EXPECT_EQ(after - before, 0);
+    EXPECT_DOUBLE_EQ(actual.heading, 0.2);
+    EXPECT_DOUBLE_EQ(actual.velocity, 0.5);
+    for (std::size_t k = 0; k < mpc.getHorizon(); k++) {
+        ModelInput input = mpc.getPlannedInput(k);
+        EXPECT_LE(std::abs(input(0, 0)), 0.2);
+        EXPECT_LE(std::abs(input(1, 0)), 0.5);
+    }
+    EXPECT_GT(mpc.getLastIterations(), 1);
+
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                               1.0, 0.1, 0.01);
+    simulation.setControlMode(ControlMode::MPC, tuning, 10);
+    ASSERT_NE(simulation.getMPCController(), nullptr);
+    EXPECT_EQ(simulation.getMPCController()->getHorizon(), 10u);
+    EXPECT_EQ(simulation.getLQRController(), nullptr);
+    // A copy gets its own controller, not a share of this one's plan
+    RobotSimulation copy = simulation;
+    ASSERT_NE(copy.getMPCController(), nullptr);
+    EXPECT_NE(copy.getMPCController(), simulation.getMPCController());
+    EXPECT_EQ(copy.getMPCController()->getHorizon(), 10u);
+    ConvergenceCriteria criteria;
+    criteria.maxIterations = 200;
+    criteria.velocityTolerance = 0.01;
+    criteria.headingTolerance = 0.01;
+    criteria.settleWindow = 10;
+    criteria.stopOnConvergence = true;
+    SimulationResult result = simulation.run(0.3, 2.0, criteria);
+    EXPECT_EQ(result.reason, TerminationReason::Converged);
+    EXPECT_EQ(parseControlMode("mpc"), ControlMode::MPC);
+    EXPECT_THROW(parseControlMode("pd"), std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks that Q16.16 arithmetic rounds and saturates
+ *        instead of wrapping, and that its elementary functions are close to
+ *        the library's.
+ */
+TEST(Fixed16Test, TestSaturatingArithmetic) {
+    Fixed16 half = Fixed16::fromDouble(0.5);
+    EXPECT_EQ(half.raw(), 32768);
+    EXPECT_DOUBLE_EQ((half + half).toDouble(), 1.0);
+    EXPECT_DOUBLE_EQ((Fixed16::fromDouble(3.0) * Fixed16::fromDouble(-2.5))
+                         .toDouble(), -7.5);
+    EXPECT_DOUBLE_EQ((Fixed16::fromDouble(1.0) / Fixed16::fromDouble(4.0))
+                         .toDouble(), 0.25);
+    EXPECT_EQ(Fixed16::fromDouble(1e9), Fixed16::max());
+    EXPECT_EQ(Fixed16::fromDouble(-1e9), Fixed16::lowest());
+    EXPECT_EQ(Fixed16::fromDouble(std::nan("")), Fixed16());
+    EXPECT_EQ(Fixed16::max() + half, Fixed16::max());
+    EXPECT_EQ(Fixed16::lowest() - half, Fixed16::lowest());
+    EXPECT_EQ(-Fixed16::lowest(), Fixed16::max());
+    EXPECT_EQ(Fixed16::fromDouble(200.0) * Fixed16::fromDouble(-200.0),
+              Fixed16::lowest());
+    EXPECT_EQ(half / Fixed16(), Fixed16::max());
+    EXPECT_EQ(Fixed16() / Fixed16(), Fixed16());
+    // One step is 2^-16; products round to the nearest step
+    Fixed16 step = Fixed16::fromRaw(1);
+    EXPECT_EQ((step * half).raw(), 1);
+    EXPECT_EQ((Fixed16::fromRaw(3) / Fixed16::fromDouble(2.0)).raw(), 2);
+
+    for (double angle = -10.0; angle <= 10.0; angle += 0.01) {
+        Fixed16 value = Fixed16::fromDouble(angle);
+        double exact = value.toDouble();
+        EXPECT_NEAR(sin(value).toDouble(), std::sin(exact), 5e-5);
+        EXPECT_NEAR(cos(value).toDouble(), std::cos(exact), 5e-5);
+        EXPECT_NEAR(atan(value).toDouble(), std::atan(exact), 5e-5);
+    }
+    EXPECT_NEAR(tan(Fixed16::fromDouble(M_PI / 4.0)).toDouble(), 1.0, 1e-4);
+}
+
+/**
+ * @brief Runs the closed loop of NumericSimulationTest in T.
+ *
+ * @return The largest difference of heading, speed and pose from the same
+ *         loop run by RobotSimulation, over all steps.
+ */
+template <typename T>
+static double numericTrajectoryError(int steps) {
+    RobotSimulation reference(0.5, 1.0, M_PI / 4.0, 0.1, 0.001, 0.001, 0.01,
+                              1.0, 0.01, 0.01);
+    PIDController controller(0.1, 0.001, 0.001, 0.01, 1.0, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4.0);
+    robot.setMaxSteeringAngle(M_PI / 4.0);
+    NumericSimulation<T> simulation(controller, robot);
+    T targetHeading = NumericPolicy<T>::fromDouble(0.3);
+    T targetVelocity = NumericPolicy<T>::fromDouble(2.0);
+
+    double largest = 0.0;
+    for (int i = 0; i < steps; i++) {
+        reference.step(0.3, 2.0);
+        simulation.step(targetHeading, targetVelocity);
+        double x, y, theta, velocity, nx, ny, ntheta, nvelocity;
+        reference.getState(x, y, theta, velocity);
+        simulation.getState(nx, ny, ntheta, nvelocity);
+        double errors[] = {
+            reference.getCurrentHeading() - simulation.getCurrentHeading(),
+            reference.getCurrentVelocity() - simulation.getCurrentVelocity(),
+            x - nx, y - ny, theta - ntheta};
+        for (double error : errors) {
+            largest = std::max(largest, std::abs(error));
+        }
+    }
+    return largest;
+}
+
+/**
+ * @brief This test case checks that the loop computed in double, float and
+ *        Q16.16 follows RobotSimulation within the bounds stated in
+ *        NumericSimulation.hpp, and that the loop converges in every type.
+ */
+TEST(NumericSimulationTest, TestTrajectoriesAcrossNumberTypes) {
+    EXPECT_LT(numericTrajectoryError<double>(1000), 1e-9);
+    EXPECT_LT(numericTrajectoryError<float>(1000), 1e-5);
+    EXPECT_LT(numericTrajectoryError<Fixed16>(1000), 5e-3);
+
+    PIDController controller(0.1, 0.001, 0.001, 0.01, 1.0, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4.0);
+    robot.setMaxSteeringAngle(M_PI / 4.0);
+    NumericSimulation<Fixed16> simulation(controller, robot);
+    for (int i = 0; i < 1000; i++) {
+        simulation.step(Fixed16::fromDouble(0.3), Fixed16::fromDouble(2.0));
+    }
+    EXPECT_NEAR(simulation.getCurrentHeading(), 0.3, 1e-3);
+    EXPECT_NEAR(simulation.getCurrentVelocity(), 2.0, 1e-3);
+    EXPECT_STREQ(NumericPolicy<Fixed16>::name(), "q16.16");
+}
+
+/**
+ * @brief This test case checks the step, ramp and S-curve moves, and that a
+ *        new target starts from wherever the setpoint is.
+ */
+TEST(SetpointProfileTest, TestShapes) {
+    SetpointProfile profile(1.0);
+    EXPECT_TRUE(profile.isSettled());
+    profile.setTarget(2.0);
+    EXPECT_DOUBLE_EQ(profile.getValue(), 2.0);
+    EXPECT_TRUE(profile.isSettled());
+
+    profile.setTarget(4.0, ProfileShape::Ramp, 1.0);
+    EXPECT_FALSE(profile.isSettled());
+    EXPECT_DOUBLE_EQ(profile.advance(0.25), 2.5);
+    EXPECT_DOUBLE_EQ(profile.advance(0.25), 3.0);
+    // Retargeting mid-ramp continues from the current value
+    profile.setTarget(0.0, ProfileShape::SCurve, 2.0);
+    EXPECT_DOUBLE_EQ(profile.getValue(), 3.0);
+    // A ramp would move 0.015 in the first 0.01 s, the S-curve far less
+    EXPECT_NEAR(profile.advance(0.01), 3.0, 1e-3);
+    EXPECT_DOUBLE_EQ(profile.advance(0.99), 1.5);
+    EXPECT_NEAR(profile.advance(0.99), 0.0, 1e-3);
+    EXPECT_DOUBLE_EQ(profile.advance(0.5), 0.0);
+    EXPECT_TRUE(profile.isSettled());
+    EXPECT_DOUBLE_EQ(profile.getTarget(), 0.0);
+
+    profile.setTarget(1.0, ProfileShape::Ramp, 0.0);
+    EXPECT_DOUBLE_EQ(profile.getValue(), 1.0);
+    EXPECT_THROW(profile.setTarget(2.0, ProfileShape::Ramp, -1.0),
+                 std::invalid_argument);
+    EXPECT_THROW(profile.setTarget(std::nan("")), std::invalid_argument);
+    EXPECT_EQ(parseProfileShape("s_curve"), ProfileShape::SCurve);
+    EXPECT_STREQ(profileShapeName(ProfileShape::Ramp), "ramp");
+    EXPECT_THROW(parseProfileShape("jump"), std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks that a step command does not kick the PID
+ *        output with bumpless transfer on, and that one session follows an
+ *        hour of commands without allocating or drifting.
+ */
+TEST(ControlSessionTest, TestBumplessTransferAndLongRun) {
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 0.1, 0.001, 0.001, 0.01,
+                               1.0, 0.01, 0.01);
+    for (int bumpless = 0; bumpless < 2; bumpless++) {
+        ControlSession session(simulation);
+        session.setBumpless(bumpless != 0);
+        session.command(0.3, 2.0);
+        session.run(1000);
+        PIDOutput before = session.step();
+        session.command(0.5, 3.0);
+        PIDOutput after = session.step();
+        double velocityKick = std::abs(after.velocity - before.velocity);
+        double headingKick = std::abs(after.heading - before.heading);
+        if (bumpless != 0) {
+            // Only the integral of the new error is added
+            EXPECT_LT(velocityKick, 0.01);
+            EXPECT_LT(headingKick, 0.01);
+        } else {
+            EXPECT_GT(velocityKick, 0.1);
+            EXPECT_GT(headingKick, 0.1);
+        }
+        session.run(2000);
+        EXPECT_NEAR(session.getSimulation().getCurrentHeading(), 0.5, 1e-4);
+        EXPECT_NEAR(session.getSimulation().getCurrentVelocity(), 3.0, 1e-4);
+    }
+
+    // 360000 steps of 0.01 s, a new command every 200 s
+    ControlSession session(simulation);
+    const ProfileShape shapes[] = {ProfileShape::Ramp, ProfileShape::SCurve,
+                                   ProfileShape::Step};
+    long allocationsBefore = allocationCount;
+    for (int i = 0; i < 18; i++) {
+        double heading = i % 2 == 0 ? 0.2 : 0.5;
+        double velocity = i % 2 == 0 ? 1.5 : 3.0;
+        session.command(heading, velocity, shapes[i % 3], 5.0);
+        EXPECT_DOUBLE_EQ(session.getHeadingProfile().getTarget(), heading);
+        session.run(20000);
+        EXPECT_TRUE(session.getVelocityProfile().isSettled());
+        EXPECT_DOUBLE_EQ(session.getVelocitySetpoint(), velocity);
+        EXPECT_NEAR(session.getSimulation().getCurrentHeading(), heading,
+                    1e-6);
+        EXPECT_NEAR(session.getSimulation().getCurrentVelocity(), velocity,
+                    1e-6);
+    }
+    EXPECT_EQ(allocationCount - allocationsBefore, 0);
+    EXPECT_EQ(session.getSteps(), 360000u);
+}
+
+/**
+ * @brief This test case checks that every index is processed exactly once.
+ */
+TEST(ThreadPoolTest, TestParallelForCoversAllIndices) {
+    ThreadPool pool(3);
+    std::vector<int> hits(1000, 0);
+    pool.parallelFor(hits.size(), [&](std::size_t i) { hits[i]++; }, 7);
+    for (int hit : hits) EXPECT_EQ(hit, 1);
+
+    EXPECT_THROW(pool.parallelFor(10, [](std::size_t i) {
+        if (i == 5) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+}
+
+/**
+ * @brief This test case checks the summary of a single scenario.
+ */
+TEST(BatchRunnerTest, TestScenarioSummary) {
+    Scenario scenario;
+    scenario.targetVelocity = 0.0;
+    scenario.targetHeading = 0.0;
+    ScenarioSummary summary = BatchRunner::runScenario(scenario);
+    EXPECT_TRUE(summary.converged);
+    EXPECT_EQ(summary.steps, scenario.maxIterations);
+    EXPECT_EQ(summary.reason, TerminationReason::Converged);
+    EXPECT_DOUBLE_EQ(summary.settlingTime, scenario.deltaT);
+    EXPECT_DOUBLE_EQ(summary.finalVelocity, 0.0);
+    EXPECT_DOUBLE_EQ(summary.velocityOvershoot, 0.0);
+    EXPECT_FALSE(std::isnan(summary.finalX));
+
+    scenario.targetVelocity = 20.0;
+    scenario.targetHeading = 0.8;
+    scenario.stopOnConvergence = true;
+    summary = BatchRunner::runScenario(scenario);
+    EXPECT_GT(summary.steps, 1);
+    EXPECT_GT(summary.velocityOvershoot, 0.0);
+}
+
+/**
+ * @brief Compares two doubles bit for bit, so NaN equals NaN.
+ */
+static bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+/**
+ * @brief This test case checks that results do not depend on thread count.
+ */
+TEST(BatchRunnerTest, TestResultsIndependentOfThreadCount) {
+    std::vector<Scenario> scenarios;
+    for (int i = 0; i < 200; i++) {
+        Scenario scenario;
+        scenario.targetHeading = -1.0 + 0.01 * i;
+        scenario.targetVelocity = 0.1 * i;
+        scenario.velP = 0.5 + 0.005 * i;
+        scenario.initialVelocity = 0.05 * (i % 7);
+        scenario.maxIterations = 50 + i % 13;
+        scenarios.push_back(scenario);
+    }
+
+    BatchRunner single(1);
+    BatchRunner parallel(4);
+    std::vector<ScenarioSummary> expected = single.run(scenarios);
+    std::vector<ScenarioSummary> actual = parallel.run(scenarios);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].converged, actual[i].converged);
+        EXPECT_EQ(expected[i].steps, actual[i].steps);
+        EXPECT_TRUE(sameBits(expected[i].finalX, actual[i].finalX));
+        EXPECT_TRUE(sameBits(expected[i].finalHeading,
+                             actual[i].finalHeading));
+        EXPECT_TRUE(sameBits(expected[i].finalVelocity,
+                             actual[i].finalVelocity));
+        EXPECT_TRUE(sameBits(expected[i].velocityOvershoot,
+                             actual[i].velocityOvershoot));
+        EXPECT_TRUE(sameBits(expected[i].settlingTime,
+                             actual[i].settlingTime));
+    }
+}
+
+/**
+ * @brief This test case checks alignment, growth and reuse of the arena.
+ */
+TEST(MonotonicArenaTest, TestBumpAndReset) {
+    MonotonicArena arena(256);
+    EXPECT_EQ(arena.getBytesReserved(), 0u);
+    EXPECT_THROW(arena.allocate(8, 3), std::invalid_argument);
+
+    char* byte = arena.allocateArray<char>(1);
+    double* values = arena.allocateArray<double>(100);
+    void* wide = arena.allocate(16, 64);
+    EXPECT_NE(byte, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values) % alignof(double), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 64, 0u);
+    for (int i = 0; i < 100; i++) values[i] = i;
+    EXPECT_GT(arena.getBlockAllocations(), 1u);
+    EXPECT_GE(arena.getBytesUsed(), 1u + 100 * sizeof(double) + 16);
+    std::size_t used = arena.getBytesUsed();
+
+    // The cycle needed several blocks; reset merges them into one.
+    arena.reset();
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+    std::uint64_t blocks = arena.getBlockAllocations();
+    std::size_t reserved = arena.getBytesReserved();
+    for (int cycle = 0; cycle < 10; cycle++) {
+        arena.allocateArray<char>(1);
+        arena.allocateArray<double>(100);
+        arena.allocate(16, 64);
+        arena.reset();
+    }
+    EXPECT_EQ(arena.getBlockAllocations(), blocks);
+    EXPECT_EQ(arena.getBytesReserved(), reserved);
+    EXPECT_GE(arena.getPeakBytesUsed(), used);
+}
+
+/**
+ * @brief This test case checks that runs through a context match plain runs
+ *        and stop allocating once the context has warmed up.
+ */
+TEST(SimulationContextTest, TestMatchesPlainRunWithoutAllocating) {
+    Scenario scenario;
+    scenario.targetVelocity = 2.0;
+    scenario.targetHeading = 0.2;
+    scenario.maxIterations = 200;
+    scenario.steeringTableIntervals = 64;
+    scenario.errorHistory = 32;
+
+    SimulationContext context(1024);
+    context.setKeepTrajectory(true);
+    ScenarioSummary expected = BatchRunner::runScenario(scenario);
+    ScenarioSummary actual = BatchRunner::runScenario(scenario, nullptr,
+                                                      &context);
+    EXPECT_EQ(expected.steps, actual.steps);
+    EXPECT_EQ(expected.reason, actual.reason);
+    EXPECT_TRUE(sameBits(expected.finalX, actual.finalX));
+    EXPECT_TRUE(sameBits(expected.finalHeading, actual.finalHeading));
+    EXPECT_TRUE(sameBits(expected.finalVelocity, actual.finalVelocity));
+
+    std::size_t steps = static_cast<std::size_t>(actual.steps);
+    ASSERT_EQ(context.getTrajectorySize(), steps);
+    TrajectorySample last = context.getSimulation().makeSample();
+    EXPECT_TRUE(sameBits(context.getTrajectory()[steps - 1].x, last.x));
+    EXPECT_EQ(context.getSimulation().getController()
+                  .getVelocityErrors().size(), 32u);
+    EXPECT_EQ(context.getCachedSteeringTables(), 1u);
+
+    // Warm up once more so the arena has merged its blocks.
+    BatchRunner::runScenario(scenario, nullptr, &context);
+    std::uint64_t blocks = context.getArena().getBlockAllocations();
+    long before = allocationCount.load();
+    for (int i = 0; i < 100; i++) {
+        BatchRunner::runScenario(scenario, nullptr, &context);
+    }
+    long after = allocationCount.load();
+    EXPECT_EQ(after - before, 0);
+    EXPECT_EQ(context.getArena().getBlockAllocations(), blocks);
+    EXPECT_EQ(context.getCachedSteeringTables(), 1u);
+}
+
+/**
+ * @brief Builds random vehicles and per-step commands for the fleet tests.
+ */
+static void makeFleetCommands(std::size_t count, int steps,
+                              std::vector<RobotModel>& models,
+                              RobotFleet& fleet,
+                              std::vector<std::vector<double>>& headings,
+                              std::vector<std::vector<double>>& velocities) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> geometry(0.3, 2.0);
+    std::uniform_real_distribution<double> command(-1.5, 1.5);
+    fleet.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        double wheelbase = geometry(generator);
+        double wheelRadius = geometry(generator) * 0.5;
+        double trackWidth = geometry(generator);
+        models.emplace_back(wheelbase, wheelRadius, trackWidth);
+        fleet.setGeometry(i, wheelbase, wheelRadius, trackWidth);
+        double velocity = command(generator);
+        models.back().setInitialState(0.0, 0.0, 0.1 * i, velocity);
+        fleet.setInitialState(i, 0.0, 0.0, 0.1 * i, velocity);
+    }
+    headings.assign(steps, std::vector<double>(count));
+    velocities.assign(steps, std::vector<double>(count));
+    for (int k = 0; k < steps; k++) {
+        for (std::size_t i = 0; i < count; i++) {
+            // Every fifth command drives straight to cover that branch.
+            headings[k][i] = (i + k) % 5 == 0 ? 0.0 : command(generator);
+            velocities[k][i] = command(generator);
+        }
+    }
+}
+
+/**
+ * @brief This test case checks the scalar fleet kernel against RobotModel.
+ */
+TEST(RobotFleetTest, TestScalarKernelMatchesRobotModel) {
+    std::vector<RobotModel> models;
+    RobotFleet fleet;
+    std::vector<std::vector<double>> headings, velocities;
+    makeFleetCommands(37, 40, models, fleet, headings, velocities);
+    fleet.setSimdEnabled(false);
+    EXPECT_FALSE(fleet.isSimdActive());
+
+    for (std::size_t k = 0; k < headings.size(); k++) {
+        fleet.step(headings[k].data(), velocities[k].data(), 0.1);
+        for (std::size_t i = 0; i < models.size(); i++) {
+            models[i].Simulate_robot_model(headings[k][i], velocities[k][i],
+                                           0.1);
+            models[i].updateState(headings[k][i], 0.1);
+        }
+    }
+
+    for (std::size_t i = 0; i < models.size(); i++) {
+        double x, y, theta, velocity, fx, fy, ftheta, fvelocity;
+        models[i].getState(x, y, theta, velocity);
+        fleet.getState(i, fx, fy, ftheta, fvelocity);
+        EXPECT_TRUE(sameBits(x, fx));
+        EXPECT_TRUE(sameBits(y, fy));
+        EXPECT_TRUE(sameBits(theta, ftheta));
+        EXPECT_TRUE(sameBits(models[i].getHeading(), fleet.heading()[i]));
+        EXPECT_TRUE(sameBits(models[i].getSpeed(), fleet.speed()[i]));
+    }
+}
+
+/**
+ * @brief This test case checks the AVX2 fleet kernel against the scalar one.
+ */
+TEST(RobotFleetTest, TestSimdKernelMatchesScalarKernel) {
+    if (!RobotFleet::simdSupported()) {
+        GTEST_SKIP() << "AVX2 is not available on this machine";
+    }
+    std::vector<RobotModel> models;
+    RobotFleet simd, scalar;
+    std::vector<std::vector<double>> headings, velocities;
+    makeFleetCommands(103, 40, models, simd, headings, velocities);
+    models.clear();
+    makeFleetCommands(103, 40, models, scalar, headings, velocities);
+    scalar.setSimdEnabled(false);
+    EXPECT_TRUE(simd.isSimdActive());
+
+    for (std::size_t k = 0; k < headings.size(); k++) {
+        simd.step(headings[k].data(), velocities[k].data(), 0.1);
+        scalar.step(headings[k].data(), velocities[k].data(), 0.1);
+    }
+
+    auto close = [](double a, double b) {
+        return std::abs(a - b) <= 1e-9 * (1.0 + std::abs(a) + std::abs(b));
+    };
+    for (std::size_t i = 0; i < simd.size(); i++) {
+        EXPECT_PRED2(close, simd.x()[i], scalar.x()[i]) << "vehicle " << i;
+        EXPECT_PRED2(close, simd.y()[i], scalar.y()[i]) << "vehicle " << i;
+        EXPECT_PRED2(close, simd.theta()[i], scalar.theta()[i]);
+        EXPECT_PRED2(close, simd.heading()[i], scalar.heading()[i]);
+        EXPECT_PRED2(close, simd.speed()[i], scalar.speed()[i]);
+        double ai, ao, oi, oo, sai, sao, soi, soo;
+        simd.getWheelState(i, ai, ao, oi, oo);
+        scalar.getWheelState(i, sai, sao, soi, soo);
+        EXPECT_PRED2(close, ai, sai);
+        EXPECT_PRED2(close, ao, sao);
+        EXPECT_PRED2(close, oi, soi);
+        EXPECT_PRED2(close, oo, soo);
+    }
+}
+
+/**
+ * @brief This test case checks the SPSC queue bounds and its order across
+ *        threads.
+ */
+TEST(SpscQueueTest, TestOrderAcrossThreads) {
+    EXPECT_THROW(SpscQueue<int>(0), std::invalid_argument);
+    SpscQueue<long> queue(50);
+    EXPECT_EQ(queue.capacity(), 64u);
+    long value = 0;
+    EXPECT_FALSE(queue.tryPop(value));
+    for (long i = 0; i < 64; i++) EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(64));
+    EXPECT_EQ(queue.size(), 64u);
+    for (long i = 0; i < 64; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+
+    const long count = 200000;
+    std::thread producer([&queue, count] {
+        for (long i = 0; i < count; i++) {
+            while (!queue.tryPush(i)) std::this_thread::yield();
+        }
+    });
+    long expected = 0;
+    while (expected < count) {
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value, expected);
+        expected++;
+    }
+    producer.join();
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+/**
+ * @brief This test case checks that seqlock readers never see a torn value.
+ */
+TEST(SeqlockTest, TestNoTornReads) {
+    struct Wide {
+        std::uint64_t words[6];
+    };
+    Wide initial = {};
+    Seqlock<Wide> cell(initial);
+    EXPECT_EQ(cell.getVersion(), 1u);
+
+    const std::uint64_t stores = 100000;
+    std::atomic<bool> done(false);
+    std::thread writer([&] {
+        Wide value;
+        for (std::uint64_t i = 1; i <= stores; i++) {
+            for (std::uint64_t& word : value.words) word = i;
+            cell.store(value);
+        }
+        done = true;
+    });
+    std::uint64_t last = 0;
+    long torn = 0, backwards = 0;
+    while (!done) {
+        Wide value = cell.load();
+        for (std::uint64_t word : value.words) {
+            if (word != value.words[0]) torn++;
+        }
+        if (value.words[0] < last) backwards++;
+        last = value.words[0];
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(backwards, 0);
+    EXPECT_EQ(cell.load().words[5], stores);
+    EXPECT_EQ(cell.getVersion(), stores + 1);
+}
+
+/**
+ * @brief This test case checks that a reader mapping the segment sees every
+ *        step a simulation publishes, never a torn sample, gets the publish
+ *        count of the sample it read, and notices when the publisher goes
+ *        away.
+ */
+TEST(SharedStateTest, TestPublishToSeparateMapping) {
+    std::string name = "/ackermann_test_" + std::to_string(::getpid());
+    EXPECT_THROW(SharedStatePublisher("ackermann"), std::invalid_argument);
+    EXPECT_THROW(SharedStateReader("/ackermann/state"),
+                 std::invalid_argument);
+    EXPECT_THROW(SharedStateReader{name}, std::runtime_error);
+
+    std::unique_ptr<SharedStateReader> reader;
+    {
+        SharedStatePublisher publisher(name);
+        reader.reset(new SharedStateReader(name));
+        EXPECT_EQ(reader->getPublishCount(), 0u);
+        EXPECT_TRUE(reader->isPublisherOpen());
+
+        RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                                   1.0, 0.1, 0.01);
+        simulation.setPublisher(&publisher);
+        PIDOutput output = {0.0, 0.0};
+        for (int i = 0; i < 5; i++) output = simulation.step(0.3, 2.0);
+        simulation.setPublisher(nullptr);
+        simulation.step(0.3, 2.0);
+        EXPECT_EQ(publisher.getPublishCount(), 5u);
+        EXPECT_EQ(reader->getPublishCount(), 5u);
+
+        SharedStateSample sample = reader->read();
+        EXPECT_DOUBLE_EQ(sample.state.time, 0.5);
+        EXPECT_DOUBLE_EQ(sample.velocityCommand, output.velocity);
+        EXPECT_DOUBLE_EQ(sample.headingCommand, output.heading);
+        EXPECT_GT(sample.publishTime, 0u);
+
+        // Every field of a sample carries its index
+        const std::uint64_t samples = 20000;
+        std::thread writer([&] {
+            TrajectorySample state = {};
+            PIDOutput command = {0.0, 0.0};
+            for (std::uint64_t i = 1; i <= samples; i++) {
+                state.time = state.x = state.headingD =
+                    static_cast<double>(i);
+                command.velocity = command.heading = static_cast<double>(i);
+                publisher.publish(state, command);
+            }
+        });
+        long torn = 0, backwards = 0, miscounted = 0;
+        double last = 0.0;
+        std::uint64_t count = 0;
+        while (reader->getPublishCount() < 5 + samples) {
+            if (!reader->tryRead(sample, count)) continue;
+            if (sample.state.time < 1.0) continue;
+            if (sample.state.x != sample.state.time ||
+                sample.state.headingD != sample.state.time ||
+                sample.headingCommand != sample.state.time) {
+                torn++;
+            }
+            // The count read with a sample is the one that published it
+            if (count != 5 + static_cast<std::uint64_t>(sample.state.time)) {
+                miscounted++;
+            }
+            if (sample.state.time < last) backwards++;
+            last = sample.state.time;
+        }
+        writer.join();
+        EXPECT_EQ(torn, 0);
+        EXPECT_EQ(backwards, 0);
+        EXPECT_EQ(miscounted, 0);
+        EXPECT_DOUBLE_EQ(reader->read(count).velocityCommand, samples);
+        EXPECT_EQ(count, 5 + samples);
+    }
+    EXPECT_FALSE(reader->isPublisherOpen());
+    EXPECT_THROW(SharedStateReader{name}, std::runtime_error);
+}
+
+/**
+ * @brief This test case checks that a telemetry consumer far slower than
+ *        the control loop neither stalls it nor changes its results.
+ */
+TEST(ConcurrentSimulationTest, TestSlowTelemetryConsumer) {
+    const std::uint64_t steps = 2000;
+    RobotSimulation reference(0.5, 1.0, M_PI / 4, 0.2, 0.01, 0.01, 0.1,
+                              0.3, 0.01, 0.01);
+    for (std::uint64_t k = 0; k < steps; k++) reference.step(0.3, 2.0);
+
+    PIDController controller(0.2, 0.01, 0.01, 0.1, 0.3, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4);
+    ConcurrentSimulation simulation(controller, robot, 16);
+    EXPECT_EQ(simulation.getLatestState().step, 0u);
+    EXPECT_TRUE(simulation.setSetpoint(0.3, 2.0));
+
+    std::atomic<bool> consuming(true);
+    std::uint64_t consumed = 0;
+    std::uint64_t lastStep = 0;
+    bool ordered = true;
+    std::thread consumer([&] {
+        StateSample sample;
+        while (consuming) {
+            if (simulation.pollTelemetry(sample)) {
+                ordered = ordered && sample.step > lastStep;
+                lastStep = sample.step;
+                consumed++;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+
+    simulation.start(steps);
+    EXPECT_THROW(simulation.start(steps), std::logic_error);
+    const ChannelStats& stats = simulation.join();
+    consuming = false;
+    consumer.join();
+
+    EXPECT_FALSE(simulation.isRunning());
+    EXPECT_EQ(stats.steps, steps);
+    EXPECT_EQ(stats.setpoints, 1u);
+    EXPECT_EQ(stats.commandLatency.getCount(), steps);
+    EXPECT_EQ(stats.controlLatency.getCount(), steps);
+    // The consumer keeps up with a fraction of the samples; the rest are
+    // dropped rather than waited for
+    EXPECT_GT(stats.telemetryDropped, 0u);
+    EXPECT_LT(consumed, steps / 2);
+    EXPECT_TRUE(ordered);
+    StateSample sample;
+    std::uint64_t remaining = 0;
+    while (simulation.pollTelemetry(sample)) remaining++;
+    EXPECT_EQ(consumed + remaining + stats.telemetryDropped, steps);
+
+    double x, y, theta, velocity;
+    reference.getState(x, y, theta, velocity);
+    StateSample last = simulation.getLatestState();
+    EXPECT_EQ(last.step, steps);
+    EXPECT_TRUE(sameBits(last.x, x));
+    EXPECT_TRUE(sameBits(last.y, y));
+    EXPECT_TRUE(sameBits(last.theta, theta));
+}
+
+/**
+ * @brief This test case checks the fleet simulation against RobotSimulation.
+ */
+TEST(FleetSimulationTest, TestMatchesRobotSimulation) {
+    const std::size_t count = 9;
+    FleetSimulation fleet(count, 0.1, 2);
+    fleet.getFleet().setSimdEnabled(false);
+    std::vector<RobotSimulation> simulations;
+    std::vector<double> targetHeadings, targetVelocities;
+    for (std::size_t i = 0; i < count; i++) {
+        double velP = 0.2 + 0.1 * i;
+        double headP = 0.3 + 0.05 * i;
+        // RobotSimulation passes the track width as the wheel radius
+        simulations.emplace_back(0.5, 1.0, M_PI / 4, velP, 0.01, 0.02, 0.1,
+                                 headP, 0.02, 0.01);
+        fleet.getFleet().setGeometry(i, 0.5, 1.0, M_PI / 4);
+        fleet.setGains(i, velP, 0.01, 0.02, headP, 0.02, 0.01);
+        targetHeadings.push_back(i % 3 == 0 ? 0.0 : 0.1 * i - 0.4);
+        targetVelocities.push_back(0.5 * i);
+        fleet.setTarget(i, targetHeadings[i], targetVelocities[i]);
+    }
+
+    for (int k = 0; k < 30; k++) {
+        fleet.step();
+        for (std::size_t i = 0; i < count; i++) {
+            simulations[i].step(targetHeadings[i], targetVelocities[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        double x, y, theta, velocity, fx, fy, ftheta, fvelocity;
+        simulations[i].getState(x, y, theta, velocity);
+        fleet.getFleet().getState(i, fx, fy, ftheta, fvelocity);
+        EXPECT_TRUE(sameBits(x, fx)) << "vehicle " << i;
+        EXPECT_TRUE(sameBits(y, fy)) << "vehicle " << i;
+        EXPECT_TRUE(sameBits(theta, ftheta)) << "vehicle " << i;
+    }
+    EXPECT_EQ(fleet.getIndex().size(), count);
+}
+
+/**
+ * @brief This test case checks the grid queries against brute force.
+ */
+TEST(SpatialGridTest, TestQueriesMatchBruteForce) {
+    EXPECT_THROW(SpatialGrid(0.0), std::invalid_argument);
+
+    const std::size_t count = 600;
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> position(-40.0, 40.0);
+    std::vector<double> x(count), y(count);
+    for (std::size_t i = 0; i < count; i++) {
+        x[i] = position(generator);
+        y[i] = position(generator);
+    }
+    // Outliers far away and a point the index must leave out
+    x[5] = 1e6;
+    y[7] = -3e12;
+    x[9] = std::numeric_limits<double>::quiet_NaN();
+
+    SpatialGrid grid(2.5);
+    grid.build(x.data(), y.data(), count);
+    EXPECT_EQ(grid.size(), count - 1);
+
+    auto dist = [&](std::size_t i, double px, double py) {
+        return std::hypot(x[i] - px, y[i] - py);
+    };
+    for (std::size_t q = 0; q < 60; q++) {
+        double px = q < 50 ? x[q] : position(generator) * 3.0;
+        double py = q < 50 ? y[q] : position(generator) * 3.0;
+        std::size_t exclude = q < 50 ? q : SpatialGrid::npos;
+        if (q == 9) continue;
+
+        std::size_t expected = SpatialGrid::npos;
+        for (std::size_t i = 0; i < count; i++) {
+            if (i == 9 || i == exclude) continue;
+            if (expected == SpatialGrid::npos ||
+                dist(i, px, py) < dist(expected, px, py)) {
+                expected = i;
+            }
+        }
+        double distance;
+        EXPECT_EQ(grid.nearest(px, py, exclude, distance), expected)
+            << "query " << q;
+        EXPECT_DOUBLE_EQ(distance, dist(expected, px, py));
+
+        std::vector<std::size_t> found, brute;
+        grid.queryRadius(px, py, 6.0, found);
+        for (std::size_t i = 0; i < count; i++) {
+            if (i != 9 && dist(i, px, py) <= 6.0) brute.push_back(i);
+        }
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, brute) << "query " << q;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs, brute;
+    grid.findPairs(3.0, 0, grid.size() / 2, pairs);
+    grid.findPairs(3.0, grid.size() / 2, grid.size(), pairs);
+    std::sort(pairs.begin(), pairs.end());
+    for (std::size_t i = 0; i < count; i++) {
+        for (std::size_t j = i + 1; j < count; j++) {
+            if (i != 9 && j != 9 && dist(i, x[j], y[j]) <= 3.0) {
+                brute.emplace_back(i, j);
+            }
+        }
+    }
+    EXPECT_FALSE(brute.empty());
+    EXPECT_EQ(pairs, brute);
+
+    FleetSimulation fleet(count, 0.1, 2);
+    for (std::size_t i = 0; i < count; i++) {
+        fleet.getFleet().setInitialState(i, x[i], y[i], 0.0, 0.0);
+    }
+    fleet.setCellSize(3.0);
+    EXPECT_EQ(fleet.findPairs(3.0), brute);
+    double distance;
+    EXPECT_EQ(fleet.nearest(0, distance),
+              grid.nearest(x[0], y[0], 0, distance));
+}
+
+/**
+ * @brief This test case checks defaults, sections and setpoint expansion.
+ */
+TEST(ScenarioFileTest, TestParseSectionsAndSetpoints) {
+    std::istringstream input(
+        "# defaults\n"
+        "dt = 0.05\n"
+        "max_iterations = 120   # trailing comment\n"
+        "\n"
+        "[scenario]\n"
+        "name = sweep\n"
+        "vel_p = 2.5\n"
+        "setpoint = 0.3 10\n"
+        "setpoint = -0.2 5.5\n"
+        "[scenario]\n"
+        "name = single\n"
+        "target_heading = 1.0\n"
+        "target_velocity = 3\n"
+        "convergence_threshold = 0.25\n"
+        "velocity_tolerance = 0.5\n"
+        "settle_window = 4\n"
+        "steering_table_intervals = 256\n"
+        "steering_table_interpolation = linear\n"
+        "stop_on_convergence = yes\n");
+    ScenarioParser parser;
+    parser.parse(input);
+    std::vector<Scenario> scenarios = parser.getScenarios();
+
+    ASSERT_EQ(scenarios.size(), 3u);
+    EXPECT_EQ(scenarios[0].name, "sweep#1");
+    EXPECT_EQ(scenarios[1].name, "sweep#2");
+    EXPECT_EQ(scenarios[2].name, "single");
+    EXPECT_DOUBLE_EQ(scenarios[0].velP, 2.5);
+    EXPECT_DOUBLE_EQ(scenarios[2].velP, Scenario().velP);
+    EXPECT_DOUBLE_EQ(scenarios[1].targetHeading, -0.2);
+    EXPECT_DOUBLE_EQ(scenarios[1].targetVelocity, 5.5);
+    EXPECT_DOUBLE_EQ(scenarios[2].deltaT, 0.05);
+    EXPECT_EQ(scenarios[2].maxIterations, 120);
+    EXPECT_TRUE(scenarios[2].stopOnConvergence);
+    EXPECT_FALSE(scenarios[0].stopOnConvergence);
+    EXPECT_DOUBLE_EQ(scenarios[2].velocityTolerance, 0.5);
+    EXPECT_DOUBLE_EQ(scenarios[2].headingTolerance, 0.25);
+    EXPECT_EQ(scenarios[2].getConvergenceCriteria().settleWindow, 4);
+    EXPECT_EQ(scenarios[2].steeringTableIntervals, 256);
+    EXPECT_FALSE(scenarios[2].steeringTableCubic);
+    EXPECT_EQ(scenarios[0].steeringTableIntervals, 0);
+}
+
+/**
+ * @brief This test case checks that defaults alone form one scenario, and
+ *        that setpoints outside of sections are not silently dropped.
+ */
+TEST(ScenarioFileTest, TestDefaultsWithoutSections) {
+    ScenarioParser parser;
+    parser.setDefault("head_p", "0.5");
+    parser.setDefault("setpoint", "0.4 12");
+    std::vector<Scenario> scenarios = parser.getScenarios();
+    ASSERT_EQ(scenarios.size(), 1u);
+    EXPECT_DOUBLE_EQ(scenarios[0].headP, 0.5);
+    EXPECT_DOUBLE_EQ(scenarios[0].targetHeading, 0.4);
+    EXPECT_DOUBLE_EQ(scenarios[0].targetVelocity, 12.0);
+
+    // With sections, such setpoints would be dropped, so they are rejected
+    std::istringstream input("[scenario]\nname = sectioned\n");
+    parser.parse(input);
+    EXPECT_THROW(parser.getScenarios(), std::invalid_argument);
+    ScenarioParser sectionsOnly;
+    std::istringstream again("[scenario]\nname = sectioned\n");
+    sectionsOnly.parse(again);
+    EXPECT_EQ(sectionsOnly.getScenarios().size(), 1u);
+}
+
+/**
+ * @brief This test case checks that malformed lines report their location.
+ */
+TEST(ScenarioFileTest, TestErrorsReportLineNumbers) {
+    ScenarioParser parser;
+    std::istringstream unknownKey("dt = 0.1\nvelp = 2\n");
+    try {
+        parser.parse(unknownKey, "bad.cfg");
+        FAIL() << "expected a parse error";
+    } catch (const std::runtime_error& error) {
+        EXPECT_NE(std::string(error.what()).find("bad.cfg:2"),
+                  std::string::npos);
+    }
+
+    std::istringstream badNumber("dt = fast\n");
+    EXPECT_THROW(parser.parse(badNumber), std::runtime_error);
+    std::istringstream badSetpoint("setpoint = 1\n");
+    EXPECT_THROW(parser.parse(badSetpoint), std::runtime_error);
+    EXPECT_THROW(parser.setDefault("max_iterations", "-3"),
+                 std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks the CSV summary output.
+ */
+TEST(ScenarioFileTest, TestWriteSummaryCsv) {
+    std::vector<Scenario> scenarios(1);
+    scenarios[0].name = "run";
+    std::vector<ScenarioSummary> summaries(1);
+    summaries[0].converged = true;
+    summaries[0].steps = 7;
+    std::ostringstream output;
+    writeSummaryCsv(output, scenarios, summaries);
+    std::string text = output.str();
+    EXPECT_EQ(text.substr(0, 5), "name,");
+    EXPECT_NE(text.find("\nrun,0,0,1,7,"), std::string::npos);
+}
+
+/**
+ * @brief Path of a scratch file in the temporary directory.
+ */
+static std::string tempPath(const std::string& name) {
+    const char* directory = std::getenv("TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/" +
+           name + "_" + std::to_string(::testing::UnitTest::GetInstance()
+                                           ->random_seed()) + ".traj";
+}
+
+/**
+ * @brief This test case checks that samples survive a round trip across
+ *        several chunks.
+ */
+TEST(TrajectoryRecorderTest, TestRoundTripAcrossChunks) {
+    std::string path = tempPath("round_trip");
+    const std::size_t count = 10;
+    {
+        TrajectoryRecorder recorder;
+        EXPECT_FALSE(recorder.isOpen());
+        recorder.open(path, 4);
+        for (std::size_t i = 0; i < count; i++) {
+            TrajectorySample sample = {};
+            sample.time = 0.1 * i;
+            sample.x = static_cast<double>(i);
+            sample.headingD = -static_cast<double>(i);
+            recorder.record(sample);
+        }
+        EXPECT_EQ(recorder.getSampleCount(), count);
+    }
+
+    TrajectoryReader reader(path);
+    ASSERT_EQ(reader.getSampleCount(), count);
+    for (std::size_t i = 0; i < count; i++) {
+        TrajectorySample sample = reader.getSample(i);
+        EXPECT_DOUBLE_EQ(sample.time, 0.1 * i);
+        EXPECT_DOUBLE_EQ(sample.x, static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(sample.headingD, -static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(reader.getValue(i, 1), static_cast<double>(i));
+    }
+    EXPECT_THROW(reader.getSample(count), std::out_of_range);
+    EXPECT_THROW(reader.getValue(0, TrajectorySample::kColumnCount),
+                 std::out_of_range);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief This test case checks that a recorded simulation matches its
+ *        state and can be converted to CSV.
+ */
+TEST(TrajectoryRecorderTest, TestSimulationRecording) {
+    std::string path = tempPath("simulation");
+    TrajectoryRecorder recorder;
+    recorder.open(path);
+    RobotSimulation simulation(0.5, 1.0, M_PI / 4.0, 1.0, 0.1, 0.01, 0.1,
+                               1.0, 0.1, 0.01);
+    simulation.setRecorder(&recorder);
+    for (int i = 0; i < 5; i++) simulation.step(0.3, 2.0);
+    simulation.setRecorder(nullptr);
+    recorder.close();
+    EXPECT_THROW(recorder.record(TrajectorySample()), std::runtime_error);
+
+    TrajectoryReader reader(path);
+    ASSERT_EQ(reader.getSampleCount(), 5u);
+    TrajectorySample last = reader.getSample(4);
+    double x, y, theta, velocity;
+    simulation.getState(x, y, theta, velocity);
+    EXPECT_DOUBLE_EQ(last.time, 0.5);
+    EXPECT_DOUBLE_EQ(last.x, x);
+    EXPECT_DOUBLE_EQ(last.heading, simulation.getCurrentHeading());
+    EXPECT_DOUBLE_EQ(last.speed, simulation.getCurrentVelocity());
+    TrajectorySample first = reader.getSample(0);
+    EXPECT_DOUBLE_EQ(first.targetVelocity, 2.0);
+    EXPECT_DOUBLE_EQ(first.velocityError, 2.0);
+    EXPECT_DOUBLE_EQ(first.velocityP, 2.0);
+
+    std::ostringstream csv;
+    writeTrajectoryCsv(csv, reader);
+    std::string text = csv.str();
+    EXPECT_EQ(text.substr(0, text.find('\n')),
+              "time,x,y,theta,heading,speed,alpha_i,alpha_o,omega_i,omega_o,"
+              "target_heading,target_velocity,"
+              "velocity_error,heading_error,velocity_p,velocity_i,velocity_d,"
+              "heading_p,heading_i,heading_d");
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 6);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief This test case checks that a replay matches its golden trace bit
+ *        for bit and pins a change to the controller or the plant.
+ */
+TEST(TraceReplayTest, TestReplayAgainstGoldenTrace) {
+    EXPECT_EQ(parseReplayMode("controller"), ReplayMode::Controller);
+    EXPECT_THROW(parseReplayMode("open_loop"), std::invalid_argument);
+
+    Scenario scenario;
+    scenario.name = "golden";
+    scenario.velP = 0.2;
+    scenario.headP = 0.3;
+    scenario.targetHeading = 0.3;
+    scenario.targetVelocity = 2.0;
+    scenario.maxIterations = 300;
+    scenario.recordPath = tempPath("golden");
+    BatchRunner::runScenario(scenario);
+    TrajectoryReader golden(scenario.recordPath);
+    ASSERT_EQ(golden.getSampleCount(), 300u);
+
+    ReplayReport closedLoop = replayTrace(scenario, golden);
+    EXPECT_TRUE(closedLoop.passed());
+    EXPECT_EQ(closedLoop.ticks, 300u);
+    EXPECT_EQ(closedLoop.firstMismatch, ReplayReport::npos);
+    EXPECT_EQ(closedLoop.worstColumn(), ReplayReport::npos);
+    ReplayReport controller = replayTrace(scenario, golden,
+                                          ReplayMode::Controller);
+    EXPECT_TRUE(controller.passed());
+    EXPECT_FALSE(controller.compared[1]);
+    EXPECT_TRUE(controller.compared[TrajectorySample::kColumnCount - 1]);
+
+    // A controller change shows up from the first tick in both modes
+    Scenario retuned = scenario;
+    retuned.velP *= 1.0 + 1e-9;
+    ReplayReport changed = replayTrace(retuned, golden);
+    EXPECT_FALSE(changed.passed());
+    EXPECT_EQ(changed.firstMismatch, 0u);
+    EXPECT_FALSE(replayTrace(retuned, golden, ReplayMode::Controller)
+                     .passed());
+    // A 1e-9 gain change stays within a 1e-6 tolerance; the absolute part
+    // covers errors that cross zero
+    EXPECT_TRUE(replayTrace(retuned, golden, ReplayMode::ClosedLoop,
+                            ReplayTolerance(1e-6, 1e-6)).passed());
+
+    // A plant change only shows up in closed loop
+    Scenario rebuilt = scenario;
+    rebuilt.wheelbase = 0.6;
+    EXPECT_FALSE(replayTrace(rebuilt, golden).passed());
+    EXPECT_TRUE(replayTrace(rebuilt, golden, ReplayMode::Controller)
+                    .passed());
+
+    std::ostringstream csv;
+    writeReplayCsv(csv, {scenario, retuned},
+                   {closedLoop, changed});
+    std::string text = csv.str();
+    std::size_t worst = changed.worstColumn();
+    ASSERT_NE(worst, ReplayReport::npos);
+    EXPECT_EQ(text, "name,mode,ticks,mismatched_ticks,first_mismatch,"
+                    "worst_column,max_error\n"
+                    "golden,closed_loop,300,0,,,\n"
+                    "golden,closed_loop,300," +
+                    std::to_string(changed.mismatchedTicks) + ",0," +
+                    TrajectorySample::columnName(worst) + "," +
+                    [&] {
+                        std::ostringstream error;
+                        error << changed.columns[worst].maxError;
+                        return error.str();
+                    }() + "\n");
+    std::remove(scenario.recordPath.c_str());
+
+    // The targets come from the trace, so a run whose setpoints move
+    // replays as well
+    std::string sessionPath = tempPath("golden_session");
+    {
+        TrajectoryRecorder recorder;
+        recorder.open(sessionPath, 64);
+        ControlSession session(BatchRunner::makeSimulation(scenario));
+        session.setBumpless(false);
+        session.getSimulation().setRecorder(&recorder);
+        session.command(0.3, 2.0, ProfileShape::Ramp, 1.0);
+        session.run(100);
+        session.command(-0.2, 1.0, ProfileShape::SCurve, 0.5);
+        session.run(100);
+        session.command(0.1, 1.5, ProfileShape::Step, 0.0);
+        session.run(100);
+    }
+    TrajectoryReader sessionTrace(sessionPath);
+    ASSERT_EQ(sessionTrace.getSampleCount(), 300u);
+    EXPECT_DOUBLE_EQ(sessionTrace.getSample(299).targetHeading, 0.1);
+    EXPECT_TRUE(replayTrace(scenario, sessionTrace).passed());
+    EXPECT_TRUE(replayTrace(scenario, sessionTrace, ReplayMode::Controller)
+                    .passed());
+    std::remove(sessionPath.c_str());
+}
+
+/**
+ * @brief This test case checks that other files are rejected.
+ */
+TEST(TrajectoryRecorderTest, TestReaderRejectsOtherFiles) {
+    std::string path = tempPath("not_a_trajectory");
+    FILE* file = std::fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    for (int i = 0; i < 100; i++) std::fputs("not a trajectory\n", file);
+    std::fclose(file);
+    EXPECT_THROW(TrajectoryReader reader(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(TrajectoryReader reader(path), std::runtime_error);
+}
+
+/**
+ * @brief This test case checks the histogram statistics and percentiles.
+ */
+TEST(LatencyHistogramTest, TestPercentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getPercentile(0.5), 0u);
+    for (std::uint64_t value = 1; value <= 1000; value++) {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(histogram.getCount(), 1000u);
+    EXPECT_EQ(histogram.getMin(), 1000u);
+    EXPECT_EQ(histogram.getMax(), 1000000u);
+    EXPECT_DOUBLE_EQ(histogram.getMean(), 500500.0);
+    EXPECT_NEAR(histogram.getPercentile(0.5), 500000.0, 0.07 * 500000.0);
+    EXPECT_NEAR(histogram.getPercentile(0.99), 990000.0, 0.07 * 990000.0);
+    EXPECT_EQ(histogram.getPercentile(1.0), 1000000u);
+
+    LatencyHistogram other;
+    other.record(7);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.getMin(), 7u);
+    EXPECT_EQ(histogram.getPercentile(0.0001), 7u);
+
+    for (std::uint64_t value : {0ull, 31ull, 32ull, 1000ull, ~0ull}) {
+        std::size_t bucket = LatencyHistogram::bucketOf(value);
+        ASSERT_LT(bucket, LatencyHistogram::kBucketCount);
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(bucket), value);
+    }
+    histogram.clear();
+    EXPECT_EQ(histogram.getCount(), 0u);
+}
+
+/**
+ * @brief This test case checks that steps are released at a fixed period.
+ */
+TEST(RealTimeExecutorTest, TestFixedPeriod) {
+    RealTimeOptions options;
+    options.period = 0.002;
+    RealTimeExecutor executor(options);
+    std::vector<std::uint64_t> indices;
+    auto start = std::chrono::steady_clock::now();
+    const RealTimeStats& stats = executor.run([&](std::uint64_t i) {
+        indices.push_back(i);
+        return true;
+    }, 20);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(indices.size(), 20u);
+    EXPECT_EQ(indices.back(), 19u);
+    EXPECT_EQ(stats.steps, 20u);
+    EXPECT_EQ(stats.wakeupJitter.getCount(), 20u);
+    EXPECT_EQ(stats.stepLatency.getCount(), 20u);
+    // Twenty releases, the first one period after the start
+    EXPECT_GE(elapsed, 20 * options.period);
+    EXPECT_THROW(RealTimeExecutor(RealTimeOptions{0.0}),
+                 std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks overrun accounting and early stops.
+ */
+TEST(RealTimeExecutorTest, TestMissedDeadlinesAndStop) {
+    RealTimeOptions options;
+    options.period = 0.001;
+    RealTimeExecutor executor(options);
+    const RealTimeStats& stats = executor.run([](std::uint64_t i) {
+        if (i == 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return i < 3;
+    }, 100);
+    EXPECT_EQ(stats.steps, 4u);
+    EXPECT_GE(stats.missedDeadlines, 1u);
+    EXPECT_GE(stats.skippedPeriods, 4u);
+    EXPECT_GE(stats.stepLatency.getMax(), 5000000u);
+
+    executor.run([&executor](std::uint64_t) {
+        executor.requestStop();
+        return true;
+    }, 100);
+    EXPECT_EQ(executor.getStats().steps, 1u);
+    EXPECT_TRUE(executor.isStopRequested());
+    // The next run starts afresh
+    executor.run([](std::uint64_t i) { return i < 2; }, 100);
+    EXPECT_EQ(executor.getStats().steps, 3u);
+    EXPECT_FALSE(executor.isStopRequested());
+}
+
+/**
+ * @brief This test case checks that a paced scenario matches an unpaced one.
+ */
+TEST(RealTimeExecutorTest, TestScenarioMatchesBatchRun) {
+    Scenario scenario;
+    scenario.deltaT = 0.001;
+    scenario.targetHeading = 0.3;
+    scenario.targetVelocity = 2.0;
+    scenario.maxIterations = 10;
+    RealTimeOptions options;
+    options.period = scenario.deltaT;
+    RealTimeExecutor executor(options);
+    ScenarioSummary paced = BatchRunner::runScenario(scenario, &executor);
+    ScenarioSummary unpaced = BatchRunner::runScenario(scenario);
+    EXPECT_EQ(executor.getStats().steps, 10u);
+    EXPECT_EQ(paced.steps, unpaced.steps);
+    EXPECT_TRUE(sameBits(paced.finalHeading, unpaced.finalHeading));
+    EXPECT_TRUE(sameBits(paced.finalVelocity, unpaced.finalVelocity));
+}
+
+/**
+ * @brief Gains shared by the runtime and compile-time controller tests.
+ */
+struct SharedTestGains {
+    static constexpr double velP = 2.0;
+    static constexpr double velI = 0.5;
+    static constexpr double velD = 0.1;
+    static constexpr double dt = 0.1;
+    static constexpr double headP = 1.0;
+    static constexpr double headI = 0.25;
+    static constexpr double headD = 0.2;
+};
+
+/**
+ * @brief Proportional-only gains, for the zero-term elimination test.
+ */
+struct ProportionalOnlyGains {
+    static constexpr double velP = 3.0;
+    static constexpr double velI = 0.0;
+    static constexpr double velD = 0.0;
+    static constexpr double dt = 0.01;
+    static constexpr double headP = 0.5;
+    static constexpr double headI = 0.0;
+    static constexpr double headD = 0.0;
+};
+
+/**
+ * @brief Builds a controller with the shared test gains.
+ */
+template <typename Controller>
+Controller makeSharedController() {
+    return Controller();
+}
+
+template <>
+PIDController makeSharedController<PIDController>() {
+    typedef SharedTestGains G;
+    return PIDController(G::velP, G::velI, G::velD, G::dt,
+                         G::headP, G::headI, G::headD);
+}
+
+template <typename Controller>
+class PIDControllerContractTest : public ::testing::Test {};
+
+typedef ::testing::Types<PIDController,
+                         FixedGainPIDController<SharedTestGains>>
+    PIDControllerTypes;
+TYPED_TEST_SUITE(PIDControllerContractTest, PIDControllerTypes);
+
+/**
+ * @brief This test case checks that both controllers report their gains.
+ */
+TYPED_TEST(PIDControllerContractTest, TestGains) {
+    TypeParam PID = makeSharedController<TypeParam>();
+    EXPECT_DOUBLE_EQ(PID.getVelocityProportionalConstant(), 2.0);
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegralConstant(), 0.5);
+    EXPECT_DOUBLE_EQ(PID.getVelocityDerivativeConstant(), 0.1);
+    EXPECT_DOUBLE_EQ(PID.getDeltaTime(), 0.1);
+    EXPECT_DOUBLE_EQ(PID.getHeadingProportionalConstant(), 1.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegralConstant(), 0.25);
+    EXPECT_DOUBLE_EQ(PID.getHeadingDerivativeConstant(), 0.2);
+}
+
+/**
+ * @brief This test case checks the streaming P, I and D terms.
+ */
+TYPED_TEST(PIDControllerContractTest, TestStreamingTerms) {
+    TypeParam PID = makeSharedController<TypeParam>();
+    EXPECT_TRUE(PID.computePID().empty());
+    PIDOutput empty = PID.computeControl();
+    EXPECT_EQ(empty.velocity, 0.0);
+    EXPECT_EQ(empty.heading, 0.0);
+
+    PID.computeErrors(4.0, 0.0, -4.0, 0.0);
+    PIDTerms first = PID.computeTerms();
+    EXPECT_DOUBLE_EQ(first.velocityD, 0.0);
+    EXPECT_DOUBLE_EQ(first.velocityP, 8.0);
+
+    double errors[] = {3.0, -1.0, 2.5};
+    double sum = 4.0;
+    for (double error : errors) {
+        PID.computeErrors(error, 0.0, -error, 0.0);
+        sum += error;
+    }
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), sum);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -sum);
+
+    PIDTerms terms = PID.computeTerms();
+    EXPECT_DOUBLE_EQ(terms.velocityError, 2.5);
+    EXPECT_DOUBLE_EQ(terms.headingError, -2.5);
+    EXPECT_DOUBLE_EQ(terms.velocityD, 0.1 * (3.5 / 0.1));
+    EXPECT_DOUBLE_EQ(terms.headingD, 0.2 * (-3.5 / 0.1));
+
+    std::vector<double> out = PID.computePID();
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_DOUBLE_EQ(out[0], 2.0 * 2.5 + 0.5 * sum + 0.1 * (3.5 / 0.1));
+    EXPECT_DOUBLE_EQ(out[1], -2.5 - 0.25 * sum + 0.2 * (-3.5 / 0.1));
+    PIDOutput output = PID.computeControl();
+    EXPECT_EQ(output.velocity, out[0]);
+    EXPECT_EQ(output.heading, out[1]);
+}
+
+/**
+ * @brief This test case checks the anti-windup clamp and reset.
+ */
+TYPED_TEST(PIDControllerContractTest, TestAntiWindupAndReset) {
+    TypeParam PID = makeSharedController<TypeParam>();
+    PID.setIntegralLimits(5.0, -2.0);
+    for (int i = 0; i < 100; i++) {
+        PID.computeErrors(10.0, 0.0, -10.0, 0.0);
+    }
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 5.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -2.0);
+    PID.computeErrors(-1.0, 0.0, 1.0, 0.0);
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 4.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), -1.0);
+
+    PID.reset();
+    EXPECT_DOUBLE_EQ(PID.getVelocityIntegral(), 0.0);
+    EXPECT_DOUBLE_EQ(PID.getHeadingIntegral(), 0.0);
+    EXPECT_TRUE(PID.computePID().empty());
+}
+
+/**
+ * @brief This test case checks that the compile-time controller follows
+ *        the runtime one over a long random sequence.
+ */
+TEST(FixedGainPIDControllerTest, TestMatchesRuntimeController) {
+    PIDController runtime = makeSharedController<PIDController>();
+    FixedGainPIDController<SharedTestGains> fixed;
+    runtime.setIntegralLimits(50.0, 20.0);
+    fixed.setIntegralLimits(50.0, 20.0);
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> value(-10.0, 10.0);
+    for (int i = 0; i < 1000; i++) {
+        double velocity = value(generator), heading = value(generator);
+        runtime.computeErrors(velocity, 0.0, heading, 0.0);
+        fixed.computeErrors(velocity, 0.0, heading, 0.0);
+        PIDOutput expected = runtime.computeControl();
+        PIDOutput actual = fixed.computeControl();
+        ASSERT_NEAR(actual.velocity, expected.velocity,
+                    1e-12 * (1.0 + std::abs(expected.velocity)));
+        ASSERT_NEAR(actual.heading, expected.heading,
+                    1e-12 * (1.0 + std::abs(expected.heading)));
+    }
+}
+
+/**
+ * @brief This test case checks that zero gains remove their terms.
+ */
+TEST(FixedGainPIDControllerTest, TestZeroGainsAreEliminated) {
+    typedef FixedGainPIDController<ProportionalOnlyGains> Controller;
+    static_assert(Controller::getVelocityProportionalConstant() == 3.0,
+                  "gains are compile-time constants");
+    static_assert(std::is_trivially_copyable<Controller>::value,
+                  "the controller holds plain state only");
+
+    Controller PID;
+    PID.computeErrors(2.0, 0.0, 4.0, 0.0);
+    PID.computeErrors(1.0, 0.0, -4.0, 0.0);
+    PIDTerms terms = PID.computeTerms();
+    EXPECT_EQ(terms.velocityP, 3.0);
+    EXPECT_EQ(terms.headingP, -2.0);
+    EXPECT_EQ(terms.velocityI, 0.0);
+    EXPECT_EQ(terms.velocityD, 0.0);
+    EXPECT_EQ(terms.headingD, 0.0);
+    EXPECT_EQ(PID.getVelocityIntegral(), 0.0);
+    PIDOutput output = PID.computeControl();
+    EXPECT_EQ(output.velocity, 3.0);
+    EXPECT_EQ(output.heading, -2.0);
+}
+
+/**
+ * @brief A small tuning problem that runs quickly.
+ */
+static TuningProblem makeTuningProblem() {
+    TuningProblem problem;
+    problem.base.maxIterations = 40;
+    problem.base.deltaT = 0.1;
+    problem.setpoints = {{0.3, 2.0}, {-0.2, 1.0}};
+    return problem;
+}
+
+/**
+ * @brief This test case checks the cost function and its early stop.
+ */
+TEST(GainTunerTest, TestEvaluateAndPrune) {
+    TuningProblem problem = makeTuningProblem();
+    PIDGains gains = PIDGains::fromScenario(problem.base);
+    double cost = GainTuner::evaluate(problem, gains);
+    ASSERT_TRUE(std::isfinite(cost));
+    EXPECT_GT(cost, 0.0);
+    EXPECT_EQ(GainTuner::evaluate(problem, gains), cost);
+
+    // Stopped early: above the bound but below the full cost
+    double partial = GainTuner::evaluate(problem, gains, cost / 4);
+    EXPECT_GT(partial, cost / 4);
+    EXPECT_LT(partial, cost);
+
+    Scenario scenario;
+    gains.headP = 4.0;
+    gains.applyTo(scenario);
+    EXPECT_EQ(scenario.headP, 4.0);
+    EXPECT_EQ(gains[3], 4.0);
+}
+
+/**
+ * @brief This test case checks that tuning improves on the starting gains
+ *        and does not depend on the thread count.
+ */
+TEST(GainTunerTest, TestTuneIsDeterministic) {
+    TuningProblem problem = makeTuningProblem();
+    TuningOptions options;
+    options.initialSamples = 16;
+    options.maxEvaluations = 600;
+
+    TuningReport serial = GainTuner(1).tune(problem, options);
+    TuningReport parallel = GainTuner(4).tune(problem, options);
+
+    EXPECT_LE(serial.bestCost, serial.initialCost);
+    EXPECT_DOUBLE_EQ(serial.bestCost,
+                     GainTuner::evaluate(problem, serial.best));
+    EXPECT_EQ(serial.bestCost, parallel.bestCost);
+    for (std::size_t i = 0; i < PIDGains::kCount; i++) {
+        EXPECT_EQ(serial.best[i], parallel.best[i]);
+        EXPECT_GE(serial.best[i], problem.lower[i]);
+        EXPECT_LE(serial.best[i], problem.upper[i]);
+    }
+    ASSERT_FALSE(serial.history.empty());
+    EXPECT_EQ(serial.history[0].evaluations, 17u);
+    for (std::size_t i = 1; i < serial.history.size(); i++) {
+        EXPECT_LE(serial.history[i].bestCost, serial.history[i - 1].bestCost);
+    }
+    EXPECT_EQ(serial.summaries.size(), 2u);
+    EXPECT_GT(serial.pruned, 0u);
+
+    problem.lower.velP = 10.0;
+    EXPECT_THROW(GainTuner(1).tune(problem, options), std::invalid_argument);
+}
+
+/**
+ * @brief This test case checks that the profiler records every stage on
+ *        every thread only while enabled, including threads that ended.
+ */
+TEST(ProfilerTest, TestRecordsStagesPerThread) {
+    EXPECT_EQ(parseProfileFormat("prometheus"), ProfileFormat::Prometheus);
+    EXPECT_THROW(parseProfileFormat("json"), std::invalid_argument);
+
+    auto run = [](int steps) {
+        RobotSimulation simulation(0.5, 1.0, 0.6, 1.0, 0.1, 0.01, 0.01,
+                                   1.0, 0.1, 0.01);
+        simulation.setInitialState(0.0, 0.0, 0.0, 1.0);
+        for (int i = 0; i < steps; i++) simulation.step(0.3, 2.0);
+    };
+
+    // Nothing is recorded while disabled
+    Profiler::setEnabled(false);
+    Profiler::reset();
+    run(10);
+    EXPECT_EQ(Profiler::snapshot().stages[0].getCount(), 0u);
+
+    Profiler::setEnabled(true);
+    EXPECT_GT(Profiler::getNanosecondsPerTick(), 0.0);
+    run(100);
+    std::thread first(run, 200);
+    std::thread second(run, 300);
+    first.join();
+    second.join();
+    ProfileSnapshot snapshot = Profiler::snapshot();
+    Profiler::setEnabled(false);
+
+#if ACKERMANN_PROFILE
+    // The ended threads are included
+    EXPECT_GE(snapshot.threads, 3u);
+    for (std::size_t i = 0; i < kProfileStageCount; i++) {
+        EXPECT_EQ(snapshot.stages[i].getCount(), 600u)
+            << profileStageName(static_cast<ProfileStage>(i));
+    }
+    const LatencyHistogram& step =
+        snapshot.stages[static_cast<int>(ProfileStage::ControlStep)];
+    const LatencyHistogram& errors =
+        snapshot.stages[static_cast<int>(ProfileStage::ComputeErrors)];
+    EXPECT_GE(step.getSum(), errors.getSum());
+    EXPECT_LE(step.getPercentile(0.5), step.getPercentile(0.99));
+    EXPECT_LE(step.getPercentile(0.99), step.getMax());
+    // Euler evaluates the derivative once per step; no table is enabled
+    EXPECT_EQ(snapshot.counters[static_cast<int>(
+                  ProfileCounter::DerivativeEvaluations)], 600u);
+    EXPECT_EQ(snapshot.counters[static_cast<int>(
+                  ProfileCounter::SteeringTableMisses)], 0u);
+
+    std::ostringstream text;
+    snapshot.write(text);
+    EXPECT_NE(text.str().find("compute_errors"), std::string::npos);
+    EXPECT_NE(text.str().find("derivative_evaluations"), std::string::npos);
+    std::ostringstream prometheus;
+    snapshot.write(prometheus, ProfileFormat::Prometheus);
+    EXPECT_NE(prometheus.str().find(
+                  "# TYPE ackermann_stage_duration_nanoseconds summary\n"),
+              std::string::npos);
+    EXPECT_NE(prometheus.str().find(
+                  "ackermann_stage_duration_nanoseconds_count"
+                  "{stage=\"update_state\"} 600\n"),
+              std::string::npos);
+    EXPECT_NE(prometheus.str().find(
+                  "ackermann_derivative_evaluations_total 600\n"),
+              std::string::npos);
+#else
+    // The macros are compiled out, so nothing is recorded
+    EXPECT_EQ(snapshot.stages[static_cast<int>(ProfileStage::ControlStep)]
+                  .getCount(), 0u);
+#endif
+
+    Profiler::reset();
+    EXPECT_EQ(Profiler::snapshot().stages[0].getCount(), 0u);
+}
+
+/**
+ * @brief This test case checks that the scheduler runs every rate group
+ *        once per divisor ticks from its offset, runs the groups due on one
+ *        tick in the order they were added and rejects a zero period,
+ *        divisor or an offset past the divisor.
+ */
+TEST(RateGroupSchedulerTest, TestDeterministicSchedule) {
+    EXPECT_THROW(RateGroupScheduler(0.0), std::invalid_argument);
+    RateGroupScheduler scheduler(0.01);
+    std::vector<std::string> log;
+    auto logger = [&log](const char* name) {
+        return [&log, name](std::uint64_t tick) {
+            log.push_back(name + std::to_string(tick));
+        };
+    };
+    scheduler.addGroup("fast", 1, logger("f"));
+    scheduler.addGroup("slow", 3, logger("s"));
+    scheduler.addGroup("mid", 2, logger("m"), 1);
+    EXPECT_THROW(scheduler.addGroup("bad", 0, logger("b")),
+                 std::invalid_argument);
+    EXPECT_THROW(scheduler.addGroup("bad", 2, logger("b"), 2),
+                 std::invalid_argument);
+    EXPECT_EQ(scheduler.getHyperperiod(), 6u);
+
+    // Groups due on the same tick run in the order they were added
+    scheduler.run(4);
+    const std::vector<std::string> expected = {"f0", "s0", "f1", "m1", "f2",
+                                               "f3", "s3", "m3"};
+    EXPECT_EQ(log, expected);
+    EXPECT_EQ(scheduler.getTick(), 4u);
+    EXPECT_DOUBLE_EQ(scheduler.getTime(), 0.04);
+    EXPECT_DOUBLE_EQ(scheduler.getGroupPeriod(1), 0.03);
+    EXPECT_EQ(scheduler.getGroupName(2), "mid");
+
+    // A group added later joins the schedule as if it had run from tick 0
+    scheduler.addGroup("late", 4, logger("l"), 2);
+    log.clear();
+    scheduler.run(3);
+    const std::vector<std::string> later = {"f4", "f5", "m5", "f6", "s6",
+                                            "l6"};
+    EXPECT_EQ(log, later);
+
+    // Over many hyperperiods every group runs once per divisor ticks
+    scheduler.reset();
+    scheduler.run(1200);
+    EXPECT_EQ(scheduler.getRunCount(0), 1200u);
+    EXPECT_EQ(scheduler.getRunCount(1), 400u);
+    EXPECT_EQ(scheduler.getRunCount(2), 600u);
+    EXPECT_EQ(scheduler.getRunCount(3), 300u);
+}
+
+/**
+ * @brief This test case checks that the multi-rate loop matches
+ *        RobotSimulation::step() at divisor 1, scales the slower loops and
+ *        still settles on the targets with a slow velocity loop.
+ */
+TEST(MultiRateSimulationTest, TestRatesAndScaling) {
+    PIDController controller(0.2, 0.01, 0.01, 0.1, 0.3, 0.01, 0.01);
+    RobotModel robot(0.5, 1.0, M_PI / 4);
+
+    // With every divisor at 1 the loop is RobotSimulation::step()
+    RobotSimulation reference(0.5, 1.0, M_PI / 4, 0.2, 0.01, 0.01, 0.1,
+                              0.3, 0.01, 0.01);
+    MultiRateSimulation single(controller, robot);
+    single.setTargets(0.3, 2.0);
+    for (int k = 0; k < 500; k++) {
+        PIDOutput expected = reference.step(0.3, 2.0);
+        single.tick();
+        ASSERT_EQ(single.getCommand().heading, expected.heading);
+        ASSERT_EQ(single.getCommand().velocity, expected.velocity);
+    }
+    double x, y, theta, velocity;
+    double refX, refY, refTheta, refVelocity;
+    single.getRobot().getState(x, y, theta, velocity);
+    reference.getState(refX, refY, refTheta, refVelocity);
+    EXPECT_EQ(x, refX);
+    EXPECT_EQ(y, refY);
+    EXPECT_EQ(theta, refTheta);
+    EXPECT_EQ(single.getRobot().getSpeed(), reference.getCurrentVelocity());
+
+    // A velocity loop at a fifth of the heading rate runs a fifth as often
+    RateConfig rates;
+    rates.velocityDivisor = 5;
+    controller.setIntegralLimits(10.0, 4.0);
+    MultiRateSimulation multi(controller, robot, rates);
+    multi.setTargets(0.3, 2.0);
+    multi.run(500);
+    EXPECT_EQ(multi.getScheduler().getRunCount(0), 500u);
+    EXPECT_EQ(multi.getScheduler().getRunCount(1), 100u);
+    EXPECT_EQ(multi.getScheduler().getRunCount(2), 500u);
+    // Its integral sums a fifth as many errors, so Ki and the limit scale
+    const PIDController& velocityLoop = multi.getVelocityLoop();
+    EXPECT_DOUBLE_EQ(velocityLoop.getDeltaTime(), 0.5);
+    EXPECT_DOUBLE_EQ(velocityLoop.getVelocityIntegralConstant(), 0.05);
+    EXPECT_DOUBLE_EQ(velocityLoop.getVelocityIntegralLimit(), 2.0);
+    EXPECT_EQ(velocityLoop.getHeadingProportionalConstant(), 0.0);
+    EXPECT_DOUBLE_EQ(multi.getHeadingLoop().getDeltaTime(), 0.1);
+    EXPECT_EQ(multi.getHeadingLoop().getHeadingIntegralConstant(), 0.01);
+    EXPECT_EQ(multi.getHeadingLoop().getHeadingIntegralLimit(), 4.0);
+
+    // A velocity loop at a tenth of the rate still settles on the targets,
+    // because its command is spread over the plant steps it holds for
+    rates.velocityDivisor = 10;
+    MultiRateSimulation tenth(controller, robot, rates);
+    tenth.setTargets(0.3, 2.0);
+    tenth.run(2000);
+    EXPECT_NEAR(tenth.getRobot().getSpeed(), 2.0, 1e-3);
+    EXPECT_NEAR(tenth.getRobot().getHeading(), 0.3, 1e-3);
+
+    rates.plantDivisor = 0;
+    EXPECT_THROW(MultiRateSimulation(controller, robot, rates),
+                 std::invalid_argument);
+}